@@ -160,6 +160,20 @@ CommandLineHandler::CommandLineHandler()
             .add_name("--to-stdout")
             .set_description("send render to standard output"));
 
+    parser().add_option_handler(
+        &m_send_to_shared_memory
+            .add_name("--to-shared-memory")
+            .set_description("send render to a shared memory tile channel that local viewers can read")
+            .set_syntax("name")
+            .set_exact_value_count(1));
+
+    parser().add_option_handler(
+        &m_shared_memory_slots
+            .add_name("--shared-memory-slots")
+            .set_description("set the number of tiles the shared memory tile channel can hold (default: 256, maximum: 4096)")
+            .set_syntax("count")
+            .set_exact_value_count(1));
+
     parser().add_option_handler(
         &m_save_light_paths
             .add_name("--save-light-paths")
@@ -167,11 +181,30 @@ CommandLineHandler::CommandLineHandler()
             .set_syntax("filename")
             .set_exact_value_count(1));
 
+    parser().add_option_handler(
+        &m_save_profile_trace
+            .add_name("--save-profile-trace")
+            .set_description("record a profile of the render and save it to disk in Chrome trace format")
+            .set_syntax("filename")
+            .set_exact_value_count(1));
+
+    parser().add_option_handler(
+        &m_save_statistics
+            .add_name("--save-statistics")
+            .set_description("save render statistics to disk in JSON format")
+            .set_syntax("filename")
+            .set_exact_value_count(1));
+
     parser().add_option_handler(
         &m_disable_autosave
             .add_name("--disable-autosave")
             .set_description("disable automatic saving of rendered images"));
 
+    parser().add_option_handler(
+        &m_daemon_mode
+            .add_name("--daemon")
+            .set_description("keep the project loaded and render frames on commands read from standard input"));
+
     parser().add_option_handler(
         &m_run_unit_tests
             .add_name("--run-unit-tests")
@@ -76,10 +76,15 @@ class CommandLineHandler
     foundation::FlagOptionHandler                   m_display_output;
 #endif
     foundation::FlagOptionHandler                   m_send_to_stdout;
+    foundation::ValueOptionHandler<std::string>     m_send_to_shared_memory;
+    foundation::ValueOptionHandler<int>             m_shared_memory_slots;
     foundation::FlagOptionHandler                   m_send_to_mplay;
     foundation::ValueOptionHandler<int>             m_send_to_hrmanpipe;
     foundation::FlagOptionHandler                   m_disable_autosave;
     foundation::ValueOptionHandler<std::string>     m_save_light_paths;
+    foundation::ValueOptionHandler<std::string>     m_save_profile_trace;
+    foundation::ValueOptionHandler<std::string>     m_save_statistics;
+    foundation::FlagOptionHandler                   m_daemon_mode;
 
     // Developer-oriented options.
     foundation::ValueOptionHandler<std::string>     m_run_unit_tests;
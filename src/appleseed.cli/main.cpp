@@ -31,6 +31,8 @@
 #include "commandlinehandler.h"
 #include "houdinitilecallbacks.h"
 #include "progresstilecallback.h"
+#include "renderdaemon.h"
+#include "sharedmemorytilecallback.h"
 #include "stdouttilecallback.h"
 
 // appleseed.shared headers.
@@ -55,6 +57,8 @@
 #include "foundation/utility/benchmark.h"
 #include "foundation/utility/filter.h"
 #include "foundation/utility/log.h"
+#include "foundation/utility/profiler.h"
+#include "foundation/utility/statistics.h"
 #include "foundation/utility/string.h"
 #include "foundation/utility/test.h"
 
@@ -68,6 +72,8 @@
 // Standard headers.
 #include <cstddef>
 #include <cstdlib>
+#include <fstream>
+#include <iostream>
 #include <memory>
 #include <string>
 
@@ -477,19 +483,11 @@ namespace
         return value == "progressive";
     }
 
-    bool render(const string& project_filename)
+    ITileCallbackFactory* create_tile_callback_factory(
+        const string&       project_filename,
+        const Project&      project,
+        const ParamArray&   params)
     {
-        // Load the project.
-        auto_release_ptr<Project> project = load_project(project_filename);
-        if (project.get() == nullptr)
-            return false;
-
-        // Retrieve the rendering parameters.
-        ParamArray params;
-        if (!configure_project(project.ref(), params))
-            return false;
-
-        // Create the tile callback factory.
         unique_ptr<ITileCallbackFactory> tile_callback_factory;
         if (g_cl.m_send_to_mplay.is_set())
         {
@@ -513,7 +511,34 @@ namespace
                 new StdOutTileCallbackFactory(
                     StdOutTileCallbackFactory::TileOutputOptions::AllAOVs));
         }
-        else if (project->get_display() == nullptr)
+        else if (g_cl.m_send_to_shared_memory.is_set())
+        {
+            size_t slot_count = SharedMemoryTileCallbackFactory::DefaultSlotCount;
+
+            if (g_cl.m_shared_memory_slots.is_set())
+            {
+                const int value = g_cl.m_shared_memory_slots.value();
+                const int max_value = static_cast<int>(SharedMemoryTileCallbackFactory::MaxSlotCount);
+
+                if (value < 1 || value > max_value)
+                {
+                    LOG_WARNING(
+                        g_logger,
+                        "invalid number of shared memory slots (%d), it must be between 1 and %d; using %s slots.",
+                        value,
+                        max_value,
+                        pretty_uint(SharedMemoryTileCallbackFactory::DefaultSlotCount).c_str());
+                }
+                else slot_count = static_cast<size_t>(value);
+            }
+
+            tile_callback_factory.reset(
+                new SharedMemoryTileCallbackFactory(
+                    g_cl.m_send_to_shared_memory.value().c_str(),
+                    slot_count,
+                    g_logger));
+        }
+        else if (project.get_display() == nullptr)
         {
             // Create a default tile callback if needed.
             if (params.get_optional<string>("frame_renderer", "") != "progressive")
@@ -523,6 +548,45 @@ namespace
             }
         }
 
+        return tile_callback_factory.release();
+    }
+
+    // Write the statistics of the last render to a JSON file.
+    bool save_render_statistics(
+        const MasterRenderer&   renderer,
+        const string&           file_path)
+    {
+        LOG_INFO(g_logger, "writing render statistics to %s...", file_path.c_str());
+
+        ofstream file(file_path.c_str());
+        if (file.is_open())
+            file << "{\"statistics\":" << renderer.get_statistics().to_json() << "}\n";
+
+        if (!file)
+        {
+            LOG_ERROR(g_logger, "failed to write render statistics to %s.", file_path.c_str());
+            return false;
+        }
+
+        return true;
+    }
+
+    bool render(const string& project_filename)
+    {
+        // Load the project.
+        auto_release_ptr<Project> project = load_project(project_filename);
+        if (project.get() == nullptr)
+            return false;
+
+        // Retrieve the rendering parameters.
+        ParamArray params;
+        if (!configure_project(project.ref(), params))
+            return false;
+
+        // Create the tile callback factory.
+        unique_ptr<ITileCallbackFactory> tile_callback_factory(
+            create_tile_callback_factory(project_filename, project.ref(), params));
+
         // Create the master renderer.
         DefaultRendererController renderer_controller;
         MasterRenderer renderer(
@@ -543,6 +607,16 @@ namespace
         {
             rendering_result = renderer.render();
         }
+
+        bool success = true;
+
+        // Optionally save render statistics to disk, even if rendering failed.
+        if (g_cl.m_save_statistics.is_set())
+        {
+            if (!save_render_statistics(renderer, g_cl.m_save_statistics.value()))
+                success = false;
+        }
+
         if (rendering_result.m_status != MasterRenderer::RenderingResult::Succeeded)
             return false;
 
@@ -552,8 +626,6 @@ namespace
             "rendering finished in %s.",
             pretty_time(rendering_result.m_render_time, 3).c_str());
 
-        bool success = true;
-
         // Optionally archive the frame to disk.
         char* archive_path = nullptr;
         if (params.get_optional<bool>("autosave", true))
@@ -679,6 +751,45 @@ namespace
 
         return true;
     }
+
+    bool serve(const string& project_filename)
+    {
+        // Replies to commands are written to the standard output.
+        if (g_cl.m_send_to_stdout.is_set())
+        {
+            LOG_ERROR(g_logger, "--to-stdout cannot be used together with --daemon.");
+            return false;
+        }
+
+        // Load the project.
+        auto_release_ptr<Project> project = load_project(project_filename);
+        if (project.get() == nullptr)
+            return false;
+
+        // Retrieve the rendering parameters.
+        ParamArray params;
+        if (!configure_project(project.ref(), params))
+            return false;
+
+        // Keep texture tiles cached from one frame to the next.
+        params.insert_path("texture_store.persistent", true);
+
+        // Create the tile callback factory.
+        unique_ptr<ITileCallbackFactory> tile_callback_factory(
+            create_tile_callback_factory(project_filename, project.ref(), params));
+
+        // Create the master renderer. It is kept alive for all frames.
+        DefaultRendererController renderer_controller;
+        MasterRenderer renderer(
+            project.ref(),
+            params,
+            &renderer_controller,
+            tile_callback_factory.get());
+
+        // Render frames on demand.
+        RenderDaemon daemon(project.ref(), renderer, g_logger);
+        return daemon.run(cin, cout);
+    }
 }
 
 
@@ -723,6 +834,10 @@ int main(int argc, const char* argv[])
     if (g_cl.m_run_unit_benchmarks.is_set())
         run_unit_benchmarks();
 
+    // Start recording a profile of the render if requested.
+    if (g_cl.m_save_profile_trace.is_set())
+        Profiler::set_enabled(true);
+
     // Render the specified project.
     if (!g_cl.m_filename.values().empty())
     {
@@ -730,9 +845,38 @@ int main(int argc, const char* argv[])
 
         if (g_cl.m_benchmark_mode.is_set())
             success = success && benchmark_render(project_filename);
+        else if (g_cl.m_daemon_mode.is_set())
+            success = success && serve(project_filename);
         else success = success && render(project_filename);
     }
 
+    // Save the recorded profile to disk.
+    if (g_cl.m_save_profile_trace.is_set())
+    {
+        Profiler::set_enabled(false);
+
+        const char* file_path = g_cl.m_save_profile_trace.value().c_str();
+        LOG_INFO(
+            g_logger,
+            "writing profile trace with %s events to %s...",
+            pretty_uint(Profiler::get_event_count()).c_str(),
+            file_path);
+
+        if (Profiler::get_dropped_event_count() > 0)
+        {
+            LOG_WARNING(
+                g_logger,
+                "%s profile events were dropped.",
+                pretty_uint(Profiler::get_dropped_event_count()).c_str());
+        }
+
+        if (!Profiler::write_chrome_trace(file_path))
+        {
+            LOG_ERROR(g_logger, "failed to write profile trace to %s.", file_path);
+            success = false;
+        }
+    }
+
     if (is_debugger_attached())
         Console::pause();
 
@@ -0,0 +1,276 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2018 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// Interface header.
+#include "renderdaemon.h"
+
+// appleseed.renderer headers.
+#include "renderer/api/camera.h"
+#include "renderer/api/frame.h"
+#include "renderer/api/project.h"
+#include "renderer/api/rendering.h"
+#include "renderer/api/scene.h"
+#include "renderer/api/utility.h"
+
+// appleseed.foundation headers.
+#include "foundation/math/matrix.h"
+#include "foundation/math/transform.h"
+#include "foundation/platform/thread.h"
+#include "foundation/utility/log.h"
+#include "foundation/utility/string.h"
+
+// Standard headers.
+#include <cstddef>
+#include <istream>
+#include <ostream>
+
+using namespace foundation;
+using namespace renderer;
+using namespace std;
+
+namespace appleseed {
+namespace cli {
+
+namespace
+{
+    // Parse a row-major 4x4 matrix from 16 tokens starting at a given index.
+    bool parse_matrix(
+        const vector<string>&   tokens,
+        const size_t            first,
+        Matrix4d&               matrix,
+        string&                 reply)
+    {
+        if (tokens.size() != first + 16)
+        {
+            reply = "expected 16 matrix coefficients";
+            return false;
+        }
+
+        try
+        {
+            for (size_t i = 0; i < 16; ++i)
+                matrix[i] = from_string<double>(tokens[first + i]);
+        }
+        catch (const ExceptionStringConversionError&)
+        {
+            reply = "invalid matrix coefficient";
+            return false;
+        }
+
+        return true;
+    }
+}
+
+RenderDaemon::RenderDaemon(
+    Project&            project,
+    MasterRenderer&     renderer,
+    Logger&             logger)
+  : m_project(project)
+  , m_renderer(renderer)
+  , m_logger(logger)
+  , m_success(true)
+{
+}
+
+bool RenderDaemon::run(istream& input, ostream& output)
+{
+    LOG_INFO(m_logger, "waiting for commands...");
+
+    string line;
+    while (getline(input, line))
+    {
+        TokenVector tokens;
+        tokenize(line, " \t\r", tokens);
+
+        // Skip empty lines.
+        if (tokens.empty())
+            continue;
+
+        const string& command = tokens[0];
+
+        if (command == "quit")
+        {
+            output << "ok" << endl;
+            break;
+        }
+
+        string reply;
+        bool ok;
+
+        if (command == "set")
+            ok = execute_set(tokens, reply);
+        else if (command == "transform")
+            ok = execute_transform(tokens, reply);
+        else if (command == "camera")
+            ok = execute_camera(tokens, reply);
+        else if (command == "render")
+            ok = execute_render(tokens, reply);
+        else
+        {
+            reply = "unknown command \"" + command + "\"";
+            ok = false;
+        }
+
+        if (!ok)
+            LOG_ERROR(m_logger, "%s: %s.", command.c_str(), reply.c_str());
+
+        output << (ok ? "ok" : "error");
+        if (!reply.empty())
+            output << ' ' << reply;
+        output << endl;
+    }
+
+    return m_success;
+}
+
+bool RenderDaemon::execute_set(const TokenVector& tokens, string& reply)
+{
+    if (tokens.size() < 3)
+    {
+        reply = "expected a parameter path and a value";
+        return false;
+    }
+
+    // The value is the remainder of the line and may contain spaces.
+    string value = tokens[2];
+    for (size_t i = 3, e = tokens.size(); i < e; ++i)
+        value += ' ' + tokens[i];
+
+    m_renderer.get_parameters().insert_path(tokens[1], value);
+
+    return true;
+}
+
+bool RenderDaemon::execute_transform(const TokenVector& tokens, string& reply)
+{
+    if (tokens.size() < 2)
+    {
+        reply = "expected an assembly instance name";
+        return false;
+    }
+
+    AssemblyInstance* assembly_instance =
+        m_project.get_scene()->assembly_instances().get_by_name(tokens[1].c_str());
+    if (assembly_instance == nullptr)
+    {
+        reply = "no assembly instance named \"" + tokens[1] + "\"";
+        return false;
+    }
+
+    Matrix4d matrix;
+    if (!parse_matrix(tokens, 2, matrix, reply))
+        return false;
+
+    // The assembly tree is refit rather than rebuilt when only transforms changed.
+    assembly_instance->transform_sequence().clear();
+    assembly_instance->transform_sequence().set_transform(
+        0.0f,
+        Transformd::from_local_to_parent(matrix));
+
+    return true;
+}
+
+bool RenderDaemon::execute_camera(const TokenVector& tokens, string& reply)
+{
+    Camera* camera = m_project.get_uncached_active_camera();
+    if (camera == nullptr)
+    {
+        reply = "no active camera";
+        return false;
+    }
+
+    Matrix4d matrix;
+    if (!parse_matrix(tokens, 1, matrix, reply))
+        return false;
+
+    camera->transform_sequence().clear();
+    camera->transform_sequence().set_transform(
+        0.0f,
+        Transformd::from_local_to_parent(matrix));
+
+    return true;
+}
+
+bool RenderDaemon::execute_render(const TokenVector& tokens, string& reply)
+{
+    if (tokens.size() > 2)
+    {
+        reply = "expected at most one output file";
+        return false;
+    }
+
+    LOG_INFO(m_logger, "rendering frame...");
+
+    MasterRenderer::RenderingResult rendering_result;
+    if (m_renderer.get_parameters().get_optional<bool>("background_mode", true))
+    {
+        ProcessPriorityContext background_context(ProcessPriorityLow, &m_logger);
+        rendering_result = m_renderer.render();
+    }
+    else
+    {
+        rendering_result = m_renderer.render();
+    }
+
+    if (rendering_result.m_status != MasterRenderer::RenderingResult::Succeeded)
+    {
+        reply = "rendering failed";
+        m_success = false;
+        return false;
+    }
+
+    LOG_INFO(
+        m_logger,
+        "rendering finished in %s.",
+        pretty_time(rendering_result.m_render_time, 3).c_str());
+
+    const Frame* frame = m_project.get_frame();
+
+    bool success = true;
+    if (tokens.size() == 2)
+    {
+        const char* file_path = tokens[1].c_str();
+        success = frame->write_main_image(file_path) && success;
+        success = frame->write_aov_images(file_path) && success;
+    }
+    else success = frame->write_main_and_aov_images();
+
+    if (!success)
+    {
+        reply = "failed to write images";
+        m_success = false;
+        return false;
+    }
+
+    reply = to_string(rendering_result.m_render_time);
+
+    return true;
+}
+
+}   // namespace cli
+}   // namespace appleseed
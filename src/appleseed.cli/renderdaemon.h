@@ -0,0 +1,98 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2018 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef APPLESEED_CLI_RENDERDAEMON_H
+#define APPLESEED_CLI_RENDERDAEMON_H
+
+// appleseed.foundation headers.
+#include "foundation/core/concepts/noncopyable.h"
+
+// Standard headers.
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// Forward declarations.
+namespace foundation    { class Logger; }
+namespace renderer      { class MasterRenderer; }
+namespace renderer      { class Project; }
+
+namespace appleseed {
+namespace cli {
+
+//
+// A long-running render server that keeps a project and its master renderer
+// alive across frames, so that acceleration structures, compiled shaders and
+// texture caches are reused from one frame to the next.
+//
+// Commands are read one per line. Each command gets a single reply line that
+// starts with either "ok" or "error":
+//
+//   set <parameter path> <value>           set a rendering parameter
+//   transform <assembly instance> <m00> ... <m33>
+//                                          set the transform of an assembly instance
+//   camera <m00> ... <m33>                 set the transform of the active camera
+//   render [<output file>]                 render a frame and write it to disk
+//   quit                                   stop the server
+//
+// Matrices are given in row-major order.
+//
+
+class RenderDaemon
+  : public foundation::NonCopyable
+{
+  public:
+    // Constructor.
+    RenderDaemon(
+        renderer::Project&          project,
+        renderer::MasterRenderer&   renderer,
+        foundation::Logger&         logger);
+
+    // Execute commands until the quit command or the end of the input.
+    // Return false if one or more frames failed to render.
+    bool run(std::istream& input, std::ostream& output);
+
+  private:
+    typedef std::vector<std::string> TokenVector;
+
+    renderer::Project&          m_project;
+    renderer::MasterRenderer&   m_renderer;
+    foundation::Logger&         m_logger;
+    bool                        m_success;
+
+    // Each command returns true on success and fills in the reply message.
+    bool execute_set(const TokenVector& tokens, std::string& reply);
+    bool execute_transform(const TokenVector& tokens, std::string& reply);
+    bool execute_camera(const TokenVector& tokens, std::string& reply);
+    bool execute_render(const TokenVector& tokens, std::string& reply);
+};
+
+}       // namespace cli
+}       // namespace appleseed
+
+#endif  // !APPLESEED_CLI_RENDERDAEMON_H
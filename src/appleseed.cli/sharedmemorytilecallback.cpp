@@ -0,0 +1,281 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2018 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// Interface header.
+#include "sharedmemorytilecallback.h"
+
+// appleseed.shared headers.
+#include "tilechannel/tilechannelwriter.h"
+
+// appleseed.renderer headers.
+#include "renderer/api/aov.h"
+#include "renderer/api/frame.h"
+
+// appleseed.foundation headers.
+#include "foundation/image/canvasproperties.h"
+#include "foundation/image/image.h"
+#include "foundation/image/pixel.h"
+#include "foundation/image/tile.h"
+#include "foundation/platform/thread.h"
+#include "foundation/utility/log.h"
+#include "foundation/utility/string.h"
+
+// Standard headers.
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <string>
+
+using namespace appleseed::shared;
+using namespace foundation;
+using namespace renderer;
+using namespace std;
+
+namespace appleseed {
+namespace cli {
+
+namespace
+{
+    //
+    // SharedMemoryTileCallback.
+    //
+
+    class SharedMemoryTileCallback
+      : public TileCallbackBase
+    {
+      public:
+        SharedMemoryTileCallback(
+            const char*         channel_name,
+            const size_t        slot_count,
+            Logger&             logger)
+          : m_channel_name(channel_name)
+          , m_slot_count(slot_count)
+          , m_logger(logger)
+          , m_open_failed(false)
+          , m_plane_count(0)
+        {
+            assert(m_slot_count > 0);
+        }
+
+        void release() override
+        {
+            // The factory always return the same tile callback instance.
+            // Prevent this instance from being destroyed by doing nothing here.
+        }
+
+        void on_tiled_frame_begin(const Frame* frame) override
+        {
+            boost::mutex::scoped_lock lock(m_mutex);
+
+            if (open_channel(*frame))
+                m_writer.begin_update();
+        }
+
+        void on_tile_end(
+            const Frame*        frame,
+            const size_t        tile_x,
+            const size_t        tile_y) override
+        {
+            boost::mutex::scoped_lock lock(m_mutex);
+
+            if (open_channel(*frame))
+                write_tile(*frame, tile_x, tile_y);
+        }
+
+        void on_progressive_frame_update(const Frame* frame) override
+        {
+            boost::mutex::scoped_lock lock(m_mutex);
+
+            if (!open_channel(*frame))
+                return;
+
+            m_writer.begin_update();
+
+            const CanvasProperties& props = frame->image().properties();
+
+            for (size_t ty = 0; ty < props.m_tile_count_y; ++ty)
+            {
+                for (size_t tx = 0; tx < props.m_tile_count_x; ++tx)
+                    write_tile(*frame, tx, ty);
+            }
+        }
+
+      private:
+        const string        m_channel_name;
+        const size_t        m_slot_count;
+        Logger&             m_logger;
+        boost::mutex        m_mutex;
+        bool                m_open_failed;
+        size_t              m_plane_count;      // number of published planes
+        TileChannelWriter   m_writer;
+
+        bool open_channel(const Frame& frame)
+        {
+            if (m_writer.is_open())
+                return true;
+
+            if (m_open_failed)
+                return false;
+
+            const CanvasProperties& props = frame.image().properties();
+
+            m_writer.add_plane("beauty", props.m_channel_count);
+            m_plane_count = 1;
+
+            for (size_t i = 0, e = frame.aovs().size(); i < e; ++i)
+            {
+                const AOV* aov = frame.aovs().get_by_index(i);
+
+                if (!m_writer.add_plane(
+                        aov->get_name(),
+                        aov->get_image().properties().m_channel_count))
+                {
+                    LOG_WARNING(
+                        m_logger,
+                        "shared memory tile channel \"%s\" is limited to %s planes, "
+                        "the last %s aov(s) will not be published.",
+                        m_channel_name.c_str(),
+                        pretty_uint(m_plane_count).c_str(),
+                        pretty_uint(e - i).c_str());
+                    break;
+                }
+
+                ++m_plane_count;
+            }
+
+            // There is no point in holding more than one full update of every plane.
+            const size_t slot_count = min(m_slot_count, props.m_tile_count * m_plane_count);
+
+            if (!m_writer.open(
+                    m_channel_name.c_str(),
+                    props.m_canvas_width,
+                    props.m_canvas_height,
+                    props.m_tile_width,
+                    props.m_tile_height,
+                    slot_count))
+            {
+                LOG_ERROR(m_logger, "failed to create shared memory tile channel \"%s\".", m_channel_name.c_str());
+                m_open_failed = true;
+                return false;
+            }
+
+            LOG_INFO(m_logger, "publishing tiles to shared memory tile channel \"%s\".", m_channel_name.c_str());
+
+            return true;
+        }
+
+        void write_tile(
+            const Frame&        frame,
+            const size_t        tile_x,
+            const size_t        tile_y)
+        {
+            // We assume all AOV images have the same properties as the main image.
+            const CanvasProperties& props = frame.image().properties();
+
+            do_write_tile(
+                props,
+                frame.image().tile(tile_x, tile_y),
+                tile_x,
+                tile_y,
+                0);
+
+            for (size_t i = 0, e = m_plane_count - 1; i < e; ++i)
+            {
+                const AOV* aov = frame.aovs().get_by_index(i);
+
+                do_write_tile(
+                    props,
+                    aov->get_image().tile(tile_x, tile_y),
+                    tile_x,
+                    tile_y,
+                    i + 1);
+            }
+        }
+
+        void do_write_tile(
+            const CanvasProperties& properties,
+            const Tile&         tile,
+            const size_t        tile_x,
+            const size_t        tile_y,
+            const size_t        plane_index)
+        {
+            const size_t x = tile_x * properties.m_tile_width;
+            const size_t y = tile_y * properties.m_tile_height;
+
+            if (tile.get_pixel_format() != PixelFormatFloat)
+            {
+                const Tile tmp(tile, PixelFormatFloat);
+                m_writer.write_tile(
+                    plane_index,
+                    x,
+                    y,
+                    tmp.get_width(),
+                    tmp.get_height(),
+                    tmp.get_channel_count(),
+                    reinterpret_cast<const float*>(tmp.get_storage()));
+            }
+            else
+            {
+                m_writer.write_tile(
+                    plane_index,
+                    x,
+                    y,
+                    tile.get_width(),
+                    tile.get_height(),
+                    tile.get_channel_count(),
+                    reinterpret_cast<const float*>(tile.get_storage()));
+            }
+        }
+    };
+}
+
+
+//
+// SharedMemoryTileCallbackFactory class implementation.
+//
+
+SharedMemoryTileCallbackFactory::SharedMemoryTileCallbackFactory(
+    const char*         channel_name,
+    const size_t        slot_count,
+    Logger&             logger)
+  : m_callback(new SharedMemoryTileCallback(channel_name, slot_count, logger))
+{
+}
+
+void SharedMemoryTileCallbackFactory::release()
+{
+    delete this;
+}
+
+ITileCallback* SharedMemoryTileCallbackFactory::create()
+{
+    return m_callback.get();
+}
+
+}   // namespace cli
+}   // namespace appleseed
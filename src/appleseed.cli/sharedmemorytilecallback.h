@@ -0,0 +1,75 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2018 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef APPLESEED_CLI_SHAREDMEMORYTILECALLBACK_H
+#define APPLESEED_CLI_SHAREDMEMORYTILECALLBACK_H
+
+// appleseed.renderer headers.
+#include "renderer/api/rendering.h"
+
+// Standard headers.
+#include <cstddef>
+#include <memory>
+
+// Forward declarations.
+namespace foundation    { class Logger; }
+
+namespace appleseed {
+namespace cli {
+
+//
+// Publish rendered tiles to a shared memory tile channel so that viewers
+// running on the same machine can display them without going through a pipe.
+//
+
+class SharedMemoryTileCallbackFactory
+  : public renderer::ITileCallbackFactory
+{
+  public:
+    // Bounds on the number of tiles the channel can hold. Readers that fall
+    // behind by more than this number of tiles lose the oldest ones.
+    static const size_t DefaultSlotCount = 256;
+    static const size_t MaxSlotCount = 4096;
+
+    SharedMemoryTileCallbackFactory(
+        const char*         channel_name,
+        const size_t        slot_count,
+        foundation::Logger& logger);
+
+    void release() override;
+
+    renderer::ITileCallback* create() override;
+
+  private:
+    std::unique_ptr<renderer::ITileCallback> m_callback;
+};
+
+}       // namespace cli
+}       // namespace appleseed
+
+#endif  // !APPLESEED_CLI_SHAREDMEMORYTILECALLBACK_H
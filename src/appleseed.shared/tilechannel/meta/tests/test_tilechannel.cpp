@@ -0,0 +1,126 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2018 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// appleseed.shared headers.
+#include "tilechannel/tilechannelformat.h"
+#include "tilechannel/tilechannelreader.h"
+#include "tilechannel/tilechannelwriter.h"
+
+// appleseed.foundation headers.
+#include "foundation/utility/test.h"
+
+// Standard headers.
+#include <cstring>
+
+using namespace appleseed::shared;
+using namespace foundation;
+
+TEST_SUITE(Shared_TileChannel)
+{
+    const char* ChannelName = "appleseed_test_tilechannel";
+
+    struct Fixture
+    {
+        TileChannelWriter   m_writer;
+        TileChannelReader   m_reader;
+
+        Fixture()
+        {
+            m_writer.add_plane("beauty", 4);
+            m_writer.add_plane("depth", 1);
+            m_writer.open(ChannelName, 64, 32, 16, 16, 4);
+            m_reader.open(ChannelName);
+        }
+    };
+
+    TEST_CASE_F(Open_ExposesFrameAndPlanes, Fixture)
+    {
+        ASSERT_TRUE(m_reader.is_open());
+
+        const TileChannelHeader& header = m_reader.get_header();
+
+        EXPECT_EQ(64, header.m_frame_width);
+        EXPECT_EQ(32, header.m_frame_height);
+        EXPECT_EQ(16, header.m_tile_width);
+        EXPECT_EQ(16, header.m_tile_height);
+        EXPECT_EQ(4, header.m_slot_count);
+        EXPECT_EQ(2, header.m_plane_count);
+        EXPECT_EQ(0, strcmp(header.m_planes[1].m_name, "depth"));
+        EXPECT_EQ(1, header.m_planes[1].m_channel_count);
+    }
+
+    TEST_CASE_F(AcquireTile_GivenPublishedTile_ReturnsTile, Fixture)
+    {
+        float pixels[16 * 16];
+        for (size_t i = 0; i < 16 * 16; ++i)
+            pixels[i] = static_cast<float>(i);
+
+        m_writer.write_tile(1, 16, 0, 16, 16, 1, pixels);
+
+        TileChannelTile tile;
+        ASSERT_TRUE(m_reader.acquire_tile(tile));
+
+        EXPECT_EQ(1, tile.m_header->m_plane_index);
+        EXPECT_EQ(16, tile.m_header->m_x);
+        EXPECT_EQ(0, tile.m_header->m_y);
+        EXPECT_EQ(1, tile.m_header->m_channel_count);
+        EXPECT_EQ(255.0f, tile.m_pixels[255]);
+        EXPECT_TRUE(m_reader.release_tile(tile));
+
+        EXPECT_FALSE(m_reader.acquire_tile(tile));
+    }
+
+    TEST_CASE_F(ReleaseTile_GivenTileOverwrittenWhileInUse_ReturnsFalse, Fixture)
+    {
+        const float pixels[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+        m_writer.write_tile(0, 0, 0, 1, 1, 4, pixels);
+
+        TileChannelTile tile;
+        ASSERT_TRUE(m_reader.acquire_tile(tile));
+
+        for (size_t i = 0; i < 4; ++i)
+            m_writer.write_tile(0, 0, 0, 1, 1, 4, pixels);
+
+        EXPECT_FALSE(m_reader.release_tile(tile));
+    }
+
+    TEST_CASE_F(AcquireTile_GivenReaderFellBehind_SkipsOverwrittenTiles, Fixture)
+    {
+        const float pixels[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+        for (size_t i = 0; i < 6; ++i)
+            m_writer.write_tile(0, i, 0, 1, 1, 4, pixels);
+
+        TileChannelTile tile;
+        ASSERT_TRUE(m_reader.acquire_tile(tile));
+
+        EXPECT_EQ(2, tile.m_header->m_x);
+        EXPECT_EQ(2, m_reader.get_lost_tile_count());
+    }
+}
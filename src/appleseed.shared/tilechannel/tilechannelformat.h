@@ -0,0 +1,119 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2018 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef APPLESEED_SHARED_TILECHANNEL_TILECHANNELFORMAT_H
+#define APPLESEED_SHARED_TILECHANNEL_TILECHANNELFORMAT_H
+
+// appleseed.foundation headers.
+#include "foundation/platform/types.h"
+
+// Boost headers.
+#include "boost/atomic.hpp"
+
+// Standard headers.
+#include <cstddef>
+
+namespace appleseed {
+namespace shared {
+
+//
+// Memory layout of a tile channel, a ring buffer of tiles living in a named
+// shared memory object, written by a renderer and read by a local viewer or
+// compositor.
+//
+// The shared memory object starts with a TileChannelHeader. It is followed by
+// m_slot_count slots of m_slot_size bytes, the first one at offset m_header_size.
+// Every slot starts with a TileChannelSlotHeader, immediately followed by the
+// pixels of the tile: m_width x m_height pixels of m_channel_count 32-bit
+// floats, row by row, with interleaved channels. All values are in the native
+// byte order of the machine.
+//
+// Tiles are published in sequence. Tile number n (starting at 0) goes to slot
+// n % m_slot_count. To publish it, the writer:
+//
+//   1. sets the slot's m_sequence to 0,
+//   2. fills the slot header and the pixels,
+//   3. sets the slot's m_sequence to n + 1,
+//   4. sets the channel's m_write_sequence to n + 1.
+//
+// A reader keeps its own read sequence r. It can read tile r whenever
+// r < m_write_sequence, and the pixels it reads are valid as long as the slot's
+// m_sequence is still r + 1 once it is done with them. A reader that falls
+// m_slot_count tiles behind loses the oldest tiles.
+//
+// m_update identifies the pass or progressive update that produced a tile:
+// all tiles of a given update are published before the tiles of the next one.
+//
+
+const foundation::uint32 TileChannelMagic = 0x43545341;        // "ASTC"
+const foundation::uint32 TileChannelVersion = 1;
+
+const size_t TileChannelMaxPlaneCount = 32;
+const size_t TileChannelMaxPlaneNameLength = 64;                // including the terminating zero
+
+struct TileChannelPlane
+{
+    char                            m_name[TileChannelMaxPlaneNameLength];
+    foundation::uint32              m_channel_count;
+    foundation::uint32              m_reserved;
+};
+
+struct TileChannelHeader
+{
+    foundation::uint32              m_magic;                    // TileChannelMagic
+    foundation::uint32              m_version;                  // TileChannelVersion
+    foundation::uint32              m_header_size;              // offset of the first slot, in bytes
+    foundation::uint32              m_slot_count;
+    foundation::uint64              m_slot_size;                // size of a slot, in bytes
+    foundation::uint32              m_frame_width;              // in pixels
+    foundation::uint32              m_frame_height;             // in pixels
+    foundation::uint32              m_tile_width;               // in pixels
+    foundation::uint32              m_tile_height;              // in pixels
+    foundation::uint32              m_plane_count;              // beauty first, then AOVs
+    foundation::uint32              m_reserved;
+    TileChannelPlane                m_planes[TileChannelMaxPlaneCount];
+    boost::atomic<foundation::uint64> m_write_sequence;         // number of published tiles
+};
+
+struct TileChannelSlotHeader
+{
+    boost::atomic<foundation::uint64> m_sequence;               // tile number + 1, or 0 while being written
+    foundation::uint32              m_update;
+    foundation::uint32              m_plane_index;
+    foundation::uint32              m_x;                        // position of the tile in the frame, in pixels
+    foundation::uint32              m_y;
+    foundation::uint32              m_width;                    // in pixels
+    foundation::uint32              m_height;                   // in pixels
+    foundation::uint32              m_channel_count;
+    foundation::uint32              m_reserved;
+};
+
+}       // namespace shared
+}       // namespace appleseed
+
+#endif  // !APPLESEED_SHARED_TILECHANNEL_TILECHANNELFORMAT_H
@@ -0,0 +1,192 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2018 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// Interface header.
+#include "tilechannelreader.h"
+
+// Boost headers.
+#include "boost/interprocess/exceptions.hpp"
+#include "boost/interprocess/mapped_region.hpp"
+#include "boost/interprocess/shared_memory_object.hpp"
+
+// Standard headers.
+#include <cassert>
+#include <cstddef>
+#include <memory>
+
+using namespace foundation;
+using namespace std;
+namespace bi = boost::interprocess;
+
+namespace appleseed {
+namespace shared {
+
+struct TileChannelReader::Impl
+{
+    unique_ptr<bi::shared_memory_object> m_shm;
+    unique_ptr<bi::mapped_region>       m_region;
+    const TileChannelHeader*            m_header;
+    uint64                              m_read_sequence;
+    uint64                              m_lost_tile_count;
+
+    const TileChannelSlotHeader* get_slot(const uint64 sequence) const
+    {
+        const uint8* base = static_cast<const uint8*>(m_region->get_address());
+        const size_t slot_index = static_cast<size_t>(sequence % m_header->m_slot_count);
+        return
+            reinterpret_cast<const TileChannelSlotHeader*>(
+                base + m_header->m_header_size + slot_index * m_header->m_slot_size);
+    }
+};
+
+TileChannelReader::TileChannelReader()
+  : impl(new Impl())
+{
+    impl->m_header = nullptr;
+    impl->m_read_sequence = 0;
+    impl->m_lost_tile_count = 0;
+}
+
+TileChannelReader::~TileChannelReader()
+{
+    close();
+    delete impl;
+}
+
+bool TileChannelReader::open(const char* name)
+{
+    close();
+
+    try
+    {
+        impl->m_shm.reset(
+            new bi::shared_memory_object(
+                bi::open_only,
+                name,
+                bi::read_only));
+
+        impl->m_region.reset(new bi::mapped_region(*impl->m_shm, bi::read_only));
+    }
+    catch (const bi::interprocess_exception&)
+    {
+        impl->m_region.reset();
+        impl->m_shm.reset();
+        return false;
+    }
+
+    const TileChannelHeader* header =
+        static_cast<const TileChannelHeader*>(impl->m_region->get_address());
+
+    if (impl->m_region->get_size() < sizeof(TileChannelHeader) ||
+        header->m_magic != TileChannelMagic ||
+        header->m_version != TileChannelVersion ||
+        impl->m_region->get_size() < header->m_header_size + header->m_slot_count * header->m_slot_size)
+    {
+        impl->m_region.reset();
+        impl->m_shm.reset();
+        return false;
+    }
+
+    impl->m_header = header;
+    impl->m_read_sequence = 0;
+    impl->m_lost_tile_count = 0;
+
+    return true;
+}
+
+void TileChannelReader::close()
+{
+    impl->m_header = nullptr;
+    impl->m_region.reset();
+    impl->m_shm.reset();
+}
+
+bool TileChannelReader::is_open() const
+{
+    return impl->m_header != nullptr;
+}
+
+const TileChannelHeader& TileChannelReader::get_header() const
+{
+    assert(is_open());
+    return *impl->m_header;
+}
+
+bool TileChannelReader::acquire_tile(TileChannelTile& tile)
+{
+    assert(is_open());
+
+    const uint64 write_sequence =
+        impl->m_header->m_write_sequence.load(boost::memory_order_acquire);
+
+    // Skip the tiles that were already overwritten.
+    const uint64 slot_count = impl->m_header->m_slot_count;
+    if (write_sequence - impl->m_read_sequence > slot_count)
+    {
+        impl->m_lost_tile_count += write_sequence - slot_count - impl->m_read_sequence;
+        impl->m_read_sequence = write_sequence - slot_count;
+    }
+
+    while (impl->m_read_sequence < write_sequence)
+    {
+        const uint64 sequence = impl->m_read_sequence++;
+        const TileChannelSlotHeader* slot_header = impl->get_slot(sequence);
+
+        if (slot_header->m_sequence.load(boost::memory_order_acquire) == sequence + 1)
+        {
+            tile.m_sequence = sequence;
+            tile.m_header = slot_header;
+            tile.m_pixels =
+                reinterpret_cast<const float*>(
+                    reinterpret_cast<const uint8*>(slot_header) + sizeof(TileChannelSlotHeader));
+            return true;
+        }
+
+        // The slot is already being reused by a more recent tile.
+        ++impl->m_lost_tile_count;
+    }
+
+    return false;
+}
+
+bool TileChannelReader::release_tile(const TileChannelTile& tile) const
+{
+    assert(is_open());
+
+    boost::atomic_thread_fence(boost::memory_order_acquire);
+
+    return tile.m_header->m_sequence.load(boost::memory_order_relaxed) == tile.m_sequence + 1;
+}
+
+uint64 TileChannelReader::get_lost_tile_count() const
+{
+    return impl->m_lost_tile_count;
+}
+
+}   // namespace shared
+}   // namespace appleseed
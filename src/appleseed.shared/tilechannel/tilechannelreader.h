@@ -0,0 +1,103 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2018 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef APPLESEED_SHARED_TILECHANNEL_TILECHANNELREADER_H
+#define APPLESEED_SHARED_TILECHANNEL_TILECHANNELREADER_H
+
+// appleseed.shared headers.
+#include "application/dllsymbol.h"
+#include "tilechannel/tilechannelformat.h"
+
+// appleseed.foundation headers.
+#include "foundation/core/concepts/noncopyable.h"
+#include "foundation/platform/types.h"
+
+namespace appleseed {
+namespace shared {
+
+//
+// A tile read from a tile channel. The header and the pixels point directly
+// into the shared memory object.
+//
+
+struct TileChannelTile
+{
+    foundation::uint64              m_sequence;
+    const TileChannelSlotHeader*    m_header;
+    const float*                    m_pixels;
+};
+
+
+//
+// Reads tiles from a shared memory tile channel, without copying them.
+// See tilechannelformat.h for a description of the channel layout.
+//
+// A reader must only be used by one thread at a time.
+//
+
+class SHAREDDLL TileChannelReader
+  : public foundation::NonCopyable
+{
+  public:
+    // Constructor.
+    TileChannelReader();
+
+    // Destructor. Closes the channel.
+    ~TileChannelReader();
+
+    // Map an existing tile channel. Return true on success.
+    bool open(const char* name);
+
+    // Unmap the channel.
+    void close();
+
+    // Return true if the channel is open.
+    bool is_open() const;
+
+    // Access the channel header. The channel must be open.
+    const TileChannelHeader& get_header() const;
+
+    // Fetch the next published tile. Return false if there is none.
+    bool acquire_tile(TileChannelTile& tile);
+
+    // Return true if a tile was not overwritten by the writer since it was acquired,
+    // i.e. if the data read from it is valid.
+    bool release_tile(const TileChannelTile& tile) const;
+
+    // Return the number of tiles that were overwritten before they could be acquired.
+    foundation::uint64 get_lost_tile_count() const;
+
+  private:
+    struct Impl;
+    Impl* impl;
+};
+
+}       // namespace shared
+}       // namespace appleseed
+
+#endif  // !APPLESEED_SHARED_TILECHANNEL_TILECHANNELREADER_H
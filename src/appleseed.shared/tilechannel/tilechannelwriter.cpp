@@ -0,0 +1,275 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2018 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// Interface header.
+#include "tilechannelwriter.h"
+
+// appleseed.shared headers.
+#include "tilechannel/tilechannelformat.h"
+
+// appleseed.foundation headers.
+#include "foundation/utility/memory.h"
+
+// Boost headers.
+#include "boost/interprocess/exceptions.hpp"
+#include "boost/interprocess/mapped_region.hpp"
+#include "boost/interprocess/shared_memory_object.hpp"
+#include "boost/thread/mutex.hpp"
+
+// Standard headers.
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace foundation;
+using namespace std;
+namespace bi = boost::interprocess;
+
+namespace appleseed {
+namespace shared {
+
+struct TileChannelWriter::Impl
+{
+    vector<TileChannelPlane>            m_planes;
+    size_t                              m_max_channel_count;
+
+    string                              m_name;
+    unique_ptr<bi::shared_memory_object> m_shm;
+    unique_ptr<bi::mapped_region>       m_region;
+    TileChannelHeader*                  m_header;
+
+    boost::mutex                        m_mutex;
+    uint32                              m_update;
+    uint64                              m_write_sequence;
+
+    uint8* get_slot(const uint64 sequence) const
+    {
+        uint8* base = static_cast<uint8*>(m_region->get_address());
+        const size_t slot_index = static_cast<size_t>(sequence % m_header->m_slot_count);
+        return base + m_header->m_header_size + slot_index * m_header->m_slot_size;
+    }
+};
+
+TileChannelWriter::TileChannelWriter()
+  : impl(new Impl())
+{
+    impl->m_max_channel_count = 0;
+    impl->m_header = nullptr;
+    impl->m_update = 0;
+    impl->m_write_sequence = 0;
+}
+
+TileChannelWriter::~TileChannelWriter()
+{
+    close();
+    delete impl;
+}
+
+bool TileChannelWriter::add_plane(
+    const char*                 name,
+    const size_t                channel_count)
+{
+    boost::mutex::scoped_lock lock(impl->m_mutex);
+
+    assert(!is_open());
+
+    if (impl->m_planes.size() == TileChannelMaxPlaneCount)
+        return false;
+
+    TileChannelPlane plane;
+    memset(&plane, 0, sizeof(plane));
+    strncpy(plane.m_name, name, TileChannelMaxPlaneNameLength - 1);
+    plane.m_channel_count = static_cast<uint32>(channel_count);
+
+    impl->m_planes.push_back(plane);
+    impl->m_max_channel_count = max(impl->m_max_channel_count, channel_count);
+
+    return true;
+}
+
+bool TileChannelWriter::open(
+    const char*                 name,
+    const size_t                frame_width,
+    const size_t                frame_height,
+    const size_t                tile_width,
+    const size_t                tile_height,
+    const size_t                slot_count)
+{
+    boost::mutex::scoped_lock lock(impl->m_mutex);
+
+    assert(!is_open());
+    assert(slot_count > 0);
+
+    const size_t header_size = align(sizeof(TileChannelHeader), 64);
+    const size_t slot_size =
+        align(
+            sizeof(TileChannelSlotHeader) +
+            tile_width * tile_height * impl->m_max_channel_count * sizeof(float),
+            64);
+
+    try
+    {
+        bi::shared_memory_object::remove(name);
+
+        impl->m_shm.reset(
+            new bi::shared_memory_object(
+                bi::create_only,
+                name,
+                bi::read_write));
+        impl->m_shm->truncate(static_cast<bi::offset_t>(header_size + slot_count * slot_size));
+
+        impl->m_region.reset(new bi::mapped_region(*impl->m_shm, bi::read_write));
+    }
+    catch (const bi::interprocess_exception&)
+    {
+        impl->m_region.reset();
+        impl->m_shm.reset();
+        bi::shared_memory_object::remove(name);
+        return false;
+    }
+
+    impl->m_name = name;
+    impl->m_update = 0;
+    impl->m_write_sequence = 0;
+
+    // Fill the channel header. The write sequence is set last so that readers
+    // only see a complete header.
+    TileChannelHeader* header = new (impl->m_region->get_address()) TileChannelHeader();
+    header->m_magic = TileChannelMagic;
+    header->m_version = TileChannelVersion;
+    header->m_header_size = static_cast<uint32>(header_size);
+    header->m_slot_count = static_cast<uint32>(slot_count);
+    header->m_slot_size = slot_size;
+    header->m_frame_width = static_cast<uint32>(frame_width);
+    header->m_frame_height = static_cast<uint32>(frame_height);
+    header->m_tile_width = static_cast<uint32>(tile_width);
+    header->m_tile_height = static_cast<uint32>(tile_height);
+    header->m_plane_count = static_cast<uint32>(impl->m_planes.size());
+    header->m_reserved = 0;
+    memset(header->m_planes, 0, sizeof(header->m_planes));
+    copy(impl->m_planes.begin(), impl->m_planes.end(), header->m_planes);
+    impl->m_header = header;
+
+    for (size_t i = 0; i < slot_count; ++i)
+    {
+        TileChannelSlotHeader* slot_header =
+            new (impl->get_slot(i)) TileChannelSlotHeader();
+        slot_header->m_sequence.store(0, boost::memory_order_relaxed);
+    }
+
+    header->m_write_sequence.store(0, boost::memory_order_release);
+
+    return true;
+}
+
+void TileChannelWriter::close()
+{
+    boost::mutex::scoped_lock lock(impl->m_mutex);
+
+    if (!is_open())
+        return;
+
+    impl->m_header = nullptr;
+    impl->m_region.reset();
+    impl->m_shm.reset();
+
+    bi::shared_memory_object::remove(impl->m_name.c_str());
+}
+
+bool TileChannelWriter::is_open() const
+{
+    return impl->m_header != nullptr;
+}
+
+void TileChannelWriter::begin_update()
+{
+    boost::mutex::scoped_lock lock(impl->m_mutex);
+
+    ++impl->m_update;
+}
+
+void TileChannelWriter::write_tile(
+    const size_t                plane_index,
+    const size_t                x,
+    const size_t                y,
+    const size_t                width,
+    const size_t                height,
+    const size_t                channel_count,
+    const float*                pixels)
+{
+    boost::mutex::scoped_lock lock(impl->m_mutex);
+
+    if (!is_open())
+        return;
+
+    assert(plane_index < impl->m_planes.size());
+    assert(width <= impl->m_header->m_tile_width);
+    assert(height <= impl->m_header->m_tile_height);
+    assert(channel_count <= impl->m_max_channel_count);
+
+    const uint64 sequence = impl->m_write_sequence++;
+
+    uint8* slot = impl->get_slot(sequence);
+    TileChannelSlotHeader* slot_header = reinterpret_cast<TileChannelSlotHeader*>(slot);
+
+    // Invalidate the slot while it is being overwritten.
+    slot_header->m_sequence.store(0, boost::memory_order_relaxed);
+    boost::atomic_thread_fence(boost::memory_order_release);
+
+    slot_header->m_update = impl->m_update;
+    slot_header->m_plane_index = static_cast<uint32>(plane_index);
+    slot_header->m_x = static_cast<uint32>(x);
+    slot_header->m_y = static_cast<uint32>(y);
+    slot_header->m_width = static_cast<uint32>(width);
+    slot_header->m_height = static_cast<uint32>(height);
+    slot_header->m_channel_count = static_cast<uint32>(channel_count);
+    slot_header->m_reserved = 0;
+
+    memcpy(
+        slot + sizeof(TileChannelSlotHeader),
+        pixels,
+        width * height * channel_count * sizeof(float));
+
+    // Publish the tile.
+    slot_header->m_sequence.store(sequence + 1, boost::memory_order_release);
+    impl->m_header->m_write_sequence.store(sequence + 1, boost::memory_order_release);
+}
+
+uint64 TileChannelWriter::get_write_sequence() const
+{
+    boost::mutex::scoped_lock lock(impl->m_mutex);
+
+    return impl->m_write_sequence;
+}
+
+}   // namespace shared
+}   // namespace appleseed
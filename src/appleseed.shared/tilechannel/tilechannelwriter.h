@@ -0,0 +1,108 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2018 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef APPLESEED_SHARED_TILECHANNEL_TILECHANNELWRITER_H
+#define APPLESEED_SHARED_TILECHANNEL_TILECHANNELWRITER_H
+
+// appleseed.shared headers.
+#include "application/dllsymbol.h"
+
+// appleseed.foundation headers.
+#include "foundation/core/concepts/noncopyable.h"
+#include "foundation/platform/types.h"
+
+// Standard headers.
+#include <cstddef>
+
+namespace appleseed {
+namespace shared {
+
+//
+// Publishes tiles into a shared memory tile channel.
+// See tilechannelformat.h for a description of the channel layout.
+//
+// All methods are thread-safe.
+//
+
+class SHAREDDLL TileChannelWriter
+  : public foundation::NonCopyable
+{
+  public:
+    // Constructor.
+    TileChannelWriter();
+
+    // Destructor. Closes the channel.
+    ~TileChannelWriter();
+
+    // Declare an image plane. Must be called before open().
+    // Return false if there are already too many planes.
+    bool add_plane(
+        const char*                 name,
+        const size_t                channel_count);
+
+    // Create the shared memory object holding the channel, replacing any existing
+    // object of the same name. Return true on success.
+    bool open(
+        const char*                 name,
+        const size_t                frame_width,
+        const size_t                frame_height,
+        const size_t                tile_width,
+        const size_t                tile_height,
+        const size_t                slot_count);
+
+    // Remove the shared memory object. Readers that have it mapped keep access to it.
+    void close();
+
+    // Return true if the channel is open.
+    bool is_open() const;
+
+    // Start a new pass or progressive update.
+    void begin_update();
+
+    // Publish a tile of a given plane. Pixels are 32-bit floats.
+    void write_tile(
+        const size_t                plane_index,
+        const size_t                x,
+        const size_t                y,
+        const size_t                width,
+        const size_t                height,
+        const size_t                channel_count,
+        const float*                pixels);
+
+    // Return the number of published tiles.
+    foundation::uint64 get_write_sequence() const;
+
+  private:
+    struct Impl;
+    Impl* impl;
+};
+
+}       // namespace shared
+}       // namespace appleseed
+
+#endif  // !APPLESEED_SHARED_TILECHANNEL_TILECHANNELWRITER_H
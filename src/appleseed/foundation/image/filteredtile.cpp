@@ -35,6 +35,9 @@
 #include "foundation/math/scalar.h"
 #include "foundation/math/vector.h"
 #include "foundation/platform/atomic.h"
+#ifdef APPLESEED_USE_SSE
+#include "foundation/platform/sse.h"
+#endif
 
 namespace foundation
 {
@@ -60,6 +63,7 @@ FilteredTile::FilteredTile(
   : Tile(width, height, channel_count + 1, PixelFormatFloat)
   , m_crop_window(Vector2u(0, 0), Vector2u(width - 1, height - 1))
   , m_filter(filter)
+  , m_tabulated_filter(filter)
 {
 }
 
@@ -72,6 +76,7 @@ FilteredTile::FilteredTile(
   : Tile(width, height, channel_count + 1, PixelFormatFloat)
   , m_crop_window(crop_window)
   , m_filter(filter)
+  , m_tabulated_filter(filter)
 {
 }
 
@@ -107,17 +112,38 @@ void FilteredTile::add(
     if (footprint.min.x > footprint.max.x)
         return;
 
+    const size_t value_count = m_channel_count - 1;
+
     for (int ry = footprint.min.y; ry <= footprint.max.y; ++ry)
     {
+        const float weight_y = m_tabulated_filter.evaluate_y(ry - dy);
+
         float* APPLESEED_RESTRICT ptr = reinterpret_cast<float*>(pixel(footprint.min.x, ry));
 
         for (int rx = footprint.min.x; rx <= footprint.max.x; ++rx)
         {
-            const float weight = m_filter.evaluate(rx - dx, ry - dy);
+            const float weight = m_tabulated_filter.evaluate_x(rx - dx) * weight_y;
             *ptr++ += weight;
 
-            for (size_t i = 0, e = m_channel_count - 1; i < e; ++i)
-                *ptr++ += values[i] * weight;
+            size_t i = 0;
+
+#ifdef APPLESEED_USE_SSE
+            // Pixels are not aligned: the weight channel precedes the values.
+            const __m128 mweight = _mm_set1_ps(weight);
+            for (; i + 4 <= value_count; i += 4)
+            {
+                _mm_storeu_ps(
+                    ptr + i,
+                    _mm_add_ps(
+                        _mm_loadu_ps(ptr + i),
+                        _mm_mul_ps(_mm_loadu_ps(values + i), mweight)));
+            }
+#endif
+
+            for (; i < value_count; ++i)
+                ptr[i] += values[i] * weight;
+
+            ptr += value_count;
         }
     }
 }
@@ -148,11 +174,13 @@ void FilteredTile::atomic_add(
 
     for (int ry = footprint.min.y; ry <= footprint.max.y; ++ry)
     {
+        const float weight_y = m_tabulated_filter.evaluate_y(ry - dy);
+
         float* APPLESEED_RESTRICT ptr = reinterpret_cast<float*>(pixel(footprint.min.x, ry));
 
         for (int rx = footprint.min.x; rx <= footprint.max.x; ++rx)
         {
-            const float weight = m_filter.evaluate(rx - dx, ry - dy);
+            const float weight = m_tabulated_filter.evaluate_x(rx - dx) * weight_y;
             foundation::atomic_add(ptr++, weight);
 
             for (size_t i = 0, e = m_channel_count - 1; i < e; ++i)
@@ -132,8 +132,9 @@ class FilteredTile
         const float*            values);
 
   protected:
-    const AABB2u            m_crop_window;
-    const Filter2f&         m_filter;
+    const AABB2u                    m_crop_window;
+    const Filter2f&                 m_filter;
+    const TabulatedFilter2<float>   m_tabulated_filter;
 };
 
 
@@ -0,0 +1,281 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2018 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef APPLESEED_FOUNDATION_MATH_BEZIERCURVEGROUP_H
+#define APPLESEED_FOUNDATION_MATH_BEZIERCURVEGROUP_H
+
+// appleseed.foundation headers.
+#include "foundation/math/beziercurve.h"
+#include "foundation/math/matrix.h"
+#include "foundation/math/vector.h"
+#include "foundation/platform/compiler.h"
+#ifdef APPLESEED_USE_SSE
+#include "foundation/platform/sse.h"
+#endif
+
+// Standard headers.
+#include <cassert>
+#include <cstddef>
+
+namespace foundation
+{
+
+//
+// A group of up to four Bezier curves of the same degree stored in SoA layout.
+//
+// The group allows to discard, four curves at a time, the curves that cannot be
+// hit by a ray: the control points of all curves are projected to ray space at
+// once and their bounding boxes are tested against the ray's footprint. This is
+// the same test that BezierCurveIntersector performs before subdividing a curve,
+// so only the surviving curves need to go through the (scalar) subdivision.
+//
+// The test is conservative: a curve for which BezierCurveIntersector would report
+// an intersection is never culled.
+//
+
+template <typename BezierCurveType>
+class BezierCurveGroup
+{
+  public:
+    // Types.
+    typedef typename BezierCurveType::ValueType ValueType;
+    typedef typename BezierCurveType::MatrixType MatrixType;
+
+    // Maximum number of curves in a group.
+    static const size_t Size = 4;
+
+    // Number of control points of each curve.
+    static const size_t ControlPointCount = BezierCurveType::Degree + 1;
+
+    // Constructor, all lanes are initially empty.
+    BezierCurveGroup();
+
+    // Store a curve in a given lane.
+    void set(const size_t lane, const BezierCurveType& curve);
+
+    // Return a bit mask of the curves (bit i for lane i) that may be intersected
+    // by the ray associated with the ray projection transform xfm (see function
+    // make_curve_projection_transform()) at a ray-space distance up to max_z.
+    size_t intersect_bboxes(const MatrixType& xfm, const ValueType max_z) const;
+
+  private:
+    // Ray-space bounding boxes are enlarged by this relative amount to absorb
+    // any difference in rounding with BezierCurveIntersector.
+    static const ValueType Margin;
+
+    APPLESEED_SIMD4_ALIGN ValueType m_x[ControlPointCount][Size];
+    APPLESEED_SIMD4_ALIGN ValueType m_y[ControlPointCount][Size];
+    APPLESEED_SIMD4_ALIGN ValueType m_z[ControlPointCount][Size];
+    APPLESEED_SIMD4_ALIGN ValueType m_half_width[Size];
+};
+
+
+//
+// BezierCurveGroup class implementation.
+//
+
+template <typename BezierCurveType>
+const typename BezierCurveGroup<BezierCurveType>::ValueType
+    BezierCurveGroup<BezierCurveType>::Margin = ValueType(1.0e-3);
+
+template <typename BezierCurveType>
+BezierCurveGroup<BezierCurveType>::BezierCurveGroup()
+{
+    // Empty lanes have a negative width and degenerate to a single point:
+    // they can never pass the test, whatever the ray projection transform.
+    for (size_t lane = 0; lane < Size; ++lane)
+    {
+        for (size_t i = 0; i < ControlPointCount; ++i)
+        {
+            m_x[i][lane] = ValueType(0.0);
+            m_y[i][lane] = ValueType(0.0);
+            m_z[i][lane] = ValueType(0.0);
+        }
+
+        m_half_width[lane] = ValueType(-1.0);
+    }
+}
+
+template <typename BezierCurveType>
+inline void BezierCurveGroup<BezierCurveType>::set(const size_t lane, const BezierCurveType& curve)
+{
+    assert(lane < Size);
+
+    for (size_t i = 0; i < ControlPointCount; ++i)
+    {
+        const typename BezierCurveType::VectorType& cp = curve.get_control_point(i);
+        m_x[i][lane] = cp.x;
+        m_y[i][lane] = cp.y;
+        m_z[i][lane] = cp.z;
+    }
+
+    m_half_width[lane] = ValueType(0.5) * curve.compute_max_width() * (ValueType(1.0) + Margin);
+}
+
+namespace impl
+{
+    // Same sequence of operations as BezierCurveBase::transform_point().
+    template <typename T>
+    inline Vector<T, 3> transform_curve_point(
+        const Matrix<T, 4, 4>&  xfm,
+        const T                 x,
+        const T                 y,
+        const T                 z)
+    {
+        const Vector<T, 4> xpt = xfm * Vector<T, 4>(x, y, z, T(1.0));
+        const T rcp_w = T(1.0) / xpt.w;
+        return Vector<T, 3>(xpt.x * rcp_w, xpt.y * rcp_w, xpt.z * rcp_w);
+    }
+
+    // Generic implementation.
+    template <size_t N, typename T>
+    size_t intersect_curve_bboxes(
+        const T                 x[][4],
+        const T                 y[][4],
+        const T                 z[][4],
+        const T                 half_width[4],
+        const Matrix<T, 4, 4>&  xfm,
+        const T                 max_z)
+    {
+        size_t mask = 0;
+
+        for (size_t lane = 0; lane < 4; ++lane)
+        {
+            const Vector<T, 3> p0 = transform_curve_point(xfm, x[0][lane], y[0][lane], z[0][lane]);
+            Vector<T, 3> bbox_min = p0, bbox_max = p0;
+
+            for (size_t i = 1; i < N; ++i)
+            {
+                const Vector<T, 3> p = transform_curve_point(xfm, x[i][lane], y[i][lane], z[i][lane]);
+                bbox_min = component_wise_min(bbox_min, p);
+                bbox_max = component_wise_max(bbox_max, p);
+            }
+
+            const T hw = half_width[lane];
+
+            if (bbox_min.z <= max_z && bbox_max.z > T(0.0) &&
+                bbox_min.x <= hw    && bbox_max.x >= -hw   &&
+                bbox_min.y <= hw    && bbox_max.y >= -hw)
+                mask |= size_t(1) << lane;
+        }
+
+        return mask;
+    }
+
+#ifdef APPLESEED_USE_SSE
+
+    // Same sequence of operations as BezierCurveBase::transform_point(), four points at a time.
+    inline void transform_curve_points(
+        const __m128            m[16],
+        const float             x[4],
+        const float             y[4],
+        const float             z[4],
+        __m128&                 px,
+        __m128&                 py,
+        __m128&                 pz)
+    {
+        const __m128 cx = _mm_load_ps(x);
+        const __m128 cy = _mm_load_ps(y);
+        const __m128 cz = _mm_load_ps(z);
+
+        const __m128 tx = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m[ 0], cx), _mm_mul_ps(m[ 1], cy)), _mm_mul_ps(m[ 2], cz)), m[ 3]);
+        const __m128 ty = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m[ 4], cx), _mm_mul_ps(m[ 5], cy)), _mm_mul_ps(m[ 6], cz)), m[ 7]);
+        const __m128 tz = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m[ 8], cx), _mm_mul_ps(m[ 9], cy)), _mm_mul_ps(m[10], cz)), m[11]);
+        const __m128 tw = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m[12], cx), _mm_mul_ps(m[13], cy)), _mm_mul_ps(m[14], cz)), m[15]);
+        const __m128 rcp_w = _mm_div_ps(_mm_set1_ps(1.0f), tw);
+
+        px = _mm_mul_ps(tx, rcp_w);
+        py = _mm_mul_ps(ty, rcp_w);
+        pz = _mm_mul_ps(tz, rcp_w);
+    }
+
+    // SSE implementation, single precision only.
+    template <size_t N>
+    size_t intersect_curve_bboxes(
+        const float                 x[][4],
+        const float                 y[][4],
+        const float                 z[][4],
+        const float                 half_width[4],
+        const Matrix<float, 4, 4>&  xfm,
+        const float                 max_z)
+    {
+        __m128 m[16];
+        for (size_t i = 0; i < 16; ++i)
+            m[i] = _mm_set1_ps(xfm[i]);
+
+        __m128 min_x, min_y, min_z;
+        transform_curve_points(m, x[0], y[0], z[0], min_x, min_y, min_z);
+        __m128 max_x = min_x, max_y = min_y, max_z4 = min_z;
+
+        for (size_t i = 1; i < N; ++i)
+        {
+            __m128 px, py, pz;
+            transform_curve_points(m, x[i], y[i], z[i], px, py, pz);
+
+            min_x = _mm_min_ps(min_x, px);
+            max_x = _mm_max_ps(max_x, px);
+            min_y = _mm_min_ps(min_y, py);
+            max_y = _mm_max_ps(max_y, py);
+            min_z = _mm_min_ps(min_z, pz);
+            max_z4 = _mm_max_ps(max_z4, pz);
+        }
+
+        const __m128 hw = _mm_load_ps(half_width);
+        const __m128 neg_hw = _mm_sub_ps(_mm_setzero_ps(), hw);
+
+        __m128 overlap = _mm_cmple_ps(min_z, _mm_set1_ps(max_z));
+        overlap = _mm_and_ps(overlap, _mm_cmpgt_ps(max_z4, _mm_setzero_ps()));
+        overlap = _mm_and_ps(overlap, _mm_cmple_ps(min_x, hw));
+        overlap = _mm_and_ps(overlap, _mm_cmpge_ps(max_x, neg_hw));
+        overlap = _mm_and_ps(overlap, _mm_cmple_ps(min_y, hw));
+        overlap = _mm_and_ps(overlap, _mm_cmpge_ps(max_y, neg_hw));
+
+        return static_cast<size_t>(_mm_movemask_ps(overlap));
+    }
+
+#endif  // APPLESEED_USE_SSE
+}
+
+template <typename BezierCurveType>
+inline size_t BezierCurveGroup<BezierCurveType>::intersect_bboxes(
+    const MatrixType&   xfm,
+    const ValueType     max_z) const
+{
+    return
+        impl::intersect_curve_bboxes<ControlPointCount>(
+            m_x,
+            m_y,
+            m_z,
+            m_half_width,
+            xfm,
+            max_z * (ValueType(1.0) + Margin));
+}
+
+}       // namespace foundation
+
+#endif  // !APPLESEED_FOUNDATION_MATH_BEZIERCURVEGROUP_H
@@ -38,6 +38,8 @@
 #include "foundation/platform/compiler.h"
 
 // Standard headers.
+#include <algorithm>
+#include <cassert>
 #include <cmath>
 #include <cstddef>
 
@@ -241,6 +243,39 @@ class FastBlackmanHarrisFilter2
 };
 
 
+//
+// A tabulated version of a separable 2D filter.
+//
+// The filter is sampled once along each axis and evaluated as the product of the
+// linearly interpolated 1D weights, which avoids calling the (virtual, and often
+// expensive) evaluate() method of the original filter for every pixel of every
+// sample's footprint. All the filters above are separable.
+//
+
+template <typename T>
+class TabulatedFilter2
+  : public Filter2<T>
+{
+  public:
+    // Number of intervals of each 1D table.
+    static const size_t TableSize = 256;
+
+    explicit TabulatedFilter2(const Filter2<T>& filter);
+
+    T evaluate(const T x, const T y) const override;
+
+    // Evaluate the filter along each axis. evaluate(x, y) == evaluate_x(x) * evaluate_y(y).
+    T evaluate_x(const T x) const;
+    T evaluate_y(const T y) const;
+
+  private:
+    T   m_x_weights[TableSize + 1];
+    T   m_y_weights[TableSize + 1];
+
+    static T lookup(const T weights[], const T x, const T radius, const T rcp_radius);
+};
+
+
 //
 // Utilities.
 //
@@ -532,6 +567,59 @@ APPLESEED_FORCE_INLINE T FastBlackmanHarrisFilter2<T>::blackman(const T x)
 }
 
 
+//
+// TabulatedFilter2 class implementation.
+//
+
+template <typename T>
+TabulatedFilter2<T>::TabulatedFilter2(const Filter2<T>& filter)
+  : Filter2<T>(filter.get_xradius(), filter.get_yradius())
+{
+    // Since the filter is separable, f(x, y) = f(x, 0) * f(0, y) / f(0, 0).
+    const T center = filter.evaluate(T(0.0), T(0.0));
+    assert(center != T(0.0));
+    const T rcp_center = T(1.0) / center;
+
+    for (size_t i = 0; i <= TableSize; ++i)
+    {
+        const T u = T(2.0) * static_cast<T>(i) / TableSize - T(1.0);
+        m_x_weights[i] = filter.evaluate(u * Filter2<T>::m_xradius, T(0.0));
+        m_y_weights[i] = filter.evaluate(T(0.0), u * Filter2<T>::m_yradius) * rcp_center;
+    }
+}
+
+template <typename T>
+inline T TabulatedFilter2<T>::evaluate(const T x, const T y) const
+{
+    return evaluate_x(x) * evaluate_y(y);
+}
+
+template <typename T>
+inline T TabulatedFilter2<T>::evaluate_x(const T x) const
+{
+    return lookup(m_x_weights, x, Filter2<T>::m_xradius, Filter2<T>::m_rcp_xradius);
+}
+
+template <typename T>
+inline T TabulatedFilter2<T>::evaluate_y(const T y) const
+{
+    return lookup(m_y_weights, y, Filter2<T>::m_yradius, Filter2<T>::m_rcp_yradius);
+}
+
+template <typename T>
+APPLESEED_FORCE_INLINE T TabulatedFilter2<T>::lookup(
+    const T     weights[],
+    const T     x,
+    const T     radius,
+    const T     rcp_radius)
+{
+    const T u = clamp((x + radius) * (T(0.5) * TableSize) * rcp_radius, T(0.0), T(TableSize));
+    const size_t i = std::min(truncate<size_t>(u), TableSize - 1);
+    const T f = u - static_cast<T>(i);
+    return weights[i] + (weights[i + 1] - weights[i]) * f;
+}
+
+
 //
 // Utilities implementation.
 //
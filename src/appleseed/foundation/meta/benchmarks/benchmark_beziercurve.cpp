@@ -0,0 +1,133 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2018 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// appleseed.foundation headers.
+#include "foundation/math/beziercurve.h"
+#include "foundation/math/beziercurvegroup.h"
+#include "foundation/math/matrix.h"
+#include "foundation/math/ray.h"
+#include "foundation/math/rng/distribution.h"
+#include "foundation/math/rng/mersennetwister.h"
+#include "foundation/math/sampling/mappings.h"
+#include "foundation/math/vector.h"
+#include "foundation/utility/alignedvector.h"
+#include "foundation/utility/benchmark.h"
+
+// Standard headers.
+#include <cstddef>
+#include <vector>
+
+using namespace foundation;
+using namespace std;
+
+BENCHMARK_SUITE(Foundation_Math_BezierCurve)
+{
+    // A fur ball: cubic curves growing out of a unit sphere, as produced by the makefluffy tool.
+    struct Fixture
+    {
+        static const size_t CurveCount = 1024;
+        static const size_t RayCount = 64;
+
+        vector<BezierCurve3f>                           m_curves;
+        AlignedVector<BezierCurveGroup<BezierCurve3f>> m_groups;
+        Ray3f                                           m_rays[RayCount];
+        Matrix4f                                        m_xfm_matrices[RayCount];
+        size_t                                          m_hit_count;
+
+        Fixture()
+          : m_hit_count(0)
+        {
+            MersenneTwister rng;
+
+            m_curves.reserve(CurveCount);
+            m_groups.resize((CurveCount + 3) / 4);
+
+            for (size_t i = 0; i < CurveCount; ++i)
+            {
+                const Vector3f root = sample_sphere_uniform(Vector2f(rand_float2(rng), rand_float2(rng)));
+                const Vector3f bend = sample_sphere_uniform(Vector2f(rand_float2(rng), rand_float2(rng)));
+
+                Vector3f control_points[4];
+                for (size_t j = 0; j < 4; ++j)
+                {
+                    const float s = j / 3.0f;
+                    control_points[j] = root * (1.0f + 0.3f * s) + bend * (0.05f * s * s);
+                }
+
+                m_curves.push_back(BezierCurve3f(control_points, 0.01f, 1.0f, Color3f(1.0f)));
+                m_groups[i / 4].set(i % 4, m_curves.back());
+            }
+
+            // Rays aimed at the fur ball from all directions.
+            for (size_t i = 0; i < RayCount; ++i)
+            {
+                const Vector3f origin = 3.0f * sample_sphere_uniform(Vector2f(rand_float2(rng), rand_float2(rng)));
+                const Vector3f target(rand_float1(rng, -1.0f, 1.0f), rand_float1(rng, -1.0f, 1.0f), rand_float1(rng, -1.0f, 1.0f));
+                m_rays[i] = Ray3f(origin, normalize(target - origin));
+                make_curve_projection_transform(m_xfm_matrices[i], m_rays[i]);
+            }
+        }
+    };
+
+    BENCHMARK_CASE_F(Intersect_OneCurveAtATime, Fixture)
+    {
+        for (size_t i = 0; i < RayCount; ++i)
+        {
+            float u, v, t = m_rays[i].m_tmax;
+
+            for (size_t c = 0; c < CurveCount; ++c)
+            {
+                if (BezierCurveIntersector<BezierCurve3f>::intersect(m_curves[c], m_rays[i], m_xfm_matrices[i], u, v, t))
+                    ++m_hit_count;
+            }
+        }
+    }
+
+    BENCHMARK_CASE_F(Intersect_GroupsOfFourCurves, Fixture)
+    {
+        for (size_t i = 0; i < RayCount; ++i)
+        {
+            float u, v, t = m_rays[i].m_tmax;
+
+            for (size_t g = 0; g < m_groups.size(); ++g)
+            {
+                // Ray directions are unit-length so ray space distances are ray parameters.
+                size_t mask = m_groups[g].intersect_bboxes(m_xfm_matrices[i], t);
+
+                for (size_t lane = 0; mask != 0; ++lane, mask >>= 1)
+                {
+                    if ((mask & 1) == 0)
+                        continue;
+
+                    if (BezierCurveIntersector<BezierCurve3f>::intersect(m_curves[4 * g + lane], m_rays[i], m_xfm_matrices[i], u, v, t))
+                        ++m_hit_count;
+                }
+            }
+        }
+    }
+}
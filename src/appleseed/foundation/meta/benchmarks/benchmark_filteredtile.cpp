@@ -64,4 +64,34 @@ BENCHMARK_SUITE(Foundation_Image_FilteredTile)
 
         m_tile.atomic_add(m_x, m_y, Values);
     }
+
+    struct BlackmanHarrisFixture
+    {
+        BlackmanHarrisFilter2<float>    m_filter;
+        FilteredTile                    m_tile;
+        const volatile float            m_x;
+        const volatile float            m_y;
+
+        BlackmanHarrisFixture()
+          : m_filter(2.0f, 2.0f)
+          , m_tile(1024, 1024, 8, m_filter)
+          , m_x(42.42f)
+          , m_y(66.66f)
+        {
+        }
+    };
+
+    BENCHMARK_CASE_F(Add_BlackmanHarris_8Channels, BlackmanHarrisFixture)
+    {
+        const float Values[8] = { 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f };
+
+        m_tile.add(m_x, m_y, Values);
+    }
+
+    BENCHMARK_CASE_F(AtomicAdd_BlackmanHarris_8Channels, BlackmanHarrisFixture)
+    {
+        const float Values[8] = { 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f };
+
+        m_tile.atomic_add(m_x, m_y, Values);
+    }
 }
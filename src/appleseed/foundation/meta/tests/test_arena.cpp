@@ -0,0 +1,101 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2018 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// appleseed.foundation headers.
+#include "foundation/utility/arena.h"
+#include "foundation/utility/memory.h"
+#include "foundation/utility/test.h"
+
+// Standard headers.
+#include <cstddef>
+
+using namespace foundation;
+
+TEST_SUITE(Foundation_Utility_Arena)
+{
+    TEST_CASE(Allocate_ReturnsAlignedMemory)
+    {
+        Arena arena;
+
+        arena.allocate(1);
+        const void* ptr = arena.allocate(1);
+
+        EXPECT_TRUE(is_aligned(ptr, 16));
+        EXPECT_EQ(32, arena.get_size());
+    }
+
+    TEST_CASE(Allocate_GivenMoreMemoryThanInlineChunk_GrowsArena)
+    {
+        Arena arena;
+
+        for (size_t i = 0; i < 64; ++i)
+            arena.allocate(16 * 1024);
+
+        EXPECT_GT(1, arena.get_chunk_count());
+        EXPECT_EQ(1024 * 1024, arena.get_size());
+    }
+
+    TEST_CASE(Allocate_GivenAllocationLargerThanChunk_Succeeds)
+    {
+        Arena arena;
+
+        unsigned char* ptr = static_cast<unsigned char*>(arena.allocate(1024 * 1024));
+        ptr[1024 * 1024 - 1] = 42;
+
+        EXPECT_TRUE(is_aligned(ptr, 16));
+        EXPECT_EQ(2, arena.get_chunk_count());
+    }
+
+    TEST_CASE(Clear_AfterGrowingArena_ReusesChunks)
+    {
+        Arena arena;
+
+        for (size_t i = 0; i < 64; ++i)
+            arena.allocate(16 * 1024);
+
+        const size_t chunk_count = arena.get_chunk_count();
+        arena.clear();
+
+        for (size_t i = 0; i < 64; ++i)
+            arena.allocate(16 * 1024);
+
+        EXPECT_EQ(chunk_count, arena.get_chunk_count());
+    }
+
+    TEST_CASE(GetPeakSize_AfterClear_ReturnsLargestSize)
+    {
+        Arena arena;
+
+        arena.allocate(1024);
+        arena.clear();
+        arena.allocate(64);
+
+        EXPECT_EQ(1024, arena.get_peak_size());
+        EXPECT_EQ(64, arena.get_size());
+    }
+}
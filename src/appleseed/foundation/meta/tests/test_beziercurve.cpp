@@ -32,8 +32,11 @@
 #include "foundation/image/image.h"
 #include "foundation/image/pixel.h"
 #include "foundation/math/beziercurve.h"
+#include "foundation/math/beziercurvegroup.h"
 #include "foundation/math/matrix.h"
 #include "foundation/math/ray.h"
+#include "foundation/math/rng/distribution.h"
+#include "foundation/math/rng/mersennetwister.h"
 #include "foundation/math/scalar.h"
 #include "foundation/math/vector.h"
 #include "foundation/utility/countof.h"
@@ -730,3 +733,61 @@ TEST_SUITE(Foundation_Math_BezierCurveIntersector)
         render_curves_to_image(Curves, countof(Curves), "unit tests/outputs/test_beziercurveintersector_bezier3curve_checkboard.png", true);
     }
 }
+
+TEST_SUITE(Foundation_Math_BezierCurveGroup)
+{
+    TEST_CASE(IntersectBBoxes_GivenEmptyGroup_ReturnsEmptyMask)
+    {
+        const Ray3f ray(Vector3f(0.0f, 0.0f, -3.0f), Vector3f(0.0f, 0.0f, 1.0f));
+
+        Matrix4f xfm_matrix;
+        make_curve_projection_transform(xfm_matrix, ray);
+
+        const BezierCurveGroup<BezierCurve3f> group;
+
+        EXPECT_EQ(0, group.intersect_bboxes(xfm_matrix, numeric_limits<float>::max()));
+    }
+
+    TEST_CASE(IntersectBBoxes_GivenCurvesHitByRay_SetsCorrespondingBits)
+    {
+        MersenneTwister rng;
+
+        for (size_t r = 0; r < 100; ++r)
+        {
+            // Build a random ray.
+            const Ray3f ray(
+                Vector3f(rand_float1(rng, -0.5f, 0.5f), rand_float1(rng, -0.5f, 0.5f), -3.0f),
+                Vector3f(rand_float1(rng, -0.2f, 0.2f), rand_float1(rng, -0.2f, 0.2f), rand_float1(rng, 0.5f, 2.0f)));
+
+            Matrix4f xfm_matrix;
+            make_curve_projection_transform(xfm_matrix, ray);
+
+            // Build a group of random curves around the ray.
+            BezierCurve3f curves[4];
+            BezierCurveGroup<BezierCurve3f> group;
+            for (size_t i = 0; i < countof(curves); ++i)
+            {
+                Vector3f control_points[4];
+                for (size_t j = 0; j < countof(control_points); ++j)
+                {
+                    control_points[j] =
+                        Vector3f(
+                            rand_float1(rng, -0.6f, 0.6f),
+                            rand_float1(rng, -0.6f, 0.6f),
+                            rand_float1(rng, -0.6f, 0.6f));
+                }
+
+                curves[i] = BezierCurve3f(control_points, rand_float1(rng, 0.01f, 0.1f), 1.0f, Color3f(1.0f));
+                group.set(i, curves[i]);
+            }
+
+            const size_t mask = group.intersect_bboxes(xfm_matrix, ray.m_tmax * norm(ray.m_dir));
+
+            for (size_t i = 0; i < countof(curves); ++i)
+            {
+                if (BezierCurveIntersector<BezierCurve3f>::intersect(curves[i], ray, xfm_matrix))
+                    EXPECT_TRUE((mask & (size_t(1) << i)) != 0);
+            }
+        }
+    }
+}
@@ -136,6 +136,22 @@ TEST_SUITE(Foundation_Utility_Cache_LRUCache)
         EXPECT_EQ(3, element_swapper.m_unload_count);
     }
 
+    TEST_CASE(Find_ReturnsElementOnlyIfPresent)
+    {
+        KeyHasher key_hasher;
+        ElementSwapperCountingUnloads element_swapper;
+        LRUCache<Key, KeyHasher, Element, ElementSwapperCountingUnloads> cache(key_hasher, element_swapper);
+
+        EXPECT_EQ(nullptr, cache.find(1));
+
+        Element& element = cache.get(1);
+
+        EXPECT_EQ(&element, cache.find(1));
+        EXPECT_EQ(nullptr, cache.find(2));
+        EXPECT_EQ(1, cache.get_hit_count());
+        EXPECT_EQ(1, cache.get_miss_count());
+    }
+
     struct ElementSwapperTrackingSize
     {
         size_t m_memory_size;
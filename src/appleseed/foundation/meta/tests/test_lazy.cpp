@@ -117,4 +117,40 @@ TEST_SUITE(Foundation_Utility_Lazy_Access)
 
         EXPECT_EQ(0, access.get());
     }
+
+    TEST_CASE(TryReleaseObject_GivenObjectBeingAccessed_ReturnsFalse)
+    {
+        unique_ptr<ObjectFactory> factory(new SimpleObjectFactory(42));
+        Lazy<Object> object(move(factory));
+
+        Access<Object> access(&object);
+
+        EXPECT_FALSE(object.try_release_object());
+    }
+
+    TEST_CASE(TryReleaseObject_GivenObjectNoLongerAccessed_ReleasesObjectAndRecreatesItOnNextAccess)
+    {
+        unique_ptr<ObjectFactory> factory(new SimpleObjectFactory(42));
+        Lazy<Object> object(move(factory));
+
+        Access<Object> access(&object);
+        access.reset(nullptr);
+
+        EXPECT_TRUE(object.try_release_object());
+
+        access.reset(&object);
+
+        EXPECT_EQ(42, access->m_value);
+    }
+
+    TEST_CASE(TryReleaseObject_GivenLazyObjectWrappingSourceObject_ReturnsFalse)
+    {
+        Object source_object(42);
+        Lazy<Object> object(&source_object);
+
+        Access<Object> access(&object);
+        access.reset(nullptr);
+
+        EXPECT_FALSE(object.try_release_object());
+    }
 }
@@ -35,6 +35,7 @@
 #include "foundation/utility/test.h"
 
 // Standard headers.
+#include <cmath>
 #include <cstddef>
 #include <string>
 #include <vector>
@@ -238,3 +239,58 @@ TEST_SUITE(Foundation_Math_Filter_BlackmanHarrisFilter2)
             "Fast Variant", fast_filter);
     }
 }
+
+TEST_SUITE(Foundation_Math_Filter_TabulatedFilter2)
+{
+    template <typename T>
+    bool matches_original_filter(const Filter2<T>& filter, const T eps)
+    {
+        const TabulatedFilter2<T> tabulated_filter(filter);
+
+        const size_t PointCount = 37;
+
+        for (size_t j = 0; j < PointCount; ++j)
+        {
+            const T y = fit<size_t, T>(j, 0, PointCount - 1, -filter.get_yradius(), filter.get_yradius());
+
+            for (size_t i = 0; i < PointCount; ++i)
+            {
+                const T x = fit<size_t, T>(i, 0, PointCount - 1, -filter.get_xradius(), filter.get_xradius());
+
+                if (std::abs(tabulated_filter.evaluate(x, y) - filter.evaluate(x, y)) > eps)
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    TEST_CASE(Evaluate_GaussianFilter_MatchesOriginalFilter)
+    {
+        const GaussianFilter2<double> filter(2.0, 3.0, 8.0);
+
+        EXPECT_TRUE(matches_original_filter(filter, 1.0e-3));
+    }
+
+    TEST_CASE(Evaluate_MitchellFilter_MatchesOriginalFilter)
+    {
+        const MitchellFilter2<double> filter(2.0, 3.0, 1.0 / 3, 1.0 / 3);
+
+        EXPECT_TRUE(matches_original_filter(filter, 1.0e-3));
+    }
+
+    TEST_CASE(Evaluate_BlackmanHarrisFilter_MatchesOriginalFilter)
+    {
+        const BlackmanHarrisFilter2<double> filter(2.0, 3.0);
+
+        EXPECT_TRUE(matches_original_filter(filter, 1.0e-3));
+    }
+
+    TEST_CASE(Evaluate_PointsOnDomainBorder_ReturnsZero)
+    {
+        const BlackmanHarrisFilter2<double> filter(2.0, 3.0);
+        const TabulatedFilter2<double> tabulated_filter(filter);
+
+        EXPECT_TRUE(is_zero_on_domain_border(tabulated_filter));
+    }
+}
@@ -0,0 +1,135 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2018 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// appleseed.foundation headers.
+#include "foundation/utility/profiler.h"
+#include "foundation/utility/test.h"
+
+// Boost headers.
+#include "boost/thread/thread.hpp"
+
+// Standard headers.
+#include <cstddef>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+using namespace foundation;
+using namespace std;
+
+TEST_SUITE(Foundation_Utility_Profiler)
+{
+    struct Fixture
+    {
+        Fixture()
+        {
+            Profiler::clear();
+        }
+
+        ~Fixture()
+        {
+            Profiler::set_enabled(false);
+            Profiler::clear();
+        }
+    };
+
+    TEST_CASE_F(ProfileZone_GivenDisabledProfiler_RecordsNothing, Fixture)
+    {
+        Profiler::set_enabled(false);
+
+        {
+            ProfileZone zone("zone");
+        }
+
+        EXPECT_EQ(0, Profiler::get_event_count());
+    }
+
+    TEST_CASE_F(ProfileZone_GivenEnabledProfiler_RecordsOneEventPerZone, Fixture)
+    {
+        Profiler::set_enabled(true);
+
+        {
+            ProfileZone outer("outer");
+            ProfileZone inner("inner");
+        }
+
+        EXPECT_EQ(2, Profiler::get_event_count());
+    }
+
+    TEST_CASE_F(Record_GivenFullThreadBuffer_DropsEvents, Fixture)
+    {
+        Profiler::set_enabled(true);
+
+        for (size_t i = 0; i < Profiler::MaxEventsPerThread + 3; ++i)
+            Profiler::record("event", 0, 1);
+
+        EXPECT_EQ(Profiler::MaxEventsPerThread, Profiler::get_event_count());
+        EXPECT_EQ(3, Profiler::get_dropped_event_count());
+    }
+
+    void record_event()
+    {
+        Profiler::record("event", 0, 1);
+    }
+
+    TEST_CASE_F(Record_GivenSuccessiveThreads_ReusesBuffersOfExitedThreads, Fixture)
+    {
+        Profiler::set_enabled(true);
+
+        // Make sure a buffer of an exited thread is available.
+        boost::thread(record_event).join();
+
+        const size_t buffer_count = Profiler::get_thread_buffer_count();
+
+        for (size_t i = 0; i < 4; ++i)
+            boost::thread(record_event).join();
+
+        EXPECT_EQ(buffer_count, Profiler::get_thread_buffer_count());
+        EXPECT_EQ(5, Profiler::get_event_count());
+    }
+
+    TEST_CASE_F(WriteChromeTrace_WritesCompleteEvents, Fixture)
+    {
+        Profiler::set_enabled(true);
+
+        Profiler::record("zone \"quoted\"", 10, 25);
+
+        const char* Filepath = "unit tests/outputs/test_profiler.json";
+        ASSERT_TRUE(Profiler::write_chrome_trace(Filepath));
+
+        ifstream file(Filepath);
+        const string contents(
+            (istreambuf_iterator<char>(file)),
+            istreambuf_iterator<char>());
+
+        EXPECT_EQ(0, contents.find("{\"traceEvents\":["));
+        EXPECT_NEQ(string::npos, contents.find("\"name\":\"zone \\\"quoted\\\"\""));
+        EXPECT_NEQ(string::npos, contents.find("\"ph\":\"X\""));
+        EXPECT_NEQ(string::npos, contents.find("\"ts\":10,\"dur\":15"));
+    }
+}
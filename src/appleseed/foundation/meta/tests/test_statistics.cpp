@@ -211,6 +211,76 @@ TEST_SUITE(Foundation_Utility_Statistics)
 
         EXPECT_EQ("  existing value                19.6%", stats.to_string());
     }
+
+    TEST_CASE(Merge_GivenExistingSizeAndTimeStatistics_KeepsExistingValues)
+    {
+        Statistics stats;
+        stats.insert_size("size", 2048);
+        stats.insert_time("time", 1.5);
+
+        Statistics other_stats;
+        other_stats.insert_size("size", 1024);
+        other_stats.insert_time("time", 2.0);
+
+        stats.merge(other_stats);
+
+        EXPECT_EQ("{\"size\":2048,\"time\":1.5}", stats.to_json());
+    }
+
+    TEST_CASE(SingleSizeStatistic)
+    {
+        Statistics stats;
+
+        stats.insert_size("some value", 2048);
+
+        EXPECT_EQ("  some value                    2.0 KB", stats.to_string());
+    }
+
+    TEST_CASE(ToJson_GivenEmptyStatistics)
+    {
+        Statistics stats;
+
+        EXPECT_EQ("{}", stats.to_json());
+    }
+
+    TEST_CASE(ToJson_GivenScalarStatistics)
+    {
+        Statistics stats;
+
+        stats.insert<uint64>("count", 17000);
+        stats.insert("ratio", 0.5);
+        stats.insert<string>("name", "\"bunny\"");
+        stats.insert_size("size", 2048);
+        stats.insert_time("time", 1.5);
+
+        EXPECT_EQ(
+            "{\"count\":17000,\"ratio\":0.5,\"name\":\"\\\"bunny\\\"\",\"size\":2048,\"time\":1.5}",
+            stats.to_json());
+    }
+
+    TEST_CASE(ToJson_GivenPercentStatistic)
+    {
+        Statistics stats;
+
+        stats.insert_percent("hits", 5, 10, 1);
+
+        EXPECT_EQ("{\"hits\":{\"numerator\":5,\"denominator\":10}}", stats.to_json());
+    }
+
+    TEST_CASE(ToJson_GivenPopulationStatisticWithUnit)
+    {
+        Statistics stats;
+
+        Population<size_t> pop;
+        pop.insert(1);
+        pop.insert(3);
+
+        stats.insert("some value", pop, " KB");
+
+        EXPECT_EQ(
+            "{\"some value\":{\"count\":2,\"avg\":2,\"min\":1,\"max\":3,\"dev\":1,\"unit\":\"KB\"}}",
+            stats.to_json());
+    }
 }
 
 TEST_SUITE(Foundation_Utility_StatisticsVector)
@@ -229,4 +299,22 @@ TEST_SUITE(Foundation_Utility_StatisticsVector)
 
         EXPECT_EQ("stats 1:\n  counter 1                     17\nstats 2:\n  counter 2                     42", vec.to_string());
     }
+
+    TEST_CASE(ToJson_GivenTwoItems)
+    {
+        Statistics stats1;
+        stats1.insert<uint64>("counter 1", 17);
+
+        Statistics stats2;
+        stats2.insert<uint64>("counter 2", 42);
+
+        StatisticsVector vec;
+        vec.insert("stats 1", stats1);
+        vec.insert("stats 2", stats2);
+
+        EXPECT_EQ(
+            "[\n{\"name\":\"stats 1\",\"statistics\":{\"counter 1\":17}},"
+            "\n{\"name\":\"stats 2\",\"statistics\":{\"counter 2\":42}}\n]",
+            vec.to_json());
+    }
 }
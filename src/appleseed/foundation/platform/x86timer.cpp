@@ -37,7 +37,7 @@
 #include <cassert>
 
 // Platform headers.
-#if defined _MSC_VER && defined _WIN64
+#if defined _MSC_VER
 #include <intrin.h>
 #endif
 
@@ -201,4 +201,24 @@ uint64 X86Timer::read_end()
 #endif
 }
 
+uint64 X86Timer::read_unserialized()
+{
+// Visual C++.
+#if defined _MSC_VER
+
+    return __rdtsc();
+
+// gcc.
+#elif defined __GNUC__
+
+    return __builtin_ia32_rdtsc();
+
+// Other platforms.
+#else
+
+    #error The x86 timer is not supported on this platform.
+
+#endif
+}
+
 }   // namespace foundation
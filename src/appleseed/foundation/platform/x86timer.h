@@ -65,6 +65,11 @@ class APPLESEED_DLLSYMBOL X86Timer
     // For benchmarking, read the timer value after the benchmark ends.
     uint64 read_end();
 
+    // Read the timer value without serializing instruction execution. This is much
+    // cheaper than read_start() and read_end() and suitable for accumulating the
+    // cost of many short code paths, at the expense of precision on each of them.
+    static uint64 read_unserialized();
+
   private:
     const uint64 m_frequency;
 };
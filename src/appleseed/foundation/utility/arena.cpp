@@ -0,0 +1,91 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2018 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// Interface header.
+#include "arena.h"
+
+// appleseed.foundation headers.
+#include "foundation/utility/memory.h"
+
+// Standard headers.
+#include <new>
+
+using namespace std;
+
+namespace foundation
+{
+
+//
+// Arena class implementation.
+//
+
+Arena::~Arena()
+{
+    for (size_t i = 0, e = m_chunks.size(); i < e; ++i)
+        aligned_free(m_chunks[i].m_begin);
+}
+
+void* Arena::allocate_from_next_chunk(const size_t size)
+{
+    // The remainder of the current chunk is lost until the arena is cleared.
+    m_chunk_base += static_cast<size_t>(m_end - m_begin);
+
+    // Skip retained chunks that are too small for this allocation.
+    while (m_chunk_index < m_chunks.size())
+    {
+        const Chunk& chunk = m_chunks[m_chunk_index++];
+
+        if (chunk.m_begin + size <= chunk.m_end)
+        {
+            m_begin = chunk.m_begin;
+            m_end = chunk.m_end;
+            m_current = m_begin;
+            return allocate(size);
+        }
+
+        m_chunk_base += static_cast<size_t>(chunk.m_end - chunk.m_begin);
+    }
+
+    // Allocate a new chunk large enough for this allocation.
+    const size_t chunk_size = size > ChunkSize ? align(size, 16) : static_cast<size_t>(ChunkSize);
+    Chunk chunk;
+    chunk.m_begin = static_cast<uint8*>(aligned_malloc(chunk_size, 16));
+    if (chunk.m_begin == nullptr)
+        throw bad_alloc();
+    chunk.m_end = chunk.m_begin + chunk_size;
+    m_chunks.push_back(chunk);
+    m_chunk_index = m_chunks.size();
+
+    m_begin = chunk.m_begin;
+    m_end = chunk.m_end;
+    m_current = m_begin;
+
+    return allocate(size);
+}
+
+}   // namespace foundation
@@ -31,14 +31,19 @@
 #define APPLESEED_FOUNDATION_UTILITY_ARENA_H
 
 // appleseed.foundation headers.
-#include "foundation/core/exceptions/exception.h"
+#include "foundation/core/concepts/noncopyable.h"
 #include "foundation/platform/compiler.h"
 #include "foundation/platform/types.h"
 #include "foundation/utility/memory.h"
 
+// appleseed.main headers.
+#include "main/dllsymbol.h"
+
 // Standard headers.
 #include <cassert>
 #include <cstddef>
+#include <new>
+#include <vector>
 
 namespace foundation
 {
@@ -46,12 +51,20 @@ namespace foundation
 //
 // An arena is a temporary heap providing extremely cheap memory allocation.
 //
+// Allocations are first served from an inline chunk. When it is exhausted, additional
+// chunks are allocated from the heap. Chunks are kept when the arena is cleared so that
+// an arena that is repeatedly filled and cleared stops allocating from the heap once it
+// has grown to its working size.
+//
 
-class Arena
+class APPLESEED_DLLSYMBOL Arena
+  : public NonCopyable
 {
   public:
     Arena();
+    ~Arena();
 
+    // Release all allocations at once. Chunks are retained for future allocations.
     void clear();
 
     void* allocate(const size_t size);
@@ -59,14 +72,34 @@ class Arena
     template <typename T> T* allocate();
     template <typename T> T* allocate_noinit();
 
-    const uint8* get_storage() const;
+    // Return the number of bytes currently allocated from the arena.
+    size_t get_size() const;
 
-  private:
-    enum { ArenaSize = 256 * 1024 };    // bytes
+    // Return the largest number of bytes ever allocated from the arena between two clears.
+    size_t get_peak_size() const;
 
-    APPLESEED_SIMD4_ALIGN uint8 m_storage[ArenaSize];
+    // Return the number of chunks, including the inline one.
+    size_t get_chunk_count() const;
+
+  private:
+    enum { ChunkSize = 256 * 1024 };    // bytes
+
+    struct Chunk
+    {
+        uint8*  m_begin;
+        uint8*  m_end;
+    };
+
+    APPLESEED_SIMD4_ALIGN uint8 m_storage[ChunkSize];
+    std::vector<Chunk>          m_chunks;           // heap-allocated chunks
+    size_t                      m_chunk_index;      // 0 for the inline chunk, i for m_chunks[i - 1]
+    size_t                      m_chunk_base;       // bytes consumed in the chunks preceding the current one
+    uint8*                      m_begin;
     const uint8*                m_end;
     uint8*                      m_current;
+    size_t                      m_peak_size;
+
+    void* allocate_from_next_chunk(const size_t size);
 };
 
 
@@ -75,20 +108,32 @@ class Arena
 //
 
 inline Arena::Arena()
-  : m_end(m_storage + ArenaSize)
+  : m_chunk_index(0)
+  , m_chunk_base(0)
+  , m_begin(m_storage)
+  , m_end(m_storage + ChunkSize)
   , m_current(m_storage)
+  , m_peak_size(0)
 {
 }
 
 inline void Arena::clear()
 {
+    const size_t size = get_size();
+    if (m_peak_size < size)
+        m_peak_size = size;
+
+    m_chunk_index = 0;
+    m_chunk_base = 0;
+    m_begin = m_storage;
+    m_end = m_storage + ChunkSize;
     m_current = m_storage;
 }
 
 inline void* Arena::allocate(const size_t size)
 {
     if (m_current + size > m_end)
-        throw Exception("out of arena memory");
+        return allocate_from_next_chunk(size);
 
     void* ptr = m_current;
     m_current += align(size, 16);
@@ -114,9 +159,20 @@ inline T* Arena::allocate_noinit()
     return static_cast<T*>(allocate(sizeof(T)));
 }
 
-inline const uint8* Arena::get_storage() const
+inline size_t Arena::get_size() const
+{
+    return m_chunk_base + static_cast<size_t>(m_current - m_begin);
+}
+
+inline size_t Arena::get_peak_size() const
+{
+    const size_t size = get_size();
+    return m_peak_size < size ? size : m_peak_size;
+}
+
+inline size_t Arena::get_chunk_count() const
 {
-    return m_storage;
+    return m_chunks.size() + 1;
 }
 
 }       // namespace foundation
@@ -30,6 +30,10 @@
 // Interface header.
 #include "attributeset.h"
 
+// appleseed.foundation headers.
+#include "foundation/core/exceptions/exceptionioerror.h"
+#include "foundation/utility/bufferedfile.h"
+
 // Standard headers.
 #include <cstring>
 
@@ -44,8 +48,7 @@ namespace foundation
 
 AttributeSet::~AttributeSet()
 {
-    for (size_t i = 0; i < m_channels.size(); ++i)
-        delete m_channels[i];
+    clear();
 }
 
 AttributeSet::ChannelID AttributeSet::create_channel(
@@ -74,6 +77,27 @@ void AttributeSet::delete_channel(const ChannelID channel_id)
     m_channels.erase(m_channels.begin() + channel_id);
 }
 
+void AttributeSet::clear()
+{
+    for (size_t i = 0; i < m_channels.size(); ++i)
+        delete m_channels[i];
+
+    m_channels.clear();
+}
+
+void AttributeSet::copy_from(const AttributeSet& rhs)
+{
+    if (&rhs == this)
+        return;
+
+    clear();
+
+    m_channels.reserve(rhs.m_channels.size());
+
+    for (size_t i = 0; i < rhs.m_channels.size(); ++i)
+        m_channels.push_back(new Channel(*rhs.m_channels[i]));
+}
+
 AttributeSet::ChannelID AttributeSet::find_channel(const char* name) const
 {
     assert(name);
@@ -89,4 +113,74 @@ AttributeSet::ChannelID AttributeSet::find_channel(const char* name) const
     return InvalidChannelID;
 }
 
+size_t AttributeSet::get_memory_size() const
+{
+    size_t size = sizeof(*this) + m_channels.capacity() * sizeof(Channel*);
+
+    for (size_t i = 0; i < m_channels.size(); ++i)
+    {
+        const Channel* channel = m_channels[i];
+        size += sizeof(Channel);
+        size += channel->m_name.capacity();
+        size += channel->m_storage.capacity();
+    }
+
+    return size;
+}
+
+void AttributeSet::write(WriterAdapter& writer) const
+{
+    checked_write(writer, static_cast<uint32>(m_channels.size()));
+
+    for (size_t i = 0; i < m_channels.size(); ++i)
+    {
+        const Channel* channel = m_channels[i];
+
+        checked_write(writer, static_cast<uint16>(channel->m_name.size()));
+        checked_write(writer, channel->m_name.c_str(), channel->m_name.size());
+        checked_write(writer, static_cast<uint8>(channel->m_type));
+        checked_write(writer, static_cast<uint32>(channel->m_dimension));
+
+        checked_write(writer, static_cast<uint64>(channel->m_storage.size()));
+        if (!channel->m_storage.empty())
+            checked_write(writer, &channel->m_storage[0], channel->m_storage.size());
+    }
+}
+
+void AttributeSet::read(ReaderAdapter& reader)
+{
+    clear();
+
+    uint32 channel_count;
+    checked_read(reader, channel_count);
+
+    for (uint32 i = 0; i < channel_count; ++i)
+    {
+        uint16 name_length;
+        checked_read(reader, name_length);
+        string name(name_length, ' ');
+        if (name_length > 0)
+            checked_read(reader, &name[0], name_length);
+
+        uint8 type;
+        checked_read(reader, type);
+
+        uint32 dimension;
+        checked_read(reader, dimension);
+
+        if (type > NumericTypeDouble || dimension == 0)
+            throw ExceptionIOError("invalid attribute channel");
+
+        const ChannelID channel_id =
+            create_channel(name, static_cast<NumericTypeID>(type), dimension);
+        Channel* channel = m_channels[channel_id];
+
+        uint64 storage_size;
+        checked_read(reader, storage_size);
+        channel->m_storage.resize(static_cast<size_t>(storage_size));
+        if (storage_size > 0)
+            checked_read(reader, &channel->m_storage[0], channel->m_storage.size());
+    }
+}
+
 }   // namespace foundation
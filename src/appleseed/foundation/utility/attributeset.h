@@ -42,6 +42,10 @@
 #include <string>
 #include <vector>
 
+// Forward declarations.
+namespace foundation    { class ReaderAdapter; }
+namespace foundation    { class WriterAdapter; }
+
 namespace foundation
 {
 
@@ -68,6 +72,12 @@ class AttributeSet
     // Delete an existing channel.
     void delete_channel(const ChannelID channel_id);
 
+    // Delete all channels.
+    void clear();
+
+    // Replace the content of this attribute set by a copy of another attribute set.
+    void copy_from(const AttributeSet& rhs);
+
     // Find a given attribute channel. Return InvalidChannelID if
     // the requested channel does not exist. Since this method is
     // typically called with a literal value in argument ("uv"),
@@ -104,6 +114,15 @@ class AttributeSet
         const size_t        index,
         T*                  value) const;
 
+    // Return the amount of memory used by this attribute set, in bytes.
+    size_t get_memory_size() const;
+
+    // Write the attribute set to a binary stream, or replace the content
+    // of the attribute set by the one read from a binary stream.
+    // Both methods throw foundation::ExceptionIOError on failure.
+    void write(WriterAdapter& writer) const;
+    void read(ReaderAdapter& reader);
+
   private:
     struct Channel
     {
@@ -0,0 +1,392 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2018 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// Interface header.
+#include "binaryxml.h"
+
+// appleseed.foundation headers.
+#include "foundation/utility/string.h"
+
+// Xerces-C++ headers.
+#include "xercesc/util/XMLString.hpp"
+#include "xercesc/util/XMLUni.hpp"
+
+// Standard headers.
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+
+using namespace std;
+using namespace xercesc;
+
+namespace foundation
+{
+
+namespace
+{
+    // Version of the binary XML file format being written by this code.
+    const uint16 Version = 1;
+
+    const char Signature[9] = { 'B', 'I', 'N', 'A', 'R', 'Y', 'X', 'M', 'L' };
+}
+
+
+//
+// BinaryXMLWriter class implementation.
+//
+
+BinaryXMLWriter::BinaryXMLWriter(const set<string>& numeric_elements)
+  : m_numeric_elements(numeric_elements)
+{
+}
+
+void BinaryXMLWriter::startElement(
+    const XMLCh* const                      uri,
+    const XMLCh* const                      localname,
+    const XMLCh* const                      qname,
+    const Attributes&                       attrs)
+{
+    AttributeVector attributes;
+
+    for (XMLSize_t i = 0, e = attrs.getLength(); i < e; ++i)
+    {
+        attributes.push_back(
+            make_pair(
+                transcode(attrs.getLocalName(i)),
+                transcode(attrs.getValue(i))));
+    }
+
+    start_element(transcode(localname), attributes);
+}
+
+void BinaryXMLWriter::endElement(
+    const XMLCh* const                      uri,
+    const XMLCh* const                      localname,
+    const XMLCh* const                      qname)
+{
+    end_element(transcode(localname));
+}
+
+void BinaryXMLWriter::characters(
+    const XMLCh* const                      chars,
+    const XMLSize_t                         length)
+{
+    characters(transcode(basic_string<XMLCh>(chars, length).c_str()));
+}
+
+void BinaryXMLWriter::start_element(
+    const string&                           name,
+    const AttributeVector&                  attributes)
+{
+    flush_numeric_text();
+
+    emit(static_cast<uint8>(binaryxml::RecordStartElement));
+    emit(intern(name));
+
+    const uint16 attribute_count = static_cast<uint16>(attributes.size());
+    emit(attribute_count);
+
+    for (const auto& attribute : attributes)
+    {
+        emit(intern(attribute.first));
+        emit(intern(attribute.second));
+    }
+
+    m_numeric_stack.push_back(m_numeric_elements.find(name) != m_numeric_elements.end());
+}
+
+void BinaryXMLWriter::end_element(const string& name)
+{
+    flush_numeric_text();
+
+    emit(static_cast<uint8>(binaryxml::RecordEndElement));
+
+    assert(!m_numeric_stack.empty());
+    m_numeric_stack.pop_back();
+}
+
+void BinaryXMLWriter::characters(const string& text)
+{
+    if (!m_numeric_stack.empty() && m_numeric_stack.back())
+        m_numeric_text += text;
+    else
+    {
+        emit(static_cast<uint8>(binaryxml::RecordCharacters));
+        emit(intern(text));
+    }
+}
+
+void BinaryXMLWriter::write(const char* filepath) const
+{
+    BufferedFile file(
+        filepath,
+        BufferedFile::BinaryType,
+        BufferedFile::WriteMode);
+
+    if (!file.is_open())
+        throw ExceptionIOError();
+
+    checked_write(file, Signature, sizeof(Signature));
+    checked_write(file, Version);
+
+    LZ4CompressedWriterAdapter writer(file, 256 * 1024);
+
+    // Write the string table.
+    checked_write(writer, static_cast<uint32>(m_strings.size()));
+    for (const auto& s : m_strings)
+    {
+        checked_write(writer, static_cast<uint32>(s.size()));
+        if (!s.empty())
+            checked_write(writer, s.data(), s.size());
+    }
+
+    // Write the records.
+    if (!m_records.empty())
+        checked_write(writer, &m_records[0], m_records.size());
+    checked_write(writer, static_cast<uint8>(binaryxml::RecordEndOfDocument));
+}
+
+uint32 BinaryXMLWriter::intern(const string& s)
+{
+    const StringIndexMap::const_iterator it = m_string_indices.find(s);
+
+    if (it != m_string_indices.end())
+        return it->second;
+
+    const uint32 index = static_cast<uint32>(m_strings.size());
+    m_string_indices[s] = index;
+    m_strings.push_back(s);
+
+    return index;
+}
+
+void BinaryXMLWriter::flush_numeric_text()
+{
+    if (m_numeric_text.empty())
+        return;
+
+    vector<double> values;
+    bool is_numeric = true;
+
+    try
+    {
+        tokenize(m_numeric_text, Blanks, values);
+    }
+    catch (const ExceptionStringConversionError&)
+    {
+        is_numeric = false;
+    }
+
+    if (is_numeric)
+    {
+        emit(static_cast<uint8>(binaryxml::RecordNumericCharacters));
+        emit(static_cast<uint32>(values.size()));
+        for (const auto value : values)
+            emit(value);
+    }
+    else
+    {
+        // Preserve character data that cannot be parsed as numbers.
+        emit(static_cast<uint8>(binaryxml::RecordCharacters));
+        emit(intern(m_numeric_text));
+    }
+
+    m_numeric_text.clear();
+}
+
+
+//
+// BinaryXMLReader class implementation.
+//
+
+bool BinaryXMLReader::is_binary_xml_file(const char* filepath)
+{
+    FILE* file = fopen(filepath, "rb");
+
+    if (file == nullptr)
+        return false;
+
+    char signature[sizeof(Signature)];
+    const bool is_binary_xml =
+        fread(signature, 1, sizeof(signature), file) == sizeof(signature) &&
+        memcmp(signature, Signature, sizeof(Signature)) == 0;
+
+    fclose(file);
+
+    return is_binary_xml;
+}
+
+void BinaryXMLReader::read_and_check_signature(BufferedFile& file)
+{
+    char signature[sizeof(Signature)];
+    checked_read(file, signature, sizeof(signature));
+
+    if (memcmp(signature, Signature, sizeof(Signature)))
+        throw ExceptionIOError("invalid binary xml format signature");
+}
+
+void BinaryXMLReader::read_string_table(ReaderAdapter& reader)
+{
+    uint32 count;
+    checked_read(reader, count);
+
+    m_strings.resize(count);
+    m_xml_strings.resize(count);
+
+    vector<char> buffer;
+
+    for (uint32 i = 0; i < count; ++i)
+    {
+        uint32 length;
+        checked_read(reader, length);
+
+        buffer.resize(length + 1);
+        if (length > 0)
+            checked_read(reader, &buffer[0], length);
+        buffer[length] = '\0';
+
+        // Strings are transcoded only once, regardless of how many times they're referenced.
+        m_strings[i].assign(&buffer[0], length);
+        m_xml_strings[i] = transcode(&buffer[0]);
+    }
+}
+
+uint32 BinaryXMLReader::read_string_index(ReaderAdapter& reader) const
+{
+    uint32 index;
+    checked_read(reader, index);
+
+    if (index >= m_strings.size())
+        throw ExceptionIOError("invalid string reference in binary xml document");
+
+    return index;
+}
+
+
+//
+// BinaryXMLReader::Attributes class implementation.
+//
+
+BinaryXMLReader::Attributes::Attributes(const vector<XMLChString>& strings)
+  : m_strings(strings)
+{
+}
+
+void BinaryXMLReader::Attributes::clear()
+{
+    m_attributes.clear();
+}
+
+void BinaryXMLReader::Attributes::push_back(const uint32 name_index, const uint32 value_index)
+{
+    m_attributes.push_back(make_pair(name_index, value_index));
+}
+
+XMLSize_t BinaryXMLReader::Attributes::getLength() const
+{
+    return m_attributes.size();
+}
+
+const XMLCh* BinaryXMLReader::Attributes::getURI(const XMLSize_t index) const
+{
+    return index < m_attributes.size() ? XMLUni::fgZeroLenString : nullptr;
+}
+
+const XMLCh* BinaryXMLReader::Attributes::getLocalName(const XMLSize_t index) const
+{
+    return index < m_attributes.size() ? m_strings[m_attributes[index].first].c_str() : nullptr;
+}
+
+const XMLCh* BinaryXMLReader::Attributes::getQName(const XMLSize_t index) const
+{
+    return getLocalName(index);
+}
+
+const XMLCh* BinaryXMLReader::Attributes::getType(const XMLSize_t index) const
+{
+    return index < m_attributes.size() ? XMLUni::fgCDATAString : nullptr;
+}
+
+const XMLCh* BinaryXMLReader::Attributes::getValue(const XMLSize_t index) const
+{
+    return index < m_attributes.size() ? m_strings[m_attributes[index].second].c_str() : nullptr;
+}
+
+bool BinaryXMLReader::Attributes::getIndex(const XMLCh* const uri, const XMLCh* const local_part, XMLSize_t& index) const
+{
+    return getIndex(local_part, index);
+}
+
+int BinaryXMLReader::Attributes::getIndex(const XMLCh* const uri, const XMLCh* const local_part) const
+{
+    return getIndex(local_part);
+}
+
+bool BinaryXMLReader::Attributes::getIndex(const XMLCh* const qname, XMLSize_t& index) const
+{
+    for (size_t i = 0, e = m_attributes.size(); i < e; ++i)
+    {
+        if (xercesc::XMLString::equals(m_strings[m_attributes[i].first].c_str(), qname))
+        {
+            index = i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+int BinaryXMLReader::Attributes::getIndex(const XMLCh* const qname) const
+{
+    XMLSize_t index;
+    return getIndex(qname, index) ? static_cast<int>(index) : -1;
+}
+
+const XMLCh* BinaryXMLReader::Attributes::getType(const XMLCh* const uri, const XMLCh* const local_part) const
+{
+    return getType(local_part);
+}
+
+const XMLCh* BinaryXMLReader::Attributes::getType(const XMLCh* const qname) const
+{
+    XMLSize_t index;
+    return getIndex(qname, index) ? getType(index) : nullptr;
+}
+
+const XMLCh* BinaryXMLReader::Attributes::getValue(const XMLCh* const uri, const XMLCh* const local_part) const
+{
+    return getValue(local_part);
+}
+
+const XMLCh* BinaryXMLReader::Attributes::getValue(const XMLCh* const qname) const
+{
+    XMLSize_t index;
+    return getIndex(qname, index) ? getValue(index) : nullptr;
+}
+
+}   // namespace foundation
@@ -0,0 +1,333 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2018 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef APPLESEED_FOUNDATION_UTILITY_BINARYXML_H
+#define APPLESEED_FOUNDATION_UTILITY_BINARYXML_H
+
+// appleseed.foundation headers.
+#include "foundation/core/concepts/noncopyable.h"
+#include "foundation/core/exceptions/exceptionioerror.h"
+#include "foundation/platform/types.h"
+#include "foundation/utility/bufferedfile.h"
+#include "foundation/utility/xercesc.h"
+#include "foundation/utility/xmlelement.h"
+
+// Xerces-C++ headers.
+#include "xercesc/sax2/Attributes.hpp"
+#include "xercesc/sax2/DefaultHandler.hpp"
+
+// Standard headers.
+#include <cstddef>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace foundation
+{
+
+//
+// Binary XML documents.
+//
+// A binary XML document is a compact, pre-parsed form of an XML document: element
+// names, attribute names, attribute values and character data are interned in a
+// string table, and the character data of a designated set of elements (typically
+// matrices and other numeric arrays) is stored as arrays of double-precision values.
+//
+// Reading a binary XML document replays the exact sequence of events that parsing
+// the original XML document would produce, hence existing element handlers can be
+// used unmodified. See binaryxmlspecs.txt for a description of the file format.
+//
+
+namespace binaryxml
+{
+    enum RecordType
+    {
+        RecordEndOfDocument     = 0,
+        RecordStartElement      = 1,
+        RecordEndElement        = 2,
+        RecordCharacters        = 3,
+        RecordNumericCharacters = 4
+    };
+}
+
+
+//
+// A SAX2 handler that records the events of an XML document and writes them
+// to disk as a binary XML document. Documents written with XMLElement can be
+// recorded directly, without being formatted and parsed back.
+//
+
+class BinaryXMLWriter
+  : public xercesc::DefaultHandler
+  , public IXMLContentHandler
+{
+  public:
+    // Constructor. The character data of elements whose names appear
+    // in numeric_elements will be stored as arrays of numbers.
+    explicit BinaryXMLWriter(const std::set<std::string>& numeric_elements);
+
+    // Receive notification of the start of an element.
+    void startElement(
+        const XMLCh* const                  uri,
+        const XMLCh* const                  localname,
+        const XMLCh* const                  qname,
+        const xercesc::Attributes&          attrs) override;
+
+    // Receive notification of the end of an element.
+    void endElement(
+        const XMLCh* const                  uri,
+        const XMLCh* const                  localname,
+        const XMLCh* const                  qname) override;
+
+    // Receive notification of character data inside an element.
+    void characters(
+        const XMLCh* const                  chars,
+        const XMLSize_t                     length) override;
+
+    // Receive notification of the start of an element.
+    void start_element(
+        const std::string&                  name,
+        const AttributeVector&              attributes) override;
+
+    // Receive notification of the end of an element.
+    void end_element(const std::string& name) override;
+
+    // Receive notification of character data inside an element.
+    void characters(const std::string& text) override;
+
+    // Write the recorded document to disk. Throws foundation::ExceptionIOError on failure.
+    void write(const char* filepath) const;
+
+  private:
+    typedef std::map<std::string, uint32> StringIndexMap;
+
+    const std::set<std::string>     m_numeric_elements;
+    StringIndexMap                  m_string_indices;
+    std::vector<std::string>        m_strings;
+    std::vector<uint8>              m_records;
+    std::vector<bool>               m_numeric_stack;
+    std::string                     m_numeric_text;
+
+    uint32 intern(const std::string& s);
+
+    template <typename T>
+    void emit(const T& value);
+
+    void flush_numeric_text();
+};
+
+
+//
+// Reader for binary XML documents.
+//
+
+class BinaryXMLReader
+  : public NonCopyable
+{
+  public:
+    // Read a binary XML document and replay its content into a SAX2 content handler.
+    // Throws foundation::ExceptionIOError if the file cannot be read or is invalid.
+    template <typename ElementID>
+    void read(
+        const char*                         filepath,
+        SAX2ContentHandler<ElementID>&      handler);
+
+    // Return true if a given file starts with the binary XML signature.
+    static bool is_binary_xml_file(const char* filepath);
+
+  private:
+    class Attributes;
+
+    typedef std::basic_string<XMLCh> XMLChString;
+
+    std::vector<std::string>        m_strings;
+    std::vector<XMLChString>        m_xml_strings;
+    std::vector<double>             m_values;
+
+    static void read_and_check_signature(BufferedFile& file);
+    void read_string_table(ReaderAdapter& reader);
+    uint32 read_string_index(ReaderAdapter& reader) const;
+};
+
+
+//
+// Attributes of an element of a binary XML document.
+//
+
+class BinaryXMLReader::Attributes
+  : public xercesc::Attributes
+{
+  public:
+    explicit Attributes(const std::vector<XMLChString>& strings);
+
+    void clear();
+    void push_back(const uint32 name_index, const uint32 value_index);
+
+    XMLSize_t getLength() const override;
+    const XMLCh* getURI(const XMLSize_t index) const override;
+    const XMLCh* getLocalName(const XMLSize_t index) const override;
+    const XMLCh* getQName(const XMLSize_t index) const override;
+    const XMLCh* getType(const XMLSize_t index) const override;
+    const XMLCh* getValue(const XMLSize_t index) const override;
+    bool getIndex(const XMLCh* const uri, const XMLCh* const local_part, XMLSize_t& index) const override;
+    int getIndex(const XMLCh* const uri, const XMLCh* const local_part) const override;
+    bool getIndex(const XMLCh* const qname, XMLSize_t& index) const override;
+    int getIndex(const XMLCh* const qname) const override;
+    const XMLCh* getType(const XMLCh* const uri, const XMLCh* const local_part) const override;
+    const XMLCh* getType(const XMLCh* const qname) const override;
+    const XMLCh* getValue(const XMLCh* const uri, const XMLCh* const local_part) const override;
+    const XMLCh* getValue(const XMLCh* const qname) const override;
+
+  private:
+    typedef std::pair<uint32, uint32> Attribute;
+
+    const std::vector<XMLChString>& m_strings;
+    std::vector<Attribute>          m_attributes;
+};
+
+
+//
+// BinaryXMLWriter class implementation.
+//
+
+template <typename T>
+inline void BinaryXMLWriter::emit(const T& value)
+{
+    const uint8* bytes = reinterpret_cast<const uint8*>(&value);
+    m_records.insert(m_records.end(), bytes, bytes + sizeof(T));
+}
+
+
+//
+// BinaryXMLReader class implementation.
+//
+
+template <typename ElementID>
+void BinaryXMLReader::read(
+    const char*                             filepath,
+    SAX2ContentHandler<ElementID>&          handler)
+{
+    BufferedFile file(
+        filepath,
+        BufferedFile::BinaryType,
+        BufferedFile::ReadMode);
+
+    if (!file.is_open())
+        throw ExceptionIOError();
+
+    read_and_check_signature(file);
+
+    uint16 version;
+    checked_read(file, version);
+
+    if (version != 1)
+        throw ExceptionIOError("unknown binary xml format version");
+
+    LZ4CompressedReaderAdapter reader(file);
+    read_string_table(reader);
+
+    Attributes attributes(m_xml_strings);
+    std::vector<uint32> element_stack;
+
+    while (true)
+    {
+        uint8 record_type;
+        checked_read(reader, record_type);
+
+        switch (record_type)
+        {
+          case binaryxml::RecordEndOfDocument:
+            if (!element_stack.empty())
+                throw ExceptionIOError("unbalanced elements in binary xml document");
+            return;
+
+          case binaryxml::RecordStartElement:
+            {
+                const uint32 name_index = read_string_index(reader);
+
+                uint16 attribute_count;
+                checked_read(reader, attribute_count);
+
+                attributes.clear();
+
+                for (uint16 i = 0; i < attribute_count; ++i)
+                {
+                    const uint32 attribute_name = read_string_index(reader);
+                    const uint32 attribute_value = read_string_index(reader);
+                    attributes.push_back(attribute_name, attribute_value);
+                }
+
+                element_stack.push_back(name_index);
+                handler.start_element(m_strings[name_index], attributes);
+            }
+            break;
+
+          case binaryxml::RecordEndElement:
+            {
+                if (element_stack.empty())
+                    throw ExceptionIOError("unbalanced elements in binary xml document");
+
+                const uint32 name_index = element_stack.back();
+                element_stack.pop_back();
+                handler.end_element(m_strings[name_index]);
+            }
+            break;
+
+          case binaryxml::RecordCharacters:
+            {
+                const XMLChString& chars = m_xml_strings[read_string_index(reader)];
+                handler.characters(chars.c_str(), chars.size());
+            }
+            break;
+
+          case binaryxml::RecordNumericCharacters:
+            {
+                uint32 count;
+                checked_read(reader, count);
+
+                m_values.resize(count);
+
+                if (count > 0)
+                {
+                    checked_read(reader, &m_values[0], count * sizeof(double));
+                    handler.numeric_characters(&m_values[0], count);
+                }
+            }
+            break;
+
+          default:
+            throw ExceptionIOError("invalid record in binary xml document");
+        }
+    }
+}
+
+}       // namespace foundation
+
+#endif  // !APPLESEED_FOUNDATION_UTILITY_BINARYXML_H
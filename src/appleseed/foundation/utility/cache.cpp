@@ -76,6 +76,13 @@ namespace cache_impl
             + "  hits " + pretty_uint(m_hit_count)
             + "  misses " + pretty_uint(m_miss_count);
     }
+
+    string CacheStatisticsEntry::to_json() const
+    {
+        return
+              "{\"hits\":" + std::to_string(m_hit_count)
+            + ",\"misses\":" + std::to_string(m_miss_count) + "}";
+    }
 }
 
 }   // namespace foundation
@@ -473,6 +473,10 @@ class LRUCache
     // Get an element from the cache.
     ElementType& get(const KeyType& key);
 
+    // Get an element from the cache if it is present, without loading it.
+    // Return nullptr if the element is not in the cache.
+    ElementType* find(const KeyType& key);
+
     // Return the size (in bytes) of this object in memory.
     size_t get_memory_size() const;
 
@@ -901,28 +905,10 @@ clear()
 FOUNDATION_LRUCACHE_TEMPLATE_DEF(inline Element&)
 get(const KeyType& key)
 {
-    // Search for this key in the index.
-    typename Index::iterator index_it = m_index.find(key);
-
-    if (index_it != m_index.end())
+    if (Element* element = find(key))
     {
-        // The key was found in the index: cache hit.
-        ++m_hit_count;
-
-        if (m_queue_size > 1)
-        {
-            // Move the element to the front of the queue.
-            m_queue.splice(
-                m_queue.begin(),
-                m_queue,
-                index_it->second);
-
-            // Update the queue iterator in the index.
-            index_it->second = m_queue.begin();
-        }
-
-        // Return the element.
-        return index_it->second->m_element;
+        // Cache hit.
+        return *element;
     }
     else
     {
@@ -968,6 +954,34 @@ get(const KeyType& key)
     }
 }
 
+FOUNDATION_LRUCACHE_TEMPLATE_DEF(inline Element*)
+find(const KeyType& key)
+{
+    // Search for this key in the index.
+    typename Index::iterator index_it = m_index.find(key);
+
+    if (index_it == m_index.end())
+        return nullptr;
+
+    // The key was found in the index: cache hit.
+    ++m_hit_count;
+
+    if (m_queue_size > 1)
+    {
+        // Move the element to the front of the queue.
+        m_queue.splice(
+            m_queue.begin(),
+            m_queue,
+            index_it->second);
+
+        // Update the queue iterator in the index.
+        index_it->second = m_queue.begin();
+    }
+
+    // Return the element.
+    return &index_it->second->m_element;
+}
+
 FOUNDATION_LRUCACHE_TEMPLATE_DEF(inline size_t)
 get_memory_size() const
 {
@@ -1108,6 +1122,7 @@ namespace cache_impl
         std::unique_ptr<Entry> clone() const override;
         void merge(const Entry* other) override;
         std::string to_string() const override;
+        std::string to_json() const override;
     };
 }
 
@@ -62,7 +62,8 @@ class ILazyFactory
     // Destructor.
     virtual ~ILazyFactory() {}
 
-    // Create the object.
+    // Create the object. Return nullptr on failure, in which case
+    // creation will be attempted again on the next access.
     virtual std::unique_ptr<Object> create() = 0;
 };
 
@@ -99,6 +100,12 @@ class Lazy
     // Return the source object associated with that lazy object, if any.
     ObjectType* get_source_object() const;
 
+    // Delete the object if it was created by the factory and is not currently
+    // being accessed. The object will be recreated on the next access. This
+    // method never blocks: it returns false if the lazy object is busy.
+    // Return true if the object was deleted.
+    bool try_release_object();
+
   private:
     template <typename> friend class Access;
 
@@ -141,10 +148,10 @@ class Access
     // if any. Note that releasing access to a lazy object does not
     // imply that the object is deleted, even if the reference count
     // on this object has reached 0. An object is deleted only if it
-    // is garbage-collected.
+    // is garbage-collected (see Lazy::try_release_object()).
     void reset(LazyType* lazy);
 
-    // Get the object pointer.
+    // Get the object pointer. Return nullptr if the object could not be created.
     ObjectType* get() const;
     ObjectType& ref() const;
 
@@ -387,6 +394,23 @@ inline typename Lazy<Object>::ObjectType* Lazy<Object>::get_source_object() cons
     return m_source_object;
 }
 
+template <typename Object>
+bool Lazy<Object>::try_release_object()
+{
+    boost::mutex::scoped_lock lock(m_mutex, boost::try_to_lock);
+
+    if (!lock.owns_lock())
+        return false;
+
+    if (!m_own_object || m_object == nullptr || m_reference_count > 0)
+        return false;
+
+    delete m_object;
+    m_object = nullptr;
+
+    return true;
+}
+
 
 //
 // Access class implementation.
@@ -0,0 +1,300 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2018 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// Interface header.
+#include "profiler.h"
+
+// appleseed.foundation headers.
+#include "foundation/platform/compiler.h"
+
+// Boost headers.
+#include "boost/atomic/atomic.hpp"
+#include "boost/thread/locks.hpp"
+#include "boost/thread/mutex.hpp"
+
+// Standard headers.
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+using namespace std;
+
+namespace foundation
+{
+
+//
+// Profiler class implementation.
+//
+
+namespace
+{
+    struct Event
+    {
+        const char*                     m_name;
+        uint64                          m_begin_time;
+        uint64                          m_end_time;
+    };
+
+    struct ThreadBuffer
+    {
+        size_t                          m_thread_index;
+        vector<Event>                   m_events;
+        boost::atomic<size_t>           m_event_count;
+        boost::atomic<size_t>           m_dropped_event_count;
+
+        explicit ThreadBuffer(const size_t thread_index)
+          : m_thread_index(thread_index)
+          , m_events(Profiler::MaxEventsPerThread)
+          , m_event_count(0)
+          , m_dropped_event_count(0)
+        {
+        }
+    };
+
+    typedef vector<unique_ptr<ThreadBuffer>> ThreadBufferVector;
+
+    // Buffers are never deallocated so that threads can keep pointers to them.
+    // Buffers of exited threads are kept in a free list and reused by new threads.
+    boost::atomic<bool>                 g_enabled(false);
+    boost::mutex                        g_buffers_mutex;
+    ThreadBufferVector                  g_buffers;
+    vector<ThreadBuffer*>               g_free_buffers;
+    boost::atomic<size_t>               g_unbuffered_event_count(0);
+    const chrono::steady_clock::time_point g_origin = chrono::steady_clock::now();
+
+    APPLESEED_TLS ThreadBuffer*         t_buffer = nullptr;
+    APPLESEED_TLS bool                  t_no_buffer = false;
+
+    // Return the buffer of the calling thread to the free list when the thread exits.
+    struct ThreadBufferOwner
+    {
+        ThreadBuffer*                   m_buffer;
+
+        ThreadBufferOwner()
+          : m_buffer(nullptr)
+        {
+        }
+
+        ~ThreadBufferOwner()
+        {
+            if (m_buffer != nullptr)
+            {
+                boost::mutex::scoped_lock lock(g_buffers_mutex);
+                g_free_buffers.push_back(m_buffer);
+            }
+        }
+    };
+
+    // Only touched when a thread acquires its buffer, since accessing it may be slower than t_buffer.
+    thread_local ThreadBufferOwner      t_buffer_owner;
+
+    // Return nullptr if all buffers are taken.
+    ThreadBuffer* get_thread_buffer()
+    {
+        if (t_buffer == nullptr && !t_no_buffer)
+        {
+            boost::mutex::scoped_lock lock(g_buffers_mutex);
+
+            if (!g_free_buffers.empty())
+            {
+                t_buffer = g_free_buffers.back();
+                g_free_buffers.pop_back();
+            }
+            else if (g_buffers.size() < Profiler::MaxThreadBuffers)
+            {
+                g_buffers.emplace_back(new ThreadBuffer(g_buffers.size()));
+                t_buffer = g_buffers.back().get();
+            }
+            else
+            {
+                t_no_buffer = true;
+                return nullptr;
+            }
+
+            t_buffer_owner.m_buffer = t_buffer;
+        }
+
+        return t_buffer;
+    }
+
+    void write_json_string(ofstream& file, const char* s)
+    {
+        file << '"';
+
+        for (; *s; ++s)
+        {
+            if (*s == '"' || *s == '\\')
+                file << '\\';
+            file << *s;
+        }
+
+        file << '"';
+    }
+}
+
+void Profiler::set_enabled(const bool enabled)
+{
+    g_enabled.store(enabled, boost::memory_order_relaxed);
+}
+
+bool Profiler::is_enabled()
+{
+    return g_enabled.load(boost::memory_order_relaxed);
+}
+
+void Profiler::clear()
+{
+    boost::mutex::scoped_lock lock(g_buffers_mutex);
+
+    for (const auto& buffer : g_buffers)
+    {
+        buffer->m_event_count.store(0, boost::memory_order_relaxed);
+        buffer->m_dropped_event_count.store(0, boost::memory_order_relaxed);
+    }
+
+    g_unbuffered_event_count.store(0, boost::memory_order_relaxed);
+}
+
+size_t Profiler::get_event_count()
+{
+    boost::mutex::scoped_lock lock(g_buffers_mutex);
+
+    size_t count = 0;
+
+    for (const auto& buffer : g_buffers)
+        count += buffer->m_event_count.load(boost::memory_order_acquire);
+
+    return count;
+}
+
+size_t Profiler::get_dropped_event_count()
+{
+    boost::mutex::scoped_lock lock(g_buffers_mutex);
+
+    size_t count = g_unbuffered_event_count.load(boost::memory_order_relaxed);
+
+    for (const auto& buffer : g_buffers)
+        count += buffer->m_dropped_event_count.load(boost::memory_order_relaxed);
+
+    return count;
+}
+
+size_t Profiler::get_thread_buffer_count()
+{
+    boost::mutex::scoped_lock lock(g_buffers_mutex);
+
+    return g_buffers.size();
+}
+
+bool Profiler::write_chrome_trace(const char* filepath)
+{
+    ofstream file(filepath);
+
+    if (!file.is_open())
+        return false;
+
+    file << "{\"traceEvents\":[";
+
+    bool first = true;
+
+    boost::mutex::scoped_lock lock(g_buffers_mutex);
+
+    for (const auto& buffer : g_buffers)
+    {
+        const size_t tid = buffer->m_thread_index;
+        const size_t event_count = buffer->m_event_count.load(boost::memory_order_acquire);
+
+        if (event_count == 0)
+            continue;
+
+        file << (first ? "\n" : ",\n");
+        first = false;
+
+        file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tid
+             << ",\"args\":{\"name\":\"thread " << tid << "\"}}";
+
+        for (size_t i = 0; i < event_count; ++i)
+        {
+            const Event& event = buffer->m_events[i];
+
+            file << ",\n{\"name\":";
+            write_json_string(file, event.m_name);
+            file << ",\"cat\":\"appleseed\",\"ph\":\"X\",\"pid\":1,\"tid\":" << tid
+                 << ",\"ts\":" << event.m_begin_time
+                 << ",\"dur\":" << event.m_end_time - event.m_begin_time << '}';
+        }
+    }
+
+    file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    file.close();
+
+    return !file.fail();
+}
+
+uint64 Profiler::read_time()
+{
+    return
+        static_cast<uint64>(
+            chrono::duration_cast<chrono::microseconds>(
+                chrono::steady_clock::now() - g_origin).count());
+}
+
+void Profiler::record(
+    const char*     name,
+    const uint64    begin_time,
+    const uint64    end_time)
+{
+    ThreadBuffer* buffer = get_thread_buffer();
+
+    if (buffer == nullptr)
+    {
+        g_unbuffered_event_count.fetch_add(1, boost::memory_order_relaxed);
+        return;
+    }
+
+    // Only this thread writes to its buffer: a relaxed load is enough.
+    const size_t index = buffer->m_event_count.load(boost::memory_order_relaxed);
+
+    if (index == MaxEventsPerThread)
+    {
+        buffer->m_dropped_event_count.fetch_add(1, boost::memory_order_relaxed);
+        return;
+    }
+
+    Event& event = buffer->m_events[index];
+    event.m_name = name;
+    event.m_begin_time = begin_time;
+    event.m_end_time = end_time;
+
+    // Publish the event to readers.
+    buffer->m_event_count.store(index + 1, boost::memory_order_release);
+}
+
+}   // namespace foundation
@@ -0,0 +1,138 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2018 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef APPLESEED_FOUNDATION_UTILITY_PROFILER_H
+#define APPLESEED_FOUNDATION_UTILITY_PROFILER_H
+
+// appleseed.foundation headers.
+#include "foundation/core/concepts/noncopyable.h"
+#include "foundation/platform/types.h"
+
+// appleseed.main headers.
+#include "main/dllsymbol.h"
+
+// Standard headers.
+#include <cstddef>
+
+namespace foundation
+{
+
+//
+// A lightweight tracing profiler.
+//
+// Profile zones record their begin and end times into per-thread event buffers.
+// Recording is lock-free: each thread only ever appends to its own buffer, which
+// is assigned the first time the thread records an event. When a thread exits,
+// its buffer and the events it holds are handed over to the next new thread, so
+// the number of buffers is bounded by the number of simultaneously live threads.
+// Recording is disabled by default, in which case a zone costs a single check.
+//
+// Recorded events can be exported in the Chrome trace event format, which can be
+// loaded in chrome://tracing or in Perfetto.
+//
+
+class APPLESEED_DLLSYMBOL Profiler
+  : public NonCopyable
+{
+  public:
+    // Maximum number of events recorded per thread; further events are dropped.
+    static const size_t MaxEventsPerThread = 64 * 1024;
+
+    // Maximum number of thread buffers; events of threads without a buffer are dropped.
+    static const size_t MaxThreadBuffers = 256;
+
+    // Enable or disable recording.
+    static void set_enabled(const bool enabled);
+    static bool is_enabled();
+
+    // Discard all recorded events. No zone must be recorded concurrently.
+    static void clear();
+
+    // Return the number of recorded events.
+    static size_t get_event_count();
+
+    // Return the number of events dropped because a thread buffer was full or not available.
+    static size_t get_dropped_event_count();
+
+    // Return the number of allocated thread buffers.
+    static size_t get_thread_buffer_count();
+
+    // Write all recorded events to a Chrome trace file.
+    // Returns true on success, false otherwise.
+    static bool write_chrome_trace(const char* filepath);
+
+    // Return the current time in microseconds.
+    static uint64 read_time();
+
+    // Record a complete event. `name` must outlive the profiler.
+    static void record(
+        const char*     name,
+        const uint64    begin_time,
+        const uint64    end_time);
+};
+
+
+//
+// Record the lifetime of a scope as a profiler event.
+//
+
+class ProfileZone
+  : public NonCopyable
+{
+  public:
+    // Constructor. `name` must outlive the profiler, typically a string literal.
+    explicit ProfileZone(const char* name);
+
+    // Destructor.
+    ~ProfileZone();
+
+  private:
+    const char*     m_name;
+    uint64          m_begin_time;
+};
+
+
+//
+// ProfileZone class implementation.
+//
+
+inline ProfileZone::ProfileZone(const char* name)
+  : m_name(Profiler::is_enabled() ? name : nullptr)
+  , m_begin_time(m_name ? Profiler::read_time() : 0)
+{
+}
+
+inline ProfileZone::~ProfileZone()
+{
+    if (m_name)
+        Profiler::record(m_name, m_begin_time, Profiler::read_time());
+}
+
+}       // namespace foundation
+
+#endif  // !APPLESEED_FOUNDATION_UTILITY_PROFILER_H
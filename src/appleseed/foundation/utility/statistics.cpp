@@ -31,13 +31,72 @@
 #include "statistics.h"
 
 // appleseed.foundation headers.
+#include "foundation/platform/snprintf.h"
 #include "foundation/utility/foreach.h"
 
+// Standard headers.
+#include <cmath>
+#include <cstdlib>
+
 using namespace std;
 
 namespace foundation
 {
 
+//
+// Helpers for the JSON export of statistics.
+//
+
+namespace statistics_impl
+{
+    string to_json_string(const string& s)
+    {
+        string result;
+        result.reserve(s.size() + 2);
+        result += '"';
+
+        for (const char c : s)
+        {
+            switch (c)
+            {
+              case '"': result += "\\\""; break;
+              case '\\': result += "\\\\"; break;
+              case '\n': result += "\\n"; break;
+              case '\r': result += "\\r"; break;
+              case '\t': result += "\\t"; break;
+
+              default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    char buf[8];
+                    portable_snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned int>(c));
+                    result += buf;
+                }
+                else result += c;
+                break;
+            }
+        }
+
+        result += '"';
+        return result;
+    }
+
+    string to_json_number(const double value)
+    {
+        if (!isfinite(value))
+            return "null";
+
+        // Prefer 15 significant digits, use 17 if needed to round-trip.
+        char buf[32];
+        portable_snprintf(buf, sizeof(buf), "%.15g", value);
+        if (strtod(buf, nullptr) != value)
+            portable_snprintf(buf, sizeof(buf), "%.17g", value);
+
+        return buf;
+    }
+}
+
+
 //
 // Statistics class implementation.
 //
@@ -121,6 +180,27 @@ string Statistics::to_string(const size_t max_header_length) const
     return sstr.str();
 }
 
+string Statistics::to_json() const
+{
+    string result = "{";
+
+    for (const_each<EntryVector> i = m_entries; i; ++i)
+    {
+        const Entry* entry = *i;
+
+        if (i.it() > m_entries.begin())
+            result += ',';
+
+        result += statistics_impl::to_json_string(entry->m_name);
+        result += ':';
+        result += entry->to_json();
+    }
+
+    result += '}';
+
+    return result;
+}
+
 
 //
 // Statistics::ExceptionDuplicateName class implementation.
@@ -159,6 +239,11 @@ Statistics::Entry::Entry(
 {
 }
 
+string Statistics::Entry::to_json() const
+{
+    return statistics_impl::to_json_string(to_string());
+}
+
 
 //
 // Statistics::IntegerEntry class implementation.
@@ -188,6 +273,11 @@ string Statistics::IntegerEntry::to_string() const
     return pretty_int(m_value);
 }
 
+string Statistics::IntegerEntry::to_json() const
+{
+    return std::to_string(m_value);
+}
+
 
 //
 // Statistics::UnsignedIntegerEntry class implementation.
@@ -217,6 +307,11 @@ string Statistics::UnsignedIntegerEntry::to_string() const
     return pretty_uint(m_value);
 }
 
+string Statistics::UnsignedIntegerEntry::to_json() const
+{
+    return std::to_string(m_value);
+}
+
 
 //
 // Statistics::FloatingPointEntry class implementation.
@@ -246,6 +341,81 @@ string Statistics::FloatingPointEntry::to_string() const
     return pretty_scalar(m_value);
 }
 
+string Statistics::FloatingPointEntry::to_json() const
+{
+    return statistics_impl::to_json_number(m_value);
+}
+
+
+//
+// Statistics::SizeEntry class implementation.
+//
+
+Statistics::SizeEntry::SizeEntry(
+    const string&               name,
+    const uint64                bytes,
+    const streamsize            precision)
+  : Entry(name, "bytes")
+  , m_bytes(bytes)
+  , m_precision(precision)
+{
+}
+
+unique_ptr<Statistics::Entry> Statistics::SizeEntry::clone() const
+{
+    return unique_ptr<Entry>(new SizeEntry(*this));
+}
+
+void Statistics::SizeEntry::merge(const Entry* other)
+{
+    // Like the formatted strings they replace, size statistics are not merged.
+}
+
+string Statistics::SizeEntry::to_string() const
+{
+    return pretty_size(m_bytes, m_precision);
+}
+
+string Statistics::SizeEntry::to_json() const
+{
+    return std::to_string(m_bytes);
+}
+
+
+//
+// Statistics::TimeEntry class implementation.
+//
+
+Statistics::TimeEntry::TimeEntry(
+    const string&               name,
+    const double                seconds,
+    const streamsize            precision)
+  : Entry(name, "seconds")
+  , m_seconds(seconds)
+  , m_precision(precision)
+{
+}
+
+unique_ptr<Statistics::Entry> Statistics::TimeEntry::clone() const
+{
+    return unique_ptr<Entry>(new TimeEntry(*this));
+}
+
+void Statistics::TimeEntry::merge(const Entry* other)
+{
+    // Like the formatted strings they replace, time statistics are not merged.
+}
+
+string Statistics::TimeEntry::to_string() const
+{
+    return pretty_time(m_seconds, m_precision);
+}
+
+string Statistics::TimeEntry::to_json() const
+{
+    return statistics_impl::to_json_number(m_seconds);
+}
+
 
 //
 // Statistics::StringEntry class implementation.
@@ -275,6 +445,11 @@ string Statistics::StringEntry::to_string() const
     return m_value;
 }
 
+string Statistics::StringEntry::to_json() const
+{
+    return statistics_impl::to_json_string(m_value);
+}
+
 
 //
 // StatisticsVector class implementation.
@@ -299,6 +474,11 @@ void StatisticsVector::insert(
     m_stats.push_back(named_stats);
 }
 
+void StatisticsVector::insert(const StatisticsVector& other)
+{
+    m_stats.insert(m_stats.end(), other.m_stats.begin(), other.m_stats.end());
+}
+
 void StatisticsVector::merge(const StatisticsVector& other)
 {
     for (const_each<NamedStatisticsVector> i = other.m_stats; i; ++i)
@@ -335,4 +515,25 @@ string StatisticsVector::to_string(const size_t max_header_length) const
     return sstr.str();
 }
 
+string StatisticsVector::to_json() const
+{
+    string result = "[";
+
+    for (const_each<NamedStatisticsVector> i = m_stats; i; ++i)
+    {
+        if (i.it() > m_stats.begin())
+            result += ',';
+
+        result += "\n{\"name\":";
+        result += statistics_impl::to_json_string(i->m_name);
+        result += ",\"statistics\":";
+        result += i->m_stats.to_json();
+        result += '}';
+    }
+
+    result += "\n]";
+
+    return result;
+}
+
 }   // namespace foundation
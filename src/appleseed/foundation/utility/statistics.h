@@ -89,6 +89,10 @@ class Statistics
         virtual std::unique_ptr<Entry> clone() const = 0;
         virtual void merge(const Entry* other) = 0;
         virtual std::string to_string() const = 0;
+
+        // Return the value of this entry as a JSON value.
+        // The default implementation returns to_string() as a JSON string.
+        virtual std::string to_json() const;
     };
 
     struct IntegerEntry
@@ -104,6 +108,7 @@ class Statistics
         std::unique_ptr<Entry> clone() const override;
         void merge(const Entry* other) override;
         std::string to_string() const override;
+        std::string to_json() const override;
     };
 
     struct UnsignedIntegerEntry
@@ -119,6 +124,7 @@ class Statistics
         std::unique_ptr<Entry> clone() const override;
         void merge(const Entry* other) override;
         std::string to_string() const override;
+        std::string to_json() const override;
     };
 
     struct FloatingPointEntry
@@ -134,6 +140,41 @@ class Statistics
         std::unique_ptr<Entry> clone() const override;
         void merge(const Entry* other) override;
         std::string to_string() const override;
+        std::string to_json() const override;
+    };
+
+    struct SizeEntry
+      : public Entry
+    {
+        uint64              m_bytes;
+        std::streamsize     m_precision;
+
+        SizeEntry(
+            const std::string&          name,
+            const uint64                bytes,
+            const std::streamsize       precision);
+
+        std::unique_ptr<Entry> clone() const override;
+        void merge(const Entry* other) override;
+        std::string to_string() const override;
+        std::string to_json() const override;
+    };
+
+    struct TimeEntry
+      : public Entry
+    {
+        double              m_seconds;
+        std::streamsize     m_precision;
+
+        TimeEntry(
+            const std::string&          name,
+            const double                seconds,
+            const std::streamsize       precision);
+
+        std::unique_ptr<Entry> clone() const override;
+        void merge(const Entry* other) override;
+        std::string to_string() const override;
+        std::string to_json() const override;
     };
 
     template <typename T>
@@ -153,6 +194,7 @@ class Statistics
         std::unique_ptr<Entry> clone() const override;
         void merge(const Entry* other) override;
         std::string to_string() const override;
+        std::string to_json() const override;
     };
 
     struct StringEntry
@@ -168,6 +210,7 @@ class Statistics
         std::unique_ptr<Entry> clone() const override;
         void merge(const Entry* other) override;
         std::string to_string() const override;
+        std::string to_json() const override;
     };
 
     template <typename T>
@@ -186,6 +229,7 @@ class Statistics
         std::unique_ptr<Entry> clone() const override;
         void merge(const Entry* other) override;
         std::string to_string() const override;
+        std::string to_json() const override;
     };
 
     Statistics();
@@ -247,6 +291,9 @@ class Statistics
 
     std::string to_string(const size_t max_header_length = 30) const;
 
+    // Return the statistics as a JSON object, one member per entry.
+    std::string to_json() const;
+
   private:
     typedef std::vector<Entry*> EntryVector;
     typedef std::map<std::string, Entry*> EntryIndex;
@@ -274,10 +321,15 @@ class StatisticsVector
         const std::string&              name,
         const Statistics&               stats);
 
+    void insert(const StatisticsVector& other);
+
     void merge(const StatisticsVector& other);
 
     std::string to_string(const size_t max_header_length = 30) const;
 
+    // Return the statistics as a JSON array of {"name", "statistics"} objects.
+    std::string to_json() const;
+
   private:
     struct NamedStatistics
     {
@@ -410,7 +462,9 @@ inline void Statistics::insert_size(
     const uint64                        bytes,
     const std::streamsize               precision)
 {
-    insert(name, pretty_size(bytes, precision));
+    insert(
+        std::unique_ptr<SizeEntry>(
+            new SizeEntry(name, bytes, precision)));
 }
 
 inline void Statistics::insert_time(
@@ -418,7 +472,9 @@ inline void Statistics::insert_time(
     const double                        seconds,
     const std::streamsize               precision)
 {
-    insert(name, pretty_time(seconds, precision));
+    insert(
+        std::unique_ptr<TimeEntry>(
+            new TimeEntry(name, seconds, precision)));
 }
 
 template <typename T>
@@ -434,6 +490,20 @@ void Statistics::insert_percent(
 }
 
 
+//
+// Helpers for the JSON export of statistics.
+//
+
+namespace statistics_impl
+{
+    // Return a string as a quoted and escaped JSON string.
+    std::string to_json_string(const std::string& s);
+
+    // Return a number as a JSON number, or null if it is not finite.
+    std::string to_json_number(const double value);
+}
+
+
 //
 // Statistics::Entry class implementation.
 //
@@ -491,6 +561,18 @@ std::string Statistics::PercentEntry<T>::to_string() const
     return pretty_percent(m_numerator, m_denominator, m_precision);
 }
 
+template <typename T>
+std::string Statistics::PercentEntry<T>::to_json() const
+{
+    std::string result;
+    result += "{\"numerator\":";
+    result += statistics_impl::to_json_number(static_cast<double>(m_numerator));
+    result += ",\"denominator\":";
+    result += statistics_impl::to_json_number(static_cast<double>(m_denominator));
+    result += '}';
+    return result;
+}
+
 
 //
 // Statistics::PopulationEntry class implementation.
@@ -535,6 +617,32 @@ std::string Statistics::PopulationEntry<T>::to_string() const
     return sstr.str();
 }
 
+template <typename T>
+std::string Statistics::PopulationEntry<T>::to_json() const
+{
+    std::string result;
+    result += "{\"count\":";
+    result += std::to_string(static_cast<uint64>(m_value.get_size()));
+    result += ",\"avg\":";
+    result += statistics_impl::to_json_number(m_value.get_mean());
+    result += ",\"min\":";
+    result += statistics_impl::to_json_number(static_cast<double>(m_value.get_min()));
+    result += ",\"max\":";
+    result += statistics_impl::to_json_number(static_cast<double>(m_value.get_max()));
+    result += ",\"dev\":";
+    result += statistics_impl::to_json_number(m_value.get_dev());
+
+    const std::string unit = trim_both(m_unit);
+    if (!unit.empty())
+    {
+        result += ",\"unit\":";
+        result += statistics_impl::to_json_string(unit);
+    }
+
+    result += '}';
+    return result;
+}
+
 }       // namespace foundation
 
 #endif  // !APPLESEED_FOUNDATION_UTILITY_STATISTICS_H
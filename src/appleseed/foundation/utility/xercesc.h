@@ -46,8 +46,11 @@
 // Standard headers.
 #include <cassert>
 #include <cstddef>
+#include <iomanip>
+#include <limits>
 #include <map>
 #include <memory>
+#include <sstream>
 #include <stack>
 #include <string>
 
@@ -142,6 +145,12 @@ class IElementHandler
         const XMLCh* const          chars,
         const XMLSize_t             length) = 0;
 
+    // Receive notification of pre-parsed numeric data inside an element.
+    // This is only emitted when reading binary XML documents.
+    virtual void numeric_characters(
+        const double*               values,
+        const size_t                count) = 0;
+
     // Receive notification of the start of a child element.
     virtual void start_child_element(
         const ElementID             element,
@@ -177,6 +186,13 @@ class ElementHandlerBase
         const XMLCh* const          chars,
         const XMLSize_t             length) override;
 
+    // Receive notification of pre-parsed numeric data inside an element.
+    // The default implementation converts the values back to text and
+    // forwards them to characters().
+    void numeric_characters(
+        const double*               values,
+        const size_t                count) override;
+
     // Receive notification of the start of a child element.
     void start_child_element(
         const ElementID             element,
@@ -256,6 +272,17 @@ class SAX2ContentHandler
         const XMLCh* const                          chars,
         const XMLSize_t                             length) override;
 
+    // Variants of the methods above that bypass name transcoding,
+    // used when replaying binary XML documents.
+    void start_element(
+        const std::string&                          name,
+        const xercesc::Attributes&                  attrs);
+    void end_element(
+        const std::string&                          name);
+    void numeric_characters(
+        const double*                               values,
+        const size_t                                count);
+
   private:
     typedef IElementHandler<ElementID> ElementHandlerType;
 
@@ -369,6 +396,26 @@ void ElementHandlerBase<ElementID>::characters(
 {
 }
 
+template <typename ElementID>
+void ElementHandlerBase<ElementID>::numeric_characters(
+    const double*               values,
+    const size_t                count)
+{
+    // Use enough digits for the values to be parsed back exactly.
+    std::stringstream sstr;
+    sstr << std::setprecision(std::numeric_limits<double>::max_digits10);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (i > 0)
+            sstr << ' ';
+        sstr << values[i];
+    }
+
+    const std::basic_string<XMLCh> chars = transcode(sstr.str());
+    characters(chars.c_str(), chars.size());
+}
+
 template <typename ElementID>
 void ElementHandlerBase<ElementID>::start_child_element(
     const ElementID             element,
@@ -439,8 +486,34 @@ void SAX2ContentHandler<ElementID>::startElement(
     const XMLCh* const                          qname,
     const xercesc::Attributes&                  attrs)
 {
-    const typename FactoryInfoMap::const_iterator it =
-        m_factory_info.find(transcode(localname));
+    start_element(transcode(localname), attrs);
+}
+
+template <typename ElementID>
+void SAX2ContentHandler<ElementID>::endElement(
+    const XMLCh* const                          uri,
+    const XMLCh* const                          localname,
+    const XMLCh* const                          qname)
+{
+    end_element(transcode(localname));
+}
+
+template <typename ElementID>
+void SAX2ContentHandler<ElementID>::characters(
+    const XMLCh* const                          chars,
+    const XMLSize_t                             length)
+{
+    assert(!m_handler_stack.empty());
+
+    m_handler_stack.top()->characters(chars, length);
+}
+
+template <typename ElementID>
+void SAX2ContentHandler<ElementID>::start_element(
+    const std::string&                          name,
+    const xercesc::Attributes&                  attrs)
+{
+    const typename FactoryInfoMap::const_iterator it = m_factory_info.find(name);
 
     ElementHandlerType* handler;
 
@@ -461,10 +534,8 @@ void SAX2ContentHandler<ElementID>::startElement(
 }
 
 template <typename ElementID>
-void SAX2ContentHandler<ElementID>::endElement(
-    const XMLCh* const                          uri,
-    const XMLCh* const                          localname,
-    const XMLCh* const                          qname)
+void SAX2ContentHandler<ElementID>::end_element(
+    const std::string&                          name)
 {
     ElementHandlerType* handler = m_handler_stack.top();
 
@@ -472,8 +543,7 @@ void SAX2ContentHandler<ElementID>::endElement(
 
     m_handler_stack.pop();
 
-    const typename FactoryInfoMap::const_iterator it =
-        m_factory_info.find(transcode(localname));
+    const typename FactoryInfoMap::const_iterator it = m_factory_info.find(name);
 
     if (it != m_factory_info.end())
         m_handler_stack.top()->end_child_element(it->second.m_id, handler);
@@ -482,13 +552,13 @@ void SAX2ContentHandler<ElementID>::endElement(
 }
 
 template <typename ElementID>
-void SAX2ContentHandler<ElementID>::characters(
-    const XMLCh* const                          chars,
-    const XMLSize_t                             length)
+void SAX2ContentHandler<ElementID>::numeric_characters(
+    const double*                               values,
+    const size_t                                count)
 {
     assert(!m_handler_stack.empty());
 
-    m_handler_stack.top()->characters(chars, length);
+    m_handler_stack.top()->numeric_characters(values, count);
 }
 
 }       // namespace foundation
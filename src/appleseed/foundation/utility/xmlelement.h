@@ -47,6 +47,81 @@
 namespace foundation
 {
 
+//
+// Interface of a receiver of the structure of an XML document, used to write
+// a document as a sequence of events rather than as formatted text.
+//
+
+class IXMLContentHandler
+{
+  public:
+    typedef std::pair<std::string, std::string> Attribute;
+    typedef std::vector<Attribute> AttributeVector;
+
+    // Destructor.
+    virtual ~IXMLContentHandler() {}
+
+    // Receive notification of the start of an element. Attribute values are not escaped.
+    virtual void start_element(
+        const std::string&      name,
+        const AttributeVector&  attributes) = 0;
+
+    // Receive notification of the end of an element.
+    virtual void end_element(const std::string& name) = 0;
+
+    // Receive notification of character data inside an element.
+    virtual void characters(const std::string& text) = 0;
+};
+
+
+//
+// The destination of an XML document: either a file to which formatted XML
+// is written, or a content handler receiving the structure of the document.
+//
+
+class XMLOutput
+{
+  public:
+    enum ContentType
+    {
+        HasNoContent,
+        HasChildElements,
+        HasChildText
+    };
+
+    // Write formatted XML to a file.
+    XMLOutput(
+        std::FILE*              file,
+        Indenter&               indenter);
+
+    // Send the structure of the document to a content handler.
+    explicit XMLOutput(IXMLContentHandler& handler);
+
+    // Return the indentation of the current line, or an empty string
+    // if the document is sent to a content handler.
+    const char* get_indentation() const;
+
+    // Open an element.
+    void start_element(
+        const std::string&                          name,
+        const IXMLContentHandler::AttributeVector&  attributes,
+        const ContentType                           content_type) const;
+
+    // Close an element previously opened with HasChildElements or HasChildText.
+    void end_element(
+        const std::string&                          name,
+        const ContentType                           content_type) const;
+
+    // Write character data. The text is written verbatim.
+    void characters(const std::string& text) const;
+
+  private:
+    std::FILE*              m_file;
+    Indenter*               m_indenter;
+    IXMLContentHandler*     m_handler;
+};
+
+
 //
 // A class representing a XML element.
 //
@@ -59,6 +134,9 @@ class XMLElement
         const std::string&  name,
         std::FILE*          file,
         Indenter&           indenter);
+    XMLElement(
+        const std::string&  name,
+        const XMLOutput&    output);
 
     // Destructor, closes the element.
     ~XMLElement();
@@ -71,9 +149,9 @@ class XMLElement
 
     enum ContentType
     {
-        HasNoContent,
-        HasChildElements,
-        HasChildText
+        HasNoContent        = XMLOutput::HasNoContent,
+        HasChildElements    = XMLOutput::HasChildElements,
+        HasChildText        = XMLOutput::HasChildText
     };
 
     // Write the element.
@@ -83,12 +161,10 @@ class XMLElement
     void close();
 
   private:
-    typedef std::pair<std::string, std::string> Attribute;
-    typedef std::vector<Attribute> AttributeVector;
+    typedef IXMLContentHandler::AttributeVector AttributeVector;
 
     const std::string       m_name;
-    std::FILE*              m_file;
-    Indenter&               m_indenter;
+    const XMLOutput         m_output;
     AttributeVector         m_attributes;
     bool                    m_is_open;
     ContentType             m_content_type;
@@ -119,48 +195,56 @@ void write_dictionary(
     const Dictionary&       dictionary,
     std::FILE*              file,
     Indenter&               indenter);
+void write_dictionary(
+    const Dictionary&       dictionary,
+    const XMLOutput&        output);
 
 
 //
 // Implementation.
 //
 
-inline XMLElement::XMLElement(
-    const std::string&      name,
+inline XMLOutput::XMLOutput(
     std::FILE*              file,
     Indenter&               indenter)
-  : m_name(name)
-  , m_file(file)
-  , m_indenter(indenter)
-  , m_is_open(false)
-  , m_content_type(HasNoContent)
+  : m_file(file)
+  , m_indenter(&indenter)
+  , m_handler(nullptr)
 {
 }
 
-inline XMLElement::~XMLElement()
+inline XMLOutput::XMLOutput(IXMLContentHandler& handler)
+  : m_file(nullptr)
+  , m_indenter(nullptr)
+  , m_handler(&handler)
 {
-    close();
 }
 
-template <typename T>
-void XMLElement::add_attribute(
-    const std::string&      name,
-    const T&                value)
+inline const char* XMLOutput::get_indentation() const
 {
-    assert(!m_is_open);
-
-    m_attributes.push_back(std::make_pair(name, to_string(value)));
+    return m_handler ? "" : m_indenter->c_str();
 }
 
-inline void XMLElement::write(const ContentType content_type)
+inline void XMLOutput::start_element(
+    const std::string&                              name,
+    const IXMLContentHandler::AttributeVector&      attributes,
+    const ContentType                               content_type) const
 {
-    assert(!m_is_open);
+    if (m_handler)
+    {
+        m_handler->start_element(name, attributes);
+
+        if (content_type == HasNoContent)
+            m_handler->end_element(name);
+
+        return;
+    }
 
     // Open the tag.
-    std::fprintf(m_file, "%s<%s", m_indenter.c_str(), m_name.c_str());
+    std::fprintf(m_file, "%s<%s", m_indenter->c_str(), name.c_str());
 
     // Emit the attributes.
-    for (const_each<AttributeVector> i = m_attributes; i; ++i)
+    for (const_each<IXMLContentHandler::AttributeVector> i = attributes; i; ++i)
     {
         const std::string attribute_value = replace_special_xml_characters(i->second);
         std::fprintf(m_file, " %s=\"%s\"", i->first.c_str(), attribute_value.c_str());
@@ -175,16 +259,95 @@ inline void XMLElement::write(const ContentType content_type)
 
       case HasChildElements:
         std::fprintf(m_file, ">\n");
-        ++m_indenter;
-        m_is_open = true;
+        ++*m_indenter;
         break;
 
       case HasChildText:
         std::fprintf(m_file, ">");
-        m_is_open = true;
         break;
     }
+}
+
+inline void XMLOutput::end_element(
+    const std::string&                              name,
+    const ContentType                               content_type) const
+{
+    if (m_handler)
+    {
+        m_handler->end_element(name);
+        return;
+    }
+
+    switch (content_type)
+    {
+      case HasNoContent:
+        APPLESEED_UNREACHABLE;
+        break;
+
+      case HasChildElements:
+        --*m_indenter;
+        std::fprintf(m_file, "%s</%s>\n", m_indenter->c_str(), name.c_str());
+        break;
+
+      case HasChildText:
+        std::fprintf(m_file, "</%s>\n", name.c_str());
+        break;
+    }
+}
+
+inline void XMLOutput::characters(const std::string& text) const
+{
+    if (m_handler)
+        m_handler->characters(text);
+    else std::fprintf(m_file, "%s", text.c_str());
+}
+
+inline XMLElement::XMLElement(
+    const std::string&      name,
+    std::FILE*              file,
+    Indenter&               indenter)
+  : m_name(name)
+  , m_output(file, indenter)
+  , m_is_open(false)
+  , m_content_type(HasNoContent)
+{
+}
+
+inline XMLElement::XMLElement(
+    const std::string&      name,
+    const XMLOutput&        output)
+  : m_name(name)
+  , m_output(output)
+  , m_is_open(false)
+  , m_content_type(HasNoContent)
+{
+}
 
+inline XMLElement::~XMLElement()
+{
+    close();
+}
+
+template <typename T>
+void XMLElement::add_attribute(
+    const std::string&      name,
+    const T&                value)
+{
+    assert(!m_is_open);
+
+    m_attributes.push_back(std::make_pair(name, to_string(value)));
+}
+
+inline void XMLElement::write(const ContentType content_type)
+{
+    assert(!m_is_open);
+
+    m_output.start_element(
+        m_name,
+        m_attributes,
+        static_cast<XMLOutput::ContentType>(content_type));
+
+    m_is_open = content_type != HasNoContent;
     m_content_type = content_type;
 }
 
@@ -193,21 +356,9 @@ inline void XMLElement::close()
     if (m_is_open)
     {
         // Close the element.
-        switch (m_content_type)
-        {
-          case HasNoContent:
-            APPLESEED_UNREACHABLE;
-            break;
-
-          case HasChildElements:
-            --m_indenter;
-            std::fprintf(m_file, "%s</%s>\n", m_indenter.c_str(), m_name.c_str());
-            break;
-
-          case HasChildText:
-            std::fprintf(m_file, "</%s>\n", m_name.c_str());
-            break;
-        }
+        m_output.end_element(
+            m_name,
+            static_cast<XMLOutput::ContentType>(m_content_type));
 
         m_is_open = false;
     }
@@ -217,10 +368,17 @@ inline void write_dictionary(
     const Dictionary&       dictionary,
     std::FILE*              file,
     Indenter&               indenter)
+{
+    write_dictionary(dictionary, XMLOutput(file, indenter));
+}
+
+inline void write_dictionary(
+    const Dictionary&       dictionary,
+    const XMLOutput&        output)
 {
     for (const_each<StringDictionary> i = dictionary.strings(); i; ++i)
     {
-        XMLElement element("parameter", file, indenter);
+        XMLElement element("parameter", output);
         element.add_attribute("name", i->key());
 
         const std::string value = i->value<std::string>();
@@ -228,7 +386,7 @@ inline void write_dictionary(
         if (value.find('\n') != std::string::npos)
         {
             element.write(XMLElement::HasChildText);
-            std::fprintf(file, "%s", value.c_str());
+            output.characters(value);
         }
         else
         {
@@ -239,10 +397,10 @@ inline void write_dictionary(
 
     for (const_each<DictionaryDictionary> i = dictionary.dictionaries(); i; ++i)
     {
-        XMLElement element("parameters", file, indenter);
+        XMLElement element("parameters", output);
         element.add_attribute("name", i->key());
         element.write(XMLElement::HasChildElements);
-        write_dictionary(i->value(), file, indenter);
+        write_dictionary(i->value(), output);
     }
 }
 
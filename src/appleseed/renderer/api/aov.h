@@ -43,6 +43,7 @@
 #include "renderer/modeling/aov/glossyaov.h"
 #include "renderer/modeling/aov/iaovfactory.h"
 #include "renderer/modeling/aov/normalaov.h"
+#include "renderer/modeling/aov/pixelcostaov.h"
 #include "renderer/modeling/aov/pixeltimeaov.h"
 #include "renderer/modeling/aov/positionaov.h"
 #include "renderer/modeling/aov/uvaov.h"
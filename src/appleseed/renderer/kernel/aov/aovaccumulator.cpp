@@ -30,6 +30,7 @@
 #include "aovaccumulator.h"
 
 // appleseed.renderer headers.
+#include "renderer/kernel/aov/aovcomponents.h"
 #include "renderer/kernel/shading/shadingcomponents.h"
 #include "renderer/kernel/shading/shadingpoint.h"
 #include "renderer/kernel/shading/shadingresult.h"
@@ -142,6 +143,68 @@ void UnfilteredAOVAccumulator::on_tile_begin(
 }
 
 
+//
+// ComponentAOVAccumulator class implementation.
+//
+
+ComponentAOVAccumulator::ComponentAOVAccumulator(
+    const size_t                index,
+    const uint32                components)
+  : m_index(index)
+  , m_components(components)
+{
+}
+
+void ComponentAOVAccumulator::convert_components(
+    const uint32                components,
+    const ShadingComponents&    shading_components,
+    const AOVComponents&        aov_components,
+    Color3f                     rgb[ComponentCount])
+{
+    const Spectrum* spectra[ComponentCount] =
+    {
+        &shading_components.m_diffuse,
+        &shading_components.m_glossy,
+        &shading_components.m_volume,
+        &shading_components.m_emission,
+        &shading_components.m_indirect_diffuse,
+        &shading_components.m_indirect_glossy,
+        &shading_components.m_indirect_volume,
+        &aov_components.m_albedo
+    };
+
+    for (size_t i = 0; i < ComponentCount; ++i)
+    {
+        rgb[i] =
+            (components & (1UL << i)) != 0
+                ? spectra[i]->to_rgb(g_std_lighting_conditions)
+                : Color3f(0.0f);
+    }
+}
+
+void ComponentAOVAccumulator::write(
+    const PixelContext&         pixel_context,
+    const ShadingPoint&         shading_point,
+    const ShadingComponents&    shading_components,
+    const AOVComponents&        aov_components,
+    ShadingResult&              shading_result)
+{
+    Color3f rgb[ComponentCount];
+    convert_components(m_components, shading_components, aov_components, rgb);
+
+    Color3f sum(0.0f);
+
+    for (size_t i = 0; i < ComponentCount; ++i)
+    {
+        if ((m_components & (1UL << i)) != 0)
+            sum += rgb[i];
+    }
+
+    shading_result.m_aovs[m_index].rgb() = sum;
+    shading_result.m_aovs[m_index].a = shading_result.m_main.a;
+}
+
+
 //
 // AOVAccumulatorContainer class implementation.
 //
@@ -170,38 +233,23 @@ AOVAccumulatorContainer::AOVAccumulatorContainer(const Frame& frame)
     }
 }
 
-namespace
-{
-    class BeautyAOVAccumulator
-      : public AOVAccumulator
-    {
-      public:
-        void write(
-            const PixelContext&         pixel_context,
-            const ShadingPoint&         shading_point,
-            const ShadingComponents&    shading_components,
-            const AOVComponents&        aov_components,
-            ShadingResult&              shading_result) override
-        {
-            shading_result.m_main.rgb() =
-                shading_components.m_beauty.to_rgb(g_std_lighting_conditions);
-        }
-    };
-}
-
 void AOVAccumulatorContainer::init()
 {
     m_size = 0;
     memset(m_accumulators, 0, MaxAovAccumulators * sizeof(AOVAccumulator*));
 
-    // Create beauty accumulator.
-    insert(auto_release_ptr<AOVAccumulator>(new BeautyAOVAccumulator()));
+    m_component_aov_count = 0;
+    m_component_mask = 0;
+    memset(m_component_accumulators, 0, MaxAovAccumulators * sizeof(ComponentAOVAccumulator*));
 }
 
 AOVAccumulatorContainer::~AOVAccumulatorContainer()
 {
     for (size_t i = 0, e = m_size; i < e; ++i)
         delete m_accumulators[i];
+
+    for (size_t i = 0, e = m_component_aov_count; i < e; ++i)
+        delete m_component_accumulators[i];
 }
 
 void AOVAccumulatorContainer::on_tile_begin(
@@ -258,6 +306,13 @@ void AOVAccumulatorContainer::write(
     const AOVComponents&        aov_components,
     ShadingResult&              shading_result)
 {
+    // Beauty.
+    shading_result.m_main.rgb() =
+        shading_components.m_beauty.to_rgb(g_std_lighting_conditions);
+
+    if (m_component_aov_count > 0)
+        write_component_aovs(shading_components, aov_components, shading_result);
+
     for (size_t i = 0, e = m_size; i < e; ++i)
     {
         m_accumulators[i]->write(
@@ -269,14 +324,65 @@ void AOVAccumulatorContainer::write(
     }
 }
 
+void AOVAccumulatorContainer::write_component_aovs(
+    const ShadingComponents&    shading_components,
+    const AOVComponents&        aov_components,
+    ShadingResult&              shading_result) const
+{
+    // Convert every shading component used by at least one AOV to RGB, once.
+    Color3f rgb[ComponentAOVAccumulator::ComponentCount];
+    ComponentAOVAccumulator::convert_components(
+        m_component_mask,
+        shading_components,
+        aov_components,
+        rgb);
+
+    const float alpha = shading_result.m_main.a;
+
+    for (size_t i = 0, e = m_component_aov_count; i < e; ++i)
+    {
+        const uint32 components = m_component_aov_masks[i];
+
+        Color3f sum(0.0f);
+
+        for (size_t j = 0; j < ComponentAOVAccumulator::ComponentCount; ++j)
+        {
+            if ((components & (1UL << j)) != 0)
+                sum += rgb[j];
+        }
+
+        Color4f& aov = shading_result.m_aovs[m_component_aov_indices[i]];
+        aov.rgb() = sum;
+        aov.a = alpha;
+    }
+}
+
 bool AOVAccumulatorContainer::insert(auto_release_ptr<AOVAccumulator> aov_accum)
 {
     assert(aov_accum.get());
 
-    if (m_size == MaxAovAccumulators - 1)
+    if (m_size + m_component_aov_count == MaxAovAccumulators)
         return false;
 
-    m_accumulators[m_size++] = aov_accum.release();
+    ComponentAOVAccumulator* component_accum =
+        dynamic_cast<ComponentAOVAccumulator*>(aov_accum.get());
+
+    if (component_accum)
+    {
+        // Component accumulators don't react to tile, pixel or sample events
+        // and are evaluated by write_component_aovs() rather than one by one.
+        m_component_accumulators[m_component_aov_count] = component_accum;
+        m_component_aov_indices[m_component_aov_count] = component_accum->get_index();
+        m_component_aov_masks[m_component_aov_count] = component_accum->get_components();
+        m_component_mask |= component_accum->get_components();
+        ++m_component_aov_count;
+        aov_accum.release();
+    }
+    else
+    {
+        m_accumulators[m_size++] = aov_accum.release();
+    }
+
     return true;
 }
 
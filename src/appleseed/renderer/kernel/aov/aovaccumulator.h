@@ -38,6 +38,7 @@
 #include "foundation/core/concepts/noncopyable.h"
 #include "foundation/image/color.h"
 #include "foundation/math/vector.h"
+#include "foundation/platform/types.h"
 #include "foundation/utility/autoreleaseptr.h"
 
 // Standard headers.
@@ -148,6 +149,65 @@ class UnfilteredAOVAccumulator
 };
 
 
+//
+// Accumulator for AOVs that are sums of shading components.
+//
+// When part of an AOVAccumulatorContainer, these accumulators are not invoked
+// one by one: the container evaluates all of them in a single pass, converting
+// each shading component to RGB only once. Tile, pixel and sample events are
+// not forwarded to them.
+//
+
+class ComponentAOVAccumulator
+  : public AOVAccumulator
+{
+  public:
+    // Shading components, as bits of a component mask.
+    enum Component
+    {
+        Diffuse             = 1UL << 0,
+        Glossy              = 1UL << 1,
+        Volume              = 1UL << 2,
+        Emission            = 1UL << 3,
+        IndirectDiffuse     = 1UL << 4,
+        IndirectGlossy      = 1UL << 5,
+        IndirectVolume      = 1UL << 6,
+        Albedo              = 1UL << 7
+    };
+
+    enum { ComponentCount = 8 };
+
+    // Constructor.
+    ComponentAOVAccumulator(
+        const size_t                index,
+        const foundation::uint32    components);
+
+    // Return the index of the AOV in the shading result.
+    size_t get_index() const;
+
+    // Return the mask of the shading components summed into the AOV.
+    foundation::uint32 get_components() const;
+
+    // Convert the shading components of a component mask to RGB, in component order.
+    static void convert_components(
+        const foundation::uint32    components,
+        const ShadingComponents&    shading_components,
+        const AOVComponents&        aov_components,
+        foundation::Color3f         rgb[ComponentCount]);
+
+    void write(
+        const PixelContext&         pixel_context,
+        const ShadingPoint&         shading_point,
+        const ShadingComponents&    shading_components,
+        const AOVComponents&        aov_components,
+        ShadingResult&              shading_result) override;
+
+  private:
+    const size_t                m_index;
+    const foundation::uint32    m_components;
+};
+
+
 //
 // A collection of AOV accumulators.
 //
@@ -206,10 +266,23 @@ class AOVAccumulatorContainer
     void init();
     bool insert(foundation::auto_release_ptr<AOVAccumulator> aov_accum);
 
-    enum { MaxAovAccumulators = MaxAOVCount + 1 };  // MaxAOVCount + Beauty
+    void write_component_aovs(
+        const ShadingComponents&    shading_components,
+        const AOVComponents&        aov_components,
+        ShadingResult&              shading_result) const;
+
+    enum { MaxAovAccumulators = MaxAOVCount };
 
-    size_t          m_size;
-    AOVAccumulator* m_accumulators[MaxAovAccumulators];
+    // Accumulators invoked one by one.
+    size_t                      m_size;
+    AOVAccumulator*             m_accumulators[MaxAovAccumulators];
+
+    // Accumulators evaluated in a single batched pass.
+    size_t                      m_component_aov_count;
+    foundation::uint32          m_component_mask;   // union of the component masks of all component AOVs
+    ComponentAOVAccumulator*    m_component_accumulators[MaxAovAccumulators];
+    size_t                      m_component_aov_indices[MaxAovAccumulators];
+    foundation::uint32          m_component_aov_masks[MaxAovAccumulators];
 };
 
 
@@ -244,6 +317,21 @@ inline float UnfilteredAOVAccumulator::square_distance_to_pixel_center(
         foundation::square(ps.y - 0.5) + foundation::square(ps.y - 0.5));
 }
 
+
+//
+// ComponentAOVAccumulator class implementation.
+//
+
+inline size_t ComponentAOVAccumulator::get_index() const
+{
+    return m_index;
+}
+
+inline foundation::uint32 ComponentAOVAccumulator::get_components() const
+{
+    return m_components;
+}
+
 }       // namespace renderer
 
 #endif  // !APPLESEED_RENDERER_KERNEL_AOV_AOVACCUMULATOR_H
@@ -33,8 +33,11 @@
 #include "renderer/global/globallogger.h"
 
 // appleseed.foundation headers.
+#include "foundation/image/canvasproperties.h"
 #include "foundation/image/color.h"
 #include "foundation/image/image.h"
+#include "foundation/image/tile.h"
+#include "foundation/math/vector.h"
 #include "foundation/utility/job/iabortswitch.h"
 
 // BCD headers.
@@ -46,6 +49,7 @@
 #include "bcd/Utils.h"
 
 // Standard headers.
+#include <cassert>
 #include <cmath>
 #include <memory>
 #include <vector>
@@ -60,22 +64,21 @@ namespace renderer
 namespace
 {
 
-    void image_to_deepimage(const Image& src, Deepimf& dst)
+    void image_to_deepimage(const Image& src, const AABB2u& window, Deepimf& dst)
     {
-        const CanvasProperties& src_props = src.properties();
-        assert(src_props.m_channel_count == 4);
+        assert(src.properties().m_channel_count == 4);
+
+        const size_t w = window.extent(0) + 1;
+        const size_t h = window.extent(1) + 1;
 
-        dst.resize(
-            static_cast<int>(src_props.m_canvas_width),
-            static_cast<int>(src_props.m_canvas_height),
-            3);
+        dst.resize(static_cast<int>(w), static_cast<int>(h), 3);
 
-        for (size_t j = 0; j < src_props.m_canvas_height; ++j)
+        for (size_t j = 0; j < h; ++j)
         {
-            for (size_t i = 0; i < src_props.m_canvas_width; ++i)
+            for (size_t i = 0; i < w; ++i)
             {
                 Color4f c;
-                src.get_pixel(i, j, c);
+                src.get_pixel(window.min.x + i, window.min.y + j, c);
                 c.unpremultiply_in_place();
 
                 dst.set(static_cast<int>(j), static_cast<int>(i), 0, c[0]);
@@ -85,6 +88,18 @@ namespace
         }
     }
 
+    void image_to_deepimage(const Image& src, Deepimf& dst)
+    {
+        const CanvasProperties& src_props = src.properties();
+
+        image_to_deepimage(
+            src,
+            AABB2u(
+                Vector2u(0, 0),
+                Vector2u(src_props.m_canvas_width - 1, src_props.m_canvas_height - 1)),
+            dst);
+    }
+
     void deepimage_to_image(const Deepimf& src, Image& dst)
     {
         const CanvasProperties& dst_props = dst.properties();
@@ -111,6 +126,42 @@ namespace
         }
     }
 
+    // Store the pixels of `region` of a denoised window into a tile. Alpha is taken from `img`.
+    void deepimage_to_tile(
+        const Deepimf&  src,
+        const Image&    img,
+        const AABB2u&   window,
+        const AABB2u&   region,
+        Tile&           dst)
+    {
+        assert(src.getDepth() == 3);
+        assert(dst.get_width() == region.extent(0) + 1);
+        assert(dst.get_height() == region.extent(1) + 1);
+        assert(dst.get_channel_count() == 4);
+
+        const size_t offset_x = region.min.x - window.min.x;
+        const size_t offset_y = region.min.y - window.min.y;
+
+        for (size_t j = 0, h = dst.get_height(); j < h; ++j)
+        {
+            for (size_t i = 0, w = dst.get_width(); i < w; ++i)
+            {
+                Color4f c;
+                img.get_pixel(region.min.x + i, region.min.y + j, c);
+
+                const int line = static_cast<int>(offset_y + j);
+                const int column = static_cast<int>(offset_x + i);
+
+                c[0] = src.get(line, column, 0);
+                c[1] = src.get(line, column, 1);
+                c[2] = src.get(line, column, 2);
+
+                c.premultiply_in_place();
+                dst.set_pixel(i, j, c);
+            }
+        }
+    }
+
     class DenoiserCallbacks
       : public ICallbacks
     {
@@ -281,4 +332,93 @@ bool denoise_aov_image(
     return success;
 }
 
+size_t get_denoiser_margin(const DenoiserOptions& options)
+{
+    // Every scale of the multiscale denoiser halves the resolution and thus doubles
+    // the footprint of the patches and of the search window in the full-resolution image.
+    const size_t scale_count = options.m_num_scales > 1 ? options.m_num_scales : 1;
+    return (options.m_patch_radius + options.m_search_window_radius + 1) << (scale_count - 1);
+}
+
+bool denoise_beauty_image_region(
+    const Image&            img,
+    const AABB2u&           window,
+    const AABB2u&           region,
+    Deepimf&                num_samples,
+    Deepimf&                histograms,
+    Deepimf&                covariances,
+    const DenoiserOptions&  options,
+    IAbortSwitch*           abort_switch,
+    Tile&                   result)
+{
+    Deepimf src;
+    image_to_deepimage(img, window, src);
+
+    if (options.m_prefilter_spikes)
+    {
+        SpikeRemovalFilter::filter(
+            src,
+            num_samples,
+            histograms,
+            covariances,
+            options.m_prefilter_threshold_stddev_factor);
+    }
+
+    Deepimf dst(src);
+
+    const bool success =
+        do_denoise_image(
+            src,
+            num_samples,
+            histograms,
+            covariances,
+            options,
+            abort_switch,
+            dst);
+
+    if (success)
+        deepimage_to_tile(dst, img, window, region, result);
+
+    return success;
+}
+
+bool denoise_aov_image_region(
+    const Image&            img,
+    const AABB2u&           window,
+    const AABB2u&           region,
+    const Deepimf&          num_samples,
+    const Deepimf&          histograms,
+    const Deepimf&          covariances,
+    const DenoiserOptions&  options,
+    IAbortSwitch*           abort_switch,
+    Tile&                   result)
+{
+    Deepimf src;
+    image_to_deepimage(img, window, src);
+
+    if (options.m_prefilter_spikes)
+    {
+        SpikeRemovalFilter::filter(
+            src,
+            options.m_prefilter_threshold_stddev_factor);
+    }
+
+    Deepimf dst(src);
+
+    const bool success =
+        do_denoise_image(
+            src,
+            num_samples,
+            histograms,
+            covariances,
+            options,
+            abort_switch,
+            dst);
+
+    if (success)
+        deepimage_to_tile(dst, img, window, region, result);
+
+    return success;
+}
+
 }   // namespace renderer
@@ -29,12 +29,19 @@
 #ifndef APPLESEED_RENDERER_KERNEL_DENOISING_DENOISER_H
 #define APPLESEED_RENDERER_KERNEL_DENOISING_DENOISER_H
 
+// appleseed.foundation headers.
+#include "foundation/math/aabb.h"
+
 // BCD headers.
 #include "bcd/DeepImage.h"
 
+// Standard headers.
+#include <cstddef>
+
 // Forward declarations.
 namespace foundation    { class IAbortSwitch; }
 namespace foundation    { class Image; }
+namespace foundation    { class Tile; }
 
 namespace renderer
 {
@@ -86,6 +93,34 @@ bool denoise_aov_image(
     const DenoiserOptions&      options,
     foundation::IAbortSwitch*   abort_switch);
 
+// Return the number of pixels around a region that the denoised value of the region depends on.
+size_t get_denoiser_margin(const DenoiserOptions& options);
+
+// Denoise a region of an image without modifying the image. The denoiser inputs cover
+// the pixels of `window` (inclusive bounds) which must contain `region`. The denoised
+// pixels of `region` are stored into `result`, a 4-channel tile of the size of `region`.
+bool denoise_beauty_image_region(
+    const foundation::Image&    img,
+    const foundation::AABB2u&   window,
+    const foundation::AABB2u&   region,
+    bcd::Deepimf&               num_samples,
+    bcd::Deepimf&               histograms,
+    bcd::Deepimf&               covariances,
+    const DenoiserOptions&      options,
+    foundation::IAbortSwitch*   abort_switch,
+    foundation::Tile&           result);
+
+bool denoise_aov_image_region(
+    const foundation::Image&    img,
+    const foundation::AABB2u&   window,
+    const foundation::AABB2u&   region,
+    const bcd::Deepimf&         num_samples,
+    const bcd::Deepimf&         histograms,
+    const bcd::Deepimf&         covariances,
+    const DenoiserOptions&      options,
+    foundation::IAbortSwitch*   abort_switch,
+    foundation::Tile&           result);
+
 }       // namespace renderer
 
 #endif  // !APPLESEED_RENDERER_KERNEL_DENOISING_DENOISER_H
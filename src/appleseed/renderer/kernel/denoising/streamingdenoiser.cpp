@@ -0,0 +1,361 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2018 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// Interface header.
+#include "streamingdenoiser.h"
+
+// appleseed.renderer headers.
+#include "renderer/global/globallogger.h"
+#include "renderer/modeling/aov/aov.h"
+#include "renderer/modeling/aov/denoiseraov.h"
+#include "renderer/modeling/frame/frame.h"
+
+// appleseed.foundation headers.
+#include "foundation/image/canvasproperties.h"
+#include "foundation/image/color.h"
+#include "foundation/image/image.h"
+#include "foundation/image/pixel.h"
+#include "foundation/image/tile.h"
+#include "foundation/math/vector.h"
+#include "foundation/utility/job/iabortswitch.h"
+#include "foundation/utility/profiler.h"
+#include "foundation/utility/string.h"
+
+// BCD headers.
+#include "bcd/DeepImage.h"
+
+// Standard headers.
+#include <algorithm>
+#include <cassert>
+
+using namespace bcd;
+using namespace foundation;
+using namespace std;
+
+namespace renderer
+{
+
+namespace
+{
+    DenoiserOptions make_single_threaded(DenoiserOptions options)
+    {
+        // Tiles are denoised by the rendering threads while the other threads keep rendering.
+        options.m_num_cores = 1;
+        return options;
+    }
+}
+
+StreamingDenoiser::StreamingDenoiser(
+    const Frame&            frame,
+    const size_t            thread_count)
+  : m_denoiser_aov(*frame.get_denoiser_aov())
+  , m_options(make_single_threaded(frame.get_denoiser_options(thread_count)))
+  , m_finish_options(frame.get_denoiser_options(thread_count))
+  , m_tile_count_x(frame.image().properties().m_tile_count_x)
+  , m_tile_count_y(frame.image().properties().m_tile_count_y)
+  , m_pending_tile_count(0)
+  , m_peak_pending_tile_count(0)
+{
+    m_images.push_back(&frame.image());
+
+    for (size_t i = 0, e = frame.aovs().size(); i < e; ++i)
+    {
+        const AOV* aov = frame.aovs().get_by_index(i);
+
+        if (aov->has_color_data())
+            m_images.push_back(&aov->get_image());
+    }
+
+    const CanvasProperties& props = frame.image().properties();
+    const size_t margin = get_denoiser_margin(m_options);
+
+    m_tiles.resize(m_tile_count_x * m_tile_count_y);
+
+    for (size_t ty = 0; ty < m_tile_count_y; ++ty)
+    {
+        for (size_t tx = 0; tx < m_tile_count_x; ++tx)
+        {
+            TileInfo& info = tile(tx, ty);
+
+            info.m_state = TileState::Pending;
+
+            info.m_bbox.min.x = tx * props.m_tile_width;
+            info.m_bbox.min.y = ty * props.m_tile_height;
+            info.m_bbox.max.x = min((tx + 1) * props.m_tile_width, props.m_canvas_width) - 1;
+            info.m_bbox.max.y = min((ty + 1) * props.m_tile_height, props.m_canvas_height) - 1;
+
+            info.m_window.min.x = info.m_bbox.min.x > margin ? info.m_bbox.min.x - margin : 0;
+            info.m_window.min.y = info.m_bbox.min.y > margin ? info.m_bbox.min.y - margin : 0;
+            info.m_window.max.x = min(info.m_bbox.max.x + margin, props.m_canvas_width - 1);
+            info.m_window.max.y = min(info.m_bbox.max.y + margin, props.m_canvas_height - 1);
+
+            info.m_neighbors.min.x = info.m_window.min.x / props.m_tile_width;
+            info.m_neighbors.min.y = info.m_window.min.y / props.m_tile_height;
+            info.m_neighbors.max.x = info.m_window.max.x / props.m_tile_width;
+            info.m_neighbors.max.y = info.m_window.max.y / props.m_tile_height;
+        }
+    }
+}
+
+StreamingDenoiser::~StreamingDenoiser()
+{
+}
+
+void StreamingDenoiser::on_tile_end(
+    const size_t            tile_x,
+    const size_t            tile_y,
+    IAbortSwitch*           abort_switch)
+{
+    vector<size_t> ready_tiles;
+
+    {
+        boost::mutex::scoped_lock lock(m_mutex);
+
+        TileInfo& info = tile(tile_x, tile_y);
+
+        if (info.m_state != TileState::Pending)
+            return;
+
+        info.m_state = TileState::Rendered;
+
+        collect_ready_tiles(info.m_neighbors, ready_tiles);
+    }
+
+    denoise_tiles(ready_tiles, m_options, abort_switch);
+}
+
+void StreamingDenoiser::finish(IAbortSwitch* abort_switch)
+{
+    vector<size_t> ready_tiles;
+
+    {
+        boost::mutex::scoped_lock lock(m_mutex);
+
+        for (TileInfo& info : m_tiles)
+        {
+            if (info.m_state == TileState::Pending)
+                info.m_state = TileState::Rendered;
+        }
+
+        collect_ready_tiles(
+            AABB2u(Vector2u(0, 0), Vector2u(m_tile_count_x - 1, m_tile_count_y - 1)),
+            ready_tiles);
+    }
+
+    denoise_tiles(ready_tiles, m_finish_options, abort_switch);
+
+    assert(m_pending_tile_count == 0);
+
+    RENDERER_LOG_DEBUG(
+        "streaming denoiser kept at most %s of %s denoised tiles in memory.",
+        pretty_uint(m_peak_pending_tile_count).c_str(),
+        pretty_uint(m_tiles.size()).c_str());
+}
+
+size_t StreamingDenoiser::get_peak_pending_tile_count() const
+{
+    return m_peak_pending_tile_count;
+}
+
+StreamingDenoiser::TileInfo& StreamingDenoiser::tile(const size_t tile_x, const size_t tile_y)
+{
+    assert(tile_x < m_tile_count_x);
+    assert(tile_y < m_tile_count_y);
+
+    return m_tiles[tile_y * m_tile_count_x + tile_x];
+}
+
+bool StreamingDenoiser::all_neighbors_reached(const TileInfo& info, const TileState state) const
+{
+    for (size_t ty = info.m_neighbors.min.y; ty <= info.m_neighbors.max.y; ++ty)
+    {
+        for (size_t tx = info.m_neighbors.min.x; tx <= info.m_neighbors.max.x; ++tx)
+        {
+            if (m_tiles[ty * m_tile_count_x + tx].m_state < state)
+                return false;
+        }
+    }
+
+    return true;
+}
+
+void StreamingDenoiser::collect_ready_tiles(
+    const AABB2u&           candidates,
+    vector<size_t>&         ready_tiles)
+{
+    for (size_t ty = candidates.min.y; ty <= candidates.max.y; ++ty)
+    {
+        for (size_t tx = candidates.min.x; tx <= candidates.max.x; ++tx)
+        {
+            TileInfo& info = tile(tx, ty);
+
+            if (info.m_state == TileState::Rendered &&
+                all_neighbors_reached(info, TileState::Rendered))
+            {
+                info.m_state = TileState::Denoising;
+                ready_tiles.push_back(ty * m_tile_count_x + tx);
+            }
+        }
+    }
+}
+
+void StreamingDenoiser::collect_committable_tiles(
+    const AABB2u&           candidates,
+    vector<size_t>&         committable_tiles)
+{
+    for (size_t ty = candidates.min.y; ty <= candidates.max.y; ++ty)
+    {
+        for (size_t tx = candidates.min.x; tx <= candidates.max.x; ++tx)
+        {
+            TileInfo& info = tile(tx, ty);
+
+            if (info.m_state == TileState::Denoised &&
+                all_neighbors_reached(info, TileState::Denoised))
+            {
+                info.m_state = TileState::Committed;
+                committable_tiles.push_back(ty * m_tile_count_x + tx);
+
+                assert(m_pending_tile_count > 0);
+                --m_pending_tile_count;
+            }
+        }
+    }
+}
+
+void StreamingDenoiser::denoise_tiles(
+    vector<size_t>&         ready_tiles,
+    const DenoiserOptions&  options,
+    IAbortSwitch*           abort_switch)
+{
+    vector<size_t> committable_tiles;
+
+    for (const size_t tile_index : ready_tiles)
+    {
+        TileInfo& info = m_tiles[tile_index];
+
+        // Denoise the tile. Its neighbors are rendered and won't be written to
+        // until this tile is denoised, so this happens outside the lock.
+        denoise_tile(info, options, abort_switch);
+
+        committable_tiles.clear();
+
+        {
+            boost::mutex::scoped_lock lock(m_mutex);
+
+            info.m_state = TileState::Denoised;
+
+            ++m_pending_tile_count;
+            m_peak_pending_tile_count = max(m_peak_pending_tile_count, m_pending_tile_count);
+
+            collect_committable_tiles(info.m_neighbors, committable_tiles);
+        }
+
+        // No other tile will ever read the pixels of committable tiles.
+        for (const size_t committable_tile_index : committable_tiles)
+            commit_tile(m_tiles[committable_tile_index]);
+    }
+}
+
+void StreamingDenoiser::denoise_tile(
+    TileInfo&               info,
+    const DenoiserOptions&  options,
+    IAbortSwitch*           abort_switch)
+{
+    ProfileZone profile_zone("denoise tile");
+
+    info.m_results.resize(m_images.size());
+
+    if (abort_switch && abort_switch->is_aborted())
+        return;
+
+    Deepimf num_samples, histograms, covariances;
+    m_denoiser_aov.extract_region(info.m_window, num_samples, histograms, covariances);
+
+    const size_t width = info.m_bbox.extent(0) + 1;
+    const size_t height = info.m_bbox.extent(1) + 1;
+
+    for (size_t i = 0, e = m_images.size(); i < e; ++i)
+    {
+        unique_ptr<Tile> result(new Tile(width, height, 4, PixelFormatFloat));
+
+        // The beauty image is denoised first since spike removal updates the denoiser inputs.
+        const bool success =
+            i == 0
+                ? denoise_beauty_image_region(
+                      *m_images[i],
+                      info.m_window,
+                      info.m_bbox,
+                      num_samples,
+                      histograms,
+                      covariances,
+                      options,
+                      abort_switch,
+                      *result)
+                : denoise_aov_image_region(
+                      *m_images[i],
+                      info.m_window,
+                      info.m_bbox,
+                      num_samples,
+                      histograms,
+                      covariances,
+                      options,
+                      abort_switch,
+                      *result);
+
+        if (success)
+            info.m_results[i] = move(result);
+    }
+}
+
+void StreamingDenoiser::commit_tile(TileInfo& info)
+{
+    for (size_t i = 0, e = info.m_results.size(); i < e; ++i)
+    {
+        const Tile* result = info.m_results[i].get();
+
+        if (result == nullptr)
+            continue;
+
+        Image& image = *m_images[i];
+
+        for (size_t y = 0, h = result->get_height(); y < h; ++y)
+        {
+            for (size_t x = 0, w = result->get_width(); x < w; ++x)
+            {
+                Color4f color;
+                result->get_pixel(x, y, color);
+                image.set_pixel(info.m_bbox.min.x + x, info.m_bbox.min.y + y, color);
+            }
+        }
+    }
+
+    info.m_results.clear();
+    info.m_results.shrink_to_fit();
+}
+
+}   // namespace renderer
@@ -0,0 +1,157 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2018 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef APPLESEED_RENDERER_KERNEL_DENOISING_STREAMINGDENOISER_H
+#define APPLESEED_RENDERER_KERNEL_DENOISING_STREAMINGDENOISER_H
+
+// appleseed.renderer headers.
+#include "renderer/kernel/denoising/denoiser.h"
+
+// appleseed.foundation headers.
+#include "foundation/core/concepts/noncopyable.h"
+#include "foundation/math/aabb.h"
+
+// Boost headers.
+#include "boost/thread/mutex.hpp"
+
+// Standard headers.
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Forward declarations.
+namespace foundation    { class IAbortSwitch; }
+namespace foundation    { class Image; }
+namespace foundation    { class Tile; }
+namespace renderer      { class DenoiserAOV; }
+namespace renderer      { class Frame; }
+
+namespace renderer
+{
+
+//
+// Denoises a frame tile by tile while it is being rendered.
+//
+// A tile is denoised as soon as all the tiles within the denoiser margin around it
+// are rendered. Denoised pixels are held back until every tile whose denoising reads
+// them is itself denoised, then written to the frame. Only the denoiser inputs of
+// the tile being denoised and the denoised tiles that are not yet written to the
+// frame are kept in memory.
+//
+// The tiles must be reported in their final state, i.e. during the last rendering pass.
+//
+
+class StreamingDenoiser
+  : public foundation::NonCopyable
+{
+  public:
+    // Constructor.
+    StreamingDenoiser(
+        const Frame&                frame,
+        const size_t                thread_count);
+
+    // Destructor.
+    ~StreamingDenoiser();
+
+    // Report that a tile is rendered. Tiles that become ready are denoised on the
+    // calling thread. This method is thread-safe.
+    void on_tile_end(
+        const size_t                tile_x,
+        const size_t                tile_y,
+        foundation::IAbortSwitch*   abort_switch);
+
+    // Denoise the tiles that were not denoised yet (for instance because they were
+    // never reported) and write all remaining denoised pixels to the frame.
+    void finish(foundation::IAbortSwitch* abort_switch);
+
+    // Return the largest number of denoised tiles waiting to be written to the frame.
+    size_t get_peak_pending_tile_count() const;
+
+  private:
+    enum class TileState
+    {
+        Pending,        // not rendered yet
+        Rendered,       // rendered, waiting for its neighbors
+        Denoising,      // being denoised
+        Denoised,       // denoised, waiting for its neighbors to be denoised
+        Committed       // denoised pixels written to the frame
+    };
+
+    struct TileInfo
+    {
+        typedef std::vector<std::unique_ptr<foundation::Tile>> TileVector;
+
+        TileState           m_state;
+        foundation::AABB2u  m_bbox;         // pixels of the tile
+        foundation::AABB2u  m_window;       // pixels read to denoise the tile
+        foundation::AABB2u  m_neighbors;    // tiles overlapping m_window
+        TileVector          m_results;      // denoised pixels, beauty first, then color AOVs
+    };
+
+    const DenoiserAOV&                  m_denoiser_aov;
+    std::vector<foundation::Image*>     m_images;                   // beauty first, then color AOVs
+    const DenoiserOptions               m_options;                  // options used by the rendering threads
+    const DenoiserOptions               m_finish_options;           // options used by finish()
+    const size_t                        m_tile_count_x;
+    const size_t                        m_tile_count_y;
+
+    boost::mutex                        m_mutex;
+    std::vector<TileInfo>               m_tiles;
+    size_t                              m_pending_tile_count;
+    size_t                              m_peak_pending_tile_count;
+
+    TileInfo& tile(const size_t tile_x, const size_t tile_y);
+
+    bool all_neighbors_reached(const TileInfo& info, const TileState state) const;
+
+    // Collect the tiles that can be denoised and mark them as being denoised. Caller must hold the lock.
+    void collect_ready_tiles(
+        const foundation::AABB2u&   candidates,
+        std::vector<size_t>&        ready_tiles);
+
+    // Collect the denoised tiles whose pixels can be written to the frame. Caller must hold the lock.
+    void collect_committable_tiles(
+        const foundation::AABB2u&   candidates,
+        std::vector<size_t>&        committable_tiles);
+
+    void denoise_tiles(
+        std::vector<size_t>&        ready_tiles,
+        const DenoiserOptions&      options,
+        foundation::IAbortSwitch*   abort_switch);
+
+    void denoise_tile(
+        TileInfo&                   info,
+        const DenoiserOptions&      options,
+        foundation::IAbortSwitch*   abort_switch);
+
+    void commit_tile(TileInfo& info);
+};
+
+}       // namespace renderer
+
+#endif  // !APPLESEED_RENDERER_KERNEL_DENOISING_STREAMINGDENOISER_H
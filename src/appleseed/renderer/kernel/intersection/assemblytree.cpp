@@ -47,6 +47,7 @@
 #include "renderer/modeling/scene/objectinstance.h"
 #include "renderer/modeling/scene/scene.h"
 #include "renderer/utility/bbox.h"
+#include "renderer/utility/statisticsrecorder.h"
 
 // appleseed.foundation headers.
 #include "foundation/math/beziercurve.h"
@@ -62,7 +63,9 @@
 #include "foundation/utility/lazy.h"
 #include "foundation/utility/siphash.h"
 #include "foundation/utility/statistics.h"
+#include "foundation/utility/stopwatch.h"
 #include "foundation/utility/string.h"
+#include "foundation/utility/uid.h"
 
 // Standard headers.
 #include <algorithm>
@@ -81,9 +84,12 @@ namespace renderer
 // AssemblyTree class implementation.
 //
 
-AssemblyTree::AssemblyTree(const Scene& scene)
+AssemblyTree::AssemblyTree(
+    const Scene&                        scene,
+    StatisticsRecorder&                 statistics_recorder)
   : TreeType(AlignedAllocator<void>(System::get_l1_data_cache_line_size()))
   , m_scene(scene)
+  , m_statistics_recorder(statistics_recorder)
 #ifdef APPLESEED_WITH_EMBREE
   , m_use_embree(false)
   , m_dirty(false)
@@ -98,7 +104,28 @@ AssemblyTree::~AssemblyTree()
 
 void AssemblyTree::update()
 {
-    rebuild_assembly_tree();
+    // Collect assembly instances and their bounding boxes.
+    RENDERER_LOG_INFO("collecting assembly instances...");
+    ItemVector items;
+    AABBVector assembly_instance_bboxes;
+    collect_assembly_instances(
+        m_scene.assembly_instances(),
+        TransformSequence(),
+        items,
+        assembly_instance_bboxes);
+
+    // If only transforms or bounding boxes of assembly instances changed,
+    // the topology of the tree can be kept and only its bounding boxes updated.
+    UniqueIDVector layout;
+    compute_item_layout(items, layout);
+    if (!m_nodes.empty() && layout == m_item_layout)
+        refit_assembly_tree(items, assembly_instance_bboxes);
+    else
+    {
+        rebuild_assembly_tree(items, assembly_instance_bboxes);
+        m_item_layout.swap(layout);
+    }
+
     update_tree_hierarchy();
 }
 
@@ -109,13 +136,16 @@ size_t AssemblyTree::get_memory_size() const
         - sizeof(*static_cast<const TreeType*>(this))
         + sizeof(*this)
         + m_items.capacity() * sizeof(AssemblyInstance*)
+        + m_item_ordering.capacity() * sizeof(size_t)
+        + m_item_layout.capacity() * sizeof(UniqueID)
         + m_assembly_versions.size() * sizeof(pair<UniqueID, VersionID>);
 }
 
 void AssemblyTree::collect_assembly_instances(
     const AssemblyInstanceContainer&    assembly_instances,
     const TransformSequence&            parent_transform_seq,
-    AABBVector&                         assembly_instance_bboxes)
+    ItemVector&                         items,
+    AABBVector&                         assembly_instance_bboxes) const
 {
     for (const_each<AssemblyInstanceContainer> i = assembly_instances; i; ++i)
     {
@@ -134,6 +164,7 @@ void AssemblyTree::collect_assembly_instances(
         collect_assembly_instances(
             assembly.assembly_instances(),
             cumulated_transform_seq,
+            items,
             assembly_instance_bboxes);
 
         // Skip empty assemblies.
@@ -141,7 +172,7 @@ void AssemblyTree::collect_assembly_instances(
             continue;
 
         // Create and store an item for this assembly instance.
-        m_items.emplace_back(
+        items.emplace_back(
             &assembly,
             &assembly_instance,
             cumulated_transform_seq);
@@ -155,22 +186,31 @@ void AssemblyTree::collect_assembly_instances(
     }
 }
 
-void AssemblyTree::rebuild_assembly_tree()
+void AssemblyTree::compute_item_layout(
+    const ItemVector&                   items,
+    UniqueIDVector&                     layout)
+{
+    layout.clear();
+    layout.reserve(2 * items.size());
+
+    for (const_each<ItemVector> i = items; i; ++i)
+    {
+        layout.push_back(i->m_assembly_instance->get_uid());
+        layout.push_back(i->m_assembly_uid);
+    }
+}
+
+void AssemblyTree::rebuild_assembly_tree(
+    ItemVector&                         items,
+    const AABBVector&                   assembly_instance_bboxes)
 {
     // Clear the current tree.
     clear();
-    m_items.clear();
+    m_items.swap(items);
+    m_item_ordering.clear();
 
     Statistics statistics;
 
-    // Collect assembly instances and their bounding boxes.
-    RENDERER_LOG_INFO("collecting assembly instances...");
-    AABBVector assembly_instance_bboxes;
-    collect_assembly_instances(
-        m_scene.assembly_instances(),
-        TransformSequence(),
-        assembly_instance_bboxes);
-
     RENDERER_LOG_INFO(
         "building assembly tree (%s %s)...",
         pretty_int(m_items.size()).c_str(),
@@ -195,6 +235,7 @@ void AssemblyTree::rebuild_assembly_tree()
     {
         const vector<size_t>& ordering = partitioner.get_item_ordering();
         assert(m_items.size() == ordering.size());
+        m_item_ordering = ordering;
 
         // Reorder the items according to the tree ordering.
         ItemVector temp_assembly_instances(ordering.size());
@@ -208,11 +249,19 @@ void AssemblyTree::rebuild_assembly_tree()
         store_items_in_leaves(statistics);
     }
 
-    // Print assembly tree statistics.
-    RENDERER_LOG_DEBUG("%s",
+    // Report the memory taken by the time samples of the transform sequences.
+    size_t transform_samples_size = 0;
+    for (const_each<ItemVector> i = m_items; i; ++i)
+        transform_samples_size += i->m_transform_sequence.get_sample_memory_size();
+    statistics.insert_size("transform samples", transform_samples_size);
+
+    // Print and record assembly tree statistics.
+    const StatisticsVector statistics_vector =
         StatisticsVector::make(
             "assembly tree statistics",
-            statistics).to_string().c_str());
+            statistics);
+    RENDERER_LOG_DEBUG("%s", statistics_vector.to_string().c_str());
+    m_statistics_recorder.record(statistics_vector);
 
 #ifdef APPLESEED_WITH_EMBREE
 
@@ -224,6 +273,94 @@ void AssemblyTree::rebuild_assembly_tree()
 #endif
 }
 
+void AssemblyTree::refit_assembly_tree(
+    ItemVector&                         items,
+    AABBVector&                         assembly_instance_bboxes)
+{
+    assert(items.size() == m_item_ordering.size());
+    assert(items.size() == assembly_instance_bboxes.size());
+
+    RENDERER_LOG_INFO(
+        "refitting assembly tree (%s %s)...",
+        pretty_int(items.size()).c_str(),
+        plural(items.size(), "assembly instance").c_str());
+
+    Stopwatch<DefaultWallclockTimer> stopwatch;
+    stopwatch.start();
+
+    if (!items.empty())
+    {
+        // Reorder the items and their bounding boxes according to the existing tree ordering.
+        ItemVector temp_items(items.size());
+        small_item_reorder(
+            &items[0],
+            &temp_items[0],
+            &m_item_ordering[0],
+            m_item_ordering.size());
+        AABBVector temp_bboxes(assembly_instance_bboxes.size());
+        small_item_reorder(
+            &assembly_instance_bboxes[0],
+            &temp_bboxes[0],
+            &m_item_ordering[0],
+            m_item_ordering.size());
+    }
+
+    m_items.swap(items);
+
+    // Update the bounding boxes of all interior nodes, bottom-up.
+    refit_node(0, assembly_instance_bboxes);
+
+    stopwatch.measure();
+
+    Statistics statistics;
+    statistics.insert_time("refit time", stopwatch.get_seconds());
+    statistics.merge(bvh::TreeStatistics<AssemblyTree>(*this, AABB3d(m_scene.compute_bbox())));
+
+    // Items stored in leaves hold copies of the transform sequences and must be refreshed.
+    store_items_in_leaves(statistics);
+
+    // Print and record assembly tree statistics.
+    const StatisticsVector statistics_vector =
+        StatisticsVector::make(
+            "assembly tree statistics",
+            statistics);
+    RENDERER_LOG_DEBUG("%s", statistics_vector.to_string().c_str());
+    m_statistics_recorder.record(statistics_vector);
+}
+
+AABB3d AssemblyTree::refit_node(
+    const size_t                        node_index,
+    const AABBVector&                   assembly_instance_bboxes)
+{
+    const NodeType& node = m_nodes[node_index];
+
+    if (node.is_leaf())
+    {
+        AABB3d bbox;
+        bbox.invalidate();
+
+        const size_t item_begin = node.get_item_index();
+        const size_t item_end = item_begin + node.get_item_count();
+
+        for (size_t i = item_begin; i < item_end; ++i)
+            bbox.insert(assembly_instance_bboxes[i]);
+
+        return bbox;
+    }
+
+    const size_t child_node_index = node.get_child_node_index();
+    const AABB3d left_bbox = refit_node(child_node_index, assembly_instance_bboxes);
+    const AABB3d right_bbox = refit_node(child_node_index + 1, assembly_instance_bboxes);
+
+    m_nodes[node_index].set_left_bbox(left_bbox);
+    m_nodes[node_index].set_right_bbox(right_bbox);
+
+    AABB3d bbox(left_bbox);
+    bbox.insert(right_bbox);
+
+    return bbox;
+}
+
 void AssemblyTree::store_items_in_leaves(Statistics& statistics)
 {
     size_t leaf_count = 0;
@@ -361,6 +498,21 @@ namespace
         return false;
     }
 
+    UniqueID get_geometry_uid(const ObjectInstance& object_instance)
+    {
+        const Object& object = object_instance.get_object();
+
+        // Identical mesh objects share their geometry and can share their trees too,
+        // unless alpha mapping is involved since intersection filters are disabled
+        // on shared trees.
+        if (strcmp(object.get_model(), MeshObjectFactory().get_model()) == 0 &&
+            object.get_uncached_alpha_map() == nullptr &&
+            !object_instance.uses_alpha_mapping())
+            return static_cast<const MeshObject&>(object).get_geometry_uid();
+
+        return object.get_uid();
+    }
+
     uint64 hash_assembly_geometry(const Assembly& assembly, const char* model)
     {
         uint64 hash = 0;
@@ -373,7 +525,7 @@ namespace
             {
                 uint64 values[2 + 16];
                 values[0] = hash;
-                values[1] = object.get_uid();
+                values[1] = get_geometry_uid(*i);
                 memcpy(&values[2], &i->get_transform().get_local_to_parent()[0], 16 * 8);
                 hash = siphash24(&values, sizeof(values));
             }
@@ -460,7 +612,8 @@ void AssemblyTree::create_region_tree(const Assembly& assembly)
                 RegionTree::Arguments(
                     m_scene,
                     assembly.get_uid(),
-                    assembly)));
+                    assembly,
+                    m_statistics_recorder)));
 
         tree = new Lazy<RegionTree>(move(region_tree_factory));
         m_region_tree_repository.insert(hash, tree);
@@ -492,7 +645,8 @@ void AssemblyTree::create_triangle_tree(const Assembly& assembly)
                     assembly.get_uid(),
                     assembly_bbox,
                     assembly,
-                    regions)));
+                    regions,
+                    m_statistics_recorder)));
 
         tree = new Lazy<TriangleTree>(move(triangle_tree_factory));
         m_triangle_tree_repository.insert(hash, tree);
@@ -520,7 +674,8 @@ void AssemblyTree::create_curve_tree(const Assembly& assembly)
                     m_scene,
                     assembly.get_uid(),
                     assembly_bbox,
-                    assembly)));
+                    assembly,
+                    m_statistics_recorder)));
 
         tree = new Lazy<CurveTree>(move(curve_tree_factory));
         m_curve_tree_repository.insert(hash, tree);
@@ -556,7 +711,8 @@ void AssemblyTree::create_embree_scene(const Assembly& assembly)
             new EmbreeSceneFactory(
                 EmbreeScene::Arguments(
                     m_scene.get_embree_device(),
-                    assembly
+                    assembly,
+                    m_statistics_recorder
                 )));
         
         scene = new Lazy<EmbreeScene>(move(embree_scene_factory));
@@ -62,6 +62,7 @@ namespace foundation    { class Statistics; }
 namespace renderer      { class AssemblyInstance; }
 namespace renderer      { class Scene; }
 namespace renderer      { class ShadingPoint; }
+namespace renderer      { class StatisticsRecorder; }
 
 namespace renderer
 {
@@ -78,13 +79,17 @@ class AssemblyTree
            >
 {
   public:
-    // Constructor, builds the tree for a given scene.
-    explicit AssemblyTree(const Scene& scene);
+    // Constructor, builds the tree for a given scene. Statistics of the assembly
+    // tree and of all the child trees are recorded into a given recorder.
+    AssemblyTree(
+        const Scene&                scene,
+        StatisticsRecorder&         statistics_recorder);
 
     // Destructor.
     ~AssemblyTree();
 
-    // Update the assembly tree and all the child trees.
+    // Update the assembly tree and all the child trees. The assembly tree is only
+    // refitted if the set of assembly instances did not change since the last update.
     void update();
 
     // Return the size (in bytes) of this object in memory.
@@ -126,10 +131,14 @@ class AssemblyTree
     typedef std::vector<Item> ItemVector;
     typedef std::vector<foundation::AABB3d> AABBVector;
     typedef std::vector<const Assembly*> AssemblyVector;
+    typedef std::vector<foundation::UniqueID> UniqueIDVector;
     typedef std::map<foundation::UniqueID, foundation::VersionID> AssemblyVersionMap;
 
     const Scene&                    m_scene;
+    StatisticsRecorder&             m_statistics_recorder;
     ItemVector                      m_items;
+    std::vector<size_t>             m_item_ordering;        // tree ordering of the items, as collected
+    UniqueIDVector                  m_item_layout;          // assembly instance and assembly UIDs of the items, as collected
     AssemblyVersionMap              m_assembly_versions;
 
     TreeRepository<TriangleTree>    m_triangle_tree_repository;
@@ -153,9 +162,22 @@ class AssemblyTree
     void collect_assembly_instances(
         const AssemblyInstanceContainer&        assembly_instances,
         const TransformSequence&                parent_transform_seq,
+        ItemVector&                             items,
+        AABBVector&                             assembly_instance_bboxes) const;
+
+    static void compute_item_layout(
+        const ItemVector&                       items,
+        UniqueIDVector&                         layout);
+
+    void rebuild_assembly_tree(
+        ItemVector&                             items,
+        const AABBVector&                       assembly_instance_bboxes);
+    void refit_assembly_tree(
+        ItemVector&                             items,
         AABBVector&                             assembly_instance_bboxes);
-
-    void rebuild_assembly_tree();
+    foundation::AABB3d refit_node(
+        const size_t                            node_index,
+        const AABBVector&                       assembly_instance_bboxes);
     void store_items_in_leaves(foundation::Statistics& statistics);
 
     void update_tree_hierarchy();
@@ -38,6 +38,7 @@
 #include "renderer/modeling/scene/objectinstance.h"
 #include "renderer/utility/messagecontext.h"
 #include "renderer/utility/paramarray.h"
+#include "renderer/utility/statisticsrecorder.h"
 
 // appleseed.foundation headers.
 #include "foundation/core/exceptions/exceptionnotimplemented.h"
@@ -73,11 +74,13 @@ CurveTree::Arguments::Arguments(
     const Scene&            scene,
     const UniqueID          curve_tree_uid,
     const GAABB3&           bbox,
-    const Assembly&         assembly)
+    const Assembly&         assembly,
+    StatisticsRecorder&     statistics_recorder)
   : m_scene(scene)
   , m_curve_tree_uid(curve_tree_uid)
   , m_bbox(bbox)
   , m_assembly(assembly)
+  , m_statistics_recorder(statistics_recorder)
 {
 }
 
@@ -104,11 +107,13 @@ CurveTree::CurveTree(const Arguments& arguments)
     statistics.insert_time("total build time", stopwatch.measure().get_seconds());
     statistics.insert_size("nodes alignment", alignment(&m_nodes[0]));
 
-    // Print curve tree statistics.
-    RENDERER_LOG_DEBUG("%s",
+    // Print and record curve tree statistics.
+    const StatisticsVector statistics_vector =
         StatisticsVector::make(
             "curve tree #" + to_string(m_arguments.m_curve_tree_uid) + " statistics",
-            statistics).to_string().c_str());
+            statistics);
+    RENDERER_LOG_DEBUG("%s", statistics_vector.to_string().c_str());
+    m_arguments.m_statistics_recorder.record(statistics_vector);
 }
 
 void CurveTree::collect_curves(vector<GAABB3>& curve_bboxes)
@@ -222,6 +227,7 @@ void CurveTree::build_bvh(
         reorder_curve_keys(ordering);
         reorder_curves(ordering);
         reorder_curve_keys_in_leaf_nodes();
+        build_curve_groups();
     }
 }
 
@@ -302,6 +308,38 @@ void CurveTree::reorder_curve_keys_in_leaf_nodes()
     }
 }
 
+void CurveTree::build_curve_groups()
+{
+    m_curve1_groups.clear();
+    m_curve3_groups.clear();
+
+    for (size_t i = 0; i < m_nodes.size(); ++i)
+    {
+        if (!m_nodes[i].is_leaf())
+            continue;
+
+        LeafUserData& user_data = m_nodes[i].get_user_data<LeafUserData>();
+
+        // Degree-1 curves of this leaf node, padded with empty lanes.
+        user_data.m_curve1_group_offset = static_cast<uint32>(m_curve1_groups.size());
+        for (uint32 j = 0; j < user_data.m_curve1_count; ++j)
+        {
+            if (j % Curve1GroupType::Size == 0)
+                m_curve1_groups.push_back(Curve1GroupType());
+            m_curve1_groups.back().set(j % Curve1GroupType::Size, m_curves1[user_data.m_curve1_offset + j]);
+        }
+
+        // Degree-3 curves of this leaf node, padded with empty lanes.
+        user_data.m_curve3_group_offset = static_cast<uint32>(m_curve3_groups.size());
+        for (uint32 j = 0; j < user_data.m_curve3_count; ++j)
+        {
+            if (j % Curve3GroupType::Size == 0)
+                m_curve3_groups.push_back(Curve3GroupType());
+            m_curve3_groups.back().set(j % Curve3GroupType::Size, m_curves3[user_data.m_curve3_offset + j]);
+        }
+    }
+}
+
 
 //
 // CurveTreeFactory class implementation.
@@ -57,6 +57,7 @@ namespace foundation    { class Statistics; }
 namespace renderer      { class Assembly; }
 namespace renderer      { class ParamArray; }
 namespace renderer      { class Scene; }
+namespace renderer      { class StatisticsRecorder; }
 
 namespace renderer
 {
@@ -80,13 +81,15 @@ class CurveTree
         const foundation::UniqueID              m_curve_tree_uid;
         const GAABB3                            m_bbox;
         const Assembly&                         m_assembly;
+        StatisticsRecorder&                     m_statistics_recorder;
 
         // Constructor.
         Arguments(
             const Scene&                        scene,
             const foundation::UniqueID          curve_tree_uid,
             const GAABB3&                       bbox,
-            const Assembly&                     assembly);
+            const Assembly&                     assembly,
+            StatisticsRecorder&                 statistics_recorder);
     };
 
     // Constructor, builds the tree for a given assembly.
@@ -102,12 +105,16 @@ class CurveTree
         foundation::uint32  m_curve1_count;
         foundation::uint32  m_curve3_offset;
         foundation::uint32  m_curve3_count;
+        foundation::uint32  m_curve1_group_offset;
+        foundation::uint32  m_curve3_group_offset;
     };
 
-    const Arguments         m_arguments;
-    std::vector<Curve1Type> m_curves1;
-    std::vector<Curve3Type> m_curves3;
-    std::vector<CurveKey>   m_curve_keys;
+    const Arguments                                 m_arguments;
+    std::vector<Curve1Type>                         m_curves1;
+    std::vector<Curve3Type>                         m_curves3;
+    std::vector<CurveKey>                           m_curve_keys;
+    foundation::AlignedVector<Curve1GroupType>      m_curve1_groups;
+    foundation::AlignedVector<Curve3GroupType>      m_curve3_groups;
 
     void collect_curves(std::vector<GAABB3>& curve_bboxes);
 
@@ -124,6 +131,9 @@ class CurveTree
 
     // Reorder curve keys in leaf nodes so that all degree-1 curve keys come before degree-3 ones.
     void reorder_curve_keys_in_leaf_nodes();
+
+    // Build the groups of curves of each leaf node.
+    void build_curve_groups();
 };
 
 
@@ -276,35 +286,59 @@ inline bool CurveLeafVisitor::visit(
 {
     const CurveTree::LeafUserData& user_data = node.get_user_data<CurveTree::LeafUserData>();
 
-    size_t curve_index = node.get_item_index();
+    const size_t curve1_index = node.get_item_index();
+    const size_t curve3_index = curve1_index + user_data.m_curve1_count;
     size_t hit_curve_index = ~size_t(0);
     GScalar u, v, t = ray.m_tmax;
 
-    for (foundation::uint32 i = 0; i < user_data.m_curve1_count; ++i, ++curve_index)
+    // Groups are culled in ray space where distances are scaled by the norm of the ray direction.
+    const GScalar norm_dir = foundation::norm(ray.m_dir);
+
+    for (foundation::uint32 i = 0; i < user_data.m_curve1_count; i += Curve1GroupType::Size)
     {
-        const Curve1Type& curve = m_tree.m_curves1[user_data.m_curve1_offset + i];
-        if (Curve1IntersectorType::intersect(curve, ray, m_xfm_matrix, u, v, t))
+        const Curve1GroupType& group = m_tree.m_curve1_groups[user_data.m_curve1_group_offset + i / Curve1GroupType::Size];
+
+        size_t mask = group.intersect_bboxes(m_xfm_matrix, t * norm_dir);
+
+        for (size_t lane = 0; mask != 0; ++lane, mask >>= 1)
         {
-            m_shading_point.m_primitive_type = ShadingPoint::PrimitiveCurve1;
-            m_shading_point.m_ray.m_tmax = static_cast<double>(t);
-            m_shading_point.m_bary[0] = static_cast<float>(u);
-            m_shading_point.m_bary[1] = static_cast<float>(v);
-            hit_curve_index = curve_index;
+            if ((mask & 1) == 0)
+                continue;
+
+            const Curve1Type& curve = m_tree.m_curves1[user_data.m_curve1_offset + i + lane];
+            if (Curve1IntersectorType::intersect(curve, ray, m_xfm_matrix, u, v, t))
+            {
+                m_shading_point.m_primitive_type = ShadingPoint::PrimitiveCurve1;
+                m_shading_point.m_ray.m_tmax = static_cast<double>(t);
+                m_shading_point.m_bary[0] = static_cast<float>(u);
+                m_shading_point.m_bary[1] = static_cast<float>(v);
+                hit_curve_index = curve1_index + i + lane;
+            }
         }
     }
 
     FOUNDATION_BVH_TRAVERSAL_STATS(stats.m_intersected_items.insert(curve1_curve_count));
 
-    for (foundation::uint32 i = 0; i < user_data.m_curve3_count; ++i, ++curve_index)
+    for (foundation::uint32 i = 0; i < user_data.m_curve3_count; i += Curve3GroupType::Size)
     {
-        const Curve3Type& curve = m_tree.m_curves3[user_data.m_curve3_offset + i];
-        if (Curve3IntersectorType::intersect(curve, ray, m_xfm_matrix, u, v, t))
+        const Curve3GroupType& group = m_tree.m_curve3_groups[user_data.m_curve3_group_offset + i / Curve3GroupType::Size];
+
+        size_t mask = group.intersect_bboxes(m_xfm_matrix, t * norm_dir);
+
+        for (size_t lane = 0; mask != 0; ++lane, mask >>= 1)
         {
-            m_shading_point.m_primitive_type = ShadingPoint::PrimitiveCurve3;
-            m_shading_point.m_ray.m_tmax = static_cast<double>(t);
-            m_shading_point.m_bary[0] = static_cast<float>(u);
-            m_shading_point.m_bary[1] = static_cast<float>(v);
-            hit_curve_index = curve_index;
+            if ((mask & 1) == 0)
+                continue;
+
+            const Curve3Type& curve = m_tree.m_curves3[user_data.m_curve3_offset + i + lane];
+            if (Curve3IntersectorType::intersect(curve, ray, m_xfm_matrix, u, v, t))
+            {
+                m_shading_point.m_primitive_type = ShadingPoint::PrimitiveCurve3;
+                m_shading_point.m_ray.m_tmax = static_cast<double>(t);
+                m_shading_point.m_bary[0] = static_cast<float>(u);
+                m_shading_point.m_bary[1] = static_cast<float>(v);
+                hit_curve_index = curve3_index + i + lane;
+            }
         }
     }
 
@@ -347,27 +381,50 @@ inline bool CurveLeafProbeVisitor::visit(
 {
     const CurveTree::LeafUserData& user_data = node.get_user_data<CurveTree::LeafUserData>();
 
-    for (foundation::uint32 i = 0; i < user_data.m_curve1_count; ++i)
+    // Groups are culled in ray space where distances are scaled by the norm of the ray direction.
+    const GScalar max_z = ray.m_tmax * foundation::norm(ray.m_dir);
+
+    for (foundation::uint32 i = 0; i < user_data.m_curve1_count; i += Curve1GroupType::Size)
     {
-        const Curve1Type& curve = m_tree.m_curves1[user_data.m_curve1_offset + i];
-        if (Curve1IntersectorType::intersect(curve, ray, m_xfm_matrix))
+        const Curve1GroupType& group = m_tree.m_curve1_groups[user_data.m_curve1_group_offset + i / Curve1GroupType::Size];
+
+        size_t mask = group.intersect_bboxes(m_xfm_matrix, max_z);
+
+        for (size_t lane = 0; mask != 0; ++lane, mask >>= 1)
         {
-            FOUNDATION_BVH_TRAVERSAL_STATS(stats.m_intersected_items.insert(i + 1));
-            m_hit = true;
-            return false;
+            if ((mask & 1) == 0)
+                continue;
+
+            const Curve1Type& curve = m_tree.m_curves1[user_data.m_curve1_offset + i + lane];
+            if (Curve1IntersectorType::intersect(curve, ray, m_xfm_matrix))
+            {
+                FOUNDATION_BVH_TRAVERSAL_STATS(stats.m_intersected_items.insert(i + lane + 1));
+                m_hit = true;
+                return false;
+            }
         }
     }
 
     FOUNDATION_BVH_TRAVERSAL_STATS(stats.m_intersected_items.insert(curve1_curve_count));
 
-    for (foundation::uint32 i = 0; i < user_data.m_curve3_count; ++i)
+    for (foundation::uint32 i = 0; i < user_data.m_curve3_count; i += Curve3GroupType::Size)
     {
-        const Curve3Type& curve = m_tree.m_curves3[user_data.m_curve3_offset + i];
-        if (Curve3IntersectorType::intersect(curve, ray, m_xfm_matrix))
+        const Curve3GroupType& group = m_tree.m_curve3_groups[user_data.m_curve3_group_offset + i / Curve3GroupType::Size];
+
+        size_t mask = group.intersect_bboxes(m_xfm_matrix, max_z);
+
+        for (size_t lane = 0; mask != 0; ++lane, mask >>= 1)
         {
-            FOUNDATION_BVH_TRAVERSAL_STATS(stats.m_intersected_items.insert(i + 1));
-            m_hit = true;
-            return false;
+            if ((mask & 1) == 0)
+                continue;
+
+            const Curve3Type& curve = m_tree.m_curves3[user_data.m_curve3_offset + i + lane];
+            if (Curve3IntersectorType::intersect(curve, ray, m_xfm_matrix))
+            {
+                FOUNDATION_BVH_TRAVERSAL_STATS(stats.m_intersected_items.insert(i + lane + 1));
+                m_hit = true;
+                return false;
+            }
         }
     }
 
@@ -40,6 +40,7 @@
 #include "renderer/modeling/object/triangle.h"
 #include "renderer/modeling/scene/assembly.h"
 #include "renderer/modeling/scene/containers.h"
+#include "renderer/utility/statisticsrecorder.h"
 
 // appleseed.foundation headers.
 #include "foundation/math/area.h"
@@ -117,14 +118,18 @@ namespace
         assert(region_kit->size() == 1);
         const size_t region_idx = 0;
         const IRegion* region = region_kit->at(region_idx);
-        const Access<StaticTriangleTess> tess(&region->get_static_triangle_tess());
-        const unsigned int motion_steps_count = static_cast<unsigned int>(tess->get_motion_segment_count()) + 1;
+        const Access<StaticTriangleTess> tess_access(&region->get_static_triangle_tess());
+
+        // Geometry that could not be loaded (e.g. a page file that could not be read) is left empty.
+        static const StaticTriangleTess EmptyTess;
+        const StaticTriangleTess& tess = tess_access.get() != nullptr ? tess_access.ref() : EmptyTess;
+        const unsigned int motion_steps_count = static_cast<unsigned int>(tess.get_motion_segment_count()) + 1;
         geometry_data.m_motion_steps_count = motion_steps_count;
 
         //
         // Retrieve per vertex data.
         //
-        const unsigned int vertices_count = static_cast<unsigned int>(tess->m_vertices.size());
+        const unsigned int vertices_count = static_cast<unsigned int>(tess.m_vertices.size());
         geometry_data.m_vertices_count = vertices_count;
         geometry_data.m_vertices_stride = sizeof(GVector3);
 
@@ -134,7 +139,7 @@ namespace
         // Retrieve assembly space vertices.
         for (size_t i = 0; i < vertices_count; ++i)
         {
-            const GVector3& vertex_os = tess->m_vertices[i];
+            const GVector3& vertex_os = tess.m_vertices[i];
             geometry_data.m_vertices[i] = transform.point_to_parent(vertex_os);
         }
 
@@ -142,7 +147,7 @@ namespace
         {
             for (size_t i = 0; i < vertices_count; ++i)
             {
-                const GVector3& vertex_os = tess->get_vertex_pose(i, m - 1);
+                const GVector3& vertex_os = tess.get_vertex_pose(i, m - 1);
                 geometry_data.m_vertices[vertices_count * m + i] = transform.point_to_parent(vertex_os);
             }
         }
@@ -150,7 +155,7 @@ namespace
         //
         // Retrieve per primitive data.
         //
-        const size_t primitives_count = tess->m_primitives.size();
+        const size_t primitives_count = tess.m_primitives.size();
 
         geometry_data.m_primitives = new uint32[primitives_count * 3];
         geometry_data.m_primitives_stride = sizeof(uint32) * 3;
@@ -158,9 +163,9 @@ namespace
 
         for (size_t i = 0; i < primitives_count; ++i)
         {
-            geometry_data.m_primitives[i * 3] = tess->m_primitives[i].m_v0;
-            geometry_data.m_primitives[i * 3 + 1] = tess->m_primitives[i].m_v1;
-            geometry_data.m_primitives[i * 3 + 2] = tess->m_primitives[i].m_v2;
+            geometry_data.m_primitives[i * 3] = tess.m_primitives[i].m_v0;
+            geometry_data.m_primitives[i * 3 + 1] = tess.m_primitives[i].m_v1;
+            geometry_data.m_primitives[i * 3 + 2] = tess.m_primitives[i].m_v2;
         }
     };
 
@@ -404,10 +409,12 @@ EmbreeScene::EmbreeScene(const EmbreeScene::Arguments& arguments)
 
     statistics.insert_time("total build time", stopwatch.measure().get_seconds());
 
-    RENDERER_LOG_DEBUG("%s",
+    const StatisticsVector statistics_vector =
         StatisticsVector::make(
             "Embree scene #" + to_string(arguments.m_assembly.get_uid()) + " statistics",
-            statistics).to_string().c_str());
+            statistics);
+    RENDERER_LOG_DEBUG("%s", statistics_vector.to_string().c_str());
+    arguments.m_statistics_recorder.record(statistics_vector);
 }
 
 EmbreeScene::~EmbreeScene()
@@ -53,6 +53,7 @@
 namespace renderer { class Assembly; }
 namespace renderer { class ShadingPoint; }
 namespace renderer { class ShadingRay; }
+namespace renderer { class StatisticsRecorder; }
 
 namespace renderer
 {
@@ -84,12 +85,15 @@ class EmbreeScene
     {
         const EmbreeDevice&     m_device;
         const Assembly&         m_assembly;
+        StatisticsRecorder&     m_statistics_recorder;
 
-        explicit Arguments(
+        Arguments(
             const EmbreeDevice&     embree_device,
-            const Assembly&         assembly)
+            const Assembly&         assembly,
+            StatisticsRecorder&     statistics_recorder)
           : m_device(embree_device)
           , m_assembly(assembly)
+          , m_statistics_recorder(statistics_recorder)
         {}
     };
 
@@ -67,7 +67,8 @@ namespace
             const IRegion* region = *i;
             Access<StaticTriangleTess> tess(&region->get_static_triangle_tess());
 
-            triangle_count += tess->m_primitives.size();
+            if (tess.get() != nullptr)
+                triangle_count += tess->m_primitives.size();
         }
 
         return triangle_count;
@@ -105,7 +106,8 @@ namespace
             const IRegion* region = *i;
             Access<StaticTriangleTess> tess(&region->get_static_triangle_tess());
 
-            copy_uv_coordinates(*tess, uv);
+            if (tess.get() != nullptr)
+                copy_uv_coordinates(*tess, uv);
         }
     }
 }
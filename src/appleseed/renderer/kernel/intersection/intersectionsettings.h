@@ -35,6 +35,7 @@
 
 // appleseed.foundation headers.
 #include "foundation/math/beziercurve.h"
+#include "foundation/math/beziercurvegroup.h"
 #include "foundation/math/intersection/raytrianglemt.h"
 #include "foundation/math/matrix.h"
 
@@ -126,11 +127,15 @@ typedef foundation::BezierCurve3<GScalar> Curve3Type;
 typedef foundation::BezierCurveIntersector<Curve1Type> Curve1IntersectorType;
 typedef foundation::BezierCurveIntersector<Curve3Type> Curve3IntersectorType;
 
+// Groups of curves culled together (SoA layout) before running the curve intersectors.
+typedef foundation::BezierCurveGroup<Curve1Type> Curve1GroupType;
+typedef foundation::BezierCurveGroup<Curve3Type> Curve3GroupType;
+
 // Matrix used in curve intersections
 typedef foundation::Matrix<GScalar, 4, 4> CurveMatrixType;
 
-// Maximum number of curves per leaf.
-const size_t CurveTreeDefaultMaxLeafSize = 1;
+// Maximum number of curves per leaf, such that the curves of a given degree fit in a single group.
+const size_t CurveTreeDefaultMaxLeafSize = Curve1GroupType::Size;
 
 // Relative cost of traversing an interior node.
 const GScalar CurveTreeDefaultInteriorNodeTraversalCost(1.0);
@@ -34,8 +34,10 @@
 #include "renderer/global/globallogger.h"
 #include "renderer/kernel/intersection/assemblytree.h"
 #include "renderer/kernel/intersection/tracecontext.h"
+#include "renderer/kernel/rendering/costtracker.h"
 #include "renderer/kernel/shading/shadingray.h"
 #include "renderer/modeling/scene/assemblyinstance.h"
+#include "renderer/modeling/scene/visibilityflags.h"
 
 // appleseed.foundation headers.
 #include "foundation/platform/compiler.h"
@@ -68,6 +70,18 @@ Intersector::Intersector(
   , m_shading_ray_count(0)
   , m_probe_ray_count(0)
 {
+    static_assert(
+        VisibilityFlags::NPRRay == 1 << (RayTypeCount - 1),
+        "RayTypeCount must match the number of visibility flags");
+
+    for (size_t i = 0; i < RayTypeCount; ++i)
+        m_ray_type_counts[i] = 0;
+}
+
+void Intersector::count_ray_types(const ShadingRay& ray) const
+{
+    for (size_t i = 0; i < RayTypeCount; ++i)
+        m_ray_type_counts[i] += (ray.m_flags >> i) & 1;
 }
 
 Vector3d Intersector::refine(
@@ -241,6 +255,8 @@ bool Intersector::trace(
     ShadingPoint&                       shading_point,
     const ShadingPoint*                 parent_shading_point) const
 {
+    CostScope cost_scope(CostTracker::Traversal);
+
     assert(is_normalized(ray.m_dir));
     assert(shading_point.m_scene == nullptr);
     assert(!shading_point.is_valid());
@@ -249,6 +265,7 @@ bool Intersector::trace(
 
     // Update ray casting statistics.
     ++m_shading_ray_count;
+    count_ray_types(ray);
 
     // Initialize the shading point.
     shading_point.m_region_kit_cache = &m_region_kit_cache;
@@ -310,11 +327,14 @@ bool Intersector::trace_probe(
     const ShadingRay&                   ray,
     const ShadingPoint*                 parent_shading_point) const
 {
+    CostScope cost_scope(CostTracker::Traversal);
+
     assert(is_normalized(ray.m_dir));
     assert(parent_shading_point == 0 || parent_shading_point->hit_surface());
 
     // Update ray casting statistics.
     ++m_probe_ray_count;
+    count_ray_types(ray);
 
     // Compute ray info once for the entire traversal.
     const ShadingRay::RayInfoType ray_info(ray);
@@ -461,6 +481,11 @@ namespace
         {
             return pretty_uint(m_ray_count) + " (" + pretty_percent(m_ray_count, m_total_ray_count) + ")";
         }
+
+        string to_json() const override
+        {
+            return std::to_string(m_ray_count);
+        }
     };
 }
 
@@ -483,9 +508,22 @@ StatisticsVector Intersector::get_statistics() const
                 m_probe_ray_count,
                 total_ray_count)));
 
+    // A ray may be of several types at once.
+    Statistics ray_type_stats;
+    for (size_t i = 0; i < RayTypeCount; ++i)
+    {
+        ray_type_stats.insert(
+            unique_ptr<RayCountStatisticsEntry>(
+                new RayCountStatisticsEntry(
+                    VisibilityFlags::Names[i],
+                    m_ray_type_counts[i],
+                    total_ray_count)));
+    }
+
     StatisticsVector vec;
 
     vec.insert("intersection statistics", intersection_stats);
+    vec.insert("ray type statistics", ray_type_stats);
 
 #ifdef FOUNDATION_BVH_ENABLE_TRAVERSAL_STATS
     vec.insert(
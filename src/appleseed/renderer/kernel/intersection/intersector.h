@@ -148,13 +148,18 @@ class Intersector
     mutable StaticTriangleTessAccessCache           m_tess_cache;
 
     // Intersection statistics.
+    enum { RayTypeCount = 10 };                     // must match the number of visibility flags
     mutable foundation::uint64                      m_shading_ray_count;
     mutable foundation::uint64                      m_probe_ray_count;
+    mutable foundation::uint64                      m_ray_type_counts[RayTypeCount];
 #ifdef FOUNDATION_BVH_ENABLE_TRAVERSAL_STATS
     mutable foundation::bvh::TraversalStatistics    m_assembly_tree_traversal_stats;
     mutable foundation::bvh::TraversalStatistics    m_triangle_tree_traversal_stats;
     mutable foundation::bvh::TraversalStatistics    m_curve_tree_traversal_stats;
 #endif
+
+    // Update per-type ray counts.
+    void count_ray_types(const ShadingRay& ray) const;
 };
 
 }       // namespace renderer
@@ -412,12 +412,14 @@ namespace
 //
 
 RegionTree::Arguments::Arguments(
-    const Scene&    scene,
-    const UniqueID  assembly_uid,
-    const Assembly& assembly)
+    const Scene&        scene,
+    const UniqueID      assembly_uid,
+    const Assembly&     assembly,
+    StatisticsRecorder& statistics_recorder)
   : m_scene(scene)
   , m_assembly_uid(assembly_uid)
   , m_assembly(assembly)
+  , m_statistics_recorder(statistics_recorder)
 {
 }
 
@@ -451,7 +453,8 @@ RegionTree::RegionTree(const Arguments& arguments)
                     triangle_tree_uid,
                     interm_leaf->m_extent,
                     interm_leaf->m_assembly,
-                    interm_leaf->m_regions)));
+                    interm_leaf->m_regions,
+                    arguments.m_statistics_recorder)));
 
         // Create and store the triangle tree.
         m_triangle_trees.insert(
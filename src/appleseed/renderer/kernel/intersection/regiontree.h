@@ -54,6 +54,7 @@ namespace renderer  { class Assembly; }
 namespace renderer  { class RegionTree; }
 namespace renderer  { class Scene; }
 namespace renderer  { class ShadingPoint; }
+namespace renderer  { class StatisticsRecorder; }
 
 namespace renderer
 {
@@ -97,12 +98,14 @@ class RegionTree
         const Scene&                    m_scene;
         const foundation::UniqueID      m_assembly_uid;
         const Assembly&                 m_assembly;
+        StatisticsRecorder&             m_statistics_recorder;
 
         // Constructor.
         Arguments(
             const Scene&                scene,
             const foundation::UniqueID  assembly_uid,
-            const Assembly&             assembly);
+            const Assembly&             assembly,
+            StatisticsRecorder&         statistics_recorder);
     };
 
     // Constructor, builds the tree for a given assembly.
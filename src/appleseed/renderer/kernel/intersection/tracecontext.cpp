@@ -40,9 +40,11 @@
 #include "renderer/kernel/shading/shadingpoint.h"
 #include "renderer/kernel/shading/shadingray.h"
 #include "renderer/kernel/shading/shadingresult.h"
+#include "renderer/utility/statisticsrecorder.h"
 
 // appleseed.foundation headers.
 #include "foundation/math/bvh.h"
+#include "foundation/utility/profiler.h"
 #include "foundation/utility/string.h"
 
 // Standard headers.
@@ -59,7 +61,8 @@ namespace renderer
 
 TraceContext::TraceContext(const Scene& scene)
   : m_scene(scene)
-  , m_assembly_tree(new AssemblyTree(scene))
+  , m_statistics_recorder(new StatisticsRecorder())
+  , m_assembly_tree(new AssemblyTree(scene, *m_statistics_recorder))
 {
     RENDERER_LOG_DEBUG(
         "data structures size:\n"
@@ -82,10 +85,13 @@ TraceContext::TraceContext(const Scene& scene)
 TraceContext::~TraceContext()
 {
     delete m_assembly_tree;
+    delete m_statistics_recorder;
 }
 
 void TraceContext::update()
 {
+    ProfileZone profile_zone("update trace context");
+
     m_assembly_tree->update();
 }
 
@@ -39,6 +39,7 @@
 // Forward declarations.
 namespace renderer  { class AssemblyTree; }
 namespace renderer  { class Scene; }
+namespace renderer  { class StatisticsRecorder; }
 
 namespace renderer
 {
@@ -66,6 +67,10 @@ class APPLESEED_DLLSYMBOL TraceContext
     // Get the assembly tree.
     const AssemblyTree& get_assembly_tree() const;
 
+    // Get the record of the statistics of the acceleration structures built so far.
+    // Acceleration structures may be built lazily, while rendering.
+    StatisticsRecorder& get_statistics_recorder() const;
+
     // Synchronize the trace context with the scene.
     void update();
 
@@ -74,8 +79,9 @@ class APPLESEED_DLLSYMBOL TraceContext
 #endif
 
   private:
-    const Scene&    m_scene;
-    AssemblyTree*   m_assembly_tree;
+    const Scene&            m_scene;
+    StatisticsRecorder*     m_statistics_recorder;
+    AssemblyTree*           m_assembly_tree;
 };
 
 
@@ -93,6 +99,11 @@ inline const AssemblyTree& TraceContext::get_assembly_tree() const
     return *m_assembly_tree;
 }
 
+inline StatisticsRecorder& TraceContext::get_statistics_recorder() const
+{
+    return *m_statistics_recorder;
+}
+
 }       // namespace renderer
 
 #endif  // !APPLESEED_RENDERER_KERNEL_INTERSECTION_TRACECONTEXT_H
@@ -53,6 +53,7 @@
 #include "renderer/utility/bbox.h"
 #include "renderer/utility/messagecontext.h"
 #include "renderer/utility/paramarray.h"
+#include "renderer/utility/statisticsrecorder.h"
 
 // appleseed.foundation headers.
 #include "foundation/math/area.h"
@@ -359,6 +360,10 @@ namespace
             // Retrieve the tessellation of the region.
             Access<StaticTriangleTess> tess(&region->get_static_triangle_tess());
 
+            // Skip tessellations that could not be loaded.
+            if (tess.get() == nullptr)
+                continue;
+
             // Collect the triangles from this tessellation.
             if (tess->get_motion_segment_count() > 0)
             {
@@ -398,12 +403,14 @@ TriangleTree::Arguments::Arguments(
     const UniqueID          triangle_tree_uid,
     const GAABB3&           bbox,
     const Assembly&         assembly,
-    const RegionInfoVector& regions)
+    const RegionInfoVector& regions,
+    StatisticsRecorder&     statistics_recorder)
   : m_scene(scene)
   , m_triangle_tree_uid(triangle_tree_uid)
   , m_bbox(bbox)
   , m_assembly(assembly)
   , m_regions(regions)
+  , m_statistics_recorder(statistics_recorder)
 {
 }
 
@@ -438,11 +445,13 @@ TriangleTree::TriangleTree(const Arguments& arguments)
     assert(m_nodes.size() == m_nodes.capacity());
 #endif
 
-    // Print triangle tree statistics.
-    RENDERER_LOG_DEBUG("%s",
+    // Print and record triangle tree statistics.
+    const StatisticsVector statistics_vector =
         StatisticsVector::make(
             "triangle tree #" + to_string(m_arguments.m_triangle_tree_uid) + " statistics",
-            statistics).to_string().c_str());
+            statistics);
+    RENDERER_LOG_DEBUG("%s", statistics_vector.to_string().c_str());
+    m_arguments.m_statistics_recorder.record(statistics_vector);
 }
 
 TriangleTree::~TriangleTree()
@@ -63,6 +63,7 @@ namespace renderer      { class IntersectionFilter; }
 namespace renderer      { class ParamArray; }
 namespace renderer      { class Scene; }
 namespace renderer      { class ShadingPoint; }
+namespace renderer      { class StatisticsRecorder; }
 
 namespace renderer
 {
@@ -90,6 +91,7 @@ class TriangleTree
         const GAABB3                            m_bbox;
         const Assembly&                         m_assembly;
         const RegionInfoVector                  m_regions;
+        StatisticsRecorder&                     m_statistics_recorder;
 
         // Constructor.
         Arguments(
@@ -97,7 +99,8 @@ class TriangleTree
             const foundation::UniqueID          triangle_tree_uid,
             const GAABB3&                       bbox,
             const Assembly&                     assembly,
-            const RegionInfoVector&             regions);
+            const RegionInfoVector&             regions,
+            StatisticsRecorder&                 statistics_recorder);
     };
 
     // Constructor, builds the tree for a given set of regions.
@@ -55,7 +55,8 @@ namespace renderer
 
 BackwardLightSampler::BackwardLightSampler(
     const Scene&                        scene,
-    const ParamArray&                   params)
+    const ParamArray&                   params,
+    StatisticsRecorder*                 statistics_recorder)
   : LightSamplerBase(params)
 {
     // Read which sampling algorithm should be used.
@@ -139,7 +140,7 @@ BackwardLightSampler::BackwardLightSampler(
         m_light_tree.reset(new LightTree(m_light_tree_lights, m_emitting_triangles));
 
         // Build the light tree.
-        const vector<size_t> tri_index_to_node_index = m_light_tree->build();
+        const vector<size_t> tri_index_to_node_index = m_light_tree->build(statistics_recorder);
         assert(tri_index_to_node_index.size() == m_emitting_triangles.size());
 
         // Associate light tree nodes to emitting triangles.
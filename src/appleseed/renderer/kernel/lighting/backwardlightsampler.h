@@ -49,6 +49,7 @@ namespace foundation    { class Dictionary; }
 namespace renderer      { class LightSample; }
 namespace renderer      { class Scene; }
 namespace renderer      { class ShadingPoint; }
+namespace renderer      { class StatisticsRecorder; }
 
 namespace renderer
 {
@@ -62,10 +63,12 @@ class BackwardLightSampler
   : public LightSamplerBase
 {
   public:
-    // Constructor.
+    // Constructor. Statistics of the light tree, if one is built, are recorded
+    // into a given recorder, if any.
     BackwardLightSampler(
         const Scene&                        scene,
-        const ParamArray&                   params = ParamArray());
+        const ParamArray&                   params = ParamArray(),
+        StatisticsRecorder*                 statistics_recorder = nullptr);
 
     // Return true if the scene contains at least one non-physical light or emitting triangle.
     bool has_lights() const;
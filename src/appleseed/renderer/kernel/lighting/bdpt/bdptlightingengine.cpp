@@ -31,12 +31,15 @@
 
 // appleseed.renderer headers.
 #include "renderer/kernel/lighting/forwardlightsampler.h"
+#include "renderer/kernel/lighting/lightsample.h"
 #include "renderer/kernel/lighting/pathtracer.h"
 #include "renderer/kernel/lighting/tracer.h"
 #include "renderer/kernel/shading/shadingcomponents.h"
 #include "renderer/kernel/shading/shadingcontext.h"
+#include "renderer/modeling/bsdf/bsdf.h"
 #include "renderer/modeling/camera/camera.h"
 #include "renderer/modeling/edf/edf.h"
+#include "renderer/modeling/light/light.h"
 #include "renderer/modeling/material/material.h"
 #include "renderer/modeling/project/project.h"
 
@@ -46,6 +49,10 @@
 #include "foundation/utility/arena.h"
 #include "foundation/utility/statistics.h"
 
+// Standard headers.
+#include <cmath>
+#include <vector>
+
 using namespace foundation;
 using namespace std;
 
@@ -57,54 +64,141 @@ namespace
     //
     // Bidirectional Path Tracing lighting engine.
     //
+    // Subpath vertices are allocated from a per-engine arena that is cleared at
+    // the beginning of every sample. Forward and reverse densities are expressed
+    // in area measure and are computed once per subpath, so that the MIS weight
+    // of a connection can be evaluated in time linear in the path length.
+    //
+    // Non-physical lights (point, spot, directional lights...) cannot be hit by
+    // camera subpaths and do not expose the density of their emission directions.
+    // They are only connected directly to camera vertices (s = 1), which is then
+    // the only strategy for paths starting on them; in particular, caustics cast
+    // by non-physical lights are not rendered.
+    //
+    // Vertex merging and light vertex caching (VCM) are not implemented.
+    //
+    // Reference:
+    //
+    //   Physically Based Rendering, Third Edition, section 16.3.
+    //   http://www.pbr-book.org/3ed-2018/Light_Transport_III_Bidirectional_Methods/Bidirectional_Path_Tracing.html
+    //
 
-    enum class BDPTVertexType
-    {
-        Camera, Light, Surface, Medium
-    };
-
-    /// TODO:: decide if we should use existing PathVertex (in PathVertex.h) or just keep using BDPTVertex
     struct BDPTVertex
     {
         Vector3d                m_position;
         Vector3d                m_geometric_normal;
+        Basis3f                 m_shading_basis;
+        Vector3f                m_dir_to_prev_vertex;
         Spectrum                m_beta;
+        Spectrum                m_Le;                       // radiance emitted toward the previous vertex
         const BSDF*             m_bsdf;
         const void*             m_bsdf_data;
-        Vector3d                m_dir_to_prev_vertex;
-        const BDPTVertex*       m_prev_vertex;
-        Basis3f                 m_shading_basis;
-        Spectrum                m_Le;
-        ShadingPoint            m_shading_point;
+        const EDF*              m_edf;
+        const void*             m_edf_data;
+        const Light*            m_light;                    // non-physical light emitting from this vertex
+        float                   m_fwd_pdf;                  // area density of this vertex when sampled from its predecessor
+        float                   m_rev_pdf;                  // area density of this vertex when sampled from its successor
+        float                   m_light_pdf;                // area density of this vertex when sampled by the light sampler
+        float                   m_emission_pdf;             // solid angle density of emitting toward the previous vertex
+        bool                    m_is_specular;              // was the next vertex sampled with a Dirac delta?
         bool                    m_is_light_vertex;
 
-        float                   m_fwd_pdf;
-        float                   m_rev_pdf;
-
         BDPTVertex()
           : m_beta(0.0f)
+          , m_Le(0.0f)
           , m_bsdf(nullptr)
           , m_bsdf_data(nullptr)
-          , m_prev_vertex(nullptr)
-          , m_Le(0.0f)
-          , m_is_light_vertex(false)
+          , m_edf(nullptr)
+          , m_edf_data(nullptr)
+          , m_light(nullptr)
           , m_fwd_pdf(0.0f)
           , m_rev_pdf(0.0f)
+          , m_light_pdf(0.0f)
+          , m_emission_pdf(0.0f)
+          , m_is_specular(false)
+          , m_is_light_vertex(false)
         {
         }
 
-        double convert_density(double pdf, const BDPTVertex& vertex) const
+        Vector3f get_direction_to(const BDPTVertex& vertex) const
         {
-            const Vector3d w = m_position - vertex.m_position;
+            return Vector3f(normalize(vertex.m_position - m_position));
+        }
+
+        float evaluate_bsdf_pdf(
+            const bool          adjoint,
+            const Vector3f&     outgoing,
+            const Vector3f&     incoming) const
+        {
+            assert(m_bsdf != nullptr);
+
+            return
+                m_bsdf->evaluate_pdf(
+                    m_bsdf_data,
+                    adjoint,
+                    Vector3f(m_geometric_normal),
+                    m_shading_basis,
+                    outgoing,
+                    incoming,
+                    ScatteringMode::All);
+        }
+
+        float evaluate_edf_pdf(const Vector3f& outgoing) const
+        {
+            assert(m_edf != nullptr);
+
+            return
+                m_edf->evaluate_pdf(
+                    m_edf_data,
+                    Vector3f(m_geometric_normal),
+                    m_shading_basis,
+                    outgoing);
+        }
+
+        // Convert a solid angle density at this vertex to an area density at another vertex.
+        float convert_density(const float pdf, const BDPTVertex& vertex) const
+        {
+            const Vector3d w = vertex.m_position - m_position;
             const double dist2 = square_norm(w);
             if (dist2 == 0.0)
-                return 0.0;
+                return 0.0f;
             const double rcp_dist2 = 1.0 / dist2;
-            pdf *= max(dot(vertex.m_geometric_normal, w * sqrt(rcp_dist2)), 0.0);
-            return pdf * rcp_dist2;
+            const double cos_theta = abs(dot(vertex.m_geometric_normal, w)) * sqrt(rcp_dist2);
+            return static_cast<float>(pdf * cos_theta * rcp_dist2);
         }
     };
 
+    inline float remap0(const float pdf)
+    {
+        return pdf != 0.0f ? pdf : 1.0f;
+    }
+
+    // Compute reverse densities of all vertices that have both a predecessor and a successor.
+    void compute_reverse_pdfs(
+        const vector<BDPTVertex*>&  vertices,
+        const bool                  adjoint)
+    {
+        for (size_t i = 1; i + 1 < vertices.size(); ++i)
+        {
+            const BDPTVertex& vertex = *vertices[i];
+            BDPTVertex& prev_vertex = *vertices[i - 1];
+
+            if (vertex.m_bsdf == nullptr || vertex.m_is_specular)
+            {
+                prev_vertex.m_rev_pdf = 0.0f;
+                continue;
+            }
+
+            const float pdf =
+                vertex.evaluate_bsdf_pdf(
+                    !adjoint,
+                    vertex.get_direction_to(*vertices[i + 1]),
+                    vertex.m_dir_to_prev_vertex);
+
+            prev_vertex.m_rev_pdf = vertex.convert_density(pdf, prev_vertex);
+        }
+    }
+
     /// TODO:: supports the case where t == 1 (if pdf for camera can be queried)
     class BDPTLightingEngine
       : public ILightingEngine
@@ -113,9 +207,11 @@ namespace
         struct Parameters
         {
             const size_t    m_max_bounces;                  // maximum number of bounces, ~0 for unlimited
+            const size_t    m_rr_min_path_length;           // minimum path length before Russian Roulette kicks in, ~0 to disable it
 
             explicit Parameters(const ParamArray& params)
-                : m_max_bounces(fixup_bounces(params.get_optional<int>("max_bounces", 8)))
+              : m_max_bounces(fixup_bounces(params.get_optional<int>("max_bounces", 8)))
+              , m_rr_min_path_length(fixup_path_length(params.get_optional<size_t>("rr_min_path_length", 0)))
             {
             }
 
@@ -123,20 +219,29 @@ namespace
             {
                 return x == -1 ? ~size_t(0) : x;
             }
+
+            static size_t fixup_path_length(const size_t x)
+            {
+                return x == 0 ? ~size_t(0) : x;
+            }
         };
 
         BDPTLightingEngine(
             const Project&              project,
             const ForwardLightSampler&  light_sampler,
             const ParamArray&           params)
-          : m_light_sampler(light_sampler)
-          , m_params(params)
+          : m_params(params)
+          , m_light_sampler(light_sampler)
         {
             const Camera* camera = project.get_uncached_active_camera();
             m_shutter_open_begin_time = camera->get_shutter_open_begin_time();
             m_shutter_close_end_time = camera->get_shutter_close_end_time();
 
-            m_num_max_vertices = m_params.m_max_bounces + 3;
+            // Each subpath may bounce one more time than the full path since the
+            // connection segment is not traced by the path tracers.
+            const bool unlimited = m_params.m_max_bounces == ~size_t(0);
+            m_num_max_vertices = unlimited ? ~size_t(0) : m_params.m_max_bounces + 3;
+            m_max_subpath_bounces = unlimited ? ~size_t(0) : m_params.m_max_bounces + 1;
         }
 
         void release() override
@@ -156,27 +261,25 @@ namespace
             ShadingComponents&          radiance,               // output radiance, in W.sr^-1.m^-2
             AOVComponents&              components) override
         {
-            /// TODO:: use arena to alloc BDPTVertices instead
-            BDPTVertex* camera_vertices = new BDPTVertex[m_num_max_vertices - 1];
-            BDPTVertex* light_vertices = new BDPTVertex[m_num_max_vertices];
+            m_vertex_arena.clear();
+            m_light_vertices.clear();
+            m_camera_vertices.clear();
 
-            size_t num_light_vertices = trace_light(sampling_context, shading_context, light_vertices);
-            size_t num_camera_vertices = trace_camera(sampling_context, shading_context, shading_point, camera_vertices);
+            trace_light(sampling_context, shading_context);
+            trace_camera(sampling_context, shading_context, shading_point);
 
-            assert(num_camera_vertices <= m_num_max_vertices - 1);
-            assert(num_light_vertices <= m_num_max_vertices);
+            const size_t num_light_vertices = m_light_vertices.size();
+            const size_t num_camera_vertices = m_camera_vertices.size();
 
             for (size_t s = 0; s < num_light_vertices + 1; s++)
             {
                 for (size_t t = 2; t < num_camera_vertices + 2; t++)
                 {
-                    if (s + t <= m_num_max_vertices)
-                        connect(shading_context, shading_point, light_vertices, camera_vertices, s, t, radiance);
+                    // Written to avoid overflowing when the number of vertices is unlimited.
+                    if (s <= m_num_max_vertices && t <= m_num_max_vertices - s)
+                        connect(shading_context, shading_point, s, t, radiance);
                 }
             }
-
-            delete[] camera_vertices;
-            delete[] light_vertices;
         }
 
         // todo: use an output parameter instead of returning a spectrum.
@@ -191,8 +294,8 @@ namespace
             const double dist2 = square_norm(v);
 
             /// TODO:: the special care have to be taken for these dot products when it comes to volume
-            const double cos1 = max(-dot(normalized_v, b.m_geometric_normal), 0.0);
-            const double cos2 = max(dot(normalized_v, a.m_geometric_normal), 0.0);
+            const double cos1 = abs(dot(normalized_v, b.m_geometric_normal));
+            const double cos2 = abs(dot(normalized_v, a.m_geometric_normal));
 
             Spectrum result(0.0f);
 
@@ -214,133 +317,138 @@ namespace
             return result;
         }
 
-        /// TODO:: precompute path density using fwd_pdf and rev_pdf.
-        /// in the final code, this function should be removed and the mis weight computation should be very simple.
-        /// example: https://github.com/mmp/pbrt-v3/blob/master/src/integrators/bdpt.cpp#L228
-        float compute_path_density(
-            BDPTVertex*                 light_vertices,
-            BDPTVertex*                 camera_vertices,
+        // Compute the balance heuristic weight of the strategy (s, t) from the
+        // precomputed densities, temporarily replacing those that depend on the
+        // connection segment.
+        float compute_mis_weight(
             const size_t                s,
-            const size_t                t,
-            const size_t                p,
-            const size_t                q)
+            const size_t                t)
         {
-            assert(p + q == s + t);
+            assert(t >= 2);
+
+            // Directly visible emitters can only be sampled by unidirectional path tracing.
+            if (s + t == 2)
+                return 1.0f;
 
-            // get i Vertex in the constructed path
-            // i = 1 correspond first vertex of the full path
+            // Paths starting on non-physical lights can only be sampled by direct connections.
+            if (s == 1 && m_light_vertices[0]->m_light != nullptr)
+                return 1.0f;
 
-            auto get_vertex_start_from_light = [&](const size_t i)
+            BDPTVertex& pt = *m_camera_vertices[t - 2];
+            BDPTVertex* pt_minus = t > 2 ? m_camera_vertices[t - 3] : nullptr;
+            BDPTVertex* qs = s > 0 ? m_light_vertices[s - 1] : nullptr;
+            BDPTVertex* qs_minus = s > 1 ? m_light_vertices[s - 2] : nullptr;
+
+            // Compute the densities involving the connection segment.
+            float pt_rev, pt_minus_rev = 0.0f, qs_rev = 0.0f, qs_minus_rev = 0.0f;
+            if (s == 0)
+            {
+                pt_rev = pt.m_light_pdf;
+                if (pt_minus)
+                    pt_minus_rev = pt.convert_density(pt.m_emission_pdf, *pt_minus);
+            }
+            else
             {
-                if (i <= s)
+                const Vector3f pt_to_qs = pt.get_direction_to(*qs);
+                const Vector3f qs_to_pt = -pt_to_qs;
+
+                pt_rev =
+                    s == 1
+                        ? qs->convert_density(qs->evaluate_edf_pdf(qs_to_pt), pt)
+                        : qs->convert_density(qs->evaluate_bsdf_pdf(true, qs->m_dir_to_prev_vertex, qs_to_pt), pt);
+
+                if (pt_minus)
                 {
-                    return &light_vertices[i - 1];
+                    pt_minus_rev =
+                        pt.convert_density(
+                            pt.evaluate_bsdf_pdf(true, pt_to_qs, pt.m_dir_to_prev_vertex),
+                            *pt_minus);
                 }
-                else
+
+                qs_rev =
+                    pt.convert_density(
+                        pt.evaluate_bsdf_pdf(false, pt.m_dir_to_prev_vertex, pt_to_qs),
+                        *qs);
+
+                if (qs_minus)
                 {
-                    return &camera_vertices[s + t - i - 1];
+                    qs_minus_rev =
+                        qs->convert_density(
+                            qs->evaluate_bsdf_pdf(false, qs_to_pt, qs->m_dir_to_prev_vertex),
+                            *qs_minus);
                 }
-            };
+            }
 
-            auto get_vertex_start_from_camera = [&](const size_t i)
+            // Swap them in, along with the fact that the connection endpoints are never specular.
+            const float saved_pt_rev = pt.m_rev_pdf;
+            const bool saved_pt_is_specular = pt.m_is_specular;
+            const float saved_pt_minus_rev = pt_minus ? pt_minus->m_rev_pdf : 0.0f;
+            const float saved_qs_rev = qs ? qs->m_rev_pdf : 0.0f;
+            const bool saved_qs_is_specular = qs ? qs->m_is_specular : false;
+            const float saved_qs_minus_rev = qs_minus ? qs_minus->m_rev_pdf : 0.0f;
+
+            pt.m_rev_pdf = pt_rev;
+            pt.m_is_specular = false;
+            if (pt_minus)
+                pt_minus->m_rev_pdf = pt_minus_rev;
+            if (qs)
             {
-                if (i <= t)
-                {
-                    return &camera_vertices[i - 2];
-                }
-                else
-                {
-                    return &light_vertices[s + t - i];
-                }
-            };
+                qs->m_rev_pdf = qs_rev;
+                qs->m_is_specular = false;
+            }
+            if (qs_minus)
+                qs_minus->m_rev_pdf = qs_minus_rev;
 
-            /// TODO:: swap all pdf computation to rev_pdf and fwd_pdf
-            float result = 1.0f;
-            // start from light
-            for (size_t i = 1; i <= p; i++)
+            float sum = 0.0f;
+
+            // Consider strategies with fewer camera vertices.
+            // Strategies with a single camera vertex are not supported.
+            float ratio = 1.0f;
+            for (size_t i = t - 1; i > 1; --i)
             {
-                if (i == 1) // the vertex on light source
-                {
-                    const BDPTVertex& vertex = *get_vertex_start_from_light(i);
-                    float pdf_a = vertex.m_is_light_vertex ? m_light_sampler.evaluate_pdf(vertex.m_shading_point) : 0.0f;
-                    assert(pdf_a >= 0.0f);
-                    result *= pdf_a;
-                }
-                else if (i == 2) // the vertex after light source
-                {
-                    const BDPTVertex& prev_vertex = *get_vertex_start_from_light(i - 1);
-                    const BDPTVertex& vertex = *get_vertex_start_from_light(i);
-                    /// TODO:: fix this. This assumes diffuse light source.
-                    float pdf_w = static_cast<float>(dot(normalize(vertex.m_position - prev_vertex.m_position), prev_vertex.m_geometric_normal) * RcpPi<float>());
-                    float pdf_a = static_cast<float>(prev_vertex.convert_density(pdf_w, vertex));
-                    assert(pdf_a >= 0.0f);
-                    result *= pdf_a;
-                }
-                else
-                {
-                    const BDPTVertex& prev2_vertex = *get_vertex_start_from_light(i - 2);
-                    const BDPTVertex& prev_vertex = *get_vertex_start_from_light(i - 1);
-                    const BDPTVertex& vertex = *get_vertex_start_from_light(i);
-                    float pdf_w = prev_vertex.m_bsdf->evaluate_pdf(
-                        prev_vertex.m_bsdf_data,
-                        true,
-                        static_cast<Vector3f>(prev_vertex.m_geometric_normal),
-                        prev_vertex.m_shading_basis,
-                        static_cast<Vector3f>(normalize(vertex.m_position - prev_vertex.m_position)),
-                        static_cast<Vector3f>(normalize(prev2_vertex.m_position - prev_vertex.m_position)),
-                        ScatteringMode::All);
-                    float pdf_a = static_cast<float>(prev_vertex.convert_density(pdf_w, vertex));
-                    assert(pdf_a >= 0.0f);
-                    result *= pdf_a;
-                }
+                const BDPTVertex& vertex = *m_camera_vertices[i - 1];
+                const BDPTVertex& prev_vertex = *m_camera_vertices[i - 2];
+
+                ratio *= remap0(vertex.m_rev_pdf) / remap0(vertex.m_fwd_pdf);
+
+                if (!vertex.m_is_specular && !prev_vertex.m_is_specular)
+                    sum += ratio;
             }
 
-            // start from camera
-            for (size_t i = 3; i <= q; i++)
+            // Consider strategies with fewer light vertices.
+            ratio = 1.0f;
+            for (size_t i = s; i-- > 0; )
             {
-                if (i == 3) // first point after shading point
-                {
-                    const BDPTVertex& prev_vertex = *get_vertex_start_from_camera(i - 1);
-                    const BDPTVertex& vertex = *get_vertex_start_from_camera(i);
-                    float pdf_w = prev_vertex.m_bsdf->evaluate_pdf(
-                        prev_vertex.m_bsdf_data,
-                        false,
-                        static_cast<Vector3f>(prev_vertex.m_geometric_normal),
-                        prev_vertex.m_shading_basis,
-                        static_cast<Vector3f>(normalize(vertex.m_position - prev_vertex.m_position)),
-                        static_cast<Vector3f>(prev_vertex.m_dir_to_prev_vertex),
-                        ScatteringMode::All);
-                    float pdf_a = static_cast<float>(prev_vertex.convert_density(pdf_w, vertex));
-                    assert(pdf_a >= 0.0f);
-                    result *= pdf_a;
-                }
-                else
-                {
-                    const BDPTVertex& prev2_vertex = *get_vertex_start_from_camera(i - 2);
-                    const BDPTVertex& prev_vertex = *get_vertex_start_from_camera(i - 1);
-                    const BDPTVertex& vertex = *get_vertex_start_from_camera(i);
-                    float pdf_w = prev_vertex.m_bsdf->evaluate_pdf(
-                        prev_vertex.m_bsdf_data,
-                        false,
-                        static_cast<Vector3f>(prev_vertex.m_geometric_normal),
-                        prev_vertex.m_shading_basis,
-                        static_cast<Vector3f>(normalize(vertex.m_position - prev_vertex.m_position)),
-                        static_cast<Vector3f>(normalize(prev2_vertex.m_position - prev_vertex.m_position)),
-                        ScatteringMode::All);
-                    float pdf_a = static_cast<float>(prev_vertex.convert_density(pdf_w, vertex));
-                    assert(pdf_a >= 0.0f);
-                    result *= pdf_a;
-                }
+                const BDPTVertex& vertex = *m_light_vertices[i];
+                const bool prev_is_specular = i > 0 && m_light_vertices[i - 1]->m_is_specular;
+
+                ratio *= remap0(vertex.m_rev_pdf) / remap0(vertex.m_fwd_pdf);
+
+                if (!vertex.m_is_specular && !prev_is_specular)
+                    sum += ratio;
             }
 
-            return result;
+            // Restore the original densities.
+            pt.m_rev_pdf = saved_pt_rev;
+            pt.m_is_specular = saved_pt_is_specular;
+            if (pt_minus)
+                pt_minus->m_rev_pdf = saved_pt_minus_rev;
+            if (qs)
+            {
+                qs->m_rev_pdf = saved_qs_rev;
+                qs->m_is_specular = saved_qs_is_specular;
+            }
+            if (qs_minus)
+                qs_minus->m_rev_pdf = saved_qs_minus_rev;
+
+            assert(FP<float>::is_finite(sum));
+
+            return 1.0f / (1.0f + sum);
         }
 
         void connect(
             const ShadingContext&       shading_context,
             const ShadingPoint&         shading_point,
-            BDPTVertex*                 light_vertices,
-            BDPTVertex*                 camera_vertices,
             const size_t                s,
             const size_t                t,
             ShadingComponents&          radiance)
@@ -348,29 +456,82 @@ namespace
             assert(t >= 2);
             Spectrum result(0);
 
+            const BDPTVertex& camera_vertex = *m_camera_vertices[t - 2];
+
             if (s == 0)
             {
                 // camera subpath is a complete path
-                const BDPTVertex& camera_vertex = camera_vertices[t - 2];
                 if (!camera_vertex.m_is_light_vertex)
-                {
                     return;
-                }
+
                 result = camera_vertex.m_beta * camera_vertex.m_Le;
             }
+            else if (s == 1 && m_light_vertices[0]->m_light != nullptr)
+            {
+                if (camera_vertex.m_bsdf == nullptr)
+                    return;
+
+                // Lights that do not cast indirect light only contribute to the first camera vertex.
+                const Light* light = m_light_vertices[0]->m_light;
+                if (t > 2 && !(light->get_flags() & Light::CastIndirectLight))
+                    return;
+
+                // Sample the light toward the camera vertex.
+                Vector3d emission_position, emission_direction;
+                Spectrum light_value(Spectrum::Illuminance);
+                float light_prob;
+                light->sample(
+                    shading_context,
+                    m_light_sample.m_light_transform,
+                    camera_vertex.m_position,
+                    m_non_physical_light_s,
+                    emission_position,
+                    emission_direction,
+                    light_value,
+                    light_prob);
+
+                if (light_prob == 0.0f)
+                    return;
+
+                DirectShadingComponents camera_eval_bsdf;
+                camera_vertex.m_bsdf->evaluate(
+                    camera_vertex.m_bsdf_data,
+                    false,   // Adjoint
+                    true,    // multiply by |cos(incoming, normal)|
+                    static_cast<Vector3f>(camera_vertex.m_geometric_normal),
+                    camera_vertex.m_shading_basis,
+                    camera_vertex.m_dir_to_prev_vertex,
+                    -Vector3f(emission_direction),
+                    ScatteringMode::All,
+                    camera_eval_bsdf);
+
+                if (is_zero(camera_eval_bsdf.m_beauty))
+                    return;
+
+                Spectrum transmission;
+                shading_context.get_tracer().trace_between_simple(
+                    shading_context,
+                    camera_vertex.m_position + (emission_position - camera_vertex.m_position) * 1.0e-6,
+                    emission_position,
+                    shading_point.get_ray().m_time,
+                    VisibilityFlags::ShadowRay,
+                    shading_point.get_ray().m_depth,
+                    transmission);
+
+                const float attenuation =
+                    light->compute_distance_attenuation(camera_vertex.m_position, emission_position);
+
+                result = camera_eval_bsdf.m_beauty * camera_vertex.m_beta * light_value * transmission;
+                result *= attenuation / (m_light_sample.m_probability * light_prob);
+            }
             else if (s == 1)
             {
                 // only one light vertex
-                const BDPTVertex& light_vertex = light_vertices[s - 1];
-                const BDPTVertex& camera_vertex = camera_vertices[t - 2];
+                const BDPTVertex& light_vertex = *m_light_vertices[0];
 
                 /// TODO:: need to take care of light material as well
-                if (camera_vertex.m_bsdf == nullptr || camera_vertex.m_bsdf_data == nullptr)
-                {
+                if (camera_vertex.m_bsdf == nullptr || light_vertex.m_edf == nullptr)
                     return;
-                }
-
-                Spectrum geometry = compute_geometry_term(shading_context, shading_point, camera_vertex, light_vertex);
 
                 DirectShadingComponents camera_eval_bsdf;
                 camera_vertex.m_bsdf->evaluate(
@@ -379,20 +540,31 @@ namespace
                     false,
                     static_cast<Vector3f>(camera_vertex.m_geometric_normal),
                     camera_vertex.m_shading_basis,
-                    static_cast<Vector3f>(normalize(light_vertex.m_position - camera_vertex.m_position)),
-                    static_cast<Vector3f>(camera_vertex.m_dir_to_prev_vertex),
+                    camera_vertex.m_dir_to_prev_vertex,
+                    camera_vertex.get_direction_to(light_vertex),
                     ScatteringMode::All,
                     camera_eval_bsdf);
 
-                result = geometry * camera_eval_bsdf.m_beauty * camera_vertex.m_beta * light_vertex.m_beta;
+                if (is_zero(camera_eval_bsdf.m_beauty))
+                    return;
+
+                // Evaluate the emission toward the camera vertex rather than reusing the sampled emission direction.
+                Spectrum edf_value(Spectrum::Illuminance);
+                light_vertex.m_edf->evaluate(
+                    light_vertex.m_edf_data,
+                    static_cast<Vector3f>(light_vertex.m_geometric_normal),
+                    light_vertex.m_shading_basis,
+                    light_vertex.get_direction_to(camera_vertex),
+                    edf_value);
+
+                Spectrum geometry = compute_geometry_term(shading_context, shading_point, camera_vertex, light_vertex);
+                result = geometry * camera_eval_bsdf.m_beauty * camera_vertex.m_beta * edf_value / light_vertex.m_light_pdf;
             }
             else
             {
-                const BDPTVertex& light_vertex = light_vertices[s - 1];
-                const BDPTVertex& camera_vertex = camera_vertices[t - 2];
+                const BDPTVertex& light_vertex = *m_light_vertices[s - 1];
 
-                if (light_vertex.m_bsdf == nullptr || camera_vertex.m_bsdf == nullptr ||
-                    light_vertex.m_bsdf_data == nullptr || camera_vertex.m_bsdf == nullptr)
+                if (light_vertex.m_bsdf == nullptr || camera_vertex.m_bsdf == nullptr)
                     return;
 
                 DirectShadingComponents camera_eval_bsdf;
@@ -402,11 +574,14 @@ namespace
                     false,
                     static_cast<Vector3f>(camera_vertex.m_geometric_normal),
                     camera_vertex.m_shading_basis,
-                    static_cast<Vector3f>(normalize(light_vertex.m_position - camera_vertex.m_position)),
-                    static_cast<Vector3f>(camera_vertex.m_dir_to_prev_vertex),
+                    camera_vertex.m_dir_to_prev_vertex,
+                    camera_vertex.get_direction_to(light_vertex),
                     ScatteringMode::All,
                     camera_eval_bsdf);
 
+                if (is_zero(camera_eval_bsdf.m_beauty))
+                    return;
+
                 DirectShadingComponents light_eval_bsdf;
                 light_vertex.m_bsdf->evaluate(
                     light_vertex.m_bsdf_data,
@@ -414,11 +589,14 @@ namespace
                     false,
                     static_cast<Vector3f>(light_vertex.m_geometric_normal),
                     light_vertex.m_shading_basis,
-                    static_cast<Vector3f>(normalize(camera_vertex.m_position - light_vertex.m_position)),
-                    static_cast<Vector3f>(light_vertex.m_dir_to_prev_vertex),
+                    light_vertex.m_dir_to_prev_vertex,
+                    light_vertex.get_direction_to(camera_vertex),
                     ScatteringMode::All,
                     light_eval_bsdf);
 
+                if (is_zero(light_eval_bsdf.m_beauty))
+                    return;
+
                 Spectrum geometry = compute_geometry_term(shading_context, shading_point, camera_vertex, light_vertex);
                 result = geometry * camera_eval_bsdf.m_beauty * light_eval_bsdf.m_beauty * camera_vertex.m_beta * light_vertex.m_beta;
             }
@@ -427,33 +605,15 @@ namespace
             if (fz(result, 1.0e-4f))
                 return;
 
-            const float numerator = compute_path_density(light_vertices, camera_vertices, s, t, s, t);
-            if (numerator == 0.0f)
-                return;
-
-            /// TODO:: unhandled case where (numerator <= 0) (specular surface / impossible path).
-            assert(FP<float>::is_finite(numerator));
-            assert(numerator > 0.0f);
-
-            float denominator = 0.0f;
-            // [p = 0, q = s + t], [p = 1, q = s + t - 1] ... [p = s + t - 2, q = 2]
-            for (size_t i = 0; i <= s + t - 2; i++)
-                denominator += compute_path_density(light_vertices, camera_vertices, s, t, i, s + t - i);
-
-            /// TODO:: unhandled case where (denominator <= 0) (specular surface / impossible path).
-            assert(FP<float>::is_finite(denominator));
-            assert(denominator > 0.0f);
-
-            const float mis_weight = numerator / denominator;
+            const float mis_weight = compute_mis_weight(s, t);
 
             assert(mis_weight <= 1.0f);
             radiance.m_beauty += mis_weight * result;
         }
 
-        size_t trace_light(
+        void trace_light(
             SamplingContext&            sampling_context,
-            const ShadingContext&       shading_context,
-            BDPTVertex*                 vertices)
+            const ShadingContext&       shading_context)
         {
             // Sample the light sources.
             sampling_context.split_in_place(4, 1);
@@ -467,24 +627,26 @@ namespace
                 Vector3f(s[1], s[2], s[3]),
                 light_sample);
 
-            return
-                light_sample.m_triangle != nullptr
-                    ? trace_emitting_triangle(
-                        sampling_context,
-                        shading_context,
-                        light_sample,
-                        vertices)
-                    : trace_non_physical_light(
-                        sampling_context,
-                        shading_context,
-                        light_sample);
+            if (light_sample.m_triangle != nullptr)
+            {
+                trace_emitting_triangle(
+                    sampling_context,
+                    shading_context,
+                    light_sample);
+            }
+            else
+            {
+                trace_non_physical_light(
+                    sampling_context,
+                    shading_context,
+                    light_sample);
+            }
         }
 
-        size_t trace_emitting_triangle(
+        void trace_emitting_triangle(
             SamplingContext&            sampling_context,
             const ShadingContext&       shading_context,
-            LightSample&                light_sample,
-            BDPTVertex*                 vertices)
+            LightSample&                light_sample)
         {
             // Make sure the geometric normal of the light sample is in the same hemisphere as the shading normal.
             light_sample.m_geometric_normal =
@@ -509,6 +671,9 @@ namespace
                     light_shading_point);
             }
 
+            const void* edf_data = material_data.m_edf->evaluate_inputs(shading_context, light_shading_point);
+            const Basis3f shading_basis(Vector3f(light_sample.m_shading_normal));
+
             // Sample the EDF.
             sampling_context.split_in_place(2, 1);
             Vector3f emission_direction;
@@ -516,14 +681,17 @@ namespace
             float edf_prob;
             material_data.m_edf->sample(
                 sampling_context,
-                material_data.m_edf->evaluate_inputs(shading_context, light_shading_point),
+                edf_data,
                 Vector3f(light_sample.m_geometric_normal),
-                Basis3f(Vector3f(light_sample.m_shading_normal)),
+                shading_basis,
                 sampling_context.next2<Vector2f>(),
                 emission_direction,
                 edf_value,
                 edf_prob);
 
+            if (edf_prob == 0.0f)
+                return;
+
             // Compute the initial particle weight.
             Spectrum initial_flux = edf_value / light_sample.m_probability;
 
@@ -548,34 +716,40 @@ namespace
                 VisibilityFlags::LightRay,
                 0);
 
-            BDPTVertex& bdpt_vertex = vertices[0];
-            bdpt_vertex.m_beta = initial_flux;
-            bdpt_vertex.m_fwd_pdf = light_sample.m_probability;
-            /// CONFUSE:: why geometric normal is flipped?
-            bdpt_vertex.m_geometric_normal = -light_shading_point.get_geometric_normal();
-            bdpt_vertex.m_is_light_vertex = true;
-            bdpt_vertex.m_position = light_shading_point.get_point();
-            bdpt_vertex.m_rev_pdf = 1.0;
-            bdpt_vertex.m_shading_point = light_shading_point;
+            BDPTVertex* light_vertex = m_vertex_arena.allocate<BDPTVertex>();
+            light_vertex->m_position = light_sample.m_point;
+            light_vertex->m_geometric_normal = light_sample.m_geometric_normal;
+            light_vertex->m_shading_basis = shading_basis;
+            light_vertex->m_beta = initial_flux;
+            light_vertex->m_edf = material_data.m_edf;
+            light_vertex->m_edf_data = edf_data;
+            light_vertex->m_fwd_pdf = light_sample.m_probability;
+            light_vertex->m_light_pdf = light_sample.m_probability;
+            light_vertex->m_is_light_vertex = true;
+            m_light_vertices.push_back(light_vertex);
 
             // Build the path tracer.
-            size_t num_light_vertices = 1;
-            PathVisitor path_visitor(initial_flux * dot(emission_direction, Vector3f(light_sample.m_shading_normal)) / edf_prob,
-                                     shading_context,
-                                     vertices,
-                                     &num_light_vertices);
+            PathVisitor path_visitor(
+                initial_flux * dot(emission_direction, Vector3f(light_sample.m_shading_normal)) / edf_prob,
+                edf_prob,
+                false,                                  // emission is only gathered along camera subpaths
+                shading_context,
+                m_light_sampler,
+                m_vertex_arena,
+                m_light_vertices);
             VolumeVisitor volume_visitor;
             PathTracer<PathVisitor, VolumeVisitor, true> path_tracer(
                 path_visitor,
                 volume_visitor,
-                ~size_t(0),
-                m_num_max_vertices - 2,
+                m_shading_point_arena,
+                m_params.m_rr_min_path_length,
+                m_max_subpath_bounces,
                 ~size_t(0),
                 ~size_t(0),
                 ~size_t(0),
                 ~size_t(0),
                 false,                                  // don't clamp roughness
-                shading_context.get_max_iterations());  // don't illuminate points closer than the light near start value
+                shading_context.get_max_iterations());
 
             const size_t light_path_length =
                 path_tracer.trace(
@@ -586,33 +760,49 @@ namespace
                     false);
 
             m_light_path_length.insert(light_path_length);
-            assert(num_light_vertices <= m_num_max_vertices);
-            return num_light_vertices;
+
+            compute_reverse_pdfs(m_light_vertices, true);
         }
 
-        size_t trace_non_physical_light(
+        void trace_non_physical_light(
             SamplingContext&            sampling_context,
             const ShadingContext&       shading_context,
             LightSample&                light_sample)
         {
-            return 0;
+            // The light is sampled toward each camera vertex when connecting subpaths.
+            sampling_context.split_in_place(2, 1);
+            m_non_physical_light_s = sampling_context.next2<Vector2d>();
+            m_light_sample = light_sample;
+
+            BDPTVertex* light_vertex = m_vertex_arena.allocate<BDPTVertex>();
+            light_vertex->m_position = light_sample.m_light_transform.get_parent_origin();
+            light_vertex->m_light = light_sample.m_light;
+            light_vertex->m_light_pdf = light_sample.m_probability;
+            light_vertex->m_is_light_vertex = true;
+            m_light_vertices.push_back(light_vertex);
         }
 
-        size_t trace_camera(
+        void trace_camera(
             SamplingContext&            sampling_context,
             const ShadingContext&       shading_context,
-            const ShadingPoint&         shading_point,
-            BDPTVertex*                 vertices)
+            const ShadingPoint&         shading_point)
         {
-            size_t num_camera_vertices = 0;
-            PathVisitor path_visitor(Spectrum(1.0), shading_context, vertices, &num_camera_vertices);
+            PathVisitor path_visitor(
+                Spectrum(1.0),
+                0.0f,                                   // the camera density is not available
+                true,
+                shading_context,
+                m_light_sampler,
+                m_vertex_arena,
+                m_camera_vertices);
             VolumeVisitor volume_visitor;
 
             PathTracer<PathVisitor, VolumeVisitor, false> path_tracer(
                 path_visitor,
                 volume_visitor,
-                ~size_t(0),
-                m_num_max_vertices - 2,
+                m_shading_point_arena,
+                m_params.m_rr_min_path_length,
+                m_max_subpath_bounces,
                 ~size_t(0),
                 ~size_t(0),
                 ~size_t(0),
@@ -628,13 +818,15 @@ namespace
                     false);
 
             m_camera_path_length.insert(camera_path_length);
-            assert(num_camera_vertices <= m_num_max_vertices - 1);
-            return num_camera_vertices;
+
+            compute_reverse_pdfs(m_camera_vertices, false);
         }
 
         StatisticsVector get_statistics() const override
         {
             Statistics stats;
+            stats.insert("light path length", m_light_path_length);
+            stats.insert("camera path length", m_camera_path_length);
 
             return StatisticsVector::make("bdpt statistics", stats);
         }
@@ -651,23 +843,45 @@ namespace
         Population<uint64>          m_camera_path_length;
 
         size_t                      m_num_max_vertices;
+        size_t                      m_max_subpath_bounces;
+
+        // Non-physical light sampled for the current sample, if any.
+        LightSample                 m_light_sample;
+        Vector2d                    m_non_physical_light_s;
+
+        // Per-sample storage, reused across samples to avoid heap allocations.
+        Arena                       m_vertex_arena;
+        Arena                       m_shading_point_arena;
+        vector<BDPTVertex*>         m_light_vertices;
+        vector<BDPTVertex*>         m_camera_vertices;
 
         struct PathVisitor
         {
+            const Spectrum                  m_initial_beta;
+            const float                     m_initial_pdf;
+            const bool                      m_gather_emission;
             const ShadingContext&           m_shading_context;
-            Spectrum                        m_initial_beta;
-            BDPTVertex*                     m_vertices;
-            size_t*                         m_num_vertices;
+            const ForwardLightSampler&      m_light_sampler;
+            Arena&                          m_arena;
+            vector<BDPTVertex*>&            m_vertices;
+            size_t                          m_hit_count;
 
             PathVisitor(
                 const Spectrum&             initial_beta,
+                const float                 initial_pdf,
+                const bool                  gather_emission,
                 const ShadingContext&       shading_context,
-                BDPTVertex*                 vertices,
-                size_t*                     num_vertices)
+                const ForwardLightSampler&  light_sampler,
+                Arena&                      arena,
+                vector<BDPTVertex*>&        vertices)
               : m_initial_beta(initial_beta)
+              , m_initial_pdf(initial_pdf)
+              , m_gather_emission(gather_emission)
               , m_shading_context(shading_context)
+              , m_light_sampler(light_sampler)
+              , m_arena(arena)
               , m_vertices(vertices)
-              , m_num_vertices(num_vertices)
+              , m_hit_count(0)
             {
             }
 
@@ -689,26 +903,57 @@ namespace
             void on_hit(const PathVertex& vertex)
             {
                 // create BDPT Vertex
-                BDPTVertex& bdpt_vertex = m_vertices[*m_num_vertices];
-                bdpt_vertex.m_beta = vertex.m_throughput * m_initial_beta;
-                bdpt_vertex.m_bsdf = vertex.m_bsdf;
-                bdpt_vertex.m_bsdf_data = vertex.m_bsdf_data;
-                bdpt_vertex.m_dir_to_prev_vertex = normalize(vertex.m_outgoing.get_value());
-                bdpt_vertex.m_fwd_pdf = vertex.m_prev_prob;
-                bdpt_vertex.m_geometric_normal = vertex.get_geometric_normal();
-                bdpt_vertex.m_position = vertex.get_point();
-                bdpt_vertex.m_shading_basis = Basis3f(vertex.get_shading_basis());
-                bdpt_vertex.m_shading_point = *vertex.m_shading_point;
-                /// TODO:: compute rev_pdf here
-
-                if (vertex.m_edf)
+                BDPTVertex* bdpt_vertex = m_arena.allocate<BDPTVertex>();
+                bdpt_vertex->m_position = vertex.get_point();
+                bdpt_vertex->m_geometric_normal = vertex.get_geometric_normal();
+                bdpt_vertex->m_shading_basis = Basis3f(vertex.get_shading_basis());
+                bdpt_vertex->m_dir_to_prev_vertex = Vector3f(normalize(vertex.m_outgoing.get_value()));
+                bdpt_vertex->m_beta = vertex.m_throughput * m_initial_beta;
+                bdpt_vertex->m_bsdf = vertex.m_bsdf;
+                bdpt_vertex->m_bsdf_data = vertex.m_bsdf_data;
+
+                // The scattering properties of the path vertex are only meaningful after the first bounce.
+                const bool first_hit = m_hit_count++ == 0;
+
+                if (!m_vertices.empty())
+                {
+                    BDPTVertex& prev_vertex = *m_vertices.back();
+
+                    if (!first_hit && vertex.m_prev_prob == BSDF::DiracDelta)
+                        prev_vertex.m_is_specular = true;
+                    else
+                    {
+                        const float pdf = first_hit ? m_initial_pdf : vertex.m_prev_prob;
+                        bdpt_vertex->m_fwd_pdf = prev_vertex.convert_density(pdf, *bdpt_vertex);
+                    }
+                }
+
+                if (vertex.m_edf && m_gather_emission)
                 {
-                    vertex.compute_emitted_radiance(m_shading_context, bdpt_vertex.m_Le);
-                    bdpt_vertex.m_is_light_vertex = true;
+                    const ShadingPoint& shading_point = *vertex.m_shading_point;
+
+                    bdpt_vertex->m_edf = vertex.m_edf;
+                    bdpt_vertex->m_is_light_vertex = true;
+                    bdpt_vertex->m_light_pdf = m_light_sampler.evaluate_pdf(shading_point);
+
+                    // No radiance if we're too close to the light.
+                    if (shading_point.get_distance() >= vertex.m_edf->get_light_near_start())
+                    {
+                        if (const ShaderGroup* sg = vertex.get_material()->get_render_data().m_shader_group)
+                            m_shading_context.execute_osl_emission(*sg, shading_point);
+
+                        bdpt_vertex->m_edf_data = vertex.m_edf->evaluate_inputs(m_shading_context, shading_point);
+                        vertex.m_edf->evaluate(
+                            bdpt_vertex->m_edf_data,
+                            Vector3f(bdpt_vertex->m_geometric_normal),
+                            bdpt_vertex->m_shading_basis,
+                            bdpt_vertex->m_dir_to_prev_vertex,
+                            bdpt_vertex->m_Le,
+                            bdpt_vertex->m_emission_pdf);
+                    }
                 }
 
-                bdpt_vertex.m_prev_vertex = (*m_num_vertices == 0) ? nullptr : m_vertices - 1;
-                (*m_num_vertices)++;
+                m_vertices.push_back(bdpt_vertex);
             }
 
             void on_scatter(const PathVertex& vertex)
@@ -783,6 +1028,15 @@ Dictionary BDPTLightingEngineFactory::get_params_metadata()
             .insert("label", "Max Bounces")
             .insert("help", "Maximum number of bounces"));
 
+    metadata.dictionaries().insert(
+        "rr_min_path_length",
+        Dictionary()
+            .insert("type", "int")
+            .insert("default", "0")
+            .insert("min", "0")
+            .insert("label", "Russian Roulette Start Bounce")
+            .insert("help", "Consider pruning low contribution paths starting with this bounce (0 to disable Russian Roulette)"));
+
     return metadata;
 }
 
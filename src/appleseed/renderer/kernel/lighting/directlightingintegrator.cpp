@@ -34,6 +34,7 @@
 #include "renderer/kernel/lighting/backwardlightsampler.h"
 #include "renderer/kernel/lighting/lightpathstream.h"
 #include "renderer/kernel/lighting/tracer.h"
+#include "renderer/kernel/rendering/costtracker.h"
 #include "renderer/kernel/shading/directshadingcomponents.h"
 #include "renderer/kernel/shading/shadingcontext.h"
 #include "renderer/kernel/shading/shadingpoint.h"
@@ -102,6 +103,8 @@ void DirectLightingIntegrator::compute_outgoing_radiance_material_sampling(
     const Dual3d&               outgoing,
     DirectShadingComponents&    radiance) const
 {
+    CostScope cost_scope(CostTracker::LightSampling);
+
     radiance.set(0.0f);
 
     // No hittable light in the scene.
@@ -128,6 +131,8 @@ void DirectLightingIntegrator::compute_outgoing_radiance_light_sampling_low_vari
     DirectShadingComponents&    radiance,
     LightPathStream*            light_path_stream) const
 {
+    CostScope cost_scope(CostTracker::LightSampling);
+
     radiance.set(0.0f);
 
     // No light source in the scene.
@@ -208,6 +213,8 @@ void DirectLightingIntegrator::compute_outgoing_radiance_combined_sampling_low_v
     DirectShadingComponents&    radiance,
     LightPathStream*            light_path_stream) const
 {
+    CostScope cost_scope(CostTracker::LightSampling);
+
     compute_outgoing_radiance_material_sampling(
         sampling_context,
         MISPower2,
@@ -171,6 +171,10 @@ void LightSamplerBase::collect_emitting_triangles(
             // Retrieve the tessellation of the region.
             Access<StaticTriangleTess> tess(&region->get_static_triangle_tess());
 
+            // Skip tessellations that could not be loaded.
+            if (tess.get() == nullptr)
+                continue;
+
             // Loop over the triangles of the region.
             const size_t triangle_count = tess->m_primitives.size();
             for (size_t triangle_index = 0; triangle_index < triangle_count; ++triangle_index)
@@ -533,6 +533,7 @@ namespace
         TextureCache                    m_texture_cache;
         Intersector                     m_intersector;
         Arena                           m_arena;
+        Arena                           m_shading_point_arena;
         OSLShaderGroupExec              m_shadergroup_exec;
         Tracer                          m_tracer;
         const ShadingContext            m_shading_context;
@@ -686,6 +687,7 @@ namespace
             PathTracerType path_tracer(
                 path_visitor,
                 volume_visitor,
+                m_shading_point_arena,
                 m_params.m_rr_min_path_length,
                 m_params.m_max_bounces,
                 ~size_t(0), // max diffuse bounces
@@ -770,6 +772,7 @@ namespace
             PathTracerType path_tracer(
                 path_visitor,
                 volume_visitor,
+                m_shading_point_arena,
                 m_params.m_rr_min_path_length,
                 m_params.m_max_bounces,
                 ~size_t(0), // max diffuse bounces
@@ -864,6 +867,7 @@ namespace
             PathTracerType path_tracer(
                 path_visitor,
                 volume_visitor,
+                m_shading_point_arena,
                 m_params.m_rr_min_path_length,
                 m_params.m_max_bounces,
                 ~size_t(0), // max diffuse bounces
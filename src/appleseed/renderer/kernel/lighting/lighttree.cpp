@@ -37,6 +37,7 @@
 #include "renderer/modeling/input/source.h"
 #include "renderer/modeling/light/light.h"
 #include "renderer/modeling/material/material.h"
+#include "renderer/utility/statisticsrecorder.h"
 
 // appleseed.foundation headers.
 #include "foundation/image/colorspace.h"
@@ -72,7 +73,7 @@ LightTree::LightTree(
 {
 }
 
-vector<size_t> LightTree::build()
+vector<size_t> LightTree::build(StatisticsRecorder* statistics_recorder)
 {
     AABBVector light_bboxes;
 
@@ -145,16 +146,20 @@ vector<size_t> LightTree::build()
         tri_index_to_node_index.resize(m_emitting_triangles.size());
         recursive_node_update(0, 0, 0, tri_index_to_node_index);
 
-        // Print light tree statistics.
+        // Print and record light tree statistics.
         Statistics statistics;
         statistics.insert("nodes", m_nodes.size());
         statistics.insert("max tree depth", m_tree_depth);
         statistics.insert_time("total build time", builder.get_build_time());
-        RENDERER_LOG_INFO("%s",
+        const StatisticsVector statistics_vector =
             StatisticsVector::make(
                 "light tree statistics",
-                statistics).to_string().c_str());
-        
+                statistics);
+        RENDERER_LOG_INFO("%s", statistics_vector.to_string().c_str());
+
+        if (statistics_recorder != nullptr)
+            statistics_recorder->record(statistics_vector);
+
         return tri_index_to_node_index;
     }
 
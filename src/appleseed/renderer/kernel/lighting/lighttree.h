@@ -44,6 +44,7 @@
 
 // Forward declarations.
 namespace renderer  { class ShadingPoint; }
+namespace renderer  { class StatisticsRecorder; }
 
 namespace renderer
 {
@@ -66,7 +67,8 @@ class LightTree
         const std::vector<NonPhysicalLightInfo>&      non_physical_lights,
         const std::vector<EmittingTriangle>&          emitting_triangles);
 
-    std::vector<size_t> build();
+    // Build the tree. Its statistics are recorded into a given recorder, if any.
+    std::vector<size_t> build(StatisticsRecorder* statistics_recorder = nullptr);
 
     bool is_built() const;
 
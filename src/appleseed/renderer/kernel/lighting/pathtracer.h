@@ -72,6 +72,11 @@ namespace renderer
 //
 // A generic path tracer.
 //
+// Shading points along the path are allocated from an arena supplied by the caller.
+// Path tracers are usually short-lived, so the arena should be owned by a per-thread
+// object such that its chunks are reused across paths. The arena is cleared at the
+// beginning of each path.
+//
 
 template <typename PathVisitor, typename VolumeVisitor, bool Adjoint>
 class PathTracer
@@ -81,6 +86,7 @@ class PathTracer
     PathTracer(
         PathVisitor&            path_visitor,
         VolumeVisitor&          volume_visitor,
+        foundation::Arena&      shading_point_arena,
         const size_t            rr_min_path_length,
         const size_t            max_bounces,
         const size_t            max_diffuse_bounces,
@@ -104,11 +110,10 @@ class PathTracer
         const ShadingPoint&     shading_point,
         const bool              clear_arena = true);
 
-    const ShadingPoint& get_path_vertex(const size_t i) const;
-
   private:
     PathVisitor&                m_path_visitor;
     VolumeVisitor&              m_volume_visitor;
+    foundation::Arena&          m_shading_point_arena;
     const size_t                m_rr_min_path_length;
     const size_t                m_max_bounces;
     const size_t                m_max_diffuse_bounces;
@@ -123,7 +128,6 @@ class PathTracer
     size_t                      m_specular_bounces;
     size_t                      m_volume_bounces;
     size_t                      m_iterations;
-    foundation::Arena           m_shading_point_arena;
 
     // Determine whether a ray can pass through a surface with a given alpha value.
     static bool pass_through(
@@ -163,6 +167,7 @@ template <typename PathVisitor, typename VolumeVisitor, bool Adjoint>
 inline PathTracer<PathVisitor, VolumeVisitor, Adjoint>::PathTracer(
     PathVisitor&                path_visitor,
     VolumeVisitor&              volume_visitor,
+    foundation::Arena&          shading_point_arena,
     const size_t                rr_min_path_length,
     const size_t                max_bounces,
     const size_t                max_diffuse_bounces,
@@ -174,6 +179,7 @@ inline PathTracer<PathVisitor, VolumeVisitor, Adjoint>::PathTracer(
     const double                near_start)
   : m_path_visitor(path_visitor)
   , m_volume_visitor(volume_visitor)
+  , m_shading_point_arena(shading_point_arena)
   , m_rr_min_path_length(rr_min_path_length)
   , m_max_bounces(max_bounces)
   , m_max_diffuse_bounces(max_diffuse_bounces)
@@ -236,6 +242,8 @@ size_t PathTracer<PathVisitor, VolumeVisitor, Adjoint>::trace(
     m_volume_bounces = 0;
     m_iterations = 0;
 
+    m_shading_point_arena.clear();
+
     while (true)
     {
         if (clear_arena)
@@ -969,12 +977,6 @@ bool PathTracer<PathVisitor, VolumeVisitor, Adjoint>::march(
     return true;
 }
 
-template<typename PathVisitor, typename VolumeVisitor, bool Adjoint>
-inline const ShadingPoint& PathTracer<PathVisitor, VolumeVisitor, Adjoint>::get_path_vertex(const size_t i) const
-{
-    return reinterpret_cast<const ShadingPoint*>(m_shading_point_arena.get_storage())[i];
-}
-
 }       // namespace renderer
 
 #endif  // !APPLESEED_RENDERER_KERNEL_LIGHTING_PATHTRACER_H
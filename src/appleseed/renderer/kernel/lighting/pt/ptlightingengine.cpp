@@ -57,6 +57,7 @@
 #include "foundation/math/population.h"
 #include "foundation/math/vector.h"
 #include "foundation/platform/types.h"
+#include "foundation/utility/arena.h"
 #include "foundation/utility/containers/dictionary.h"
 #include "foundation/utility/statistics.h"
 #include "foundation/utility/string.h"
@@ -224,6 +225,7 @@ namespace
             PathTracer<PathVisitor, VolumeVisitor, false> path_tracer(     // false = not adjoint
                 path_visitor,
                 volume_visitor,
+                m_shading_point_arena,
                 m_params.m_rr_min_path_length,
                 m_params.m_max_bounces == ~size_t(0) ? ~size_t(0) : m_params.m_max_bounces + 1,
                 m_params.m_max_diffuse_bounces == ~size_t(0) ? ~size_t(0) : m_params.m_max_diffuse_bounces + 1,
@@ -250,7 +252,17 @@ namespace
             stats.insert("path count", m_path_count);
             stats.insert("path length", m_path_length);
 
-            return StatisticsVector::make("path tracing statistics", stats);
+            // Peak memory usage of the shading point arena of this rendering thread.
+            Population<uint64> arena_peak_size;
+            arena_peak_size.insert(m_shading_point_arena.get_peak_size() / 1024);
+            Statistics arena_stats;
+            arena_stats.insert("peak size", arena_peak_size, " KB");
+            arena_stats.insert<uint64>("chunks", m_shading_point_arena.get_chunk_count());
+
+            StatisticsVector vec;
+            vec.insert("path tracing statistics", stats);
+            vec.insert("shading point arena statistics", arena_stats);
+            return vec;
         }
 
       private:
@@ -337,6 +349,8 @@ namespace
         uint64                          m_path_count;
         Population<uint64>              m_path_length;
 
+        Arena                           m_shading_point_arena;      // reused across paths
+
         size_t                          m_inf_volume_ray_warnings;
         static const size_t             MaxInfVolumeRayWarnings = 5;
 
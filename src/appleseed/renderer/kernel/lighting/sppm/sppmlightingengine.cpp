@@ -55,6 +55,7 @@
 #include "foundation/math/scalar.h"
 #include "foundation/math/vector.h"
 #include "foundation/platform/types.h"
+#include "foundation/utility/arena.h"
 #include "foundation/utility/containers/dictionary.h"
 #include "foundation/utility/statistics.h"
 
@@ -178,6 +179,7 @@ namespace
             PathTracer<PathVisitor, VolumeVisitor, false> path_tracer(     // false = not adjoint
                 path_visitor,
                 volume_visitor,
+                m_shading_point_arena,
                 m_params.m_path_tracing_rr_min_path_length,
                 m_params.m_path_tracing_max_bounces,
                 ~size_t(0), // max diffuse bounces
@@ -215,6 +217,7 @@ namespace
         uint64                          m_path_count;
         Population<uint64>              m_path_length;
         knn::Answer<float>              m_answer;
+        Arena                           m_shading_point_arena;
 
         struct PathVisitor
         {
@@ -64,8 +64,10 @@ SPPMPassCallback::SPPMPassCallback(
     TextureStore&                   texture_store,
     OIIOTextureSystem&              oiio_texture_system,
     OSLShadingSystem&               shading_system,
+    StatisticsRecorder&             statistics_recorder,
     const SPPMParameters&           params)
   : m_params(params)
+  , m_statistics_recorder(statistics_recorder)
   , m_photon_tracer(
         scene,
         light_sampler,
@@ -73,6 +75,7 @@ SPPMPassCallback::SPPMPassCallback(
         texture_store,
         oiio_texture_system,
         shading_system,
+        statistics_recorder,
         params)
   , m_pass_number(0)
 {
@@ -119,7 +122,7 @@ void SPPMPassCallback::on_pass_begin(
         return;
 
     // Build a new photon map.
-    m_photon_map.reset(new SPPMPhotonMap(m_photons));
+    m_photon_map.reset(new SPPMPhotonMap(m_photons, m_statistics_recorder));
 }
 
 void SPPMPassCallback::on_pass_end(
@@ -55,6 +55,7 @@ namespace renderer      { class ForwardLightSampler; }
 namespace renderer      { class OIIOTextureSystem; }
 namespace renderer      { class OSLShadingSystem; }
 namespace renderer      { class Scene; }
+namespace renderer      { class StatisticsRecorder; }
 namespace renderer      { class TextureStore; }
 namespace renderer      { class TraceContext; }
 
@@ -77,6 +78,7 @@ class SPPMPassCallback
         TextureStore&                   texture_store,
         OIIOTextureSystem&              oiio_texture_system,
         OSLShadingSystem&               shading_system,
+        StatisticsRecorder&             statistics_recorder,
         const SPPMParameters&           params);
 
     // Delete this instance.
@@ -106,6 +108,7 @@ class SPPMPassCallback
 
   private:
     const SPPMParameters                m_params;
+    StatisticsRecorder&                 m_statistics_recorder;
     SPPMPhotonTracer                    m_photon_tracer;
     foundation::uint32                  m_pass_number;
     SPPMPhotonVector                    m_photons;
@@ -33,6 +33,7 @@
 // appleseed.renderer headers.
 #include "renderer/global/globallogger.h"
 #include "renderer/kernel/lighting/sppm/sppmphoton.h"
+#include "renderer/utility/statisticsrecorder.h"
 
 // appleseed.foundation headers.
 #include "foundation/platform/defaulttimers.h"
@@ -48,7 +49,9 @@ using namespace foundation;
 namespace renderer
 {
 
-SPPMPhotonMap::SPPMPhotonMap(SPPMPhotonVector& photons)
+SPPMPhotonMap::SPPMPhotonMap(
+    SPPMPhotonVector&       photons,
+    StatisticsRecorder&     statistics_recorder)
 {
     const size_t photon_count = photons.size();
 
@@ -67,10 +70,12 @@ SPPMPhotonMap::SPPMPhotonMap(SPPMPhotonVector& photons)
         statistics.insert_size("size", photons.get_memory_size());
         statistics.merge(knn::TreeStatistics<knn::Tree3f>(*this));
 
-        RENDERER_LOG_DEBUG("%s",
+        const StatisticsVector statistics_vector =
             StatisticsVector::make(
                 "sppm photon map statistics",
-                statistics).to_string().c_str());
+                statistics);
+        RENDERER_LOG_DEBUG("%s", statistics_vector.to_string().c_str());
+        statistics_recorder.record(statistics_vector);
     }
     else
     {
@@ -35,6 +35,7 @@
 
 // Forward declarations.
 namespace renderer  { class SPPMPhotonVector; }
+namespace renderer  { class StatisticsRecorder; }
 
 namespace renderer
 {
@@ -43,8 +44,10 @@ class SPPMPhotonMap
   : public foundation::knn::Tree3f
 {
   public:
-    // Constructor, *moves* the photon positions into the map.
-    explicit SPPMPhotonMap(SPPMPhotonVector& photons);
+    // Constructor, *moves* the photon positions into the map and records its statistics.
+    SPPMPhotonMap(
+        SPPMPhotonVector&       photons,
+        StatisticsRecorder&     statistics_recorder);
 };
 
 }       // namespace renderer
@@ -59,6 +59,7 @@
 #include "renderer/modeling/scene/objectinstance.h"
 #include "renderer/modeling/scene/scene.h"
 #include "renderer/modeling/scene/visibilityflags.h"
+#include "renderer/utility/statisticsrecorder.h"
 #include "renderer/utility/transformsequence.h"
 
 // appleseed.foundation headers.
@@ -309,6 +310,7 @@ namespace
         Intersector                 m_intersector;
         OIIOTextureSystem&          m_oiio_texture_system;
         Arena                       m_arena;
+        Arena                       m_shading_point_arena;
         OSLShaderGroupExec          m_shadergroup_exec;
         const SPPMParameters        m_params;
         Tracer                      m_tracer;
@@ -433,6 +435,7 @@ namespace
             PathTracer<PathVisitor, VolumeVisitor, true> path_tracer(      // true = adjoint
                 path_visitor,
                 volume_visitor,
+                m_shading_point_arena,
                 m_params.m_photon_tracing_rr_min_path_length,
                 m_params.m_photon_tracing_max_bounces,
                 ~size_t(0), // max diffuse bounces
@@ -500,6 +503,7 @@ namespace
             PathTracer<PathVisitor, VolumeVisitor, true> path_tracer(      // true = adjoint
                 path_visitor,
                 volume_visitor,
+                m_shading_point_arena,
                 m_params.m_photon_tracing_rr_min_path_length,
                 m_params.m_photon_tracing_max_bounces,
                 ~size_t(0), // max diffuse bounces
@@ -614,6 +618,7 @@ namespace
         Intersector                 m_intersector;
         OIIOTextureSystem&          m_oiio_texture_system;
         Arena                       m_arena;
+        Arena                       m_shading_point_arena;
         OSLShaderGroupExec          m_shadergroup_exec;
         const SPPMParameters        m_params;
         Tracer                      m_tracer;
@@ -708,6 +713,7 @@ namespace
             PathTracer<PathVisitor, VolumeVisitor, true> path_tracer(      // true = adjoint
                 path_visitor,
                 volume_visitor,
+                m_shading_point_arena,
                 m_params.m_photon_tracing_rr_min_path_length,
                 m_params.m_photon_tracing_max_bounces,
                 ~size_t(0), // max diffuse bounces
@@ -738,6 +744,7 @@ SPPMPhotonTracer::SPPMPhotonTracer(
     TextureStore&               texture_store,
     OIIOTextureSystem&          oiio_texture_system,
     OSLShadingSystem&           shading_system,
+    StatisticsRecorder&         statistics_recorder,
     const SPPMParameters&       params)
   : m_params(params)
   , m_scene(scene)
@@ -748,6 +755,7 @@ SPPMPhotonTracer::SPPMPhotonTracer(
   , m_total_stored_photon_count(0)
   , m_oiio_texture_system(oiio_texture_system)
   , m_shading_system(shading_system)
+  , m_statistics_recorder(statistics_recorder)
 {
 }
 
@@ -869,10 +877,12 @@ void SPPMPhotonTracer::trace_photons(
         pretty_uint(m_total_stored_photon_count) + " (" +
         pretty_percent(m_total_stored_photon_count, m_total_emitted_photon_count) +
         ")");
-    RENDERER_LOG_DEBUG("%s",
+    const StatisticsVector statistics_vector =
         StatisticsVector::make(
             "sppm photon tracing statistics",
-            statistics).to_string().c_str());
+            statistics);
+    RENDERER_LOG_DEBUG("%s", statistics_vector.to_string().c_str());
+    m_statistics_recorder.record(statistics_vector);
 }
 
 void SPPMPhotonTracer::schedule_light_photon_tracing_jobs(
@@ -48,6 +48,7 @@ namespace renderer      { class OIIOTextureSystem; }
 namespace renderer      { class OSLShadingSystem; }
 namespace renderer      { class Scene; }
 namespace renderer      { class SPPMPhotonVector; }
+namespace renderer      { class StatisticsRecorder; }
 namespace renderer      { class TextureStore; }
 namespace renderer      { class TraceContext; }
 
@@ -65,6 +66,7 @@ class SPPMPhotonTracer
         TextureStore&               texture_store,
         OIIOTextureSystem&          oiio_texture_system,
         OSLShadingSystem&           shading_system,
+        StatisticsRecorder&         statistics_recorder,
         const SPPMParameters&       params);
 
     void trace_photons(
@@ -83,6 +85,7 @@ class SPPMPhotonTracer
     size_t                          m_total_stored_photon_count;
     OIIOTextureSystem&              m_oiio_texture_system;
     OSLShadingSystem&               m_shading_system;
+    StatisticsRecorder&             m_statistics_recorder;
 
     void schedule_light_photon_tracing_jobs(
         const LightTargetArray&     photon_targets,
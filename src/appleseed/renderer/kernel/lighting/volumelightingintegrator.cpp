@@ -32,6 +32,7 @@
 // appleseed.renderer headers.
 #include "renderer/kernel/lighting/backwardlightsampler.h"
 #include "renderer/kernel/lighting/directlightingintegrator.h"
+#include "renderer/kernel/rendering/costtracker.h"
 #include "renderer/kernel/shading/directshadingcomponents.h"
 #include "renderer/kernel/shading/shadingcontext.h"
 #include "renderer/kernel/shading/shadingpoint.h"
@@ -373,6 +374,8 @@ void VolumeLightingIntegrator::compute_radiance_combined_sampling(
     const MISHeuristic          mis_heuristic,
     DirectShadingComponents&    radiance) const
 {
+    CostScope cost_scope(CostTracker::Volume);
+
     radiance.set(0.0f);
 
     // No light source in the scene.
@@ -451,6 +454,8 @@ void VolumeLightingIntegrator::compute_radiance_exponential_sampling(
     const MISHeuristic          mis_heuristic,
     DirectShadingComponents&    radiance) const
 {
+    CostScope cost_scope(CostTracker::Volume);
+
     radiance.set(0.0f);
 
     // No light source in the scene.
@@ -0,0 +1,257 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2018 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// Interface header.
+#include "costtracker.h"
+
+// appleseed.foundation headers.
+#include "foundation/platform/compiler.h"
+#include "foundation/platform/timers.h"
+
+// Standard headers.
+#include <algorithm>
+#include <cassert>
+#ifndef APPLESEED_X86
+#include <chrono>
+#endif
+
+using namespace foundation;
+using namespace std;
+
+namespace renderer
+{
+
+//
+// CostTracker class implementation.
+//
+
+namespace
+{
+    struct ThreadState
+    {
+        bool                    m_tracking;
+        uint8                   m_category;
+        uint64                  m_last_cycles;
+        uint64                  m_cycles[CostTracker::CategoryCount];
+        size_t                  m_shader_group_count;
+        const ShaderGroup*      m_shader_groups[CostTracker::MaxShaderGroupCount];
+        uint64                  m_shader_group_cycles[CostTracker::MaxShaderGroupCount];
+    };
+
+    // Zero-initialized, tracking is disabled by default.
+    APPLESEED_TLS ThreadState t_state;
+
+    // Charge the cycles elapsed since the last event to the current category.
+    inline uint64 charge_elapsed_cycles(ThreadState& state)
+    {
+        const uint64 now = CostTracker::read_cycles();
+        state.m_cycles[state.m_category] += now - state.m_last_cycles;
+        state.m_last_cycles = now;
+        return now;
+    }
+
+    void add_shader_group_cycles(
+        ThreadState&            state,
+        const ShaderGroup*      shader_group,
+        const uint64            cycles)
+    {
+        const size_t count = state.m_shader_group_count;
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (state.m_shader_groups[i] == shader_group)
+            {
+                state.m_shader_group_cycles[i] += cycles;
+                return;
+            }
+        }
+
+        if (count < CostTracker::MaxShaderGroupCount - 1)
+        {
+            state.m_shader_groups[count] = shader_group;
+            state.m_shader_group_cycles[count] = cycles;
+            ++state.m_shader_group_count;
+        }
+        else if (shader_group != nullptr)
+        {
+            // Keep the last slot for shader groups that don't fit.
+            add_shader_group_cycles(state, nullptr, cycles);
+        }
+        else
+        {
+            state.m_shader_groups[count] = nullptr;
+            state.m_shader_group_cycles[count] = cycles;
+            ++state.m_shader_group_count;
+        }
+    }
+}
+
+boost::atomic<uint32> CostTracker::s_tracking_thread_count(0);
+
+const char* CostTracker::get_category_name(const size_t category)
+{
+    static const char* Names[CategoryCount] =
+    {
+        "traversal",
+        "shading",
+        "texture fetch",
+        "light sampling",
+        "volume",
+        "other"
+    };
+
+    assert(category < CategoryCount);
+    return Names[category];
+}
+
+double CostTracker::measure_frequency()
+{
+#ifdef APPLESEED_X86
+    X86Timer timer;
+    return static_cast<double>(timer.frequency());
+#else
+    return 1.0e9;
+#endif
+}
+
+uint64 CostTracker::read_cycles()
+{
+#ifdef APPLESEED_X86
+    return X86Timer::read_unserialized();
+#else
+    return
+        static_cast<uint64>(
+            chrono::duration_cast<chrono::nanoseconds>(
+                chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+void CostTracker::start_tracking()
+{
+    ThreadState& state = t_state;
+
+    if (!state.m_tracking)
+        ++s_tracking_thread_count;
+
+    fill(state.m_cycles, state.m_cycles + CategoryCount, uint64(0));
+    state.m_shader_group_count = 0;
+    state.m_category = Other;
+    state.m_last_cycles = read_cycles();
+    state.m_tracking = true;
+}
+
+void CostTracker::stop_tracking()
+{
+    ThreadState& state = t_state;
+
+    if (state.m_tracking)
+    {
+        state.m_tracking = false;
+        --s_tracking_thread_count;
+    }
+
+    fill(state.m_cycles, state.m_cycles + CategoryCount, uint64(0));
+    state.m_shader_group_count = 0;
+}
+
+bool CostTracker::is_tracking()
+{
+    return t_state.m_tracking;
+}
+
+void CostTracker::fetch_cycles(uint64 cycles[CategoryCount])
+{
+    ThreadState& state = t_state;
+
+    if (state.m_tracking)
+        charge_elapsed_cycles(state);
+
+    for (size_t i = 0; i < CategoryCount; ++i)
+    {
+        cycles[i] = state.m_cycles[i];
+        state.m_cycles[i] = 0;
+    }
+}
+
+size_t CostTracker::fetch_shader_group_cycles(
+    const ShaderGroup*      shader_groups[MaxShaderGroupCount],
+    uint64                  cycles[MaxShaderGroupCount])
+{
+    ThreadState& state = t_state;
+
+    const size_t count = state.m_shader_group_count;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        shader_groups[i] = state.m_shader_groups[i];
+        cycles[i] = state.m_shader_group_cycles[i];
+    }
+
+    state.m_shader_group_count = 0;
+
+    return count;
+}
+
+
+//
+// CostScope class implementation.
+//
+
+void CostScope::enter(
+    const CostTracker::Category category,
+    const ShaderGroup*          shader_group)
+{
+    ThreadState& state = t_state;
+
+    m_tracking = state.m_tracking;
+
+    if (m_tracking)
+    {
+        m_begin_cycles = charge_elapsed_cycles(state);
+        m_parent_category = static_cast<CostTracker::Category>(state.m_category);
+        m_shader_group = shader_group;
+        state.m_category = static_cast<uint8>(category);
+    }
+}
+
+void CostScope::leave()
+{
+    ThreadState& state = t_state;
+
+    // Tracking may have been stopped while in this scope.
+    if (state.m_tracking)
+    {
+        const uint64 now = charge_elapsed_cycles(state);
+        state.m_category = static_cast<uint8>(m_parent_category);
+
+        if (m_shader_group != nullptr)
+            add_shader_group_cycles(state, m_shader_group, now - m_begin_cycles);
+    }
+}
+
+}   // namespace renderer
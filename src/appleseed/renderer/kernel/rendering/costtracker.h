@@ -0,0 +1,173 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2018 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef APPLESEED_RENDERER_KERNEL_RENDERING_COSTTRACKER_H
+#define APPLESEED_RENDERER_KERNEL_RENDERING_COSTTRACKER_H
+
+// appleseed.foundation headers.
+#include "foundation/core/concepts/noncopyable.h"
+#include "foundation/platform/atomic.h"
+#include "foundation/platform/types.h"
+
+// Standard headers.
+#include <cstddef>
+
+// Forward declarations.
+namespace renderer  { class ShaderGroup; }
+
+namespace renderer
+{
+
+//
+// Per-thread breakdown of the rendering cost into a few categories, measured
+// with the processor cycle counter.
+//
+// Cost scopes are exclusive: cycles spent in a nested scope are only charged
+// to the category of the nested scope. Cycles spent outside of any scope are
+// charged to the Other category. In addition, the cycles spent executing each
+// shader group are tracked separately, including nested scopes.
+//
+// Tracking is enabled per thread, typically only while rendering tiles for a
+// pixel cost AOV. While no thread is tracking, a cost scope only costs an
+// inlined check of a global counter.
+//
+
+class CostTracker
+  : public foundation::NonCopyable
+{
+  public:
+    enum Category
+    {
+        Traversal,
+        Shading,
+        TextureFetch,
+        LightSampling,
+        Volume,
+        Other,
+        CategoryCount
+    };
+
+    // Maximum number of shader groups tracked per thread between two fetches.
+    // Cycles of further shader groups are attributed to a null shader group.
+    static const size_t MaxShaderGroupCount = 64;
+
+    // Return a human-readable name for a given category.
+    static const char* get_category_name(const size_t category);
+
+    // Measure the number of cycles per second of the cycle counter.
+    static double measure_frequency();
+
+    // Read the cycle counter.
+    static foundation::uint64 read_cycles();
+
+    // Start or stop tracking costs in the calling thread. Stopping discards
+    // the cycles that were not fetched yet.
+    static void start_tracking();
+    static void stop_tracking();
+    static bool is_tracking();
+
+    // Return true if at least one thread is tracking costs.
+    static bool is_any_thread_tracking();
+
+    // Retrieve the number of cycles spent in each category by the calling thread
+    // since the last call, and reset them.
+    static void fetch_cycles(foundation::uint64 cycles[CategoryCount]);
+
+    // Retrieve the number of cycles spent in each shader group by the calling
+    // thread since the last call, and reset them. Return the number of groups.
+    static size_t fetch_shader_group_cycles(
+        const ShaderGroup*      shader_groups[MaxShaderGroupCount],
+        foundation::uint64      cycles[MaxShaderGroupCount]);
+
+  private:
+    static boost::atomic<foundation::uint32> s_tracking_thread_count;
+};
+
+
+//
+// Charge the cycles spent in a scope to a given category.
+//
+
+class CostScope
+  : public foundation::NonCopyable
+{
+  public:
+    // Constructor.
+    explicit CostScope(
+        const CostTracker::Category category,
+        const ShaderGroup*      shader_group = nullptr);
+
+    // Destructor.
+    ~CostScope();
+
+  private:
+    bool                        m_tracking;
+    CostTracker::Category       m_parent_category;
+    const ShaderGroup*          m_shader_group;
+    foundation::uint64          m_begin_cycles;
+
+    void enter(
+        const CostTracker::Category category,
+        const ShaderGroup*      shader_group);
+
+    void leave();
+};
+
+
+//
+// CostTracker class implementation.
+//
+
+inline bool CostTracker::is_any_thread_tracking()
+{
+    return s_tracking_thread_count.load(boost::memory_order_relaxed) > 0;
+}
+
+
+//
+// CostScope class implementation.
+//
+
+inline CostScope::CostScope(
+    const CostTracker::Category category,
+    const ShaderGroup*          shader_group)
+  : m_tracking(false)
+{
+    if (CostTracker::is_any_thread_tracking())
+        enter(category, shader_group);
+}
+
+inline CostScope::~CostScope()
+{
+    if (m_tracking)
+        leave();
+}
+
+}       // namespace renderer
+
+#endif  // !APPLESEED_RENDERER_KERNEL_RENDERING_COSTTRACKER_H
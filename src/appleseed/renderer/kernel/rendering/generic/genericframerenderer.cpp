@@ -33,6 +33,7 @@
 // appleseed.renderer headers.
 #include "renderer/global/globallogger.h"
 #include "renderer/global/globaltypes.h"
+#include "renderer/kernel/denoising/streamingdenoiser.h"
 #include "renderer/kernel/rendering/generic/tilejob.h"
 #include "renderer/kernel/rendering/generic/tilejobfactory.h"
 #include "renderer/kernel/rendering/iframerenderer.h"
@@ -41,18 +42,21 @@
 #include "renderer/kernel/rendering/itilerenderer.h"
 #include "renderer/modeling/frame/frame.h"
 #include "renderer/utility/settingsparsing.h"
+#include "renderer/utility/statisticsrecorder.h"
 
 // appleseed.foundation headers.
 #include "foundation/core/concepts/noncopyable.h"
 #include "foundation/math/hash.h"
 #include "foundation/image/canvasproperties.h"
 #include "foundation/image/image.h"
+#include "foundation/platform/defaulttimers.h"
 #include "foundation/platform/thread.h"
 #include "foundation/platform/types.h"
 #include "foundation/utility/containers/dictionary.h"
 #include "foundation/utility/foreach.h"
 #include "foundation/utility/job.h"
 #include "foundation/utility/statistics.h"
+#include "foundation/utility/stopwatch.h"
 #include "foundation/utility/string.h"
 
 // Standard headers.
@@ -84,10 +88,12 @@ namespace
             ITileRendererFactory*   tile_renderer_factory,
             ITileCallbackFactory*   tile_callback_factory,
             IPassCallback*          pass_callback,
+            StatisticsRecorder*     statistics_recorder,
             const ParamArray&       params)
           : m_frame(frame)
           , m_params(params)
           , m_pass_callback(pass_callback)
+          , m_statistics_recorder(statistics_recorder)
           , m_is_rendering(false)
         {
             // We must have a renderer factory, but it's OK not to have a callback factory.
@@ -190,6 +196,7 @@ namespace
                     m_tile_renderers,
                     m_tile_callbacks,
                     m_pass_callback,
+                    m_statistics_recorder,
                     m_job_queue,
                     m_params.m_thread_count,
                     m_abort_switch,
@@ -294,6 +301,7 @@ namespace
                 vector<ITileRenderer*>&             tile_renderers,
                 vector<ITileCallback*>&             tile_callbacks,
                 IPassCallback*                      pass_callback,
+                StatisticsRecorder*                 statistics_recorder,
                 JobQueue&                           job_queue,
                 const size_t                        thread_count,
                 IAbortSwitch&                       abort_switch,
@@ -303,6 +311,7 @@ namespace
               , m_tile_renderers(tile_renderers)
               , m_tile_callbacks(tile_callbacks)
               , m_pass_callback(pass_callback)
+              , m_statistics_recorder(statistics_recorder)
               , m_pass_count(pass_count)
               , m_spectrum_mode(spectrum_mode)
               , m_job_queue(job_queue)
@@ -316,10 +325,16 @@ namespace
             {
                 set_current_thread_name("pass_manager");
 
+                const bool denoise = m_frame.get_denoising_mode() == Frame::DenoisingMode::Denoise;
+                const bool stream_denoising = denoise && m_frame.is_streaming_denoising_enabled();
+                unique_ptr<StreamingDenoiser> streaming_denoiser;
+
                 //
                 // Rendering passes.
                 //
 
+                Statistics pass_stats;
+
                 for (size_t pass = 0; pass < m_pass_count; ++pass)
                 {
                     // Check abort flag.
@@ -329,6 +344,9 @@ namespace
                         return;
                     }
 
+                    Stopwatch<DefaultWallclockTimer> stopwatch;
+                    stopwatch.start();
+
                     if (m_pass_count > 1)
                         RENDERER_LOG_INFO("--- beginning rendering pass %s ---", pretty_uint(pass + 1).c_str());
 
@@ -344,6 +362,10 @@ namespace
                     for (auto tile_callback : m_tile_callbacks)
                         tile_callback->on_tiled_frame_begin(&m_frame);
 
+                    // Tiles are in their final state during the last pass and can be denoised as they complete.
+                    if (stream_denoising && pass + 1 == m_pass_count)
+                        streaming_denoiser.reset(new StreamingDenoiser(m_frame, m_thread_count));
+
                     // Create tile jobs.
                     const uint32 pass_hash = hash_uint32(static_cast<uint32>(pass));
                     TileJobFactory::TileJobVector tile_jobs;
@@ -354,6 +376,7 @@ namespace
                         m_tile_callbacks,
                         pass_hash,
                         m_spectrum_mode,
+                        streaming_denoiser.get(),
                         tile_jobs,
                         m_abort_switch);
 
@@ -375,8 +398,15 @@ namespace
                         m_pass_callback->on_pass_end(m_frame, m_job_queue, m_abort_switch);
                         assert(!m_job_queue.has_scheduled_or_running_jobs());
                     }
+
+                    pass_stats.insert_time(
+                        "pass " + pretty_uint(pass + 1) + " time",
+                        stopwatch.measure().get_seconds());
                 }
 
+                if (m_statistics_recorder)
+                    m_statistics_recorder->record(StatisticsVector::make("rendering pass statistics", pass_stats));
+
                 // Check abort flag.
                 if (m_abort_switch.is_aborted())
                 {
@@ -391,16 +421,19 @@ namespace
                 // Denoising pass.
                 //
 
-                if (m_frame.get_denoising_mode() == Frame::DenoisingMode::Denoise)
+                if (denoise)
                 {
-                    if (m_pass_count > 1)
+                    if (m_pass_count > 1 && !streaming_denoiser)
                         RENDERER_LOG_INFO("--- beginning denoising pass ---");
 
                     // Call on_tile_begin() on all tiles of the frame.
                     on_tile_begin_whole_frame();
 
-                    // Denoise the frame.
-                    m_frame.denoise(m_thread_count, &m_abort_switch);
+                    // Denoise the frame, or what remains to be denoised of it.
+                    if (streaming_denoiser)
+                        streaming_denoiser->finish(&m_abort_switch);
+                    else
+                        m_frame.denoise(m_thread_count, &m_abort_switch);
 
                     // Call on_tile_end() on all tiles of the frame.
                     on_tile_end_whole_frame();
@@ -415,6 +448,7 @@ namespace
             vector<ITileRenderer*>&                 m_tile_renderers;
             vector<ITileCallback*>&                 m_tile_callbacks;
             IPassCallback*                          m_pass_callback;
+            StatisticsRecorder*                     m_statistics_recorder;
             const size_t                            m_pass_count;
             const Spectrum::Mode                    m_spectrum_mode;
             JobQueue&                               m_job_queue;
@@ -464,6 +498,7 @@ namespace
         vector<ITileRenderer*>      m_tile_renderers;   // tile renderers, one per thread
         vector<ITileCallback*>      m_tile_callbacks;   // tile callbacks, none or one per thread
         IPassCallback*              m_pass_callback;
+        StatisticsRecorder*         m_statistics_recorder;
 
         TileJobFactory              m_tile_job_factory;
 
@@ -481,6 +516,9 @@ namespace
                 stats.merge(tile_renderer->get_statistics());
 
             RENDERER_LOG_DEBUG("%s", stats.to_string().c_str());
+
+            if (m_statistics_recorder)
+                m_statistics_recorder->record(stats);
         }
     };
 }
@@ -495,11 +533,13 @@ GenericFrameRendererFactory::GenericFrameRendererFactory(
     ITileRendererFactory*   tile_renderer_factory,
     ITileCallbackFactory*   tile_callback_factory,
     IPassCallback*          pass_callback,
+    StatisticsRecorder*     statistics_recorder,
     const ParamArray&       params)
   : m_frame(frame)
   , m_tile_renderer_factory(tile_renderer_factory)
   , m_tile_callback_factory(tile_callback_factory)
   , m_pass_callback(pass_callback)
+  , m_statistics_recorder(statistics_recorder)
   , m_params(params)
 {
 }
@@ -517,6 +557,7 @@ IFrameRenderer* GenericFrameRendererFactory::create()
             m_tile_renderer_factory,
             m_tile_callback_factory,
             m_pass_callback,
+            m_statistics_recorder,
             m_params);
 }
 
@@ -525,6 +566,7 @@ IFrameRenderer* GenericFrameRendererFactory::create(
     ITileRendererFactory*   tile_renderer_factory,
     ITileCallbackFactory*   tile_callback_factory,
     IPassCallback*          pass_callback,
+    StatisticsRecorder*     statistics_recorder,
     const ParamArray&       params)
 {
     return
@@ -533,6 +575,7 @@ IFrameRenderer* GenericFrameRendererFactory::create(
             tile_renderer_factory,
             tile_callback_factory,
             pass_callback,
+            statistics_recorder,
             params);
 }
 
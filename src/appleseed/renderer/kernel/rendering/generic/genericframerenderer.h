@@ -43,6 +43,7 @@ namespace renderer      { class Frame; }
 namespace renderer      { class IPassCallback; }
 namespace renderer      { class ITileCallbackFactory; }
 namespace renderer      { class ITileRendererFactory; }
+namespace renderer      { class StatisticsRecorder; }
 
 namespace renderer
 {
@@ -61,6 +62,7 @@ class GenericFrameRendererFactory
         ITileRendererFactory*   tile_renderer_factory,
         ITileCallbackFactory*   tile_callback_factory,      // may be 0
         IPassCallback*          pass_callback,              // may be 0
+        StatisticsRecorder*     statistics_recorder,        // may be 0
         const ParamArray&       params);
 
     // Delete this instance.
@@ -75,6 +77,7 @@ class GenericFrameRendererFactory
         ITileRendererFactory*   tile_renderer_factory,
         ITileCallbackFactory*   tile_callback_factory,      // may be 0
         IPassCallback*          pass_callback,              // may be 0
+        StatisticsRecorder*     statistics_recorder,        // may be 0
         const ParamArray&       params);
 
     // Return the metadata of the generic frame renderer parameters.
@@ -85,6 +88,7 @@ class GenericFrameRendererFactory
     ITileRendererFactory*       m_tile_renderer_factory;
     ITileCallbackFactory*       m_tile_callback_factory;    // may be 0
     IPassCallback*              m_pass_callback;            // may be 0
+    StatisticsRecorder*         m_statistics_recorder;      // may be 0
     const ParamArray            m_params;
 };
 
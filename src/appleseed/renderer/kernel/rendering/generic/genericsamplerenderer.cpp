@@ -55,6 +55,7 @@
 #include "foundation/image/color.h"
 #include "foundation/image/image.h"
 #include "foundation/image/regularspectrum.h"
+#include "foundation/math/population.h"
 #include "foundation/math/vector.h"
 #include "foundation/platform/types.h"
 #include "foundation/utility/arena.h"
@@ -296,10 +297,18 @@ namespace
 
         StatisticsVector get_statistics() const override
         {
+            // Peak memory usage of the shading arena of this rendering thread.
+            Population<uint64> arena_peak_size;
+            arena_peak_size.insert(m_arena.get_peak_size() / 1024);
+            Statistics arena_stats;
+            arena_stats.insert("peak size", arena_peak_size, " KB");
+            arena_stats.insert<uint64>("chunks", m_arena.get_chunk_count());
+
             StatisticsVector stats;
             stats.merge(m_texture_cache.get_statistics());
             stats.merge(m_intersector.get_statistics());
             stats.merge(m_lighting_engine->get_statistics());
+            stats.insert("shading arena statistics", arena_stats);
             return stats;
         }
 
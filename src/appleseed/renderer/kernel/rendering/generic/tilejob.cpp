@@ -31,6 +31,7 @@
 #include "tilejob.h"
 
 // appleseed.renderer headers.
+#include "renderer/kernel/denoising/streamingdenoiser.h"
 #include "renderer/kernel/rendering/itilecallback.h"
 #include "renderer/kernel/rendering/itilerenderer.h"
 #include "renderer/modeling/frame/frame.h"
@@ -39,6 +40,7 @@
 #include "foundation/image/canvasproperties.h"
 #include "foundation/image/image.h"
 #include "foundation/image/tile.h"
+#include "foundation/utility/profiler.h"
 
 // Standard headers.
 #include <cassert>
@@ -62,6 +64,7 @@ TileJob::TileJob(
     const size_t                tile_y,
     const size_t                pass_hash,
     const Spectrum::Mode        spectrum_mode,
+    StreamingDenoiser*          streaming_denoiser,
     IAbortSwitch&               abort_switch)
   : m_tile_renderers(tile_renderers)
   , m_tile_callbacks(tile_callbacks)
@@ -70,6 +73,7 @@ TileJob::TileJob(
   , m_tile_y(tile_y)
   , m_pass_hash(pass_hash)
   , m_spectrum_mode(spectrum_mode)
+  , m_streaming_denoiser(streaming_denoiser)
   , m_abort_switch(abort_switch)
 {
     // Either there is no tile callback, or there is the same number
@@ -81,6 +85,8 @@ TileJob::TileJob(
 
 void TileJob::execute(const size_t thread_index)
 {
+    ProfileZone profile_zone("render tile");
+
     // Initialize thread-local variables.
     Spectrum::set_mode(m_spectrum_mode);
 
@@ -118,6 +124,10 @@ void TileJob::execute(const size_t thread_index)
     // Call the post-render tile callback.
     if (tile_callback)
         tile_callback->on_tile_end(&m_frame, m_tile_x, m_tile_y);
+
+    // Denoise the tiles that this tile completes the neighborhood of.
+    if (m_streaming_denoiser && !m_abort_switch.is_aborted())
+        m_streaming_denoiser->on_tile_end(m_tile_x, m_tile_y, &m_abort_switch);
 }
 
 }   // namespace renderer
@@ -42,6 +42,7 @@
 
 // Forward declarations.
 namespace renderer  { class Frame; }
+namespace renderer  { class StreamingDenoiser; }
 namespace renderer  { class ITileCallback; }
 namespace renderer  { class ITileRenderer; }
 
@@ -68,6 +69,7 @@ class TileJob
         const size_t                tile_y,
         const size_t                pass_hash,
         const Spectrum::Mode        spectrum_mode,
+        StreamingDenoiser*          streaming_denoiser,
         foundation::IAbortSwitch&   abort_switch);
 
     // Execute the job.
@@ -81,6 +83,7 @@ class TileJob
     const size_t                    m_tile_y;
     const size_t                    m_pass_hash;
     const Spectrum::Mode            m_spectrum_mode;
+    StreamingDenoiser*              m_streaming_denoiser;
     foundation::IAbortSwitch&       m_abort_switch;
 };
 
@@ -59,6 +59,7 @@ void TileJobFactory::create(
     const TileJob::TileCallbackVector&  tile_callbacks,
     const size_t                        pass_hash,
     const Spectrum::Mode                spectrum_mode,
+    StreamingDenoiser*                  streaming_denoiser,
     TileJobVector&                      tile_jobs,
     IAbortSwitch&                       abort_switch)
 {
@@ -92,6 +93,7 @@ void TileJobFactory::create(
                 tile_y,
                 pass_hash,
                 spectrum_mode,
+                streaming_denoiser,
                 abort_switch));
     }
 }
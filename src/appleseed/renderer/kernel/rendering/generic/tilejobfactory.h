@@ -45,6 +45,7 @@
 namespace foundation    { class CanvasProperties; }
 namespace foundation    { class IAbortSwitch; }
 namespace renderer      { class Frame; }
+namespace renderer      { class StreamingDenoiser; }
 namespace renderer      { class TileJob; }
 
 namespace renderer
@@ -76,6 +77,7 @@ class TileJobFactory
         const TileJob::TileCallbackVector&  tile_callbacks,
         const size_t                        pass_hash,
         const Spectrum::Mode                spectrum_mode,
+        StreamingDenoiser*                  streaming_denoiser,     // optional
         TileJobVector&                      tile_jobs,
         foundation::IAbortSwitch&           abort_switch);
 
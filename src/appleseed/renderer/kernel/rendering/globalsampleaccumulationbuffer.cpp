@@ -40,23 +40,36 @@
 #include "foundation/image/image.h"
 #include "foundation/image/pixel.h"
 #include "foundation/image/tile.h"
+#include "foundation/math/scalar.h"
 #include "foundation/utility/job/iabortswitch.h"
 
 // Boost headers.
 #include "boost/chrono/duration.hpp"
 
+// Standard headers.
+#include <algorithm>
+#include <vector>
+
 using namespace foundation;
 using namespace std;
 
 namespace renderer
 {
 
+namespace
+{
+    // Height in pixels of the bands of rows that are locked independently.
+    const size_t BandHeight = 16;
+}
+
 GlobalSampleAccumulationBuffer::GlobalSampleAccumulationBuffer(
     const size_t    width,
     const size_t    height,
     const Filter2f& filter)
   : m_fb(width, height, 3, filter)
   , m_filter_rcp_norm_factor(1.0f / compute_normalization_factor(filter))
+  , m_band_count((height + BandHeight - 1) / BandHeight)
+  , m_band_mutexes(new boost::mutex[m_band_count])
 {
 }
 
@@ -85,23 +98,71 @@ void GlobalSampleAccumulationBuffer::store_samples(
             break;
     }
 
+    const size_t height = m_fb.get_height();
     const float fw = static_cast<float>(m_fb.get_width());
-    const float fh = static_cast<float>(m_fb.get_height());
-    size_t counter = 0;
+    const float fh = static_cast<float>(height);
+    const float yradius = m_fb.get_filter().get_yradius();
+
+    // Bin the samples by band of rows.
+    vector<size_t> band_offsets(m_band_count + 1, 0);
+    vector<size_t> sample_bands(sample_count);
+    for (size_t i = 0; i < sample_count; ++i)
+    {
+        const size_t row = truncate<size_t>(max(samples[i].m_position.y * fh, 0.0f));
+        const size_t band = min(row / BandHeight, m_band_count - 1);
+        sample_bands[i] = band;
+        ++band_offsets[band + 1];
+    }
+
+    for (size_t b = 0; b < m_band_count; ++b)
+        band_offsets[b + 1] += band_offsets[b];
+
+    vector<const Sample*> sorted_samples(sample_count);
+    {
+        vector<size_t> band_ends(band_offsets.begin(), band_offsets.end() - 1);
+        for (size_t i = 0; i < sample_count; ++i)
+            sorted_samples[band_ends[sample_bands[i]]++] = &samples[i];
+    }
 
-    const Sample* sample_end = samples + sample_count;
-    for (const Sample* s = samples; s < sample_end; ++s)
+    // Splat the samples band by band.
+    for (size_t b = 0; b < m_band_count; ++b)
     {
-        if ((counter++ & 4096) == 0 && abort_switch.is_aborted())
+        const size_t begin = band_offsets[b];
+        const size_t end = band_offsets[b + 1];
+
+        if (begin == end)
+            continue;
+
+        if (abort_switch.is_aborted())
             return;
 
-        const float fx = s->m_position.x * fw;
-        const float fy = s->m_position.y * fh;
+        // Find the bands of rows that samples of this band may affect.
+        const float band_min_y = static_cast<float>(b * BandHeight) - 0.5f;
+        const float band_max_y = static_cast<float>((b + 1) * BandHeight) - 0.5f;
+        const int min_row = max(truncate<int>(fast_ceil(band_min_y - yradius)), 0);
+        const int max_row = min(truncate<int>(fast_floor(band_max_y + yradius)), static_cast<int>(height) - 1);
+        const size_t first_band = static_cast<size_t>(min_row) / BandHeight;
+        const size_t last_band = static_cast<size_t>(max_row) / BandHeight;
+
+        // Locks are always acquired in increasing band order to prevent deadlocks.
+        for (size_t l = first_band; l <= last_band; ++l)
+            m_band_mutexes[l].lock();
 
-        Color3f value(s->m_color.rgb());
-        value *= m_filter_rcp_norm_factor;
+        for (size_t i = begin; i < end; ++i)
+        {
+            const Sample* s = sorted_samples[i];
+
+            const float fx = s->m_position.x * fw;
+            const float fy = s->m_position.y * fh;
+
+            Color3f value(s->m_color.rgb());
+            value *= m_filter_rcp_norm_factor;
+
+            m_fb.add(fx, fy, &value[0]);
+        }
 
-        m_fb.atomic_add(fx, fy, &value[0]);
+        for (size_t l = last_band + 1; l-- > first_band; )
+            m_band_mutexes[l].unlock();
     }
 }
 
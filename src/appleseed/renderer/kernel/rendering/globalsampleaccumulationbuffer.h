@@ -40,8 +40,12 @@
 #include "foundation/platform/thread.h"
 #include "foundation/platform/types.h"
 
+// Boost headers.
+#include "boost/thread/mutex.hpp"
+
 // Standard headers.
 #include <cstddef>
+#include <memory>
 
 // Forward declarations.
 namespace foundation    { class IAbortSwitch; }
@@ -66,6 +70,9 @@ class GlobalSampleAccumulationBuffer
     void clear() override;
 
     // Store a set of samples into the buffer. Thread-safe.
+    // Samples are binned by bands of pixel rows and each band is splatted with
+    // plain additions while only the rows it touches are locked, so that threads
+    // splatting to different parts of the frame don't contend on the same pixels.
     void store_samples(
         const size_t                sample_count,
         const Sample                samples[],
@@ -83,6 +90,8 @@ class GlobalSampleAccumulationBuffer
     boost::shared_mutex             m_mutex;
     foundation::FilteredTile        m_fb;
     const float                     m_filter_rcp_norm_factor;
+    const size_t                    m_band_count;
+    std::unique_ptr<boost::mutex[]> m_band_mutexes;
 
     void develop_to_tile(
         foundation::Tile&           tile,
@@ -32,6 +32,7 @@
 
 // appleseed.renderer headers.
 #include "renderer/global/globallogger.h"
+#include "renderer/kernel/intersection/tracecontext.h"
 #include "renderer/kernel/lighting/lightpathrecorder.h"
 #include "renderer/kernel/rendering/iframerenderer.h"
 #include "renderer/kernel/rendering/itilecallback.h"
@@ -42,16 +43,23 @@
 #include "renderer/kernel/rendering/serialtilecallback.h"
 #include "renderer/kernel/shading/closures.h"
 #include "renderer/kernel/shading/oslshadingsystem.h"
+#include "renderer/kernel/tessellation/geometrypager.h"
+#include "renderer/kernel/tessellation/meshtessellator.h"
 #include "renderer/kernel/texturing/oiiotexturesystem.h"
+#include "renderer/kernel/texturing/textureprefetcher.h"
 #include "renderer/kernel/texturing/texturestore.h"
 #include "renderer/modeling/display/display.h"
 #include "renderer/modeling/entity/onframebeginrecorder.h"
 #include "renderer/modeling/entity/onrenderbeginrecorder.h"
 #include "renderer/modeling/frame/frame.h"
 #include "renderer/modeling/input/inputbinder.h"
+#include "renderer/modeling/object/meshobject.h"
+#include "renderer/modeling/object/meshobjectoperations.h"
 #include "renderer/modeling/project/project.h"
+#include "renderer/modeling/scene/assembly.h"
 #include "renderer/modeling/scene/scene.h"
 #include "renderer/utility/settingsparsing.h"
+#include "renderer/utility/statisticsrecorder.h"
 
 // appleseed.foundation headers.
 #include "foundation/image/canvasproperties.h"
@@ -62,13 +70,17 @@
 #include "foundation/utility/autoreleaseptr.h"
 #include "foundation/utility/job/iabortswitch.h"
 #include "foundation/utility/otherwise.h"
+#include "foundation/utility/profiler.h"
 #include "foundation/utility/statistics.h"
 #include "foundation/utility/stopwatch.h"
+#include "foundation/utility/string.h"
 
 // Standard headers.
 #include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <exception>
+#include <memory>
 #include <new>
 #include <string>
 #include <vector>
@@ -112,6 +124,160 @@ namespace
       private:
         IRendererController& m_renderer_controller;
     };
+
+    // Move the geometry of mesh objects to a geometry pager when it does not fit in the memory budget.
+    class GeometryPaging
+      : public NonCopyable
+    {
+      public:
+        explicit GeometryPaging(const ParamArray& params)
+          : m_pager(params)
+        {
+        }
+
+        // Geometry that could not be paged back in is lost at this point.
+        ~GeometryPaging()
+        {
+            if (!page_in())
+            {
+                for (auto mesh_object : m_mesh_objects)
+                    mesh_object->discard_paged_geometry();
+            }
+        }
+
+        // Page out the geometry of the mesh objects of a scene, unless it fits in the memory budget.
+        void page_out(Scene& scene)
+        {
+            vector<MeshObject*> mesh_objects;
+            size_t memory_size = 0;
+
+            for (auto& assembly : scene.assemblies())
+                collect_mesh_objects(assembly, mesh_objects, memory_size);
+
+            if (memory_size <= m_pager.get_max_size())
+            {
+                RENDERER_LOG_INFO(
+                    "mesh geometry (%s) fits in the geometry memory budget (%s), not paging it out.",
+                    pretty_size(memory_size).c_str(),
+                    pretty_size(m_pager.get_max_size()).c_str());
+                return;
+            }
+
+            for (auto mesh_object : mesh_objects)
+            {
+                if (mesh_object->page_out(m_pager))
+                    m_mesh_objects.push_back(mesh_object);
+            }
+
+            const size_t count = m_mesh_objects.size();
+            RENDERER_LOG_INFO(
+                "paged out %s mesh object%s.",
+                pretty_uint(count).c_str(),
+                count > 1 ? "s" : "");
+        }
+
+        // Move the paged out geometry back into memory. Return false if the geometry of
+        // some mesh objects could not be read back; these mesh objects remain paged out.
+        bool page_in()
+        {
+            vector<MeshObject*> failed_mesh_objects;
+
+            for (auto mesh_object : m_mesh_objects)
+            {
+                if (!mesh_object->page_in())
+                {
+                    RENDERER_LOG_ERROR(
+                        "failed to page in the geometry of mesh object \"%s\".",
+                        mesh_object->get_path().c_str());
+                    failed_mesh_objects.push_back(mesh_object);
+                }
+            }
+
+            m_mesh_objects.swap(failed_mesh_objects);
+
+            return m_mesh_objects.empty();
+        }
+
+        const GeometryPager& get_pager() const
+        {
+            return m_pager;
+        }
+
+      private:
+        GeometryPager           m_pager;
+        vector<MeshObject*>     m_mesh_objects;     // paged out mesh objects
+
+        static void collect_mesh_objects(
+            Assembly&               assembly,
+            vector<MeshObject*>&    mesh_objects,
+            size_t&                 memory_size)
+        {
+            for (auto& object : assembly.objects())
+            {
+                if (strcmp(object.get_model(), MeshObjectFactory().get_model()) == 0)
+                {
+                    // Tessellations shared with other mesh objects stay in memory.
+                    MeshObject& mesh_object = static_cast<MeshObject&>(object);
+                    if (mesh_object.is_diced() || !mesh_object.is_sharing_geometry())
+                    {
+                        mesh_objects.push_back(&mesh_object);
+                        memory_size += mesh_object.get_geometry_memory_size();
+                    }
+                }
+            }
+
+            for (auto& child_assembly : assembly.assemblies())
+                collect_mesh_objects(child_assembly, mesh_objects, memory_size);
+        }
+    };
+
+    // Move paged out geometry back into memory at the end of a render. The geometry
+    // paging is kept alive if some geometry could not be paged back in.
+    class ScopedGeometryPaging
+      : public NonCopyable
+    {
+      public:
+        explicit ScopedGeometryPaging(unique_ptr<GeometryPaging>& geometry_paging)
+          : m_geometry_paging(geometry_paging)
+        {
+        }
+
+        ~ScopedGeometryPaging()
+        {
+            if (m_geometry_paging && m_geometry_paging->page_in())
+                m_geometry_paging.reset();
+        }
+
+      private:
+        unique_ptr<GeometryPaging>& m_geometry_paging;
+    };
+
+    // Add the wall clock time spent in a scope to a named entry of a statistics object.
+    class ScopedPhaseTimer
+      : public NonCopyable
+    {
+      public:
+        ScopedPhaseTimer(
+            Statistics&         stats,
+            const char*         name)
+          : m_stats(stats)
+          , m_name(name)
+        {
+            m_stopwatch.start();
+        }
+
+        ~ScopedPhaseTimer()
+        {
+            Statistics stats;
+            stats.insert_time(m_name, m_stopwatch.measure().get_seconds());
+            m_stats.merge(stats);
+        }
+
+      private:
+        Statistics&                         m_stats;
+        const char*                         m_name;
+        Stopwatch<DefaultWallclockTimer>    m_stopwatch;
+    };
 }
 
 struct MasterRenderer::Impl
@@ -134,6 +300,15 @@ struct MasterRenderer::Impl
 
     Display*                    m_display;
 
+    unique_ptr<TextureStore>    m_texture_store;
+    const Scene*                m_texture_store_scene;
+
+    Statistics                  m_phase_stats;
+    StatisticsRecorder          m_statistics_recorder;
+    StatisticsVector            m_statistics;
+
+    unique_ptr<GeometryPaging>  m_geometry_paging;
+
     Impl(
         Project&          project,
         const ParamArray& params)
@@ -142,6 +317,7 @@ struct MasterRenderer::Impl
       , m_serial_renderer_controller(nullptr)
       , m_serial_tile_callback_factory(nullptr)
       , m_display(nullptr)
+      , m_texture_store_scene(nullptr)
     {
         m_error_handler = new OIIOErrorHandler();
 #ifndef NDEBUG
@@ -214,6 +390,8 @@ struct MasterRenderer::Impl
         TextureStore&               texture_store,
         foundation::IAbortSwitch&   abort_switch)
     {
+        ProfileZone profile_zone("initialize osl shading system");
+
         // Construct a search paths string from the project's search paths.
         const string project_search_paths =
             to_string(m_project.search_paths().to_string_reversed(SearchPaths::osl_path_separator()));
@@ -257,7 +435,32 @@ struct MasterRenderer::Impl
         return
             m_project.get_scene()->create_optimized_osl_shader_groups(
                 *m_shading_system,
-                &abort_switch);
+                &abort_switch,
+                get_rendering_thread_count(m_params));
+    }
+
+    // Return the texture store to use for the next frame. Unless the texture store is
+    // persistent, a new one is created and owned by the caller via `frame_texture_store`.
+    TextureStore& get_texture_store(unique_ptr<TextureStore>& frame_texture_store)
+    {
+        const Scene* scene = m_project.get_scene();
+        const ParamArray& params = m_params.child("texture_store");
+
+        if (!params.get_optional<bool>("persistent", false))
+        {
+            m_texture_store.reset();
+            frame_texture_store.reset(new TextureStore(*scene, params));
+            return *frame_texture_store;
+        }
+
+        if (m_texture_store.get() == nullptr || m_texture_store_scene != scene)
+        {
+            m_texture_store.reset(new TextureStore(*scene, params));
+            m_texture_store_scene = scene;
+        }
+        else RENDERER_LOG_INFO("reusing texture cache of previous frame.");
+
+        return *m_texture_store;
     }
 
     // Return true if the scene passes basic integrity checks.
@@ -287,6 +490,8 @@ struct MasterRenderer::Impl
     // Bind all scene entities inputs. Return true on success, false otherwise.
     bool bind_scene_entities_inputs() const
     {
+        ProfileZone profile_zone("bind scene entity inputs");
+
         InputBinder input_binder(*m_project.get_scene());
         input_binder.bind();
         return input_binder.get_error_count() == 0;
@@ -295,12 +500,21 @@ struct MasterRenderer::Impl
     // Render the project.
     MasterRenderer::RenderingResult render()
     {
+        ProfileZone profile_zone("render project");
+
         // Initialize thread-local variables.
         Spectrum::set_mode(get_spectrum_mode(m_params));
 
         // Reset the frame's render info.
         m_project.get_frame()->render_info().clear();
 
+        // Forget the statistics of the previous render.
+        m_phase_stats.clear();
+        m_statistics = StatisticsVector();
+        m_statistics_recorder.clear();
+        if (m_project.has_trace_context())
+            m_project.get_trace_context().get_statistics_recorder().clear();
+
         RenderingResult result;
 
         try
@@ -350,9 +564,35 @@ struct MasterRenderer::Impl
         }
 #endif
 
+        collect_statistics(result);
+
         return result;
     }
 
+    // Gather the statistics recorded during rendering.
+    void collect_statistics(const RenderingResult& result)
+    {
+        Statistics rendering_stats;
+        rendering_stats.insert<string>(
+            "status",
+            result.m_status == RenderingResult::Succeeded ? "succeeded" :
+            result.m_status == RenderingResult::Aborted ? "aborted" : "failed");
+        rendering_stats.insert_time("render time", result.m_render_time);
+        rendering_stats.insert_time("post-processing time", result.m_post_processing_time);
+
+        m_statistics = StatisticsVector::make("rendering statistics", rendering_stats);
+        m_statistics.insert("rendering phase statistics", m_phase_stats);
+        m_statistics.insert(m_statistics_recorder.get_statistics());
+
+        // Acceleration structures may be built at any time while rendering.
+        if (m_project.has_trace_context())
+        {
+            StatisticsRecorder& trace_context_recorder = m_project.get_trace_context().get_statistics_recorder();
+            m_statistics.insert(trace_context_recorder.get_statistics());
+            trace_context_recorder.clear();
+        }
+    }
+
     // Render a frame until completed or aborted and handle reinitialization events.
     MasterRenderer::RenderingResult::Status do_render()
     {
@@ -365,7 +605,14 @@ struct MasterRenderer::Impl
 
             // Perform pre-render actions. Don't proceed if that failed.
             OnRenderBeginRecorder recorder;
-            if (!m_project.get_scene()->on_render_begin(m_project, nullptr, recorder, &abort_switch))
+            bool render_begin_succeeded;
+            {
+                ProfileZone profile_zone("prepare scene");
+                ScopedPhaseTimer phase_timer(m_phase_stats, "scene preparation");
+                render_begin_succeeded =
+                    m_project.get_scene()->on_render_begin(m_project, nullptr, recorder, &abort_switch);
+            }
+            if (!render_begin_succeeded)
             {
                 recorder.on_render_end(m_project);
                 m_renderer_controller->on_rendering_abort();
@@ -385,6 +632,8 @@ struct MasterRenderer::Impl
                 break;
 
               case IRendererController::ReinitializeRendering:
+                // The scene may have been edited: don't reuse cached texture tiles.
+                m_texture_store.reset();
                 break;
 
               assert_otherwise;
@@ -421,26 +670,57 @@ struct MasterRenderer::Impl
 
         // Expand all procedural assemblies.
         // todo: could this be done in Scene::on_render_begin()?
-        if (!m_project.get_scene()->expand_procedural_assemblies(m_project, &abort_switch))
-            return IRendererController::AbortRendering;
+        {
+            ScopedPhaseTimer phase_timer(m_phase_stats, "procedural assembly expansion");
+            if (!m_project.get_scene()->expand_procedural_assemblies(m_project, &abort_switch))
+                return IRendererController::AbortRendering;
+        }
 
         // Bind entities inputs. This must be done before creating/updating the trace context.
-        if (!bind_scene_entities_inputs())
-            return IRendererController::AbortRendering;
+        {
+            ScopedPhaseTimer phase_timer(m_phase_stats, "entity inputs binding");
+            if (!bind_scene_entities_inputs())
+                return IRendererController::AbortRendering;
+        }
 
-        // Create the texture store.
-        TextureStore texture_store(
+        // Create the texture store, or reuse the one of the previous frame if requested.
+        unique_ptr<TextureStore> frame_texture_store;
+        TextureStore& texture_store = get_texture_store(frame_texture_store);
+
+        // Start reading and decoding textures in the background if requested. This overlaps
+        // texture I/O with the remaining initialization steps.
+        TexturePrefetcher texture_prefetcher(
             *m_project.get_scene(),
-            m_params.child("texture_store"));
+            texture_store,
+            get_rendering_thread_count(m_params));
+        if (m_params.child("texture_store").get_optional<bool>("prefetch", false))
+            texture_prefetcher.start(&abort_switch);
 
         // Initialize OSL's shading system.
-        if (!initialize_osl_shading_system(texture_store, abort_switch))
-            return IRendererController::AbortRendering;
+        {
+            ScopedPhaseTimer phase_timer(m_phase_stats, "osl shading system initialization");
+            if (!initialize_osl_shading_system(texture_store, abort_switch))
+                return IRendererController::AbortRendering;
+        }
 
         // Don't proceed further if initialization was aborted.
         if (abort_switch.is_aborted())
             return m_renderer_controller->get_status();
 
+        // Dice subdivision and displaced meshes. This must be done before creating renderer components,
+        // since light samplers refer to the triangles of the final tessellations, and before
+        // creating/updating the trace context.
+        MeshTessellator mesh_tessellator(
+            m_project,
+            texture_store,
+            m_params.child("tessellation"),
+            get_rendering_thread_count(m_params));
+        {
+            ScopedPhaseTimer phase_timer(m_phase_stats, "tessellation");
+            if (!mesh_tessellator.tessellate(&abort_switch))
+                return m_renderer_controller->get_status();
+        }
+
         // Create renderer components.
         RendererComponents components(
             m_project,
@@ -448,9 +728,28 @@ struct MasterRenderer::Impl
             m_tile_callback_factory,
             texture_store,
             *m_texture_system,
-            *m_shading_system);
-        if (!components.create())
-            return IRendererController::AbortRendering;
+            *m_shading_system,
+            m_statistics_recorder);
+        {
+            ScopedPhaseTimer phase_timer(m_phase_stats, "renderer components creation");
+            if (!components.create())
+                return IRendererController::AbortRendering;
+        }
+
+        // Print and record mesh memory statistics, taking geometry sharing and instancing into account.
+        const StatisticsVector mesh_memory_stats = compute_mesh_memory_statistics(*m_project.get_scene());
+        RENDERER_LOG_DEBUG("%s", mesh_memory_stats.to_string().c_str());
+        m_statistics_recorder.record(mesh_memory_stats);
+
+        // Move mesh geometry out of core if requested and if it exceeds the memory budget. This must be
+        // done before creating/updating the trace context so that acceleration structures are built from
+        // the paged geometry. Geometry that previous renders failed to page back in is still paged out.
+        if (!m_geometry_paging && m_params.child("geometry_pager").get_optional<bool>("enabled", false))
+        {
+            m_geometry_paging.reset(new GeometryPaging(m_params.child("geometry_pager")));
+            m_geometry_paging->page_out(*m_project.get_scene());
+        }
+        ScopedGeometryPaging scoped_geometry_paging(m_geometry_paging);
 
         // Build or update ray tracing acceleration structures.
 #ifdef APPLESEED_WITH_EMBREE
@@ -458,11 +757,20 @@ struct MasterRenderer::Impl
             m_params.get_optional<bool>("use_embree", false));
 #endif
 
-        m_project.update_trace_context();
+        {
+            ScopedPhaseTimer phase_timer(m_phase_stats, "trace context update");
+            m_project.update_trace_context();
+        }
 
         // Print renderer component settings.
         components.print_settings();
 
+        // Wait until textures are prefetched.
+        {
+            ScopedPhaseTimer phase_timer(m_phase_stats, "texture prefetching");
+            texture_prefetcher.wait_until_completion();
+        }
+
         // Execute the main rendering loop.
         const auto status = render_frame(components, abort_switch);
 
@@ -471,8 +779,18 @@ struct MasterRenderer::Impl
             props.m_canvas_width,
             props.m_canvas_height);
 
-        // Print texture store performance statistics.
-        RENDERER_LOG_DEBUG("%s", texture_store.get_statistics().to_string().c_str());
+        // Print and record texture store performance statistics.
+        const StatisticsVector texture_store_stats = texture_store.get_statistics();
+        RENDERER_LOG_DEBUG("%s", texture_store_stats.to_string().c_str());
+        m_statistics_recorder.record(texture_store_stats);
+
+        // Print and record geometry pager performance statistics.
+        if (m_geometry_paging)
+        {
+            const StatisticsVector geometry_pager_stats = m_geometry_paging->get_pager().get_statistics();
+            RENDERER_LOG_DEBUG("%s", geometry_pager_stats.to_string().c_str());
+            m_statistics_recorder.record(geometry_pager_stats);
+        }
 
         return status;
     }
@@ -510,6 +828,8 @@ struct MasterRenderer::Impl
             IFrameRenderer& frame_renderer = components.get_frame_renderer();
             assert(!frame_renderer.is_rendering());
 
+            ScopedPhaseTimer phase_timer(m_phase_stats, "frame rendering");
+
             // Start rendering the frame.
             frame_renderer.start_rendering();
 
@@ -555,6 +875,8 @@ struct MasterRenderer::Impl
     // Wait until the the frame is completed or rendering is aborted.
     IRendererController::Status wait_for_event(IFrameRenderer& frame_renderer) const
     {
+        ProfileZone profile_zone("render frame");
+
         bool is_paused = false;
 
         while (true)
@@ -596,6 +918,9 @@ struct MasterRenderer::Impl
 
     void postprocess(const RenderingResult& rendering_result)
     {
+        ProfileZone profile_zone("post-process frame");
+        ScopedPhaseTimer phase_timer(m_phase_stats, "post-processing");
+
         Frame* frame = m_project.get_frame();
         assert(frame != nullptr);
 
@@ -727,6 +1052,11 @@ MasterRenderer::RenderingResult MasterRenderer::render()
     return impl->render();
 }
 
+const StatisticsVector& MasterRenderer::get_statistics() const
+{
+    return impl->m_statistics;
+}
+
 
 //
 // MasterRenderer::RenderingResult class implementation.
@@ -37,11 +37,12 @@
 #include "main/dllsymbol.h"
 
 // Forward declarations.
-namespace renderer  { class IRendererController; }
-namespace renderer  { class ITileCallback; }
-namespace renderer  { class ITileCallbackFactory; }
-namespace renderer  { class ParamArray; }
-namespace renderer  { class Project; }
+namespace foundation    { class StatisticsVector; }
+namespace renderer      { class IRendererController; }
+namespace renderer      { class ITileCallback; }
+namespace renderer      { class ITileCallbackFactory; }
+namespace renderer      { class ParamArray; }
+namespace renderer      { class Project; }
 
 namespace renderer
 {
@@ -89,6 +90,10 @@ class APPLESEED_DLLSYMBOL MasterRenderer
     // Render the project.
     RenderingResult render();
 
+    // Return the statistics collected during the last call to render(): rendering phase
+    // timings, ray counts, acceleration structure, texture and memory statistics, etc.
+    const foundation::StatisticsVector& get_statistics() const;
+
   private:
     struct Impl;
     Impl* impl;
@@ -42,6 +42,7 @@
 #include "renderer/modeling/frame/frame.h"
 #include "renderer/modeling/project/project.h"
 #include "renderer/utility/settingsparsing.h"
+#include "renderer/utility/statisticsrecorder.h"
 
 // appleseed.foundation headers.
 #include "foundation/core/concepts/noncopyable.h"
@@ -50,6 +51,7 @@
 #include "foundation/image/genericimagefilereader.h"
 #include "foundation/image/image.h"
 #include "foundation/math/aabb.h"
+#include "foundation/math/population.h"
 #include "foundation/math/scalar.h"
 #include "foundation/math/vector.h"
 #include "foundation/platform/defaulttimers.h"
@@ -101,8 +103,10 @@ namespace
             const Project&                  project,
             ISampleGeneratorFactory*        generator_factory,
             ITileCallbackFactory*           callback_factory,
+            StatisticsRecorder*             statistics_recorder,
             const ParamArray&               params)
           : m_project(project)
+          , m_statistics_recorder(statistics_recorder)
           , m_params(params)
           , m_sample_counter(m_params.m_max_sample_count)
           , m_ref_image_avg_lum(0.0)
@@ -346,6 +350,13 @@ namespace
             m_job_manager->stop();
 
             // The statistics thread has already been joined in stop_rendering().
+            if (m_statistics_recorder)
+            {
+                m_statistics_recorder->record(
+                    StatisticsVector::make(
+                        "progressive rendering statistics",
+                        m_statistics_func->get_statistics()));
+            }
             m_statistics_thread.reset();
             m_statistics_func.reset();
 
@@ -606,6 +617,19 @@ namespace
                 m_pause_flag.clear();
             }
 
+            Statistics get_statistics()
+            {
+                const uint64 samples = m_buffer.get_sample_count();
+                const double time = (m_timer.read() - m_timer_start_value) * m_rcp_timer_frequency;
+
+                Statistics stats;
+                stats.insert("samples", samples);
+                stats.insert("samples/pixel", samples * m_rcp_pixel_count);
+                stats.insert("samples/second", m_samples_per_second);
+                stats.insert_time("rendering time", time);
+                return stats;
+            }
+
             void operator()()
             {
                 set_current_thread_name("statistics");
@@ -641,6 +665,7 @@ namespace
 
             double                          m_rcp_pixel_count;
             SampleCountHistory<128>         m_sample_count_history;
+            Population<uint64>              m_samples_per_second;       // one value per statistics interval
             vector<Vector2d>                m_sample_count_records;     // total sample count over time
             vector<Vector2d>                m_rmsd_records;             // RMS deviation over time
 
@@ -651,6 +676,7 @@ namespace
 
                 const double samples_per_pixel = samples * m_rcp_pixel_count;
                 const uint64 samples_per_second = truncate<uint64>(m_sample_count_history.get_samples_per_second());
+                m_samples_per_second.insert(samples_per_second);
 
                 RENDERER_LOG_INFO(
                     "%s samples, %s samples/pixel, %s samples/second",
@@ -702,6 +728,7 @@ namespace
         //
 
         const Project&                          m_project;
+        StatisticsRecorder*                     m_statistics_recorder;
         const Parameters                        m_params;
         SampleCounter                           m_sample_counter;
 
@@ -739,6 +766,9 @@ namespace
                 stats.merge(sample_generator->get_statistics());
 
             RENDERER_LOG_DEBUG("%s", stats.to_string().c_str());
+
+            if (m_statistics_recorder)
+                m_statistics_recorder->record(stats);
         }
     };
 }
@@ -752,10 +782,12 @@ ProgressiveFrameRendererFactory::ProgressiveFrameRendererFactory(
     const Project&              project,
     ISampleGeneratorFactory*    generator_factory,
     ITileCallbackFactory*       callback_factory,
+    StatisticsRecorder*         statistics_recorder,
     const ParamArray&           params)
   : m_project(project)
   , m_generator_factory(generator_factory)
   , m_callback_factory(callback_factory)
+  , m_statistics_recorder(statistics_recorder)
   , m_params(params)
 {
 }
@@ -772,6 +804,7 @@ IFrameRenderer* ProgressiveFrameRendererFactory::create()
             m_project,
             m_generator_factory,
             m_callback_factory,
+            m_statistics_recorder,
             m_params);
 }
 
@@ -779,6 +812,7 @@ IFrameRenderer* ProgressiveFrameRendererFactory::create(
     const Project&              project,
     ISampleGeneratorFactory*    generator_factory,
     ITileCallbackFactory*       callback_factory,
+    StatisticsRecorder*         statistics_recorder,
     const ParamArray&           params)
 {
     return
@@ -786,6 +820,7 @@ IFrameRenderer* ProgressiveFrameRendererFactory::create(
             project,
             generator_factory,
             callback_factory,
+            statistics_recorder,
             params);
 }
 
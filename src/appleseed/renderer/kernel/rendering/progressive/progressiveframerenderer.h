@@ -42,6 +42,7 @@ namespace foundation    { class Dictionary; }
 namespace renderer      { class ISampleGeneratorFactory; }
 namespace renderer      { class ITileCallbackFactory; }
 namespace renderer      { class Project; }
+namespace renderer      { class StatisticsRecorder; }
 
 namespace renderer
 {
@@ -59,6 +60,7 @@ class ProgressiveFrameRendererFactory
         const Project&              project,
         ISampleGeneratorFactory*    generator_factory,
         ITileCallbackFactory*       callback_factory,       // may be 0
+        StatisticsRecorder*         statistics_recorder,    // may be 0
         const ParamArray&           params);
 
     // Delete this instance.
@@ -72,6 +74,7 @@ class ProgressiveFrameRendererFactory
         const Project&              project,
         ISampleGeneratorFactory*    generator_factory,
         ITileCallbackFactory*       callback_factory,       // may be 0
+        StatisticsRecorder*         statistics_recorder,    // may be 0
         const ParamArray&           params);
 
     // Return the metadata of the progressive frame renderer parameters.
@@ -81,6 +84,7 @@ class ProgressiveFrameRendererFactory
     const Project&                  m_project;
     ISampleGeneratorFactory*        m_generator_factory;
     ITileCallbackFactory*           m_callback_factory;     // may be 0
+    StatisticsRecorder*             m_statistics_recorder;  // may be 0
     ParamArray                      m_params;
 };
 
@@ -56,6 +56,9 @@
 #include "renderer/modeling/project/project.h"
 #include "renderer/utility/paramarray.h"
 
+// appleseed.foundation headers.
+#include "foundation/utility/profiler.h"
+
 // Standard headers.
 #include <string>
 
@@ -98,7 +101,8 @@ RendererComponents::RendererComponents(
     ITileCallbackFactory*   tile_callback_factory,
     TextureStore&           texture_store,
     OIIOTextureSystem&      texture_system,
-    OSLShadingSystem&       shading_system)
+    OSLShadingSystem&       shading_system,
+    StatisticsRecorder&     statistics_recorder)
   : m_project(project)
   , m_params(params)
   , m_tile_callback_factory(tile_callback_factory)
@@ -109,6 +113,7 @@ RendererComponents::RendererComponents(
   , m_texture_store(texture_store)
   , m_texture_system(texture_system)
   , m_shading_system(shading_system)
+  , m_statistics_recorder(statistics_recorder)
   , m_forward_light_sampler(nullptr)
   , m_backward_light_sampler(nullptr)
 {
@@ -116,6 +121,8 @@ RendererComponents::RendererComponents(
 
 bool RendererComponents::create()
 {
+    ProfileZone profile_zone("create renderer components");
+
     if (!create_lighting_engine_factory())
         return false;
 
@@ -159,7 +166,8 @@ bool RendererComponents::create_lighting_engine_factory()
         m_backward_light_sampler.reset(
             new BackwardLightSampler(
                 m_scene,
-                get_child_and_inherit_globals(m_params, "light_sampler")));
+                get_child_and_inherit_globals(m_params, "light_sampler"),
+                &m_statistics_recorder));
 
         m_lighting_engine_factory.reset(
             new PTLightingEngineFactory(
@@ -194,7 +202,8 @@ bool RendererComponents::create_lighting_engine_factory()
         m_backward_light_sampler.reset(
             new BackwardLightSampler(
                 m_scene,
-                get_child_and_inherit_globals(m_params, "light_sampler")));
+                get_child_and_inherit_globals(m_params, "light_sampler"),
+                &m_statistics_recorder));
 
         const SPPMParameters sppm_params(
             get_child_and_inherit_globals(m_params, "sppm"));
@@ -207,6 +216,7 @@ bool RendererComponents::create_lighting_engine_factory()
                 m_texture_store,
                 m_texture_system,
                 m_shading_system,
+                m_statistics_recorder,
                 sppm_params);
 
         m_pass_callback.reset(sppm_pass_callback);
@@ -497,6 +507,7 @@ bool RendererComponents::create_frame_renderer_factory()
                 m_tile_renderer_factory.get(),
                 m_tile_callback_factory,
                 m_pass_callback.get(),
+                &m_statistics_recorder,
                 get_child_and_inherit_globals(m_params, "generic_frame_renderer")));
 
         return true;
@@ -514,6 +525,7 @@ bool RendererComponents::create_frame_renderer_factory()
                 m_project,
                 m_sample_generator_factory.get(),
                 m_tile_callback_factory,
+                &m_statistics_recorder,
                 get_child_and_inherit_globals(m_params, "progressive_frame_renderer")));
 
         return true;
@@ -57,6 +57,7 @@ namespace renderer  { class OSLShadingSystem; }
 namespace renderer  { class ParamArray; }
 namespace renderer  { class Project; }
 namespace renderer  { class Scene; }
+namespace renderer  { class StatisticsRecorder; }
 namespace renderer  { class TextureStore; }
 namespace renderer  { class TraceContext; }
 
@@ -77,7 +78,8 @@ class RendererComponents
         ITileCallbackFactory*   tile_callback_factory,
         TextureStore&           texture_store,
         OIIOTextureSystem&      texture_system,
-        OSLShadingSystem&       shading_system);
+        OSLShadingSystem&       shading_system,
+        StatisticsRecorder&     statistics_recorder);
 
     bool create();
 
@@ -100,6 +102,7 @@ class RendererComponents
     TextureStore&                                       m_texture_store;
     OIIOTextureSystem&                                  m_texture_system;
     OSLShadingSystem&                                   m_shading_system;
+    StatisticsRecorder&                                 m_statistics_recorder;
 
     std::unique_ptr<ILightingEngineFactory>             m_lighting_engine_factory;
     std::unique_ptr<ISampleRendererFactory>             m_sample_renderer_factory;
@@ -220,6 +220,10 @@ void AOVoxelTree::build(
                 // Retrieve the tessellation of the region.
                 Access<StaticTriangleTess> tess(&region->get_static_triangle_tess());
 
+                // Skip tessellations that could not be loaded.
+                if (tess.get() == nullptr)
+                    continue;
+
                 // Push all triangles of the region into the tree.
                 const size_t triangle_count = tess->m_primitives.size();
                 for (size_t triangle_index = 0; triangle_index < triangle_count; ++triangle_index)
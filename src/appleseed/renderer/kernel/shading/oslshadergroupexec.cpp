@@ -30,6 +30,7 @@
 #include "oslshadergroupexec.h"
 
 // appleseed.renderer headers.
+#include "renderer/kernel/rendering/costtracker.h"
 #include "renderer/kernel/shading/closures.h"
 #include "renderer/kernel/shading/oslshadingsystem.h"
 #include "renderer/kernel/shading/shadingpoint.h"
@@ -199,6 +200,8 @@ void OSLShaderGroupExec::do_execute(
     const ShadingPoint&             shading_point,
     const VisibilityFlags::Type     ray_flags) const
 {
+    CostScope cost_scope(CostTracker::Shading, &shader_group);
+
     assert(m_osl_shading_context);
     assert(m_osl_thread_info);
 
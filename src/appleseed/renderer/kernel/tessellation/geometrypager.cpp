@@ -0,0 +1,375 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2018 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// Interface header.
+#include "geometrypager.h"
+
+// appleseed.renderer headers.
+#include "renderer/global/globallogger.h"
+#include "renderer/utility/paramarray.h"
+
+// appleseed.foundation headers.
+#include "foundation/core/exceptions/exceptionioerror.h"
+#include "foundation/platform/thread.h"
+#include "foundation/platform/types.h"
+#include "foundation/utility/bufferedfile.h"
+#include "foundation/utility/containers/dictionary.h"
+#include "foundation/utility/statistics.h"
+#include "foundation/utility/string.h"
+
+// Boost headers.
+#include "boost/filesystem.hpp"
+
+// Standard headers.
+#include <cassert>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+
+using namespace foundation;
+using namespace std;
+namespace bf = boost::filesystem;
+
+namespace renderer
+{
+
+//
+// GeometryPager class implementation.
+//
+
+namespace
+{
+    const size_t CompressionBufferSize = 1024 * 1024;
+
+    void write_page_file(const string& filepath, const StaticTriangleTess& tess)
+    {
+        BufferedFile file(
+            filepath.c_str(),
+            BufferedFile::BinaryType,
+            BufferedFile::WriteMode);
+
+        if (!file.is_open())
+            throw ExceptionIOError("could not create page file");
+
+        LZ4CompressedWriterAdapter writer(file, CompressionBufferSize);
+        tess.write(writer);
+    }
+
+    void read_page_file(const string& filepath, StaticTriangleTess& tess)
+    {
+        BufferedFile file(
+            filepath.c_str(),
+            BufferedFile::BinaryType,
+            BufferedFile::ReadMode);
+
+        if (!file.is_open())
+            throw ExceptionIOError("could not open page file");
+
+        LZ4CompressedReaderAdapter reader(file);
+        tess.read(reader);
+    }
+}
+
+struct GeometryPager::Impl
+{
+    struct Page
+    {
+        string                                  m_filepath;
+        unique_ptr<Lazy<StaticTriangleTess>>    m_lazy;
+        size_t                                  m_memory_size;      // 0 when not loaded
+        list<Page*>::iterator                   m_loaded_it;
+    };
+
+    // Factory that loads a tessellation back from its page file.
+    class PageFactory
+      : public ILazyFactory<StaticTriangleTess>
+    {
+      public:
+        PageFactory(Impl& impl, Page& page)
+          : m_impl(impl)
+          , m_page(page)
+        {
+        }
+
+        unique_ptr<StaticTriangleTess> create() override
+        {
+            unique_ptr<StaticTriangleTess> tess(new StaticTriangleTess());
+
+            try
+            {
+                read_page_file(m_page.m_filepath, *tess);
+            }
+            catch (const ExceptionIOError& e)
+            {
+                RENDERER_LOG_ERROR(
+                    "failed to load geometry page file %s: %s.",
+                    m_page.m_filepath.c_str(),
+                    e.what());
+                m_impl.on_page_load_failed();
+                return unique_ptr<StaticTriangleTess>();
+            }
+
+            m_impl.on_page_loaded(m_page, tess->get_memory_size());
+
+            return tess;
+        }
+
+      private:
+        Impl&   m_impl;
+        Page&   m_page;
+    };
+
+    typedef map<const Lazy<StaticTriangleTess>*, unique_ptr<Page>> PageMap;
+
+    const size_t        m_max_size;
+    bf::path            m_directory;
+
+    boost::mutex        m_mutex;
+    PageMap             m_pages;
+    list<Page*>         m_loaded_pages;         // most recently loaded first
+    size_t              m_page_index;
+    size_t              m_memory_size;
+    size_t              m_peak_memory_size;
+    uint64              m_file_size;
+    uint64              m_load_count;
+    uint64              m_failed_load_count;
+    uint64              m_release_count;
+
+    explicit Impl(const ParamArray& params)
+      : m_max_size(params.get_optional<size_t>("max_size", GeometryPager::get_default_size()))
+      , m_page_index(0)
+      , m_memory_size(0)
+      , m_peak_memory_size(0)
+      , m_file_size(0)
+      , m_load_count(0)
+      , m_failed_load_count(0)
+      , m_release_count(0)
+    {
+        const string directory = params.get_optional<string>("directory", "");
+
+        m_directory =
+            (directory.empty() ? bf::temp_directory_path() : bf::path(directory))
+                / bf::unique_path("appleseed-geometry-%%%%-%%%%-%%%%-%%%%");
+
+        bf::create_directories(m_directory);
+    }
+
+    ~Impl()
+    {
+        m_loaded_pages.clear();
+        m_pages.clear();
+
+        boost::system::error_code ec;
+        bf::remove_all(m_directory, ec);
+    }
+
+    void on_page_load_failed()
+    {
+        boost::mutex::scoped_lock lock(m_mutex);
+        ++m_failed_load_count;
+    }
+
+    void on_page_loaded(Page& page, const size_t memory_size)
+    {
+        boost::mutex::scoped_lock lock(m_mutex);
+
+        assert(page.m_memory_size == 0);
+        page.m_memory_size = memory_size;
+        page.m_loaded_it = m_loaded_pages.insert(m_loaded_pages.begin(), &page);
+
+        ++m_load_count;
+
+        m_memory_size += memory_size;
+        if (m_peak_memory_size < m_memory_size)
+            m_peak_memory_size = m_memory_size;
+
+        // Release the least recently loaded tessellations until we are within budget.
+        // Tessellations that are currently being accessed are skipped.
+        auto i = m_loaded_pages.end();
+        while (m_memory_size > m_max_size && i != m_loaded_pages.begin())
+        {
+            Page* candidate = *--i;
+
+            if (candidate == &page)
+                continue;
+
+            if (candidate->m_lazy->try_release_object())
+            {
+                m_memory_size -= candidate->m_memory_size;
+                candidate->m_memory_size = 0;
+                i = m_loaded_pages.erase(i);
+                ++m_release_count;
+            }
+        }
+    }
+};
+
+GeometryPager::GeometryPager(const ParamArray& params)
+  : impl(new Impl(params))
+{
+}
+
+GeometryPager::~GeometryPager()
+{
+    delete impl;
+}
+
+Lazy<StaticTriangleTess>* GeometryPager::page_out(const StaticTriangleTess& tess)
+{
+    boost::mutex::scoped_lock lock(impl->m_mutex);
+
+    unique_ptr<Impl::Page> page(new Impl::Page());
+    page->m_filepath =
+        (impl->m_directory / ("page-" + to_string(impl->m_page_index++) + ".bin")).string();
+    page->m_memory_size = 0;
+
+    try
+    {
+        write_page_file(page->m_filepath, tess);
+    }
+    catch (const ExceptionIOError& e)
+    {
+        RENDERER_LOG_WARNING(
+            "failed to write geometry page file %s: %s; geometry will remain in memory.",
+            page->m_filepath.c_str(),
+            e.what());
+        return nullptr;
+    }
+
+    impl->m_file_size += bf::file_size(page->m_filepath);
+
+    page->m_lazy.reset(
+        new Lazy<StaticTriangleTess>(
+            unique_ptr<ILazyFactory<StaticTriangleTess>>(
+                new Impl::PageFactory(*impl, *page))));
+
+    Lazy<StaticTriangleTess>* lazy = page->m_lazy.get();
+    impl->m_pages[lazy] = move(page);
+
+    return lazy;
+}
+
+bool GeometryPager::page_in(
+    Lazy<StaticTriangleTess>*   lazy,
+    StaticTriangleTess&         tess)
+{
+    boost::mutex::scoped_lock lock(impl->m_mutex);
+
+    const auto i = impl->m_pages.find(lazy);
+    assert(i != impl->m_pages.end());
+
+    Impl::Page& page = *i->second;
+
+    try
+    {
+        read_page_file(page.m_filepath, tess);
+    }
+    catch (const ExceptionIOError& e)
+    {
+        RENDERER_LOG_ERROR(
+            "failed to read geometry page file %s: %s.",
+            page.m_filepath.c_str(),
+            e.what());
+        tess.clear();
+        return false;
+    }
+
+    if (page.m_memory_size > 0)
+    {
+        impl->m_memory_size -= page.m_memory_size;
+        impl->m_loaded_pages.erase(page.m_loaded_it);
+    }
+
+    boost::system::error_code ec;
+    impl->m_file_size -= bf::file_size(page.m_filepath, ec);
+    bf::remove(page.m_filepath, ec);
+
+    impl->m_pages.erase(i);
+
+    return true;
+}
+
+size_t GeometryPager::get_max_size() const
+{
+    return impl->m_max_size;
+}
+
+StatisticsVector GeometryPager::get_statistics() const
+{
+    boost::mutex::scoped_lock lock(impl->m_mutex);
+
+    Statistics stats;
+    stats.insert("pages", impl->m_pages.size());
+    stats.insert_size("page files size", impl->m_file_size);
+    stats.insert_size("budget", impl->m_max_size);
+    stats.insert_size("peak size", impl->m_peak_memory_size);
+    stats.insert("loads", impl->m_load_count);
+    stats.insert("failed loads", impl->m_failed_load_count);
+    stats.insert("releases", impl->m_release_count);
+
+    return StatisticsVector::make("geometry pager statistics", stats);
+}
+
+size_t GeometryPager::get_default_size()
+{
+    return 1024 * 1024 * 1024;
+}
+
+Dictionary GeometryPager::get_params_metadata()
+{
+    Dictionary metadata;
+
+    metadata.dictionaries().insert(
+        "enabled",
+        Dictionary()
+            .insert("type", "bool")
+            .insert("default", "false")
+            .insert("label", "Enable Geometry Paging")
+            .insert("help", "Store mesh geometry on disk and load it on demand during rendering"));
+
+    metadata.dictionaries().insert(
+        "max_size",
+        Dictionary()
+            .insert("type", "int")
+            .insert("default", get_default_size())
+            .insert("label", "Geometry Memory Budget")
+            .insert("help", "Maximum amount of paged geometry kept in memory, in bytes"));
+
+    metadata.dictionaries().insert(
+        "directory",
+        Dictionary()
+            .insert("type", "text")
+            .insert("default", "")
+            .insert("label", "Page Files Directory")
+            .insert("help", "Directory where page files are stored; the system temporary directory is used if empty"));
+
+    return metadata;
+}
+
+}   // namespace renderer
@@ -0,0 +1,101 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2018 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef APPLESEED_RENDERER_KERNEL_TESSELLATION_GEOMETRYPAGER_H
+#define APPLESEED_RENDERER_KERNEL_TESSELLATION_GEOMETRYPAGER_H
+
+// appleseed.renderer headers.
+#include "renderer/kernel/tessellation/statictessellation.h"
+
+// appleseed.foundation headers.
+#include "foundation/core/concepts/noncopyable.h"
+#include "foundation/utility/lazy.h"
+
+// Standard headers.
+#include <cstddef>
+
+// Forward declarations.
+namespace foundation    { class Dictionary; }
+namespace foundation    { class StatisticsVector; }
+namespace renderer      { class ParamArray; }
+
+namespace renderer
+{
+
+//
+// Out-of-core storage for static triangle tessellations.
+//
+// Tessellations handed to the pager are written to compressed page files and
+// replaced by lazy objects that load them back the first time they are accessed.
+// Whenever the total size of the loaded tessellations exceeds the memory budget,
+// the least recently loaded tessellations that are not being accessed are released.
+// If a page file cannot be read back, accessing its lazy object yields nullptr.
+//
+
+class GeometryPager
+  : public foundation::NonCopyable
+{
+  public:
+    // Constructor.
+    explicit GeometryPager(const ParamArray& params);
+
+    // Destructor, deletes all page files.
+    ~GeometryPager();
+
+    // Write a tessellation to a page file and return a lazy object that loads it
+    // back on demand. The lazy object is owned by the pager. Return nullptr if the
+    // page file could not be written, in which case the tessellation must be kept.
+    foundation::Lazy<StaticTriangleTess>* page_out(const StaticTriangleTess& tess);
+
+    // Read back a tessellation paged out with page_out(), then delete its page
+    // file and its lazy object. Return false if the page file could not be read,
+    // in which case the tessellation is left empty and the page is kept.
+    bool page_in(
+        foundation::Lazy<StaticTriangleTess>*   lazy,
+        StaticTriangleTess&                     tess);
+
+    // Return the memory budget in bytes.
+    size_t get_max_size() const;
+
+    // Retrieve performance statistics.
+    foundation::StatisticsVector get_statistics() const;
+
+    // Return the default memory budget in bytes.
+    static size_t get_default_size();
+
+    // Return the metadata of the pager parameters.
+    static foundation::Dictionary get_params_metadata();
+
+  private:
+    struct Impl;
+    Impl* impl;
+};
+
+}       // namespace renderer
+
+#endif  // !APPLESEED_RENDERER_KERNEL_TESSELLATION_GEOMETRYPAGER_H
@@ -0,0 +1,305 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2018 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// Interface header.
+#include "loopsubdivision.h"
+
+// appleseed.renderer headers.
+#include "renderer/global/globaltypes.h"
+#include "renderer/modeling/object/triangle.h"
+
+// appleseed.foundation headers.
+#include "foundation/math/vector.h"
+#include "foundation/platform/types.h"
+
+// Standard headers.
+#include <cassert>
+#include <cstddef>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace foundation;
+using namespace std;
+
+namespace renderer
+{
+
+namespace
+{
+    inline uint64 make_edge_key(const uint32 a, const uint32 b)
+    {
+        return a < b
+            ? (static_cast<uint64>(a) << 32) | b
+            : (static_cast<uint64>(b) << 32) | a;
+    }
+
+    struct Edge
+    {
+        uint32  m_v0;
+        uint32  m_v1;
+        uint32  m_opposite[2];      // vertices opposite to the edge in the first two adjacent triangles
+        uint32  m_face_count;       // number of adjacent triangles
+    };
+
+    // Find or create an edge, return its index.
+    uint32 insert_edge(
+        unordered_map<uint64, uint32>&  edge_indices,
+        vector<Edge>&                   edges,
+        const uint32                    v0,
+        const uint32                    v1,
+        const uint32                    opposite)
+    {
+        const auto result =
+            edge_indices.insert(
+                make_pair(
+                    make_edge_key(v0, v1),
+                    static_cast<uint32>(edges.size())));
+
+        if (result.second)
+        {
+            Edge edge;
+            edge.m_v0 = v0;
+            edge.m_v1 = v1;
+            edge.m_opposite[0] = opposite;
+            edge.m_opposite[1] = Triangle::None;
+            edge.m_face_count = 1;
+            edges.push_back(edge);
+        }
+        else
+        {
+            Edge& edge = edges[result.first->second];
+            if (edge.m_face_count == 1)
+                edge.m_opposite[1] = opposite;
+            ++edge.m_face_count;
+        }
+
+        return result.first->second;
+    }
+
+    // Return the index of the texture coordinates at the middle of a texture space edge,
+    // creating them if necessary.
+    uint32 insert_tex_coords_midpoint(
+        const StaticTriangleTess&       input,
+        StaticTriangleTess&             output,
+        unordered_map<uint64, uint32>&  midpoints,
+        const uint32                    a0,
+        const uint32                    a1)
+    {
+        const uint64 key = make_edge_key(a0, a1);
+
+        const auto i = midpoints.find(key);
+        if (i != midpoints.end())
+            return i->second;
+
+        const GVector2 uv =
+            GScalar(0.5) * (input.get_tex_coords(a0) + input.get_tex_coords(a1));
+        const uint32 index = static_cast<uint32>(output.push_tex_coords(uv));
+
+        midpoints.insert(make_pair(key, index));
+
+        return index;
+    }
+}
+
+void loop_subdivide(
+    const StaticTriangleTess&   input,
+    StaticTriangleTess&         output)
+{
+    assert(&input != &output);
+    assert(input.get_motion_segment_count() == 0);
+
+    const size_t vertex_count = input.m_vertices.size();
+    const size_t triangle_count = input.m_primitives.size();
+
+    // Collect the edges of the mesh and remember the edges of each triangle.
+    unordered_map<uint64, uint32> edge_indices;
+    vector<Edge> edges;
+    vector<uint32> triangle_edges(triangle_count * 3);
+    edges.reserve(triangle_count * 3 / 2 + 1);
+
+    for (size_t i = 0; i < triangle_count; ++i)
+    {
+        const Triangle& triangle = input.m_primitives[i];
+        triangle_edges[i * 3 + 0] = insert_edge(edge_indices, edges, triangle.m_v0, triangle.m_v1, triangle.m_v2);
+        triangle_edges[i * 3 + 1] = insert_edge(edge_indices, edges, triangle.m_v1, triangle.m_v2, triangle.m_v0);
+        triangle_edges[i * 3 + 2] = insert_edge(edge_indices, edges, triangle.m_v2, triangle.m_v0, triangle.m_v1);
+    }
+
+    // Accumulate the neighbors of each vertex, and separately its neighbors along boundary edges.
+    vector<GVector3> neighbor_sums(vertex_count, GVector3(0.0f));
+    vector<GVector3> boundary_neighbor_sums(vertex_count, GVector3(0.0f));
+    vector<uint32> valences(vertex_count, 0);
+    vector<uint32> boundary_valences(vertex_count, 0);
+
+    for (const Edge& edge : edges)
+    {
+        const GVector3& p0 = input.m_vertices[edge.m_v0];
+        const GVector3& p1 = input.m_vertices[edge.m_v1];
+
+        neighbor_sums[edge.m_v0] += p1;
+        neighbor_sums[edge.m_v1] += p0;
+        ++valences[edge.m_v0];
+        ++valences[edge.m_v1];
+
+        if (edge.m_face_count != 2)
+        {
+            boundary_neighbor_sums[edge.m_v0] += p1;
+            boundary_neighbor_sums[edge.m_v1] += p0;
+            ++boundary_valences[edge.m_v0];
+            ++boundary_valences[edge.m_v1];
+        }
+    }
+
+    output.clear();
+    output.m_vertices.reserve(vertex_count + edges.size());
+
+    // Compute the new positions of the existing (even) vertices.
+    for (size_t i = 0; i < vertex_count; ++i)
+    {
+        const GVector3& p = input.m_vertices[i];
+
+        if (boundary_valences[i] == 0)
+        {
+            // Interior vertex.
+            const size_t n = valences[i];
+            if (n > 0)
+            {
+                const GScalar beta =
+                    n == 3 ? GScalar(3.0 / 16.0) : GScalar(3.0 / (8.0 * n));
+                output.m_vertices.push_back(
+                    (GScalar(1.0) - n * beta) * p + beta * neighbor_sums[i]);
+            }
+            else output.m_vertices.push_back(p);
+        }
+        else if (boundary_valences[i] == 2)
+        {
+            // Regular boundary vertex.
+            output.m_vertices.push_back(
+                GScalar(0.75) * p + GScalar(0.125) * boundary_neighbor_sums[i]);
+        }
+        else
+        {
+            // Corner or non-manifold vertex: keep it in place.
+            output.m_vertices.push_back(p);
+        }
+    }
+
+    // Insert one new (odd) vertex per edge.
+    for (const Edge& edge : edges)
+    {
+        const GVector3& p0 = input.m_vertices[edge.m_v0];
+        const GVector3& p1 = input.m_vertices[edge.m_v1];
+
+        if (edge.m_face_count == 2)
+        {
+            const GVector3& q0 = input.m_vertices[edge.m_opposite[0]];
+            const GVector3& q1 = input.m_vertices[edge.m_opposite[1]];
+            output.m_vertices.push_back(
+                GScalar(3.0 / 8.0) * (p0 + p1) + GScalar(1.0 / 8.0) * (q0 + q1));
+        }
+        else output.m_vertices.push_back(GScalar(0.5) * (p0 + p1));
+    }
+
+    // Copy existing texture coordinates; midpoints are inserted on demand below.
+    const size_t tex_coords_count = input.get_tex_coords_count();
+    if (tex_coords_count > 0)
+    {
+        output.reserve_tex_coords(tex_coords_count * 4);
+        for (size_t i = 0; i < tex_coords_count; ++i)
+            output.push_tex_coords(input.get_tex_coords(i));
+    }
+
+    unordered_map<uint64, uint32> tex_coords_midpoints;
+
+    // Split each triangle into four.
+    output.m_primitives.reserve(triangle_count * 4);
+
+    for (size_t i = 0; i < triangle_count; ++i)
+    {
+        const Triangle& triangle = input.m_primitives[i];
+
+        const uint32 v0 = triangle.m_v0;
+        const uint32 v1 = triangle.m_v1;
+        const uint32 v2 = triangle.m_v2;
+        const uint32 v01 = static_cast<uint32>(vertex_count + triangle_edges[i * 3 + 0]);
+        const uint32 v12 = static_cast<uint32>(vertex_count + triangle_edges[i * 3 + 1]);
+        const uint32 v20 = static_cast<uint32>(vertex_count + triangle_edges[i * 3 + 2]);
+
+        uint32 a0 = Triangle::None, a1 = Triangle::None, a2 = Triangle::None;
+        uint32 a01 = Triangle::None, a12 = Triangle::None, a20 = Triangle::None;
+
+        if (tex_coords_count > 0 && triangle.has_vertex_attributes())
+        {
+            a0 = triangle.m_a0;
+            a1 = triangle.m_a1;
+            a2 = triangle.m_a2;
+            a01 = insert_tex_coords_midpoint(input, output, tex_coords_midpoints, a0, a1);
+            a12 = insert_tex_coords_midpoint(input, output, tex_coords_midpoints, a1, a2);
+            a20 = insert_tex_coords_midpoint(input, output, tex_coords_midpoints, a2, a0);
+        }
+
+        output.m_primitives.push_back(Triangle(v0, v01, v20, v0, v01, v20, a0, a01, a20, triangle.m_pa));
+        output.m_primitives.push_back(Triangle(v01, v1, v12, v01, v1, v12, a01, a1, a12, triangle.m_pa));
+        output.m_primitives.push_back(Triangle(v20, v12, v2, v20, v12, v2, a20, a12, a2, triangle.m_pa));
+        output.m_primitives.push_back(Triangle(v01, v12, v20, v01, v12, v20, a01, a12, a20, triangle.m_pa));
+    }
+}
+
+void compute_smooth_vertex_normals(StaticTriangleTess& tess)
+{
+    const size_t vertex_count = tess.m_vertices.size();
+
+    tess.m_vertex_normals.assign(vertex_count, GVector3(0.0f));
+
+    for (Triangle& triangle : tess.m_primitives)
+    {
+        const GVector3& p0 = tess.m_vertices[triangle.m_v0];
+        const GVector3& p1 = tess.m_vertices[triangle.m_v1];
+        const GVector3& p2 = tess.m_vertices[triangle.m_v2];
+
+        // The length of the cross product is proportional to the area of the triangle.
+        const GVector3 n = cross(p1 - p0, p2 - p0);
+
+        tess.m_vertex_normals[triangle.m_v0] += n;
+        tess.m_vertex_normals[triangle.m_v1] += n;
+        tess.m_vertex_normals[triangle.m_v2] += n;
+
+        triangle.m_n0 = triangle.m_v0;
+        triangle.m_n1 = triangle.m_v1;
+        triangle.m_n2 = triangle.m_v2;
+    }
+
+    for (size_t i = 0; i < vertex_count; ++i)
+    {
+        tess.m_vertex_normals[i] =
+            safe_normalize(tess.m_vertex_normals[i], GVector3(0.0f, 1.0f, 0.0f));
+    }
+}
+
+}   // namespace renderer
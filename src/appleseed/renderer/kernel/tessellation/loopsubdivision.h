@@ -0,0 +1,65 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2018 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef APPLESEED_RENDERER_KERNEL_TESSELLATION_LOOPSUBDIVISION_H
+#define APPLESEED_RENDERER_KERNEL_TESSELLATION_LOOPSUBDIVISION_H
+
+// appleseed.renderer headers.
+#include "renderer/kernel/tessellation/statictessellation.h"
+
+namespace renderer
+{
+
+//
+// Loop subdivision of triangle meshes.
+//
+// Reference:
+//
+//   Smooth Subdivision Surfaces Based on Triangles
+//   Charles Loop, Master's thesis, University of Utah, 1987.
+//
+// Boundary edges (and non-manifold edges) are treated as creases. Texture
+// coordinates are interpolated linearly. Vertex motion poses are not supported.
+//
+
+// Perform one level of Loop subdivision. The output tessellation is cleared first.
+// Every triangle of the output tessellation references vertex normals with the same
+// indices as its vertices, but no vertex normal is created: call
+// compute_smooth_vertex_normals() once the final vertex positions are known.
+void loop_subdivide(
+    const StaticTriangleTess&   input,
+    StaticTriangleTess&         output);
+
+// Replace the vertex normals of a tessellation by area-weighted averages of the
+// normals of the triangles sharing each vertex. Vertex normal indices of all
+// triangles are set to their vertex indices.
+void compute_smooth_vertex_normals(StaticTriangleTess& tess);
+
+}       // namespace renderer
+
+#endif  // !APPLESEED_RENDERER_KERNEL_TESSELLATION_LOOPSUBDIVISION_H
@@ -0,0 +1,433 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2018 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// Interface header.
+#include "meshtessellator.h"
+
+// appleseed.renderer headers.
+#include "renderer/global/globallogger.h"
+#include "renderer/kernel/texturing/texturecache.h"
+#include "renderer/modeling/camera/camera.h"
+#include "renderer/modeling/frame/frame.h"
+#include "renderer/modeling/object/meshobject.h"
+#include "renderer/modeling/object/object.h"
+#include "renderer/modeling/object/triangle.h"
+#include "renderer/modeling/project/project.h"
+#include "renderer/modeling/scene/assembly.h"
+#include "renderer/modeling/scene/assemblyinstance.h"
+#include "renderer/modeling/scene/containers.h"
+#include "renderer/modeling/scene/objectinstance.h"
+#include "renderer/modeling/scene/scene.h"
+#include "renderer/utility/paramarray.h"
+#include "renderer/utility/transformsequence.h"
+
+// appleseed.foundation headers.
+#include "foundation/image/canvasproperties.h"
+#include "foundation/image/image.h"
+#include "foundation/math/scalar.h"
+#include "foundation/math/transform.h"
+#include "foundation/math/vector.h"
+#include "foundation/platform/defaulttimers.h"
+#include "foundation/utility/containers/dictionary.h"
+#include "foundation/utility/job.h"
+#include "foundation/utility/profiler.h"
+#include "foundation/utility/stopwatch.h"
+#include "foundation/utility/string.h"
+
+// Standard headers.
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <set>
+#include <vector>
+
+using namespace foundation;
+using namespace std;
+
+namespace renderer
+{
+
+//
+// MeshTessellator class implementation.
+//
+
+namespace
+{
+    // Clip a segment expressed in normalized device coordinates against the frame.
+    // Returns false if the segment lies entirely outside of the frame.
+    bool clip_to_frame(Vector2d& a, Vector2d& b)
+    {
+        const Vector2d d = b - a;
+        double t0 = 0.0, t1 = 1.0;
+
+        for (size_t i = 0; i < 2; ++i)
+        {
+            if (d[i] == 0.0)
+            {
+                if (a[i] < 0.0 || a[i] > 1.0)
+                    return false;
+                continue;
+            }
+
+            const double rcp_d = 1.0 / d[i];
+            double u0 = -a[i] * rcp_d;
+            double u1 = (1.0 - a[i]) * rcp_d;
+            if (u0 > u1)
+                std::swap(u0, u1);
+
+            t0 = max(t0, u0);
+            t1 = min(t1, u1);
+
+            if (t0 > t1)
+                return false;
+        }
+
+        const Vector2d clipped_a = a + t0 * d;
+        b = a + t1 * d;
+        a = clipped_a;
+
+        return true;
+    }
+
+    // Return the subdivision level required for the edges of an instance of a mesh
+    // object to project to at most a given length on the film of the camera.
+    // Only the visible part of the edges is taken into account; the level is uniform
+    // across the object, so a single large edge in the frame still drives it.
+    size_t compute_subdivision_level(
+        const MeshObject&       object,
+        const Transformd&       object_to_world,
+        const Camera&           camera,
+        const float             time,
+        const Vector2d&         frame_size,
+        const double            max_edge_length,
+        const size_t            max_level)
+    {
+        const size_t vertex_count = object.get_vertex_count();
+
+        vector<Vector3d> world_vertices(vertex_count);
+        for (size_t i = 0; i < vertex_count; ++i)
+            world_vertices[i] = object_to_world.point_to_parent(Vector3d(object.get_vertex(i)));
+
+        double max_square_length = 0.0;
+
+        for (size_t i = 0, e = object.get_triangle_count(); i < e; ++i)
+        {
+            const Triangle& triangle = object.get_triangle(i);
+            const uint32 v[3] = { triangle.m_v0, triangle.m_v1, triangle.m_v2 };
+
+            for (size_t j = 0; j < 3; ++j)
+            {
+                Vector2d a_ndc, b_ndc;
+                if (camera.project_segment(
+                        time,
+                        world_vertices[v[j]],
+                        world_vertices[v[(j + 1) % 3]],
+                        a_ndc,
+                        b_ndc) &&
+                    clip_to_frame(a_ndc, b_ndc))
+                {
+                    const Vector2d d = (b_ndc - a_ndc) * frame_size;
+                    max_square_length = max(max_square_length, square_norm(d));
+                }
+            }
+        }
+
+        const double max_length = sqrt(max_square_length);
+        if (max_length <= max_edge_length)
+            return 0;
+
+        // Each level of subdivision halves the length of the edges.
+        const double level = ceil(log(max_length / max_edge_length) / log(2.0));
+
+        return min(static_cast<size_t>(level), max_level);
+    }
+
+    struct DicingTarget
+    {
+        size_t              m_level;
+        set<Assembly*>      m_assemblies;   // assemblies containing the object
+
+        DicingTarget()
+          : m_level(0)
+        {
+        }
+    };
+
+    typedef map<MeshObject*, DicingTarget> DicingTargetMap;
+    typedef map<MeshObject*, set<Assembly*>> MeshInstanceMap;
+
+    struct DicingContext
+    {
+        const Camera&       m_camera;
+        const float         m_time;
+        const Vector2d      m_frame_size;
+        const double        m_edge_length;
+        DicingTargetMap     m_targets;
+        MeshInstanceMap     m_instances;    // assemblies containing each mesh object, diced or not
+
+        DicingContext(
+            const Camera&   camera,
+            const Vector2d& frame_size,
+            const double    edge_length)
+          : m_camera(camera)
+          , m_time(camera.get_shutter_middle_time())
+          , m_frame_size(frame_size)
+          , m_edge_length(edge_length)
+        {
+        }
+    };
+
+    void collect_dicing_targets(
+        DicingContext&                      context,
+        const AssemblyInstanceContainer&    assembly_instances,
+        const Transformd&                   parent_transform)
+    {
+        for (const auto& assembly_instance : assembly_instances)
+        {
+            Assembly& assembly = assembly_instance.get_assembly();
+
+            const Transformd assembly_transform =
+                assembly_instance.transform_sequence().evaluate(context.m_time) * parent_transform;
+
+            for (const auto& object_instance : assembly.object_instances())
+            {
+                Object& object = object_instance.get_object();
+
+                if (strcmp(object.get_model(), MeshObjectFactory().get_model()) != 0)
+                    continue;
+
+                MeshObject& mesh_object = static_cast<MeshObject&>(object);
+                context.m_instances[&mesh_object].insert(&assembly);
+
+                if (!mesh_object.needs_dicing())
+                    continue;
+
+                if (mesh_object.get_motion_segment_count() > 0)
+                {
+                    RENDERER_LOG_WARNING(
+                        "mesh object \"%s\" has deformation motion blur and cannot be diced.",
+                        mesh_object.get_path().c_str());
+                    continue;
+                }
+
+                const size_t level =
+                    compute_subdivision_level(
+                        mesh_object,
+                        object_instance.get_transform() * assembly_transform,
+                        context.m_camera,
+                        context.m_time,
+                        context.m_frame_size,
+                        context.m_edge_length,
+                        mesh_object.get_max_subdivision_level());
+
+                DicingTarget& target = context.m_targets[&mesh_object];
+                target.m_level = max(target.m_level, level);
+                target.m_assemblies.insert(&assembly);
+            }
+
+            collect_dicing_targets(context, assembly.assembly_instances(), assembly_transform);
+        }
+    }
+
+    // Discard the diced geometry of mesh objects that are no longer dicing targets,
+    // either because they don't need dicing anymore or because they are not instanced.
+    size_t clear_stale_dicing(
+        const DicingContext&                context,
+        const AssemblyContainer&            assemblies)
+    {
+        size_t cleared_object_count = 0;
+
+        for (auto& assembly : assemblies)
+        {
+            for (auto& object : assembly.objects())
+            {
+                if (strcmp(object.get_model(), MeshObjectFactory().get_model()) != 0)
+                    continue;
+
+                MeshObject& mesh_object = static_cast<MeshObject&>(object);
+
+                if (!mesh_object.is_diced() || context.m_targets.count(&mesh_object) > 0)
+                    continue;
+
+                mesh_object.clear_dicing();
+                ++cleared_object_count;
+
+                // Acceleration structures of the assemblies instancing the object need to be rebuilt.
+                const auto instances = context.m_instances.find(&mesh_object);
+                if (instances != context.m_instances.end())
+                {
+                    for (Assembly* instancing_assembly : instances->second)
+                        instancing_assembly->bump_version_id();
+                }
+            }
+
+            cleared_object_count += clear_stale_dicing(context, assembly.assemblies());
+        }
+
+        return cleared_object_count;
+    }
+
+    class DicingJob
+      : public IJob
+    {
+      public:
+        DicingJob(
+            MeshObject&         object,
+            const size_t        level,
+            TextureStore&       texture_store,
+            IAbortSwitch*       abort_switch)
+          : m_object(object)
+          , m_level(level)
+          , m_texture_store(texture_store)
+          , m_abort_switch(abort_switch)
+        {
+        }
+
+        void execute(const size_t thread_index) override
+        {
+            if (is_aborted(m_abort_switch))
+                return;
+
+            TextureCache texture_cache(m_texture_store);
+            m_object.dice(m_level, texture_cache);
+        }
+
+      private:
+        MeshObject&             m_object;
+        const size_t            m_level;
+        TextureStore&           m_texture_store;
+        IAbortSwitch*           m_abort_switch;
+    };
+}
+
+MeshTessellator::MeshTessellator(
+    const Project&              project,
+    TextureStore&               texture_store,
+    const ParamArray&           params,
+    const size_t                thread_count)
+  : m_project(project)
+  , m_texture_store(texture_store)
+  , m_edge_length(params.get_optional<float>("edge_length", 2.0f))
+  , m_thread_count(thread_count)
+{
+}
+
+bool MeshTessellator::tessellate(IAbortSwitch* abort_switch)
+{
+    ProfileZone profile_zone("tessellate meshes");
+
+    const Scene& scene = *m_project.get_scene();
+
+    const Camera* camera = scene.get_active_camera();
+    if (camera == nullptr)
+        return true;
+
+    const CanvasProperties& props = m_project.get_frame()->image().properties();
+
+    DicingContext context(
+        *camera,
+        Vector2d(
+            static_cast<double>(props.m_canvas_width),
+            static_cast<double>(props.m_canvas_height)),
+        max(static_cast<double>(m_edge_length), 1.0e-3));
+
+    collect_dicing_targets(context, scene.assembly_instances(), Transformd::identity());
+
+    const size_t cleared_object_count = clear_stale_dicing(context, scene.assemblies());
+    if (cleared_object_count > 0)
+    {
+        RENDERER_LOG_INFO(
+            "discarded diced geometry of %s mesh object%s.",
+            pretty_uint(cleared_object_count).c_str(),
+            cleared_object_count > 1 ? "s" : "");
+    }
+
+    if (context.m_targets.empty())
+        return true;
+
+    Stopwatch<DefaultWallclockTimer> stopwatch;
+    stopwatch.start();
+
+    JobQueue job_queue;
+    size_t diced_object_count = 0;
+
+    for (const auto& entry : context.m_targets)
+    {
+        MeshObject& object = *entry.first;
+        const DicingTarget& target = entry.second;
+
+        // Skip objects that are already diced at the right level, unless the base cage,
+        // the object parameters or the displacement map changed since they were diced.
+        if (object.is_diced() &&
+            object.get_dicing_level() == target.m_level &&
+            object.get_dicing_signature() == object.compute_dicing_signature())
+            continue;
+
+        job_queue.schedule(new DicingJob(object, target.m_level, m_texture_store, abort_switch));
+        ++diced_object_count;
+
+        // Acceleration structures of the parent assemblies need to be rebuilt.
+        for (Assembly* assembly : target.m_assemblies)
+            assembly->bump_version_id();
+    }
+
+    if (diced_object_count > 0)
+    {
+        JobManager job_manager(global_logger(), job_queue, m_thread_count);
+        job_manager.start();
+        job_queue.wait_until_completion();
+
+        stopwatch.measure();
+
+        RENDERER_LOG_INFO(
+            "diced %s mesh object%s in %s.",
+            pretty_uint(diced_object_count).c_str(),
+            diced_object_count > 1 ? "s" : "",
+            pretty_time(stopwatch.get_seconds()).c_str());
+    }
+
+    return !is_aborted(abort_switch);
+}
+
+Dictionary MeshTessellator::get_params_metadata()
+{
+    Dictionary metadata;
+
+    metadata.dictionaries().insert(
+        "edge_length",
+        Dictionary()
+            .insert("type", "float")
+            .insert("default", "2.0")
+            .insert("label", "Edge Length")
+            .insert("help", "Target length in pixels of the edges of diced meshes"));
+
+    return metadata;
+}
+
+}   // namespace renderer
@@ -0,0 +1,92 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2018 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef APPLESEED_RENDERER_KERNEL_TESSELLATION_MESHTESSELLATOR_H
+#define APPLESEED_RENDERER_KERNEL_TESSELLATION_MESHTESSELLATOR_H
+
+// appleseed.foundation headers.
+#include "foundation/core/concepts/noncopyable.h"
+
+// Standard headers.
+#include <cstddef>
+
+// Forward declarations.
+namespace foundation    { class Dictionary; }
+namespace foundation    { class IAbortSwitch; }
+namespace renderer      { class ParamArray; }
+namespace renderer      { class Project; }
+namespace renderer      { class TextureStore; }
+
+namespace renderer
+{
+
+//
+// Render-time dicing of subdivision and displaced meshes.
+//
+// For each mesh object that needs dicing, the tessellator projects the edges of
+// the base cage of every instance of the object onto the film of the active camera
+// and picks the smallest subdivision level that brings the longest projected edge
+// under the target edge length (in pixels). Objects are then diced in parallel.
+//
+// Edges are clipped against the frame, so off-screen geometry does not drive the
+// subdivision level. The level is however uniform across an object: a single large
+// visible edge refines the whole object, up to its max_subdivision_level parameter.
+//
+
+class MeshTessellator
+  : public foundation::NonCopyable
+{
+  public:
+    // Constructor.
+    MeshTessellator(
+        const Project&              project,
+        TextureStore&               texture_store,
+        const ParamArray&           params,
+        const size_t                thread_count);
+
+    // Dice all mesh objects of the scene that need it. Objects whose subdivision
+    // level, base cage, parameters and displacement map did not change since the
+    // last call are left untouched; objects that no longer need dicing get their
+    // diced geometry discarded. The version of assemblies containing objects whose
+    // geometry changed is bumped so that acceleration structures get rebuilt.
+    // Return false if tessellation was aborted.
+    bool tessellate(foundation::IAbortSwitch* abort_switch = nullptr);
+
+    // Return the metadata of the tessellator parameters.
+    static foundation::Dictionary get_params_metadata();
+
+  private:
+    const Project&                  m_project;
+    TextureStore&                   m_texture_store;
+    const float                     m_edge_length;
+    const size_t                    m_thread_count;
+};
+
+}       // namespace renderer
+
+#endif  // !APPLESEED_RENDERER_KERNEL_TESSELLATION_MESHTESSELLATOR_H
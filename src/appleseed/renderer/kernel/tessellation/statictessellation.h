@@ -37,6 +37,7 @@
 // appleseed.foundation headers.
 #include "foundation/core/concepts/noncopyable.h"
 #include "foundation/utility/attributeset.h"
+#include "foundation/utility/bufferedfile.h"
 #include "foundation/utility/lazy.h"
 #include "foundation/utility/numerictype.h"
 #include "foundation/utility/poolallocator.h"
@@ -144,6 +145,21 @@ class StaticTessellation
     // Compute the local space bounding box of the tessellation over the shutter interval.
     GAABB3 compute_local_bbox() const;
 
+    // Remove all primitives, vertices and attributes, and release the associated memory.
+    void clear();
+
+    // Replace the content of this tessellation by a copy of another tessellation.
+    void copy_from(const StaticTessellation& rhs);
+
+    // Return the amount of memory used by this tessellation, in bytes.
+    size_t get_memory_size() const;
+
+    // Write the tessellation to a binary stream, or replace the content of the
+    // tessellation by the one read from a binary stream. Both methods throw
+    // foundation::ExceptionIOError on failure.
+    void write(foundation::WriterAdapter& writer) const;
+    void read(foundation::ReaderAdapter& reader);
+
   private:
     foundation::AttributeSet::ChannelID m_uv_0_cid;         // UV coordinates set #0
     foundation::AttributeSet::ChannelID m_tangents_cid;     // per-vertex tangent vectors
@@ -154,6 +170,13 @@ class StaticTessellation
 
     void create_uv_0_attribute();
     void create_tangents_attribute();
+    void find_channels();
+
+    template <typename T>
+    static void write_array(foundation::WriterAdapter& writer, const std::vector<T>& array);
+
+    template <typename T>
+    static void read_array(foundation::ReaderAdapter& reader, std::vector<T>& array);
 };
 
 // Specialization of the StaticTessellation class for triangles.
@@ -478,6 +501,88 @@ GAABB3 StaticTessellation<Primitive>::compute_local_bbox() const
     return bbox;
 }
 
+template <typename Primitive>
+void StaticTessellation<Primitive>::clear()
+{
+    VectorArray().swap(m_vertices);
+    VectorArray().swap(m_vertex_normals);
+    PrimitiveArray().swap(m_primitives);
+
+    m_tessellation_attributes.clear();
+    m_vertex_attributes.clear();
+    m_vertex_normal_attributes.clear();
+    m_vertex_tangent_attributes.clear();
+    m_vertex_tangent_poses.clear();
+    m_primitive_attributes.clear();
+
+    find_channels();
+}
+
+template <typename Primitive>
+void StaticTessellation<Primitive>::copy_from(const StaticTessellation& rhs)
+{
+    m_vertices = rhs.m_vertices;
+    m_vertex_normals = rhs.m_vertex_normals;
+    m_primitives = rhs.m_primitives;
+
+    m_tessellation_attributes.copy_from(rhs.m_tessellation_attributes);
+    m_vertex_attributes.copy_from(rhs.m_vertex_attributes);
+    m_vertex_normal_attributes.copy_from(rhs.m_vertex_normal_attributes);
+    m_vertex_tangent_attributes.copy_from(rhs.m_vertex_tangent_attributes);
+    m_vertex_tangent_poses.copy_from(rhs.m_vertex_tangent_poses);
+    m_primitive_attributes.copy_from(rhs.m_primitive_attributes);
+
+    find_channels();
+}
+
+template <typename Primitive>
+size_t StaticTessellation<Primitive>::get_memory_size() const
+{
+    return
+          sizeof(*this)
+        + m_vertices.capacity() * sizeof(GVector3)
+        + m_vertex_normals.capacity() * sizeof(GVector3)
+        + m_primitives.capacity() * sizeof(PrimitiveType)
+        + m_tessellation_attributes.get_memory_size()
+        + m_vertex_attributes.get_memory_size()
+        + m_vertex_normal_attributes.get_memory_size()
+        + m_vertex_tangent_attributes.get_memory_size()
+        + m_vertex_tangent_poses.get_memory_size()
+        + m_primitive_attributes.get_memory_size();
+}
+
+template <typename Primitive>
+void StaticTessellation<Primitive>::write(foundation::WriterAdapter& writer) const
+{
+    write_array(writer, m_vertices);
+    write_array(writer, m_vertex_normals);
+    write_array(writer, m_primitives);
+
+    m_tessellation_attributes.write(writer);
+    m_vertex_attributes.write(writer);
+    m_vertex_normal_attributes.write(writer);
+    m_vertex_tangent_attributes.write(writer);
+    m_vertex_tangent_poses.write(writer);
+    m_primitive_attributes.write(writer);
+}
+
+template <typename Primitive>
+void StaticTessellation<Primitive>::read(foundation::ReaderAdapter& reader)
+{
+    read_array(reader, m_vertices);
+    read_array(reader, m_vertex_normals);
+    read_array(reader, m_primitives);
+
+    m_tessellation_attributes.read(reader);
+    m_vertex_attributes.read(reader);
+    m_vertex_normal_attributes.read(reader);
+    m_vertex_tangent_attributes.read(reader);
+    m_vertex_tangent_poses.read(reader);
+    m_primitive_attributes.read(reader);
+
+    find_channels();
+}
+
 template <typename Primitive>
 void StaticTessellation<Primitive>::create_uv_0_attribute()
 {
@@ -498,6 +603,44 @@ void StaticTessellation<Primitive>::create_tangents_attribute()
             3);
 }
 
+template <typename Primitive>
+void StaticTessellation<Primitive>::find_channels()
+{
+    m_uv_0_cid = m_vertex_attributes.find_channel("uv_0");
+    m_tangents_cid = m_vertex_attributes.find_channel("tangents");
+    m_ms_count_cid = m_tessellation_attributes.find_channel("motion_segment_count");
+    m_vp_cid = m_vertex_attributes.find_channel("vertex_poses");
+    m_vnp_cid = m_vertex_normal_attributes.find_channel("vertex_normal_poses");
+    m_vtp_cid = m_vertex_tangent_poses.find_channel("vertex_tangent_poses");
+}
+
+template <typename Primitive>
+template <typename T>
+void StaticTessellation<Primitive>::write_array(
+    foundation::WriterAdapter&  writer,
+    const std::vector<T>&       array)
+{
+    foundation::checked_write(writer, static_cast<foundation::uint64>(array.size()));
+
+    if (!array.empty())
+        foundation::checked_write(writer, &array[0], array.size() * sizeof(T));
+}
+
+template <typename Primitive>
+template <typename T>
+void StaticTessellation<Primitive>::read_array(
+    foundation::ReaderAdapter&  reader,
+    std::vector<T>&             array)
+{
+    foundation::uint64 size;
+    foundation::checked_read(reader, size);
+
+    std::vector<T>(static_cast<size_t>(size)).swap(array);
+
+    if (!array.empty())
+        foundation::checked_read(reader, &array[0], array.size() * sizeof(T));
+}
+
 }       // namespace renderer
 
 #endif  // !APPLESEED_RENDERER_KERNEL_TESSELLATION_STATICTESSELLATION_H
@@ -0,0 +1,90 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2018 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef APPLESEED_RENDERER_KERNEL_TEXTURING_MIPMAPLEVELS_H
+#define APPLESEED_RENDERER_KERNEL_TEXTURING_MIPMAPLEVELS_H
+
+// appleseed.foundation headers.
+#include "foundation/image/canvasproperties.h"
+#include "foundation/image/pixel.h"
+
+// Standard headers.
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace renderer
+{
+
+//
+// Compute the canvas properties of the levels of the MIP pyramid of a texture.
+//
+// Level 0 is the texture itself. Each subsequent level has half the resolution
+// of the previous one (rounded up) until a 1x1 level is reached. All levels use
+// the tile size of the texture so that they can share the texture store; levels
+// other than level 0 are stored in floating-point, in the linear RGB color space.
+//
+
+void compute_mipmap_levels(
+    const foundation::CanvasProperties&             base_props,
+    std::vector<foundation::CanvasProperties>&      levels);
+
+
+//
+// Implementation.
+//
+
+inline void compute_mipmap_levels(
+    const foundation::CanvasProperties&             base_props,
+    std::vector<foundation::CanvasProperties>&      levels)
+{
+    levels.clear();
+    levels.push_back(base_props);
+
+    size_t width = base_props.m_canvas_width;
+    size_t height = base_props.m_canvas_height;
+
+    while (width > 1 || height > 1)
+    {
+        width = std::max<size_t>((width + 1) / 2, 1);
+        height = std::max<size_t>((height + 1) / 2, 1);
+
+        levels.push_back(
+            foundation::CanvasProperties(
+                width,
+                height,
+                base_props.m_tile_width,
+                base_props.m_tile_height,
+                base_props.m_channel_count,
+                foundation::PixelFormatFloat));
+    }
+}
+
+}       // namespace renderer
+
+#endif  // !APPLESEED_RENDERER_KERNEL_TEXTURING_MIPMAPLEVELS_H
@@ -61,12 +61,13 @@ class TextureCache
     // Constructor.
     explicit TextureCache(TextureStore& store);
 
-    // Get a tile from the cache.
+    // Get a tile of a given MIP level from the cache.
     foundation::Tile& get(
         const foundation::UniqueID  assembly_uid,
         const foundation::UniqueID  texture_uid,
         const size_t                tile_x,
-        const size_t                tile_y);
+        const size_t                tile_y,
+        const size_t                level = 0);
 
     // Retrieve performance statistics.
     foundation::StatisticsVector get_statistics() const;
@@ -131,9 +132,10 @@ inline foundation::Tile& TextureCache::get(
     const foundation::UniqueID      assembly_uid,
     const foundation::UniqueID      texture_uid,
     const size_t                    tile_x,
-    const size_t                    tile_y)
+    const size_t                    tile_y,
+    const size_t                    level)
 {
-    const TileKey key(assembly_uid, texture_uid, tile_x, tile_y);
+    const TileKey key(assembly_uid, texture_uid, tile_x, tile_y, level);
     return *m_tile_cache.get(key)->m_tile;
 }
 
@@ -166,7 +168,8 @@ inline size_t TextureCache::TileKeyHasher::operator()(const TileKey& key) const
         foundation::mix_uint32(
             static_cast<foundation::uint32>(key.m_assembly_uid),
             static_cast<foundation::uint32>(key.m_texture_uid),
-            static_cast<foundation::uint32>(key.m_tile_xy));
+            static_cast<foundation::uint32>(key.m_tile_xy),
+            static_cast<foundation::uint32>(key.m_level));
 }
 
 
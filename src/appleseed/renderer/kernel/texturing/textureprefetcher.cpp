@@ -0,0 +1,259 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2018 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// Interface header.
+#include "textureprefetcher.h"
+
+// appleseed.renderer headers.
+#include "renderer/global/globallogger.h"
+#include "renderer/kernel/texturing/texturestore.h"
+#include "renderer/modeling/scene/assembly.h"
+#include "renderer/modeling/scene/basegroup.h"
+#include "renderer/modeling/scene/containers.h"
+#include "renderer/modeling/scene/scene.h"
+#include "renderer/modeling/scene/textureinstance.h"
+#include "renderer/modeling/texture/texture.h"
+
+// appleseed.foundation headers.
+#include "foundation/image/canvasproperties.h"
+#include "foundation/platform/defaulttimers.h"
+#include "foundation/utility/job.h"
+#include "foundation/utility/stopwatch.h"
+#include "foundation/utility/string.h"
+#include "foundation/utility/uid.h"
+
+// Standard headers.
+#include <cassert>
+#include <cstring>
+#include <memory>
+#include <set>
+#include <vector>
+
+using namespace foundation;
+using namespace std;
+
+namespace renderer
+{
+
+namespace
+{
+    //
+    // Reads and decodes all the tiles of a texture into the texture store.
+    //
+
+    class PrefetchJob
+      : public IJob
+    {
+      public:
+        PrefetchJob(
+            TextureStore&       texture_store,
+            const UniqueID      assembly_uid,
+            Texture&            texture,
+            IAbortSwitch*       abort_switch)
+          : m_texture_store(texture_store)
+          , m_assembly_uid(assembly_uid)
+          , m_texture(texture)
+          , m_abort_switch(abort_switch)
+          , m_tile_count(0)
+        {
+        }
+
+        void execute(const size_t thread_index) override
+        {
+            const CanvasProperties& props = m_texture.properties();
+
+            for (size_t tile_y = 0; tile_y < props.m_tile_count_y; ++tile_y)
+            {
+                for (size_t tile_x = 0; tile_x < props.m_tile_count_x; ++tile_x)
+                {
+                    if (is_aborted(m_abort_switch))
+                        return;
+
+                    const TextureStore::TileKey key(
+                        m_assembly_uid,
+                        m_texture.get_uid(),
+                        tile_x,
+                        tile_y);
+
+                    // Stop as soon as the texture store is full.
+                    if (!m_texture_store.prefetch(key))
+                        return;
+
+                    ++m_tile_count;
+                }
+            }
+        }
+
+        size_t get_tile_count() const
+        {
+            return m_tile_count;
+        }
+
+      private:
+        TextureStore&           m_texture_store;
+        const UniqueID          m_assembly_uid;
+        Texture&                m_texture;
+        IAbortSwitch*           m_abort_switch;
+        size_t                  m_tile_count;
+    };
+
+    typedef vector<unique_ptr<PrefetchJob>> PrefetchJobVector;
+
+    // Only on-disk textures benefit from prefetching: in-memory textures have nothing to decode.
+    bool is_prefetchable(const Texture& texture)
+    {
+        return strcmp(texture.get_model(), "disk_texture_2d") == 0;
+    }
+
+    void create_prefetch_jobs(
+        TextureStore&           texture_store,
+        const BaseGroup&        base_group,
+        const UniqueID          assembly_uid,
+        IAbortSwitch*           abort_switch,
+        PrefetchJobVector&      jobs)
+    {
+        // Only prefetch textures that are actually referenced by texture instances.
+        set<UniqueID> texture_uids;
+
+        for (const TextureInstance& texture_instance : base_group.texture_instances())
+        {
+            Texture* texture = base_group.textures().get_by_name(texture_instance.get_texture_name());
+
+            if (texture == nullptr || !is_prefetchable(*texture))
+                continue;
+
+            if (texture_uids.insert(texture->get_uid()).second)
+            {
+                jobs.emplace_back(
+                    new PrefetchJob(
+                        texture_store,
+                        assembly_uid,
+                        *texture,
+                        abort_switch));
+            }
+        }
+
+        for (const Assembly& assembly : base_group.assemblies())
+            create_prefetch_jobs(texture_store, assembly, assembly.get_uid(), abort_switch, jobs);
+    }
+}
+
+
+//
+// TexturePrefetcher class implementation.
+//
+
+struct TexturePrefetcher::Impl
+{
+    const Scene&                        m_scene;
+    TextureStore&                       m_texture_store;
+    JobQueue                            m_job_queue;
+    JobManager                          m_job_manager;
+    PrefetchJobVector                   m_jobs;
+    Stopwatch<DefaultWallclockTimer>    m_stopwatch;
+
+    Impl(
+        const Scene&                    scene,
+        TextureStore&                   texture_store,
+        const size_t                    thread_count)
+      : m_scene(scene)
+      , m_texture_store(texture_store)
+      , m_job_manager(
+            global_logger(),
+            m_job_queue,
+            thread_count,
+            JobManager::KeepRunningOnJobFailure)
+    {
+    }
+};
+
+TexturePrefetcher::TexturePrefetcher(
+    const Scene&                        scene,
+    TextureStore&                       texture_store,
+    const size_t                        thread_count)
+  : impl(new Impl(scene, texture_store, thread_count))
+{
+}
+
+TexturePrefetcher::~TexturePrefetcher()
+{
+    impl->m_job_queue.clear_scheduled_jobs();
+    impl->m_job_manager.stop();
+    delete impl;
+}
+
+void TexturePrefetcher::start(IAbortSwitch* abort_switch)
+{
+    assert(impl->m_jobs.empty());
+
+    create_prefetch_jobs(
+        impl->m_texture_store,
+        impl->m_scene,
+        ~UniqueID(0),       // the parent is the scene, not an assembly
+        abort_switch,
+        impl->m_jobs);
+
+    if (impl->m_jobs.empty())
+        return;
+
+    RENDERER_LOG_INFO(
+        "prefetching %s texture%s...",
+        pretty_uint(impl->m_jobs.size()).c_str(),
+        impl->m_jobs.size() > 1 ? "s" : "");
+
+    impl->m_stopwatch.start();
+
+    // Jobs remain owned by the prefetcher so that statistics can be collected afterward.
+    for (const auto& job : impl->m_jobs)
+        impl->m_job_queue.schedule(job.get(), false);
+
+    impl->m_job_manager.start();
+}
+
+void TexturePrefetcher::wait_until_completion()
+{
+    if (impl->m_jobs.empty())
+        return;
+
+    impl->m_job_queue.wait_until_completion();
+    impl->m_stopwatch.measure();
+
+    size_t tile_count = 0;
+    for (const auto& job : impl->m_jobs)
+        tile_count += job->get_tile_count();
+
+    RENDERER_LOG_INFO(
+        "prefetched %s texture tile%s in %s.",
+        pretty_uint(tile_count).c_str(),
+        tile_count > 1 ? "s" : "",
+        pretty_time(impl->m_stopwatch.get_seconds()).c_str());
+
+    impl->m_jobs.clear();
+}
+
+}   // namespace renderer
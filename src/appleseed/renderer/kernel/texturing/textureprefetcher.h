@@ -0,0 +1,81 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2018 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef APPLESEED_RENDERER_KERNEL_TEXTURING_TEXTUREPREFETCHER_H
+#define APPLESEED_RENDERER_KERNEL_TEXTURING_TEXTUREPREFETCHER_H
+
+// appleseed.foundation headers.
+#include "foundation/core/concepts/noncopyable.h"
+
+// Standard headers.
+#include <cstddef>
+
+// Forward declarations.
+namespace foundation    { class IAbortSwitch; }
+namespace renderer      { class Scene; }
+namespace renderer      { class TextureStore; }
+
+namespace renderer
+{
+
+//
+// Background prefetching of texture tiles.
+//
+// The tiles of all on-disk textures referenced by texture instances of the scene
+// are read and decoded into the texture store by worker threads, one job per texture,
+// so that the first rendering passes don't stall on texture I/O. Prefetching stops
+// as soon as the texture store is full.
+//
+
+class TexturePrefetcher
+  : public foundation::NonCopyable
+{
+  public:
+    // Constructor.
+    TexturePrefetcher(
+        const Scene&                scene,
+        TextureStore&               texture_store,
+        const size_t                thread_count);
+
+    // Destructor. Returns once running prefetching jobs are completed.
+    ~TexturePrefetcher();
+
+    // Start prefetching textures. Returns immediately.
+    void start(foundation::IAbortSwitch* abort_switch = nullptr);
+
+    // Wait until all textures have been prefetched.
+    void wait_until_completion();
+
+  private:
+    struct Impl;
+    Impl* impl;
+};
+
+}       // namespace renderer
+
+#endif  // !APPLESEED_RENDERER_KERNEL_TEXTURING_TEXTUREPREFETCHER_H
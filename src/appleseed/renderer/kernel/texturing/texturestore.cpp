@@ -32,12 +32,14 @@
 
 // appleseed.renderer headers.
 #include "renderer/global/globallogger.h"
+#include "renderer/kernel/texturing/mipmaplevels.h"
 #include "renderer/modeling/scene/assembly.h"
 #include "renderer/modeling/scene/scene.h"
 #include "renderer/modeling/texture/texture.h"
 #include "renderer/utility/paramarray.h"
 
 // appleseed.foundation headers.
+#include "foundation/image/canvasproperties.h"
 #include "foundation/image/color.h"
 #include "foundation/image/colorspace.h"
 #include "foundation/image/tile.h"
@@ -45,12 +47,14 @@
 #include "foundation/utility/containers/dictionary.h"
 #include "foundation/utility/foreach.h"
 #include "foundation/utility/memory.h"
+#include "foundation/utility/profiler.h"
 #include "foundation/utility/statistics.h"
 #include "foundation/utility/string.h"
 
 // Standard headers.
 #include <algorithm>
 #include <string>
+#include <vector>
 
 using namespace foundation;
 using namespace std;
@@ -70,6 +74,183 @@ TextureStore::TextureStore(
 {
 }
 
+bool TextureStore::prefetch(const TileKey& key)
+{
+    assert(key.get_level() == 0);
+
+    {
+        boost::mutex::scoped_lock lock(m_mutex);
+
+        // Nothing to do if the tile is already in the store.
+        if (m_tile_cache.find(key) != nullptr)
+            return true;
+
+        // The swapper ignores the element count.
+        if (m_tile_swapper.is_full(0))
+            return false;
+    }
+
+    // Read and decode the tile without holding the lock.
+    Tile* tile = m_tile_swapper.read_tile(key);
+
+    Tile* unused_tile;
+
+    {
+        boost::mutex::scoped_lock lock(m_mutex);
+
+        // On a cache miss, the swapper picks up the prefetched tile instead of loading it again.
+        // On a cache hit, the tile was loaded in the meantime and the prefetched one is not needed.
+        m_tile_swapper.set_prefetched_tile(key, tile);
+        m_tile_cache.get(key);
+        unused_tile = m_tile_swapper.take_prefetched_tile();
+    }
+
+    if (unused_tile != nullptr)
+        m_tile_swapper.get_texture(key).unload_tile(key.get_tile_x(), key.get_tile_y(), unused_tile);
+
+    return true;
+}
+
+TextureStore::TileRecord& TextureStore::acquire_level_tile(const TileKey& key)
+{
+    assert(key.get_level() > 0);
+
+    {
+        boost::mutex::scoped_lock lock(m_mutex);
+
+        if (TileRecord* record = m_tile_cache.find(key))
+        {
+            atomic_inc(&record->m_owners);
+            return *record;
+        }
+    }
+
+    // Build the tile without holding the lock.
+    Tile* tile = build_level_tile(key);
+
+    TileRecord* record;
+    Tile* unused_tile;
+
+    {
+        boost::mutex::scoped_lock lock(m_mutex);
+
+        // If another thread built the same tile in the meantime, ours is not needed.
+        m_tile_swapper.set_prefetched_tile(key, tile);
+        record = &m_tile_cache.get(key);
+        atomic_inc(&record->m_owners);
+        unused_tile = m_tile_swapper.take_prefetched_tile();
+    }
+
+    // Tiles of MIP levels are owned by the store.
+    delete unused_tile;
+
+    return *record;
+}
+
+Tile* TextureStore::build_level_tile(const TileKey& key)
+{
+    ProfileZone profile_zone("build texture mip level tile");
+
+    const size_t level = key.get_level();
+    assert(level > 0);
+
+    // Compute the properties of this level and of the previous one.
+    vector<CanvasProperties> levels;
+    compute_mipmap_levels(m_tile_swapper.get_texture(key).properties(), levels);
+    assert(level < levels.size());
+    const CanvasProperties& level_props = levels[level];
+    const CanvasProperties& parent_props = levels[level - 1];
+
+    const size_t tile_x = key.get_tile_x();
+    const size_t tile_y = key.get_tile_y();
+    const size_t level_tile_width = level_props.get_tile_width(tile_x);
+    const size_t level_tile_height = level_props.get_tile_height(tile_y);
+    const size_t channel_count = level_props.m_channel_count;
+
+    // Footprint of the tile in this level.
+    const size_t level_x0 = tile_x * level_props.m_tile_width;
+    const size_t level_y0 = tile_y * level_props.m_tile_height;
+
+    // Footprint of the tile in the previous level. Each texel of this level is the average
+    // of the (up to) 2x2 texels of the previous level it covers.
+    const size_t x0 = 2 * level_x0;
+    const size_t y0 = 2 * level_y0;
+    const size_t x1 = min(2 * (level_x0 + level_tile_width), parent_props.m_canvas_width);
+    const size_t y1 = min(2 * (level_y0 + level_tile_height), parent_props.m_canvas_height);
+
+    vector<float> sums(level_tile_width * level_tile_height * channel_count, 0.0f);
+    vector<size_t> counts(level_tile_width * level_tile_height, 0);
+
+    // Accumulate the texels of the tiles of the previous level overlapped by the footprint.
+    // These tiles go through the store, so they are shared with other lookups and only
+    // built (or loaded) once.
+    const size_t tile_x_begin = x0 / parent_props.m_tile_width;
+    const size_t tile_y_begin = y0 / parent_props.m_tile_height;
+    const size_t tile_x_end = (x1 - 1) / parent_props.m_tile_width + 1;
+    const size_t tile_y_end = (y1 - 1) / parent_props.m_tile_height + 1;
+
+    for (size_t ty = tile_y_begin; ty < tile_y_end; ++ty)
+    {
+        for (size_t tx = tile_x_begin; tx < tile_x_end; ++tx)
+        {
+            TileRecord& record =
+                acquire(
+                    TileKey(
+                        key.m_assembly_uid,
+                        key.m_texture_uid,
+                        tx,
+                        ty,
+                        level - 1));
+            const Tile& tile = *record.m_tile;
+            assert(tile.get_channel_count() == channel_count);
+
+            const size_t org_x = tx * parent_props.m_tile_width;
+            const size_t org_y = ty * parent_props.m_tile_height;
+            const size_t begin_x = max(org_x, x0);
+            const size_t begin_y = max(org_y, y0);
+            const size_t end_x = min(org_x + tile.get_width(), x1);
+            const size_t end_y = min(org_y + tile.get_height(), y1);
+
+            for (size_t y = begin_y; y < end_y; ++y)
+            {
+                const size_t row = (y / 2 - level_y0) * level_tile_width;
+
+                for (size_t x = begin_x; x < end_x; ++x)
+                {
+                    const size_t i = row + x / 2 - level_x0;
+                    float* sum = &sums[i * channel_count];
+
+                    for (size_t c = 0; c < channel_count; ++c)
+                        sum[c] += tile.get_component<float>(x - org_x, y - org_y, c);
+
+                    ++counts[i];
+                }
+            }
+
+            release(record);
+        }
+    }
+
+    Tile* level_tile =
+        new Tile(
+            level_tile_width,
+            level_tile_height,
+            channel_count,
+            level_props.m_pixel_format);
+
+    for (size_t i = 0, e = counts.size(); i < e; ++i)
+    {
+        assert(counts[i] > 0);
+        const float rcp_count = 1.0f / static_cast<float>(counts[i]);
+        const float* sum = &sums[i * channel_count];
+
+        for (size_t c = 0; c < channel_count; ++c)
+            level_tile->set_component(i, c, sum[c] * rcp_count);
+    }
+
+    return level_tile;
+}
+
 StatisticsVector TextureStore::get_statistics() const
 {
     Statistics stats = make_single_stage_cache_stats(m_tile_cache);
@@ -94,6 +275,22 @@ Dictionary TextureStore::get_params_metadata()
             .insert("label", "Texture Cache Size")
             .insert("help", "Texture cache size in bytes"));
 
+    metadata.dictionaries().insert(
+        "persistent",
+        Dictionary()
+            .insert("type", "bool")
+            .insert("default", "false")
+            .insert("label", "Persistent Texture Cache")
+            .insert("help", "Keep cached texture tiles across renders with the same renderer"));
+
+    metadata.dictionaries().insert(
+        "prefetch",
+        Dictionary()
+            .insert("type", "bool")
+            .insert("default", "false")
+            .insert("label", "Prefetch Textures")
+            .insert("help", "Read and decode texture files in parallel before rendering starts"));
+
     return metadata;
 }
 
@@ -170,12 +367,16 @@ TextureStore::TileSwapper::TileSwapper(
   , m_params(params)
   , m_memory_size(0)
   , m_peak_memory_size(0)
+  , m_prefetched_key(TileKey::invalid())
+  , m_prefetched_tile(nullptr)
 {
     gather_assemblies(scene.assemblies());
 }
 
 void TextureStore::TileSwapper::load(const TileKey& key, TileRecord& record)
 {
+    ProfileZone profile_zone("load texture tile");
+
     // Fetch the texture container.
     const TextureContainer& textures =
         key.m_assembly_uid == ~UniqueID(0)
@@ -189,31 +390,28 @@ void TextureStore::TileSwapper::load(const TileKey& key, TileRecord& record)
     {
         RENDERER_LOG_DEBUG(
             "loading tile (" FMT_SIZE_T ", " FMT_SIZE_T ") "
-            "from texture \"%s\"...",
+            "of level " FMT_SIZE_T " from texture \"%s\"...",
             key.get_tile_x(),
             key.get_tile_y(),
+            key.get_level(),
             texture->get_path().c_str());
     }
 
-    // Load the tile.
-    record.m_tile = texture->load_tile(key.get_tile_x(), key.get_tile_y());
     record.m_owners = 0;
 
-    // Convert the tile to the linear RGB color space.
-    switch (texture->get_color_space())
+    if (m_prefetched_tile != nullptr && m_prefetched_key == key)
     {
-      case ColorSpaceLinearRGB:
-        break;
-
-      case ColorSpaceSRGB:
-        convert_tile_srgb_to_linear_rgb(*record.m_tile);
-        break;
-
-      case ColorSpaceCIEXYZ:
-        convert_tile_ciexyz_to_linear_rgb(*record.m_tile);
-        break;
+        // Use the tile prepared ahead of time, it is already in the linear RGB color space.
+        record.m_tile = m_prefetched_tile;
+        m_prefetched_tile = nullptr;
+    }
+    else
+    {
+        // Tiles of MIP levels are always built by the store before they reach the cache.
+        assert(key.get_level() == 0);
 
-      assert_otherwise;
+        // Load the tile and convert it to the linear RGB color space.
+        record.m_tile = read_tile(key);
     }
 
     // Track the amount of memory used by the tile cache.
@@ -265,19 +463,80 @@ bool TextureStore::TileSwapper::unload(const TileKey& key, TileRecord& record)
     {
         RENDERER_LOG_DEBUG(
             "unloading tile (" FMT_SIZE_T ", " FMT_SIZE_T ") "
-            "from texture \"%s\"...",
+            "of level " FMT_SIZE_T " from texture \"%s\"...",
             key.get_tile_x(),
             key.get_tile_y(),
+            key.get_level(),
             texture->get_path().c_str());
     }
 
-    // Unload the tile.
-    texture->unload_tile(key.get_tile_x(), key.get_tile_y(), record.m_tile);
+    // Unload the tile. Tiles of MIP levels are owned by the store.
+    if (key.get_level() == 0)
+        texture->unload_tile(key.get_tile_x(), key.get_tile_y(), record.m_tile);
+    else delete record.m_tile;
 
     // Successfully unloaded the tile.
     return true;
 }
 
+Texture& TextureStore::TileSwapper::get_texture(const TileKey& key) const
+{
+    // Fetch the texture container.
+    const TextureContainer& textures =
+        key.m_assembly_uid == ~UniqueID(0)
+            ? m_scene.textures()
+            : m_assemblies.find(key.m_assembly_uid)->second->textures();
+
+    // Fetch the texture.
+    Texture* texture = textures.get_by_uid(key.m_texture_uid);
+    assert(texture);
+
+    return *texture;
+}
+
+Tile* TextureStore::TileSwapper::read_tile(const TileKey& key) const
+{
+    assert(key.get_level() == 0);
+
+    Texture& texture = get_texture(key);
+
+    // Load the tile.
+    Tile* tile = texture.load_tile(key.get_tile_x(), key.get_tile_y());
+
+    // Convert the tile to the linear RGB color space.
+    switch (texture.get_color_space())
+    {
+      case ColorSpaceLinearRGB:
+        break;
+
+      case ColorSpaceSRGB:
+        convert_tile_srgb_to_linear_rgb(*tile);
+        break;
+
+      case ColorSpaceCIEXYZ:
+        convert_tile_ciexyz_to_linear_rgb(*tile);
+        break;
+
+      assert_otherwise;
+    }
+
+    return tile;
+}
+
+void TextureStore::TileSwapper::set_prefetched_tile(const TileKey& key, Tile* tile)
+{
+    assert(m_prefetched_tile == nullptr);
+    m_prefetched_key = key;
+    m_prefetched_tile = tile;
+}
+
+Tile* TextureStore::TileSwapper::take_prefetched_tile()
+{
+    Tile* tile = m_prefetched_tile;
+    m_prefetched_tile = nullptr;
+    return tile;
+}
+
 void TextureStore::TileSwapper::gather_assemblies(const AssemblyContainer& assemblies)
 {
     for (const_each<AssemblyContainer> i = assemblies; i; ++i)
@@ -53,6 +53,7 @@ namespace foundation    { class StatisticsVector; }
 namespace foundation    { class Tile; }
 namespace renderer      { class ParamArray; }
 namespace renderer      { class Scene; }
+namespace renderer      { class Texture; }
 
 namespace renderer
 {
@@ -66,11 +67,14 @@ class TextureStore
 {
   public:
     // This structure uniquely identifies a texture tile in a scene.
+    // Level 0 designates the texture itself, higher levels designate
+    // the successive levels of its MIP pyramid.
     struct TileKey
     {
         foundation::UniqueID    m_assembly_uid;
         foundation::UniqueID    m_texture_uid;
         foundation::uint32      m_tile_xy;
+        foundation::uint32      m_level;
 
         TileKey();
 
@@ -78,17 +82,14 @@ class TextureStore
             const foundation::UniqueID  assembly_uid,
             const foundation::UniqueID  texture_uid,
             const size_t                tile_x,
-            const size_t                tile_y);
-
-        TileKey(
-            const foundation::UniqueID  assembly_uid,
-            const foundation::UniqueID  texture_uid,
-            const foundation::uint32    tile_xy);
+            const size_t                tile_y,
+            const size_t                level = 0);
 
         TileKey(const TileKey& rhs);
 
         size_t get_tile_x() const;
         size_t get_tile_y() const;
+        size_t get_level() const;
 
         // Return an invalid key.
         static TileKey invalid();
@@ -110,12 +111,19 @@ class TextureStore
         const Scene&        scene,
         const ParamArray&   params = ParamArray());
 
-    // Acquire an element from the store. Thread-safe.
+    // Acquire an element from the store. Tiles of MIP levels are built from the tiles
+    // of the previous level without holding the store lock. Thread-safe.
     TileRecord& acquire(const TileKey& key);
 
     // Release a previously-acquired element. Thread-safe.
     void release(TileRecord& record) const;
 
+    // Load a tile of the texture itself (level 0) into the store ahead of time, unless it
+    // is already there. The tile is read and decoded without holding the store lock, so
+    // that several tiles can be prefetched in parallel. Return false if the store is full,
+    // in which case nothing is loaded. Thread-safe.
+    bool prefetch(const TileKey& key);
+
     // Retrieve performance statistics.
     foundation::StatisticsVector get_statistics() const;
 
@@ -146,6 +154,18 @@ class TextureStore
         // Unload a cache line.
         bool unload(const TileKey& key, TileRecord& record);
 
+        // Return the texture a given tile belongs to. Thread-safe.
+        Texture& get_texture(const TileKey& key) const;
+
+        // Load a tile of level 0 and convert it to the linear RGB color space. Thread-safe.
+        foundation::Tile* read_tile(const TileKey& key) const;
+
+        // Hand over a tile loaded or built ahead of time to the next call to load() for this key.
+        void set_prefetched_tile(const TileKey& key, foundation::Tile* tile);
+
+        // Take back the prefetched tile if it was not consumed by load(), or return nullptr.
+        foundation::Tile* take_prefetched_tile();
+
         // Return true if the cache is full, false otherwise.
         bool is_full(const size_t element_count) const;
 
@@ -170,6 +190,8 @@ class TextureStore
         size_t              m_memory_size;
         size_t              m_peak_memory_size;
         AssemblyMap         m_assemblies;
+        TileKey             m_prefetched_key;
+        foundation::Tile*   m_prefetched_tile;
 
         void gather_assemblies(const AssemblyContainer& assemblies);
     };
@@ -185,6 +207,12 @@ class TextureStore
     TileKeyHasher           m_tile_key_hasher;
     TileSwapper             m_tile_swapper;
     TileCache               m_tile_cache;
+
+    // Acquire a tile of a level of the MIP pyramid of a texture, building it if needed.
+    TileRecord& acquire_level_tile(const TileKey& key);
+
+    // Build a tile of a level of the MIP pyramid of a texture by reducing the tiles of the previous level.
+    foundation::Tile* build_level_tile(const TileKey& key);
 };
 
 
@@ -194,6 +222,9 @@ class TextureStore
 
 inline TextureStore::TileRecord& TextureStore::acquire(const TileKey& key)
 {
+    if (key.get_level() > 0)
+        return acquire_level_tile(key);
+
     boost::mutex::scoped_lock lock(m_mutex);
 
     TileRecord& record = m_tile_cache.get(key);
@@ -221,29 +252,22 @@ inline TextureStore::TileKey::TileKey(
     const foundation::UniqueID  assembly_uid,
     const foundation::UniqueID  texture_uid,
     const size_t                tile_x,
-    const size_t                tile_y)
+    const size_t                tile_y,
+    const size_t                level)
   : m_assembly_uid(assembly_uid)
   , m_texture_uid(texture_uid)
   , m_tile_xy(static_cast<foundation::uint32>((tile_y << 16) | tile_x))
+  , m_level(static_cast<foundation::uint32>(level))
 {
     assert(tile_x < (1UL << 16));
     assert(tile_y < (1UL << 16));
 }
 
-inline TextureStore::TileKey::TileKey(
-    const foundation::UniqueID  assembly_uid,
-    const foundation::UniqueID  texture_uid,
-    const foundation::uint32    tile_xy)
-  : m_assembly_uid(assembly_uid)
-  , m_texture_uid(texture_uid)
-  , m_tile_xy(tile_xy)
-{
-}
-
 inline TextureStore::TileKey::TileKey(const TileKey& rhs)
   : m_assembly_uid(rhs.m_assembly_uid)
   , m_texture_uid(rhs.m_texture_uid)
   , m_tile_xy(rhs.m_tile_xy)
+  , m_level(rhs.m_level)
 {
 }
 
@@ -257,19 +281,26 @@ inline size_t TextureStore::TileKey::get_tile_y() const
     return static_cast<size_t>(m_tile_xy >> 16);
 }
 
+inline size_t TextureStore::TileKey::get_level() const
+{
+    return static_cast<size_t>(m_level);
+}
+
 inline TextureStore::TileKey TextureStore::TileKey::invalid()
 {
-    return
-        TileKey(
-            ~foundation::UniqueID(0),   // assembly unique ID
-            ~foundation::UniqueID(0),   // texture unique ID
-            ~foundation::uint32(0));    // tile X and Y coordinates
+    TileKey key;
+    key.m_assembly_uid = ~foundation::UniqueID(0);
+    key.m_texture_uid = ~foundation::UniqueID(0);
+    key.m_tile_xy = ~foundation::uint32(0);
+    key.m_level = ~foundation::uint32(0);
+    return key;
 }
 
 inline bool TextureStore::TileKey::operator==(const TileKey& rhs) const
 {
     return
         m_tile_xy == rhs.m_tile_xy &&
+        m_level == rhs.m_level &&
         m_texture_uid == rhs.m_texture_uid &&
         m_assembly_uid == rhs.m_assembly_uid;
 }
@@ -284,7 +315,9 @@ inline bool TextureStore::TileKey::operator<(const TileKey& rhs) const
     return
         m_assembly_uid == rhs.m_assembly_uid ?
             m_texture_uid == rhs.m_texture_uid ?
-                m_tile_xy < rhs.m_tile_xy :
+                m_level == rhs.m_level ?
+                    m_tile_xy < rhs.m_tile_xy :
+                m_level < rhs.m_level :
             m_texture_uid < rhs.m_texture_uid :
         m_assembly_uid < rhs.m_assembly_uid;
 }
@@ -296,7 +329,11 @@ inline bool TextureStore::TileKey::operator<(const TileKey& rhs) const
 
 inline size_t TextureStore::TileKeyHasher::operator()(const TileKey& key) const
 {
-    return foundation::mix_uint64(key.m_assembly_uid, key.m_texture_uid, key.m_tile_xy);
+    return
+        foundation::mix_uint64(
+            key.m_assembly_uid,
+            key.m_texture_uid,
+            (static_cast<foundation::uint64>(key.m_level) << 32) | key.m_tile_xy);
 }
 
 
@@ -0,0 +1,129 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2018 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// appleseed.renderer headers.
+#include "renderer/global/globaltypes.h"
+
+// appleseed.foundation headers.
+#include "foundation/utility/benchmark.h"
+
+// Standard headers.
+#include <cstddef>
+#include <vector>
+
+using namespace foundation;
+using namespace renderer;
+
+//
+// Run these benchmarks with and without APPLESEED_RGB_ONLY_SPECTRUM defined
+// to measure the impact of the compact RGB-only spectrum representation.
+//
+
+BENCHMARK_SUITE(Renderer_Utility_DynamicSpectrum31f)
+{
+    struct Fixture
+    {
+        const Spectrum::Mode    m_old_mode;
+        Spectrum                m_spectrum1;
+        Spectrum                m_spectrum2;
+
+        Fixture()
+          : m_old_mode(Spectrum::set_mode(Spectrum::RGB))
+          , m_spectrum1(42.0f)
+          , m_spectrum2(1.1f)
+        {
+        }
+
+        ~Fixture()
+        {
+            Spectrum::set_mode(m_old_mode);
+        }
+    };
+
+    BENCHMARK_CASE_F(Set_RGB, Fixture)
+    {
+        m_spectrum1.set(0.0f);
+    }
+
+    BENCHMARK_CASE_F(InPlaceAddition_RGB, Fixture)
+    {
+        m_spectrum1 += m_spectrum2;
+    }
+
+    BENCHMARK_CASE_F(InPlaceMultiplicationBySpectrum_RGB, Fixture)
+    {
+        m_spectrum1 *= m_spectrum2;
+    }
+
+    BENCHMARK_CASE_F(MultiplyAdd_RGB, Fixture)
+    {
+        madd(m_spectrum1, m_spectrum2, 0.5f);
+    }
+
+    // Mimic the per-vertex state of a batch of light paths, where the memory footprint
+    // of the spectrum type dominates.
+    struct PathVertexFixture
+    {
+        struct PathVertex
+        {
+            Spectrum    m_throughput;
+            Spectrum    m_radiance;
+            Spectrum    m_beauty;
+        };
+
+        const Spectrum::Mode    m_old_mode;
+        std::vector<PathVertex> m_vertices;
+        Spectrum                m_bsdf_value;
+
+        PathVertexFixture()
+          : m_old_mode(Spectrum::set_mode(Spectrum::RGB))
+          , m_bsdf_value(0.8f)
+        {
+            PathVertex vertex;
+            vertex.m_throughput.set(1.0f);
+            vertex.m_radiance.set(0.1f);
+            vertex.m_beauty.set(0.0f);
+            m_vertices.assign(64 * 1024, vertex);
+        }
+
+        ~PathVertexFixture()
+        {
+            Spectrum::set_mode(m_old_mode);
+        }
+    };
+
+    BENCHMARK_CASE_F(UpdatePathVertices_RGB, PathVertexFixture)
+    {
+        for (size_t i = 0, e = m_vertices.size(); i < e; ++i)
+        {
+            PathVertex& vertex = m_vertices[i];
+            vertex.m_throughput *= m_bsdf_value;
+            madd(vertex.m_beauty, vertex.m_throughput, vertex.m_radiance);
+        }
+    }
+}
@@ -0,0 +1,81 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2018 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// appleseed.renderer headers.
+#include "renderer/modeling/bssrdf/sss.h"
+
+// appleseed.foundation headers.
+#include "foundation/math/rng/distribution.h"
+#include "foundation/math/rng/xorshift32.h"
+#include "foundation/utility/benchmark.h"
+
+// Standard headers.
+#include <cstddef>
+
+using namespace foundation;
+using namespace renderer;
+
+BENCHMARK_SUITE(Renderer_Modeling_BSSRDF_SSS)
+{
+    const float Eta = 1.0f / 1.3f;
+
+    struct Fixture
+    {
+        Xorshift32          m_rng;
+        AlphaPrimeTable     m_alpha_prime_table;
+        float               m_x;
+
+        Fixture()
+          : m_x(0.0f)
+        {
+            m_alpha_prime_table.initialize<ComputeRdBetterDipole>(Eta);
+        }
+    };
+
+    BENCHMARK_CASE_F(NormalizedDiffusionSample, Fixture)
+    {
+        const float s = normalized_diffusion_s_mfp(0.5f);
+
+        for (size_t i = 0; i < 100; ++i)
+            m_x += normalized_diffusion_sample(rand_float2(m_rng), 1.0f, s);
+    }
+
+    BENCHMARK_CASE_F(ComputeAlphaPrime_BetterDipole_NumericalInversion, Fixture)
+    {
+        const ComputeRdBetterDipole rd_fun(Eta);
+
+        for (size_t i = 0; i < 100; ++i)
+            m_x += compute_alpha_prime(rd_fun, rand_float1(m_rng, 0.001f, 0.999f));
+    }
+
+    BENCHMARK_CASE_F(ComputeAlphaPrime_BetterDipole_Table, Fixture)
+    {
+        for (size_t i = 0; i < 100; ++i)
+            m_x += compute_alpha_prime(m_alpha_prime_table, rand_float1(m_rng, 0.001f, 0.999f));
+    }
+}
@@ -38,6 +38,9 @@
 #include "foundation/math/vector.h"
 #include "foundation/utility/benchmark.h"
 
+// Standard headers.
+#include <cstddef>
+
 using namespace foundation;
 using namespace renderer;
 
@@ -71,4 +74,95 @@ BENCHMARK_SUITE(Renderer_Utility_TransformSequence)
     {
         m_motion_bbox = m_sequence.to_parent(m_bbox);
     }
+
+    template <size_t MaxSamplesPerSegment>
+    struct EvaluateFixtureBase
+    {
+        static const size_t TimeCount = 256;
+
+        TransformSequence   m_sequence;
+        Transformd          m_scratch;
+        double              m_dummy;
+
+        EvaluateFixtureBase(const double angle, const Vector3d& translation)
+          : m_dummy(0.0)
+        {
+            const Vector3d axis = normalize(Vector3d(0.1, 0.2, 1.0));
+            m_sequence.set_transform(
+                0.0f,
+                Transformd::from_local_to_parent(
+                    Matrix4d::make_rotation(axis, 0.3)));
+            m_sequence.set_transform(
+                1.0f,
+                Transformd::from_local_to_parent(
+                    Matrix4d::make_translation(translation) *
+                    Matrix4d::make_rotation(axis, 0.3 + angle)));
+            m_sequence.set_max_samples_per_segment(MaxSamplesPerSegment);
+            m_sequence.prepare();
+        }
+
+        void evaluate()
+        {
+            for (size_t i = 0; i < TimeCount; ++i)
+            {
+                const float time = (i + 0.5f) / TimeCount;
+                m_dummy += m_sequence.evaluate(time, m_scratch).get_local_to_parent()[3];
+            }
+        }
+    };
+
+    template <size_t MaxSamplesPerSegment>
+    struct TranslationFixture
+      : public EvaluateFixtureBase<MaxSamplesPerSegment>
+    {
+        TranslationFixture()
+          : EvaluateFixtureBase<MaxSamplesPerSegment>(0.0, Vector3d(1.0, 0.0, 0.0))
+        {
+        }
+    };
+
+    template <size_t MaxSamplesPerSegment>
+    struct SmallRotationFixture
+      : public EvaluateFixtureBase<MaxSamplesPerSegment>
+    {
+        SmallRotationFixture()
+          : EvaluateFixtureBase<MaxSamplesPerSegment>(Pi<double>() / 360.0, Vector3d(0.1, 0.0, 0.0))
+        {
+        }
+    };
+
+    template <size_t MaxSamplesPerSegment>
+    struct LargeRotationFixture
+      : public EvaluateFixtureBase<MaxSamplesPerSegment>
+    {
+        LargeRotationFixture()
+          : EvaluateFixtureBase<MaxSamplesPerSegment>(Pi<double>() / 2.0, Vector3d(0.0))
+        {
+        }
+    };
+
+    BENCHMARK_CASE_F(Evaluate_Translation, TranslationFixture<32>)
+    {
+        evaluate();
+    }
+
+    BENCHMARK_CASE_F(Evaluate_Translation_NoSampling, TranslationFixture<0>)
+    {
+        evaluate();
+    }
+
+    BENCHMARK_CASE_F(Evaluate_SmallRotation, SmallRotationFixture<32>)
+    {
+        evaluate();
+    }
+
+    BENCHMARK_CASE_F(Evaluate_SmallRotation_NoSampling, SmallRotationFixture<0>)
+    {
+        evaluate();
+    }
+
+    BENCHMARK_CASE_F(Evaluate_LargeRotation, LargeRotationFixture<32>)
+    {
+        evaluate();
+    }
 }
@@ -0,0 +1,101 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2018 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// appleseed.renderer headers.
+#include "renderer/global/globaltypes.h"
+#include "renderer/kernel/aov/aovaccumulator.h"
+#include "renderer/kernel/aov/aovcomponents.h"
+#include "renderer/kernel/rendering/pixelcontext.h"
+#include "renderer/kernel/shading/shadingcomponents.h"
+#include "renderer/kernel/shading/shadingpoint.h"
+#include "renderer/kernel/shading/shadingresult.h"
+#include "renderer/modeling/aov/aovcontainer.h"
+#include "renderer/modeling/aov/diffuseaov.h"
+#include "renderer/modeling/aov/glossyaov.h"
+#include "renderer/modeling/color/colorspace.h"
+#include "renderer/modeling/frame/frame.h"
+#include "renderer/utility/paramarray.h"
+
+// appleseed.foundation headers.
+#include "foundation/image/color.h"
+#include "foundation/math/vector.h"
+#include "foundation/utility/autoreleaseptr.h"
+#include "foundation/utility/iostreamop.h"
+#include "foundation/utility/test.h"
+
+using namespace foundation;
+using namespace renderer;
+
+TEST_SUITE(Renderer_Kernel_AOV_AOVAccumulatorContainer)
+{
+    TEST_CASE(Write_GivenComponentAOVs_WritesSumsOfShadingComponents)
+    {
+        AOVContainer aovs;
+        aovs.insert(DiffuseAOVFactory().create(ParamArray()));
+        aovs.insert(DirectGlossyAOVFactory().create(ParamArray()));
+
+        auto_release_ptr<Frame> frame(
+            FrameFactory::create(
+                "beauty",
+                ParamArray().insert("resolution", "16 16"),
+                aovs));
+
+        AOVAccumulatorContainer accumulators(*frame);
+
+        ShadingComponents shading_components;
+        shading_components.m_beauty.set(1.0f);
+        shading_components.m_diffuse.set(0.25f);
+        shading_components.m_indirect_diffuse.set(0.5f);
+        shading_components.m_glossy.set(0.125f);
+        shading_components.m_indirect_glossy.set(2.0f);
+
+        const PixelContext pixel_context(Vector2i(0, 0), Vector2d(0.5));
+        const ShadingPoint shading_point;
+        const AOVComponents aov_components;
+
+        ShadingResult shading_result(2);
+        shading_result.m_main.a = 0.75f;
+
+        accumulators.write(
+            pixel_context,
+            shading_point,
+            shading_components,
+            aov_components,
+            shading_result);
+
+        const Color3f expected_diffuse =
+            shading_components.m_diffuse.to_rgb(g_std_lighting_conditions) +
+            shading_components.m_indirect_diffuse.to_rgb(g_std_lighting_conditions);
+        const Color3f expected_glossy =
+            shading_components.m_glossy.to_rgb(g_std_lighting_conditions);
+
+        EXPECT_EQ(shading_components.m_beauty.to_rgb(g_std_lighting_conditions), shading_result.m_main.rgb());
+        EXPECT_EQ(Color4f(expected_diffuse, 0.75f), shading_result.m_aovs[0]);
+        EXPECT_EQ(Color4f(expected_glossy, 0.75f), shading_result.m_aovs[1]);
+    }
+}
@@ -0,0 +1,155 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2018 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// appleseed.renderer headers.
+#include "renderer/kernel/rendering/costtracker.h"
+
+// appleseed.foundation headers.
+#include "foundation/platform/types.h"
+#include "foundation/utility/test.h"
+
+// Standard headers.
+#include <cstddef>
+
+using namespace foundation;
+using namespace renderer;
+
+TEST_SUITE(Renderer_Kernel_Rendering_CostTracker)
+{
+    void spin()
+    {
+        const uint64 begin = CostTracker::read_cycles();
+        while (CostTracker::read_cycles() - begin < 1000) {}
+    }
+
+    TEST_CASE(CostScope_TrackingDisabled_ChargesNothing)
+    {
+        CostTracker::stop_tracking();
+
+        {
+            CostScope cost_scope(CostTracker::Shading);
+            spin();
+        }
+
+        uint64 cycles[CostTracker::CategoryCount];
+        CostTracker::fetch_cycles(cycles);
+
+        for (size_t i = 0; i < CostTracker::CategoryCount; ++i)
+            EXPECT_EQ(0, cycles[i]);
+    }
+
+    TEST_CASE(StopTracking_DiscardsUnfetchedCycles)
+    {
+        CostTracker::start_tracking();
+
+        {
+            CostScope cost_scope(CostTracker::Shading);
+            spin();
+        }
+
+        CostTracker::stop_tracking();
+
+        uint64 cycles[CostTracker::CategoryCount];
+        CostTracker::fetch_cycles(cycles);
+
+        for (size_t i = 0; i < CostTracker::CategoryCount; ++i)
+            EXPECT_EQ(0, cycles[i]);
+
+        EXPECT_FALSE(CostTracker::is_any_thread_tracking());
+    }
+
+    TEST_CASE(CostScope_NestedScopes_ChargesEachCategoryExclusively)
+    {
+        CostTracker::start_tracking();
+
+        {
+            CostScope outer_scope(CostTracker::Shading);
+            spin();
+
+            {
+                CostScope inner_scope(CostTracker::TextureFetch);
+                spin();
+            }
+        }
+
+        uint64 cycles[CostTracker::CategoryCount];
+        CostTracker::fetch_cycles(cycles);
+        CostTracker::stop_tracking();
+
+        EXPECT_GT(0, cycles[CostTracker::Shading]);
+        EXPECT_GT(0, cycles[CostTracker::TextureFetch]);
+        EXPECT_EQ(0, cycles[CostTracker::Traversal]);
+    }
+
+    TEST_CASE(FetchCycles_ResetsCounters)
+    {
+        CostTracker::start_tracking();
+
+        {
+            CostScope cost_scope(CostTracker::Volume);
+            spin();
+        }
+
+        uint64 cycles[CostTracker::CategoryCount];
+        CostTracker::fetch_cycles(cycles);
+        CostTracker::fetch_cycles(cycles);
+        CostTracker::stop_tracking();
+
+        EXPECT_EQ(0, cycles[CostTracker::Volume]);
+    }
+
+    TEST_CASE(CostScope_GivenShaderGroup_RecordsInclusiveCycles)
+    {
+        const ShaderGroup* shader_group = reinterpret_cast<const ShaderGroup*>(0x10);
+
+        CostTracker::start_tracking();
+
+        {
+            CostScope outer_scope(CostTracker::Shading, shader_group);
+
+            {
+                CostScope inner_scope(CostTracker::TextureFetch);
+                spin();
+            }
+        }
+
+        uint64 cycles[CostTracker::CategoryCount];
+        CostTracker::fetch_cycles(cycles);
+
+        const ShaderGroup* shader_groups[CostTracker::MaxShaderGroupCount];
+        uint64 shader_group_cycles[CostTracker::MaxShaderGroupCount];
+        const size_t count =
+            CostTracker::fetch_shader_group_cycles(shader_groups, shader_group_cycles);
+
+        CostTracker::stop_tracking();
+
+        ASSERT_EQ(1, count);
+        EXPECT_EQ(shader_group, shader_groups[0]);
+        EXPECT_TRUE(shader_group_cycles[0] >= cycles[CostTracker::TextureFetch]);
+    }
+}
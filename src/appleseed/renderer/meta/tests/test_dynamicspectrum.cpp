@@ -58,6 +58,8 @@ TEST_SUITE(Renderer_Utility_DynamicSpectrum31f)
         }
     };
 
+#ifndef APPLESEED_RGB_ONLY_SPECTRUM
+
     struct SpectralFixture
     {
         const DynamicSpectrum31f::Mode m_old_mode;
@@ -137,6 +139,8 @@ TEST_SUITE(Renderer_Utility_DynamicSpectrum31f)
             EXPECT_FEQ(lerp(a[i], b[i], t[i]), result[i]);
     }
 
+#endif
+
     TEST_CASE_F(MinValue_RGB, RGBFixture)
     {
         for (size_t i = 0; i < 3; ++i)
@@ -151,6 +155,8 @@ TEST_SUITE(Renderer_Utility_DynamicSpectrum31f)
         }
     }
 
+#ifndef APPLESEED_RGB_ONLY_SPECTRUM
+
     TEST_CASE_F(MinValue_Spectral, SpectralFixture)
     {
         for (size_t i = 0; i < 31; ++i)
@@ -165,6 +171,8 @@ TEST_SUITE(Renderer_Utility_DynamicSpectrum31f)
         }
     }
 
+#endif
+
     TEST_CASE_F(MaxValue_RGB, RGBFixture)
     {
         for (size_t i = 0; i < 3; ++i)
@@ -179,6 +187,8 @@ TEST_SUITE(Renderer_Utility_DynamicSpectrum31f)
         }
     }
 
+#ifndef APPLESEED_RGB_ONLY_SPECTRUM
+
     TEST_CASE_F(MaxValue_Spectral, SpectralFixture)
     {
         for (size_t i = 0; i < 31; ++i)
@@ -216,4 +226,17 @@ TEST_SUITE(Renderer_Utility_DynamicSpectrum31f)
         for (size_t i = 0, e = x.size(); i < e; ++i)
             EXPECT_FEQ(sqrt(Values[i]), result[i]);
     }
+
+#else
+
+    TEST_CASE(SetMode_GivenSpectralModeInRGBOnlyBuild_RemainsInRGBMode)
+    {
+        DynamicSpectrum31f::set_mode(DynamicSpectrum31f::Spectral);
+
+        EXPECT_EQ(DynamicSpectrum31f::RGB, DynamicSpectrum31f::get_mode());
+        EXPECT_EQ(3, DynamicSpectrum31f::size());
+        EXPECT_EQ(4 * sizeof(float), sizeof(DynamicSpectrum31f));
+    }
+
+#endif
 }
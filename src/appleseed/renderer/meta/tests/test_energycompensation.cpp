@@ -27,12 +27,17 @@
 //
 
 // appleseed.renderer headers.
+#include "renderer/modeling/bsdf/energycompensation.h"
+#include "renderer/modeling/bsdf/energycompensationtables.h"
 #include "renderer/modeling/bsdf/glassbsdf.h"
 #include "renderer/modeling/bsdf/microfacethelper.h"
 
 // appleseed.foundation headers.
 #include "foundation/utility/test.h"
 
+// Standard headers.
+#include <cstddef>
+
 using namespace renderer;
 
 TEST_SUITE(Renderer_Modeling_BSDF_EnergyCompensation)
@@ -46,4 +51,38 @@ TEST_SUITE(Renderer_Modeling_BSDF_EnergyCompensation)
     {
         write_glass_directional_albedo_tables("unit tests/outputs");
     }
+
+    class GGXAlbedoTable
+      : public AlbedoTable2D
+    {
+      public:
+        GGXAlbedoTable()
+          : AlbedoTable2D(g_glossy_ggx_albedo_table)
+        {
+        }
+    };
+
+    TEST_CASE(GetDirectionalAlbedos_MatchesGetDirectionalAlbedo)
+    {
+        const GGXAlbedoTable table;
+
+        const size_t N = 23;
+
+        for (size_t r = 0; r < N; ++r)
+        {
+            const float roughness = static_cast<float>(r) / (N - 1);
+
+            for (size_t i = 0; i < N; ++i)
+            {
+                const float cos_theta0 = static_cast<float>(i) / (N - 1);
+                const float cos_theta1 = 1.0f - cos_theta0 * cos_theta0;
+
+                float albedo0, albedo1;
+                table.get_directional_albedos(cos_theta0, cos_theta1, roughness, albedo0, albedo1);
+
+                EXPECT_FEQ_EPS(table.get_directional_albedo(cos_theta0, roughness), albedo0, 1.0e-6f);
+                EXPECT_FEQ_EPS(table.get_directional_albedo(cos_theta1, roughness), albedo1, 1.0e-6f);
+            }
+        }
+    }
 }
@@ -0,0 +1,156 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2018 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// appleseed.renderer headers.
+#include "renderer/global/globaltypes.h"
+#include "renderer/kernel/tessellation/geometrypager.h"
+#include "renderer/kernel/tessellation/statictessellation.h"
+#include "renderer/modeling/object/triangle.h"
+#include "renderer/utility/paramarray.h"
+
+// appleseed.foundation headers.
+#include "foundation/utility/iostreamop.h"
+#include "foundation/utility/lazy.h"
+#include "foundation/utility/test.h"
+
+// Boost headers.
+#include "boost/filesystem.hpp"
+
+// Standard headers.
+#include <vector>
+
+using namespace foundation;
+using namespace renderer;
+using namespace std;
+namespace bf = boost::filesystem;
+
+TEST_SUITE(Renderer_Kernel_Tessellation_GeometryPager)
+{
+    struct Fixture
+    {
+        StaticTriangleTess  m_tess;
+
+        Fixture()
+        {
+            m_tess.m_vertices.push_back(GVector3(0.0f, 0.0f, 0.0f));
+            m_tess.m_vertices.push_back(GVector3(1.0f, 0.0f, 0.0f));
+            m_tess.m_vertices.push_back(GVector3(0.0f, 1.0f, 0.0f));
+            m_tess.m_vertex_normals.push_back(GVector3(0.0f, 0.0f, 1.0f));
+            m_tess.m_primitives.push_back(Triangle(0, 1, 2, 0, 0, 0, 0, 0, 0, 0));
+            m_tess.push_tex_coords(GVector2(0.25f, 0.75f));
+        }
+    };
+
+    TEST_CASE_F(PageOut_AccessPagedOutTessellation_LoadsTessellation, Fixture)
+    {
+        GeometryPager pager(ParamArray().insert("directory", "unit tests/outputs"));
+
+        Lazy<StaticTriangleTess>* lazy = pager.page_out(m_tess);
+        ASSERT_NEQ(0, lazy);
+
+        const Access<StaticTriangleTess> tess(lazy);
+
+        ASSERT_EQ(3, tess->m_vertices.size());
+        EXPECT_EQ(GVector3(1.0f, 0.0f, 0.0f), tess->m_vertices[1]);
+        ASSERT_EQ(1, tess->m_primitives.size());
+        EXPECT_EQ(2, tess->m_primitives[0].m_v2);
+        ASSERT_EQ(1, tess->get_tex_coords_count());
+        EXPECT_EQ(GVector2(0.25f, 0.75f), tess->get_tex_coords(0));
+    }
+
+    TEST_CASE_F(PageIn_GivenPagedOutTessellation_RestoresTessellation, Fixture)
+    {
+        GeometryPager pager(ParamArray().insert("directory", "unit tests/outputs"));
+
+        Lazy<StaticTriangleTess>* lazy = pager.page_out(m_tess);
+        ASSERT_NEQ(0, lazy);
+
+        m_tess.clear();
+        EXPECT_EQ(0, m_tess.get_tex_coords_count());
+
+        ASSERT_TRUE(pager.page_in(lazy, m_tess));
+
+        ASSERT_EQ(3, m_tess.m_vertices.size());
+        EXPECT_EQ(GVector3(0.0f, 1.0f, 0.0f), m_tess.m_vertices[2]);
+        ASSERT_EQ(1, m_tess.get_tex_coords_count());
+        EXPECT_EQ(GVector2(0.25f, 0.75f), m_tess.get_tex_coords(0));
+    }
+
+    TEST_CASE_F(PageOut_GivenZeroMemoryBudget_ReleasesTessellationsNoLongerAccessed, Fixture)
+    {
+        GeometryPager pager(
+            ParamArray()
+                .insert("directory", "unit tests/outputs")
+                .insert("max_size", 0));
+
+        Lazy<StaticTriangleTess>* lazy1 = pager.page_out(m_tess);
+        Lazy<StaticTriangleTess>* lazy2 = pager.page_out(m_tess);
+        ASSERT_NEQ(0, lazy1);
+        ASSERT_NEQ(0, lazy2);
+
+        {
+            const Access<StaticTriangleTess> tess(lazy1);
+        }
+
+        const Access<StaticTriangleTess> tess(lazy2);
+
+        // Loading the second tessellation must have released the first one.
+        EXPECT_FALSE(lazy1->try_release_object());
+        EXPECT_EQ(3, tess->m_vertices.size());
+    }
+
+    TEST_CASE_F(PageIn_GivenMissingPageFile_ReturnsFalse, Fixture)
+    {
+        const bf::path directory("unit tests/outputs/test_geometrypager_missing_page_file");
+        bf::remove_all(directory);
+
+        GeometryPager pager(ParamArray().insert("directory", directory.string()));
+
+        Lazy<StaticTriangleTess>* lazy = pager.page_out(m_tess);
+        ASSERT_NEQ(0, lazy);
+
+        vector<bf::path> page_files;
+        for (bf::recursive_directory_iterator i(directory), e; i != e; ++i)
+        {
+            if (bf::is_regular_file(i->path()))
+                page_files.push_back(i->path());
+        }
+
+        for (const auto& page_file : page_files)
+            bf::remove(page_file);
+
+        {
+            const Access<StaticTriangleTess> tess(lazy);
+            EXPECT_EQ(0, tess.get());
+        }
+
+        StaticTriangleTess tess;
+        EXPECT_FALSE(pager.page_in(lazy, tess));
+        EXPECT_EQ(0, tess.m_vertices.size());
+    }
+}
@@ -35,7 +35,9 @@
 #include "renderer/kernel/shading/shadingray.h"
 #include "renderer/kernel/texturing/texturecache.h"
 #include "renderer/kernel/texturing/texturestore.h"
+#include "renderer/modeling/object/meshobject.h"
 #include "renderer/modeling/object/object.h"
+#include "renderer/modeling/object/triangle.h"
 #include "renderer/modeling/scene/assembly.h"
 #include "renderer/modeling/scene/assemblyinstance.h"
 #include "renderer/modeling/scene/containers.h"
@@ -182,4 +184,84 @@ TEST_SUITE(Renderer_Kernel_Intersection_Intersector)
     }
 
 #endif  // APPLESEED_WITH_EMBREE
+
+    struct MeshTestScene
+      : public TestSceneBase
+    {
+        MeshTestScene()
+        {
+            auto_release_ptr<Assembly> assembly(
+                AssemblyFactory().create("assembly", ParamArray()));
+
+            auto_release_ptr<Object> object(MeshObjectFactory().create("object", ParamArray()));
+            MeshObject* mesh = static_cast<MeshObject*>(object.get());
+            mesh->push_vertex(GVector3(-1.0f, -1.0f, 0.0f));
+            mesh->push_vertex(GVector3( 1.0f, -1.0f, 0.0f));
+            mesh->push_vertex(GVector3( 0.0f,  1.0f, 0.0f));
+            mesh->push_triangle(Triangle(0, 1, 2, 0));
+            assembly->objects().insert(object);
+
+            assembly->object_instances().insert(
+                ObjectInstanceFactory::create(
+                    "object_instance",
+                    ParamArray(),
+                    "object",
+                    Transformd::identity(),
+                    StringDictionary()));
+
+            m_scene.assembly_instances().insert(
+                auto_release_ptr<AssemblyInstance>(
+                    AssemblyInstanceFactory::create(
+                        "assembly_instance",
+                        ParamArray(),
+                        "assembly")));
+
+            m_scene.assemblies().insert(assembly);
+        }
+    };
+
+    struct MeshFixture
+      : public StaticTestSceneContext<MeshTestScene>
+    {
+        TraceContext    m_trace_context;
+        TextureStore    m_texture_store;
+        TextureCache    m_texture_cache;
+        Intersector     m_intersector;
+
+        MeshFixture()
+          : m_trace_context(m_scene)
+          , m_texture_store(m_scene)
+          , m_texture_cache(m_texture_store)
+          , m_intersector(m_trace_context, m_texture_cache)
+        {
+            m_trace_context.update();
+        }
+
+        bool trace_probe(const double x)
+        {
+            const ShadingRay ray(
+                Vector3d(x, 0.0, 2.0),
+                Vector3d(0.0, 0.0, -1.0),
+                0.0,                            // tmin
+                4.0,                            // tmax
+                ShadingRay::Time(),
+                VisibilityFlags::CameraRay,
+                0);                             // depth
+
+            return m_intersector.trace_probe(ray);
+        }
+    };
+
+    TEST_CASE_F(TraceProbe_GivenAssemblyInstanceMovedAfterUpdate_HitsMovedGeometry, MeshFixture)
+    {
+        ASSERT_TRUE(trace_probe(0.0));
+
+        m_scene.assembly_instances().get_by_name("assembly_instance")->transform_sequence().set_transform(
+            0.0f,
+            Transformd::from_local_to_parent(Matrix4d::make_translation(Vector3d(10.0, 0.0, 0.0))));
+        m_trace_context.update();
+
+        EXPECT_FALSE(trace_probe(0.0));
+        EXPECT_TRUE(trace_probe(10.0));
+    }
 }
@@ -0,0 +1,123 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2018 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// appleseed.renderer headers.
+#include "renderer/global/globaltypes.h"
+#include "renderer/kernel/tessellation/loopsubdivision.h"
+#include "renderer/kernel/tessellation/statictessellation.h"
+#include "renderer/modeling/object/triangle.h"
+
+// appleseed.foundation headers.
+#include "foundation/math/vector.h"
+#include "foundation/utility/iostreamop.h"
+#include "foundation/utility/test.h"
+
+// Standard headers.
+#include <cstddef>
+
+using namespace foundation;
+using namespace renderer;
+
+TEST_SUITE(Renderer_Kernel_Tessellation_LoopSubdivision)
+{
+    TEST_CASE(LoopSubdivide_GivenTetrahedron_SplitsEachTriangleIntoFour)
+    {
+        StaticTriangleTess input;
+        input.m_vertices.push_back(GVector3(0.0f, 0.0f, 0.0f));
+        input.m_vertices.push_back(GVector3(1.0f, 0.0f, 0.0f));
+        input.m_vertices.push_back(GVector3(0.0f, 1.0f, 0.0f));
+        input.m_vertices.push_back(GVector3(0.0f, 0.0f, 1.0f));
+        input.m_primitives.push_back(Triangle(0, 2, 1, 0));
+        input.m_primitives.push_back(Triangle(0, 1, 3, 0));
+        input.m_primitives.push_back(Triangle(0, 3, 2, 0));
+        input.m_primitives.push_back(Triangle(1, 2, 3, 0));
+
+        StaticTriangleTess output;
+        loop_subdivide(input, output);
+
+        EXPECT_EQ(4 + 6, output.m_vertices.size());
+        EXPECT_EQ(4 * 4, output.m_primitives.size());
+    }
+
+    TEST_CASE(LoopSubdivide_GivenSingleTriangle_AppliesBoundaryRules)
+    {
+        StaticTriangleTess input;
+        input.m_vertices.push_back(GVector3(0.0f, 0.0f, 0.0f));
+        input.m_vertices.push_back(GVector3(8.0f, 0.0f, 0.0f));
+        input.m_vertices.push_back(GVector3(0.0f, 8.0f, 0.0f));
+        input.m_primitives.push_back(Triangle(0, 1, 2, 0));
+
+        StaticTriangleTess output;
+        loop_subdivide(input, output);
+
+        ASSERT_EQ(6, output.m_vertices.size());
+
+        // Even boundary vertex: 3/4 of itself and 1/8 of each boundary neighbor.
+        EXPECT_FEQ(GVector3(1.0f, 1.0f, 0.0f), output.m_vertices[0]);
+
+        // Odd boundary vertex: midpoint of the edge.
+        EXPECT_FEQ(GVector3(4.0f, 0.0f, 0.0f), output.m_vertices[3]);
+    }
+
+    TEST_CASE(LoopSubdivide_GivenTexCoords_InterpolatesThemLinearly)
+    {
+        StaticTriangleTess input;
+        input.m_vertices.push_back(GVector3(0.0f, 0.0f, 0.0f));
+        input.m_vertices.push_back(GVector3(1.0f, 0.0f, 0.0f));
+        input.m_vertices.push_back(GVector3(0.0f, 1.0f, 0.0f));
+        input.push_tex_coords(GVector2(0.0f, 0.0f));
+        input.push_tex_coords(GVector2(1.0f, 0.0f));
+        input.push_tex_coords(GVector2(0.0f, 1.0f));
+        input.m_primitives.push_back(Triangle(0, 1, 2, 0, 0, 0, 0, 1, 2, 0));
+
+        StaticTriangleTess output;
+        loop_subdivide(input, output);
+
+        ASSERT_EQ(6, output.get_tex_coords_count());
+
+        const Triangle& corner = output.m_primitives[0];
+        EXPECT_EQ(GVector2(0.0f, 0.0f), output.get_tex_coords(corner.m_a0));
+        EXPECT_EQ(GVector2(0.5f, 0.0f), output.get_tex_coords(corner.m_a1));
+        EXPECT_EQ(GVector2(0.0f, 0.5f), output.get_tex_coords(corner.m_a2));
+    }
+
+    TEST_CASE(ComputeSmoothVertexNormals_GivenPlanarTriangle_ProducesFaceNormal)
+    {
+        StaticTriangleTess tess;
+        tess.m_vertices.push_back(GVector3(0.0f, 0.0f, 0.0f));
+        tess.m_vertices.push_back(GVector3(1.0f, 0.0f, 0.0f));
+        tess.m_vertices.push_back(GVector3(0.0f, 1.0f, 0.0f));
+        tess.m_primitives.push_back(Triangle(0, 1, 2, 0));
+
+        compute_smooth_vertex_normals(tess);
+
+        ASSERT_EQ(3, tess.m_vertex_normals.size());
+        EXPECT_FEQ(GVector3(0.0f, 0.0f, 1.0f), tess.m_vertex_normals[0]);
+        EXPECT_EQ(2, tess.m_primitives[0].m_n2);
+    }
+}
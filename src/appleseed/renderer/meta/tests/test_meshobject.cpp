@@ -0,0 +1,114 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2018 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// appleseed.renderer headers.
+#include "renderer/global/globaltypes.h"
+#include "renderer/kernel/texturing/texturecache.h"
+#include "renderer/kernel/texturing/texturestore.h"
+#include "renderer/modeling/object/meshobject.h"
+#include "renderer/modeling/object/object.h"
+#include "renderer/modeling/object/triangle.h"
+#include "renderer/modeling/scene/scene.h"
+#include "renderer/utility/paramarray.h"
+
+// appleseed.foundation headers.
+#include "foundation/utility/autoreleaseptr.h"
+#include "foundation/utility/test.h"
+
+using namespace foundation;
+using namespace renderer;
+
+TEST_SUITE(Renderer_Modeling_Object_MeshObject)
+{
+    struct Fixture
+    {
+        auto_release_ptr<Scene>     m_scene;
+        auto_release_ptr<Object>    m_object;
+        MeshObject&                 m_mesh;
+
+        Fixture()
+          : m_scene(SceneFactory::create())
+          , m_object(
+                MeshObjectFactory().create(
+                    "mesh",
+                    ParamArray().insert("subdivision_scheme", "loop")))
+          , m_mesh(static_cast<MeshObject&>(m_object.ref()))
+        {
+            m_mesh.push_vertex(GVector3(0.0f, 0.0f, 0.0f));
+            m_mesh.push_vertex(GVector3(1.0f, 0.0f, 0.0f));
+            m_mesh.push_vertex(GVector3(0.0f, 1.0f, 0.0f));
+            m_mesh.push_triangle(Triangle(0, 1, 2, 0));
+        }
+
+        void dice(const size_t level)
+        {
+            TextureStore texture_store(m_scene.ref());
+            TextureCache texture_cache(texture_store);
+            m_mesh.dice(level, texture_cache);
+        }
+    };
+
+    TEST_CASE_F(Dice_RecordsDicingLevelAndSignature, Fixture)
+    {
+        dice(1);
+
+        EXPECT_TRUE(m_mesh.is_diced());
+        EXPECT_EQ(1, m_mesh.get_dicing_level());
+        EXPECT_EQ(m_mesh.compute_dicing_signature(), m_mesh.get_dicing_signature());
+    }
+
+    TEST_CASE_F(ComputeDicingSignature_GivenBaseCageModifiedAfterDicing_ReturnsDifferentSignature, Fixture)
+    {
+        dice(1);
+
+        m_mesh.push_vertex(GVector3(0.0f, 2.0f, 0.0f));
+
+        EXPECT_NEQ(m_mesh.get_dicing_signature(), m_mesh.compute_dicing_signature());
+    }
+
+    TEST_CASE_F(ComputeDicingSignature_GivenObjectModifiedAfterDicing_ReturnsDifferentSignature, Fixture)
+    {
+        dice(1);
+
+        m_mesh.get_parameters().insert("max_subdivision_level", 2);
+        m_mesh.bump_version_id();
+
+        EXPECT_NEQ(m_mesh.get_dicing_signature(), m_mesh.compute_dicing_signature());
+    }
+
+    TEST_CASE_F(ClearDicing_DiscardsDicedGeometry, Fixture)
+    {
+        const size_t base_cage_size = m_mesh.get_geometry_memory_size();
+        dice(1);
+
+        m_mesh.clear_dicing();
+
+        EXPECT_FALSE(m_mesh.is_diced());
+        EXPECT_EQ(base_cage_size, m_mesh.get_geometry_memory_size());
+    }
+}
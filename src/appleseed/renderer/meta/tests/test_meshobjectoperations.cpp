@@ -0,0 +1,115 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2018 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// appleseed.renderer headers.
+#include "renderer/global/globaltypes.h"
+#include "renderer/modeling/object/meshobject.h"
+#include "renderer/modeling/object/meshobjectoperations.h"
+#include "renderer/modeling/object/object.h"
+#include "renderer/modeling/object/triangle.h"
+#include "renderer/modeling/scene/assembly.h"
+#include "renderer/modeling/scene/containers.h"
+#include "renderer/modeling/scene/scene.h"
+#include "renderer/utility/paramarray.h"
+
+// appleseed.foundation headers.
+#include "foundation/utility/autoreleaseptr.h"
+#include "foundation/utility/iostreamop.h"
+#include "foundation/utility/test.h"
+
+using namespace foundation;
+using namespace renderer;
+
+TEST_SUITE(Renderer_Modeling_Object_MeshObjectOperations)
+{
+    struct Fixture
+    {
+        auto_release_ptr<Scene> m_scene;
+        MeshObject*             m_mesh1;
+        MeshObject*             m_mesh2;
+        MeshObject*             m_mesh3;
+
+        Fixture()
+          : m_scene(SceneFactory::create())
+        {
+            auto_release_ptr<Assembly> assembly(
+                AssemblyFactory().create("assembly", ParamArray()));
+
+            m_mesh1 = create_triangle(*assembly, "mesh1", 1.0f);
+            m_mesh2 = create_triangle(*assembly, "mesh2", 1.0f);
+            m_mesh3 = create_triangle(*assembly, "mesh3", 2.0f);
+
+            m_scene->assemblies().insert(assembly);
+        }
+
+        static MeshObject* create_triangle(
+            Assembly&           assembly,
+            const char*         name,
+            const float         size)
+        {
+            auto_release_ptr<Object> object(MeshObjectFactory().create(name, ParamArray()));
+            MeshObject* mesh = static_cast<MeshObject*>(object.get());
+
+            mesh->push_vertex(GVector3(0.0f, 0.0f, 0.0f));
+            mesh->push_vertex(GVector3(size, 0.0f, 0.0f));
+            mesh->push_vertex(GVector3(0.0f, size, 0.0f));
+            mesh->push_triangle(Triangle(0, 1, 2, 0));
+
+            assembly.objects().insert(object);
+
+            return mesh;
+        }
+    };
+
+    TEST_CASE_F(DeduplicateMeshObjects_SharesGeometryOfIdenticalMeshObjects, Fixture)
+    {
+        const size_t deduplicated_count = deduplicate_mesh_objects(m_scene.ref());
+
+        EXPECT_EQ(1, deduplicated_count);
+        EXPECT_TRUE(m_mesh1->is_sharing_geometry());
+        EXPECT_TRUE(m_mesh2->is_sharing_geometry());
+        EXPECT_FALSE(m_mesh3->is_sharing_geometry());
+        EXPECT_EQ(m_mesh1->get_geometry_uid(), m_mesh2->get_geometry_uid());
+        EXPECT_NEQ(m_mesh1->get_geometry_uid(), m_mesh3->get_geometry_uid());
+        EXPECT_EQ(GVector3(1.0f, 0.0f, 0.0f), m_mesh2->get_vertex(1));
+    }
+
+    TEST_CASE_F(ModifyingSharedMeshObject_CopiesGeometry, Fixture)
+    {
+        deduplicate_mesh_objects(m_scene.ref());
+
+        m_mesh2->push_vertex(GVector3(1.0f, 1.0f, 0.0f));
+
+        EXPECT_FALSE(m_mesh1->is_sharing_geometry());
+        EXPECT_FALSE(m_mesh2->is_sharing_geometry());
+        EXPECT_NEQ(m_mesh1->get_geometry_uid(), m_mesh2->get_geometry_uid());
+        EXPECT_EQ(3, m_mesh1->get_vertex_count());
+        EXPECT_EQ(4, m_mesh2->get_vertex_count());
+        EXPECT_EQ(1, m_mesh2->get_triangle_count());
+    }
+}
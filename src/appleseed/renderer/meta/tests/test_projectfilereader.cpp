@@ -28,12 +28,32 @@
 //
 
 // appleseed.renderer headers.
+#include "renderer/global/globaltypes.h"
+#include "renderer/kernel/intersection/intersectionsettings.h"
+#include "renderer/modeling/color/colorentity.h"
+#include "renderer/modeling/object/curveobject.h"
+#include "renderer/modeling/object/meshobject.h"
+#include "renderer/modeling/object/object.h"
+#include "renderer/modeling/object/triangle.h"
 #include "renderer/modeling/project/project.h"
 #include "renderer/modeling/project/projectfilereader.h"
 #include "renderer/modeling/project/projectfilewriter.h"
+#include "renderer/modeling/scene/assembly.h"
+#include "renderer/modeling/scene/assemblyinstance.h"
+#include "renderer/modeling/scene/containers.h"
+#include "renderer/modeling/scene/objectinstance.h"
+#include "renderer/modeling/scene/scene.h"
+#include "renderer/utility/paramarray.h"
+#include "renderer/utility/transformsequence.h"
 
 // appleseed.foundation headers.
+#include "foundation/image/color.h"
+#include "foundation/math/matrix.h"
+#include "foundation/math/transform.h"
+#include "foundation/math/vector.h"
 #include "foundation/utility/autoreleaseptr.h"
+#include "foundation/utility/containers/dictionary.h"
+#include "foundation/utility/iostreamop.h"
 #include "foundation/utility/test.h"
 #include "foundation/utility/testutils.h"
 
@@ -75,6 +95,193 @@ TEST_SUITE(Renderer_Modeling_Project_ProjectFileReader)
         EXPECT_TRUE(identical);
     }
 
+    TEST_CASE(BinaryProjectFileRoundTrip)
+    {
+        ProjectFileReader reader;
+        auto_release_ptr<Project> project =
+            reader.read(
+                "unit tests/inputs/test_projectfilereader_configurationblocks.appleseed",
+                "../../../schemas/project.xsd");    // path relative to input file
+
+        ASSERT_NEQ(0, project.get());
+
+        const bool binary_success =
+            ProjectFileWriter::write(
+                project.ref(),
+                "unit tests/outputs/test_projectfilereader_binaryroundtrip.appleseedb",
+                ProjectFileWriter::OmitHeaderComment);
+
+        ASSERT_TRUE(binary_success);
+
+        auto_release_ptr<Project> binary_project =
+            reader.read(
+                "unit tests/outputs/test_projectfilereader_binaryroundtrip.appleseedb",
+                nullptr,
+                ProjectFileReader::OmitProjectSchemaValidation);
+
+        ASSERT_NEQ(0, binary_project.get());
+
+        const bool plain_success =
+            ProjectFileWriter::write(
+                binary_project.ref(),
+                "unit tests/outputs/test_projectfilereader_binaryroundtrip.appleseed",
+                ProjectFileWriter::OmitHeaderComment);
+
+        ASSERT_TRUE(plain_success);
+
+        const bool identical =
+            compare_text_files(
+                "unit tests/inputs/test_projectfilereader_configurationblocks.appleseed",
+                "unit tests/outputs/test_projectfilereader_binaryroundtrip.appleseed");
+
+        EXPECT_TRUE(identical);
+    }
+
+    TEST_CASE(BinaryProjectFileRoundTrip_PreservesNumericData)
+    {
+        const bf::path OutputDirectory("unit tests/outputs/test_projectfilereader_binaryroundtrip/");
+        bf::remove_all(OutputDirectory);
+        bf::create_directories(OutputDirectory);
+
+        // Values that cannot be represented exactly with a fixed number of decimals.
+        const Matrix4d ObjectInstanceMatrix =
+            Matrix4d::make_translation(Vector3d(1.0 / 3.0, -2.0 / 7.0, 1.0e-9)) *
+            Matrix4d::make_rotation_y(1.0 / 3.0);
+        const Matrix4d AssemblyInstanceMatrix0 =
+            Matrix4d::make_rotation_x(2.0 / 3.0);
+        const Matrix4d AssemblyInstanceMatrix1 =
+            Matrix4d::make_translation(Vector3d(1.0e-7, 1.0 / 9.0, 12345.6789012345));
+        const float ColorValues[] = { 1.0f / 3.0f, 2.0f / 7.0f, 1.0e-7f };
+        const float AlphaValue = 1.0f / 9.0f;
+        const GVector3 MeshVertices[] =
+        {
+            GVector3(0.1f, 1.0f / 3.0f, -0.7f),
+            GVector3(1.0e-6f, 0.2f, 4.0f / 9.0f),
+            GVector3(2.0f / 3.0f, 1.0f / 7.0f, 0.0f)
+        };
+        const GVector3 CurveControlPoints[] =
+        {
+            GVector3(1.0f / 3.0f, 0.0f, 0.1f),
+            GVector3(0.0f, 2.0f / 3.0f, 0.3f)
+        };
+
+        // Build the project.
+        auto_release_ptr<Project> project(ProjectFactory::create("project"));
+        project->set_scene(SceneFactory::create());
+        Scene* scene = project->get_scene();
+
+        scene->colors().insert(
+            ColorEntityFactory::create(
+                "color",
+                ParamArray().insert("color_space", "linear_rgb"),
+                ColorValueArray(3, ColorValues),
+                ColorValueArray(1, &AlphaValue)));
+
+        auto_release_ptr<Assembly> assembly(AssemblyFactory().create("assembly"));
+
+        auto_release_ptr<MeshObject> mesh_object(MeshObjectFactory().create("mesh", ParamArray()));
+        for (size_t i = 0; i < 3; ++i)
+            mesh_object->push_vertex(MeshVertices[i]);
+        mesh_object->push_triangle(Triangle(0, 1, 2));
+        assembly->objects().insert(auto_release_ptr<Object>(mesh_object));
+
+        auto_release_ptr<CurveObject> curve_object(CurveObjectFactory().create("curves", ParamArray()));
+        curve_object->push_basis(1);
+        curve_object->push_curve1(Curve1Type(CurveControlPoints, GScalar(0.1), GScalar(1.0), Color3f(0.2f, 0.0f, 0.7f)));
+        assembly->objects().insert(auto_release_ptr<Object>(curve_object));
+
+        assembly->object_instances().insert(
+            ObjectInstanceFactory::create(
+                "mesh_inst",
+                ParamArray(),
+                "mesh",
+                Transformd::from_local_to_parent(ObjectInstanceMatrix),
+                StringDictionary()));
+        assembly->object_instances().insert(
+            ObjectInstanceFactory::create(
+                "curves_inst",
+                ParamArray(),
+                "curves",
+                Transformd::from_local_to_parent(ObjectInstanceMatrix),
+                StringDictionary()));
+
+        scene->assemblies().insert(assembly);
+
+        auto_release_ptr<AssemblyInstance> assembly_instance(
+            AssemblyInstanceFactory::create("assembly_inst", ParamArray(), "assembly"));
+        assembly_instance->transform_sequence().set_transform(0.0f, Transformd::from_local_to_parent(AssemblyInstanceMatrix0));
+        assembly_instance->transform_sequence().set_transform(1.0f, Transformd::from_local_to_parent(AssemblyInstanceMatrix1));
+        scene->assembly_instances().insert(assembly_instance);
+
+        // Write it as a binary project file and read it back.
+        const bool success =
+            ProjectFileWriter::write(
+                project.ref(),
+                (OutputDirectory / "project.appleseedb").string().c_str(),
+                ProjectFileWriter::OmitHeaderComment);
+
+        ASSERT_TRUE(success);
+
+        ProjectFileReader reader;
+        auto_release_ptr<Project> binary_project =
+            reader.read(
+                (OutputDirectory / "project.appleseedb").string().c_str(),
+                nullptr,
+                ProjectFileReader::OmitProjectSchemaValidation);
+
+        ASSERT_NEQ(0, binary_project.get());
+
+        const Scene* binary_scene = binary_project->get_scene();
+        ASSERT_NEQ(0, binary_scene);
+
+        // <values> and <alpha>.
+        const ColorEntity* color = binary_scene->colors().get_by_name("color");
+        ASSERT_NEQ(0, color);
+        ASSERT_EQ(3, color->get_values().size());
+        for (size_t i = 0; i < 3; ++i)
+            EXPECT_EQ(ColorValues[i], color->get_values()[i]);
+        ASSERT_EQ(1, color->get_alpha().size());
+        EXPECT_EQ(AlphaValue, color->get_alpha()[0]);
+
+        // Assembly instance transform sequence.
+        const AssemblyInstance* binary_assembly_instance = binary_scene->assembly_instances().get_by_name("assembly_inst");
+        ASSERT_NEQ(0, binary_assembly_instance);
+        ASSERT_EQ(2, binary_assembly_instance->transform_sequence().size());
+        float time;
+        Transformd transform;
+        binary_assembly_instance->transform_sequence().get_transform(0, time, transform);
+        EXPECT_EQ(0.0f, time);
+        EXPECT_EQ(AssemblyInstanceMatrix0, transform.get_local_to_parent());
+        binary_assembly_instance->transform_sequence().get_transform(1, time, transform);
+        EXPECT_EQ(1.0f, time);
+        EXPECT_EQ(AssemblyInstanceMatrix1, transform.get_local_to_parent());
+
+        const Assembly* binary_assembly = binary_scene->assemblies().get_by_name("assembly");
+        ASSERT_NEQ(0, binary_assembly);
+
+        // Mesh object and its instance.
+        const ObjectInstance* mesh_instance = binary_assembly->object_instances().get_by_name("mesh_inst");
+        ASSERT_NEQ(0, mesh_instance);
+        EXPECT_EQ(ObjectInstanceMatrix, mesh_instance->get_transform().get_local_to_parent());
+        const MeshObject* binary_mesh_object =
+            static_cast<const MeshObject*>(binary_assembly->objects().get_by_name(mesh_instance->get_object_name()));
+        ASSERT_NEQ(0, binary_mesh_object);
+        ASSERT_EQ(3, binary_mesh_object->get_vertex_count());
+        for (size_t i = 0; i < 3; ++i)
+            EXPECT_EQ(MeshVertices[i], binary_mesh_object->get_vertex(i));
+
+        // Curve object and its instance.
+        const ObjectInstance* curves_instance = binary_assembly->object_instances().get_by_name("curves_inst");
+        ASSERT_NEQ(0, curves_instance);
+        EXPECT_EQ(ObjectInstanceMatrix, curves_instance->get_transform().get_local_to_parent());
+        const CurveObject* binary_curve_object =
+            static_cast<const CurveObject*>(binary_assembly->objects().get_by_name(curves_instance->get_object_name()));
+        ASSERT_NEQ(0, binary_curve_object);
+        ASSERT_EQ(1, binary_curve_object->get_curve1_count());
+        EXPECT_EQ(CurveControlPoints[0], binary_curve_object->get_curve1(0).get_control_point(0));
+        EXPECT_EQ(CurveControlPoints[1], binary_curve_object->get_curve1(0).get_control_point(1));
+    }
+
     TEST_CASE(ReadValidPackedProject)
     {
         const char* UnpackDirectory = "unit tests/inputs/test_projectfilereader_validpackedproject.unpacked/";
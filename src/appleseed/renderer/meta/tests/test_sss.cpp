@@ -312,6 +312,19 @@ TEST_SUITE(Renderer_Modeling_BSSRDF_SSS)
         }
     }
 
+    TEST_CASE(BSSRDFReparam_BetterDipole_AlphaPrimeTableMatchesNumericalInversion)
+    {
+        for (size_t i = 0, e = countof(RDs); i < e; ++i)
+        {
+            AlphaPrimeTable table;
+            table.initialize<ComputeRdBetterDipole>(IORs[i]);
+
+            const ComputeRdBetterDipole f(IORs[i]);
+            const float rd = RDs[i];
+            EXPECT_FEQ_EPS(compute_alpha_prime(f, rd), compute_alpha_prime(table, rd), 1.0e-3f);
+        }
+    }
+
     TEST_CASE(BSSRDFReparam_StandardDipole_SigmasRdMfpSigmasRoundTrip)
     {
         //
@@ -936,6 +949,23 @@ TEST_SUITE(Renderer_Modeling_BSSRDF_SSS)
         }
     }
 
+    TEST_CASE(NormalizedDiffusion_Sample_InvertsCDF)
+    {
+        MersenneTwister rng;
+
+        for (size_t i = 0; i < 1000; ++i)
+        {
+            const float a = rand_float1(rng);
+            const float l = rand_float1(rng, 0.001f, 10.0f);
+            const float u = rand_float2(rng, 0.0f, 0.99f);
+
+            const float s = normalized_diffusion_s_mfp(a);
+            const float r = normalized_diffusion_sample(u, l, s);
+
+            EXPECT_FEQ_EPS(u, normalized_diffusion_cdf(r, l, s), 1.0e-3f);
+        }
+    }
+
     TEST_CASE(NormalizedDiffusion_IntegrateProfile)
     {
         const float Rd = 0.5f;
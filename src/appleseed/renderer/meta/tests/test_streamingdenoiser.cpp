@@ -0,0 +1,101 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2018 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// appleseed.renderer headers.
+#include "renderer/kernel/denoising/streamingdenoiser.h"
+#include "renderer/modeling/aov/aovcontainer.h"
+#include "renderer/modeling/frame/frame.h"
+#include "renderer/utility/paramarray.h"
+
+// appleseed.foundation headers.
+#include "foundation/image/canvasproperties.h"
+#include "foundation/image/color.h"
+#include "foundation/image/image.h"
+#include "foundation/utility/autoreleaseptr.h"
+#include "foundation/utility/iostreamop.h"
+#include "foundation/utility/test.h"
+
+// Standard headers.
+#include <cstddef>
+
+using namespace foundation;
+using namespace renderer;
+
+TEST_SUITE(Renderer_Kernel_Denoising_StreamingDenoiser)
+{
+    struct Fixture
+    {
+        auto_release_ptr<Frame> m_frame;
+
+        Fixture()
+        {
+            m_frame =
+                FrameFactory::create(
+                    "beauty",
+                    ParamArray()
+                        .insert("resolution", "64 64")
+                        .insert("tile_size", "16 16")
+                        .insert("denoiser", "on")
+                        .insert("denoise_scales", "1"),
+                    AOVContainer());
+
+            m_frame->clear_main_and_aov_images();
+            m_frame->image().clear(Color4f(0.5f, 0.5f, 0.5f, 1.0f));
+        }
+    };
+
+    TEST_CASE_F(OnTileEnd_GivenTilesInLinearOrder_KeepsAboutTwoRowsOfDenoisedTiles, Fixture)
+    {
+        const CanvasProperties& props = m_frame->image().properties();
+
+        StreamingDenoiser denoiser(*m_frame, 1);
+
+        for (size_t ty = 0; ty < props.m_tile_count_y; ++ty)
+        {
+            for (size_t tx = 0; tx < props.m_tile_count_x; ++tx)
+                denoiser.on_tile_end(tx, ty, nullptr);
+        }
+
+        denoiser.finish(nullptr);
+
+        EXPECT_LT(2 * props.m_tile_count_x + 2, denoiser.get_peak_pending_tile_count());
+    }
+
+    TEST_CASE_F(Finish_GivenUniformImage_LeavesImageUnchanged, Fixture)
+    {
+        StreamingDenoiser denoiser(*m_frame, 1);
+
+        denoiser.on_tile_end(0, 0, nullptr);
+        denoiser.finish(nullptr);
+
+        Color4f c;
+        m_frame->image().get_pixel(33, 17, c);
+
+        EXPECT_FEQ_EPS(Color4f(0.5f, 0.5f, 0.5f, 1.0f), c, 1.0e-3f);
+    }
+}
@@ -0,0 +1,168 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2018 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// appleseed.renderer headers.
+#include "renderer/kernel/texturing/texturecache.h"
+#include "renderer/kernel/texturing/texturestore.h"
+#include "renderer/modeling/input/sourceinputs.h"
+#include "renderer/modeling/input/texturesource.h"
+#include "renderer/modeling/scene/containers.h"
+#include "renderer/modeling/scene/scene.h"
+#include "renderer/modeling/scene/textureinstance.h"
+#include "renderer/modeling/texture/memorytexture2d.h"
+#include "renderer/modeling/texture/texture.h"
+#include "renderer/utility/paramarray.h"
+
+// appleseed.foundation headers.
+#include "foundation/image/color.h"
+#include "foundation/image/image.h"
+#include "foundation/image/pixel.h"
+#include "foundation/math/vector.h"
+#include "foundation/utility/autoreleaseptr.h"
+#include "foundation/utility/test.h"
+#include "foundation/utility/uid.h"
+
+// Standard headers.
+#include <cmath>
+#include <cstddef>
+
+using namespace foundation;
+using namespace renderer;
+using namespace std;
+
+TEST_SUITE(Renderer_Modeling_Input_TextureSource)
+{
+    struct Fixture
+    {
+        static const size_t TextureSize = 16;
+
+        auto_release_ptr<Scene> m_scene;
+
+        Fixture()
+          : m_scene(SceneFactory::create())
+        {
+            // Horizontal ramp going from 0 to 1 across the texture: texel x holds (x + 0.5) / 16.
+            // Every level of the MIP pyramid of such a texture holds the same ramp.
+            auto_release_ptr<Image> image(
+                new Image(TextureSize, TextureSize, 8, 8, 3, PixelFormatFloat));
+
+            for (size_t y = 0; y < TextureSize; ++y)
+            {
+                for (size_t x = 0; x < TextureSize; ++x)
+                {
+                    const float value = (static_cast<float>(x) + 0.5f) / TextureSize;
+                    image->set_pixel(x, y, Color3f(value));
+                }
+            }
+
+            m_scene->textures().insert(
+                MemoryTexture2dFactory().create(
+                    "texture",
+                    ParamArray().insert("color_space", "linear_rgb"),
+                    image));
+        }
+
+        // Evaluate the texture with a given filtering mode and a given footprint, expressed in texels of level 0.
+        float evaluate(
+            const char*         filtering_mode,
+            const float         u,
+            const Vector2f&     dstdx,
+            const Vector2f&     dstdy) const
+        {
+            auto_release_ptr<TextureInstance> texture_instance(
+                TextureInstanceFactory::create(
+                    "texture_inst",
+                    ParamArray()
+                        .insert("addressing_mode", "clamp")
+                        .insert("filtering_mode", filtering_mode),
+                    "texture"));
+            texture_instance->bind_texture(m_scene->textures());
+
+            const TextureSource source(~UniqueID(0), texture_instance.ref());
+
+            TextureStore texture_store(m_scene.ref());
+            TextureCache texture_cache(texture_store);
+
+            const SourceInputs source_inputs(
+                Vector2f(u, 0.5f),
+                dstdx / static_cast<float>(TextureSize),
+                dstdy / static_cast<float>(TextureSize));
+
+            Color3f color;
+            source.evaluate(texture_cache, source_inputs, color);
+
+            return color[0];
+        }
+    };
+
+    TEST_CASE_F(Evaluate_Trilinear_FractionalLevelOfDetail_ReturnsRampValue, Fixture)
+    {
+        // A footprint of 2^1.5 texels blends levels 1 and 2; both must be registered with the texture.
+        const Vector2f dstdx(pow(2.0f, 1.5f), 0.0f);
+        const Vector2f dstdy(0.0f, 1.0f);
+
+        EXPECT_FEQ_EPS(0.3f, evaluate("trilinear", 0.3f, dstdx, dstdy), 1.0e-5f);
+        EXPECT_FEQ_EPS(0.5f, evaluate("trilinear", 0.5f, dstdx, dstdy), 1.0e-5f);
+        EXPECT_FEQ_EPS(0.7f, evaluate("trilinear", 0.7f, dstdx, dstdy), 1.0e-5f);
+    }
+
+    TEST_CASE_F(Evaluate_Trilinear_FootprintLargerThanTexture_ReturnsTextureAverage, Fixture)
+    {
+        const Vector2f dstdx(32.0f, 0.0f);
+        const Vector2f dstdy(0.0f, 32.0f);
+
+        EXPECT_FEQ_EPS(0.5f, evaluate("trilinear", 0.3f, dstdx, dstdy), 1.0e-5f);
+    }
+
+    TEST_CASE_F(Evaluate_EWA_FootprintCenteredOnTexelBoundary_ReturnsRampValue, Fixture)
+    {
+        // A 4x4 texels footprint selects level 2 and filters the texels symmetrically around u.
+        const Vector2f dstdx(4.0f, 0.0f);
+        const Vector2f dstdy(0.0f, 4.0f);
+
+        EXPECT_FEQ_EPS(0.5f, evaluate("ewa", 0.5f, dstdx, dstdy), 1.0e-5f);
+    }
+
+    TEST_CASE_F(Evaluate_EWA_FootprintLargerThanTexture_ReturnsTextureAverage, Fixture)
+    {
+        const Vector2f dstdx(32.0f, 0.0f);
+        const Vector2f dstdy(0.0f, 32.0f);
+
+        EXPECT_FEQ_EPS(0.5f, evaluate("ewa", 0.3f, dstdx, dstdy), 1.0e-5f);
+    }
+
+    TEST_CASE_F(Evaluate_EWA_DegenerateFootprint_MatchesTrilinearAtLevel0, Fixture)
+    {
+        const Vector2f zero(0.0f);
+
+        EXPECT_FEQ_EPS(
+            evaluate("trilinear", 0.3f, zero, zero),
+            evaluate("ewa", 0.3f, zero, zero),
+            1.0e-6f);
+    }
+}
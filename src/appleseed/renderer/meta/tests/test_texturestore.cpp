@@ -28,12 +28,32 @@
 //
 
 // appleseed.renderer headers.
+#include "renderer/kernel/texturing/mipmaplevels.h"
 #include "renderer/kernel/texturing/texturestore.h"
+#include "renderer/modeling/scene/containers.h"
+#include "renderer/modeling/scene/scene.h"
+#include "renderer/modeling/texture/memorytexture2d.h"
+#include "renderer/modeling/texture/texture.h"
+#include "renderer/utility/paramarray.h"
 
 // appleseed.foundation headers.
+#include "foundation/image/canvasproperties.h"
+#include "foundation/image/color.h"
+#include "foundation/image/colorspace.h"
+#include "foundation/image/image.h"
+#include "foundation/image/pixel.h"
+#include "foundation/image/tile.h"
+#include "foundation/utility/autoreleaseptr.h"
 #include "foundation/utility/test.h"
+#include "foundation/utility/uid.h"
 
+// Standard headers.
+#include <cstddef>
+#include <vector>
+
+using namespace foundation;
 using namespace renderer;
+using namespace std;
 
 TEST_SUITE(Renderer_Kernel_Texturing_TextureStore_TileKey)
 {
@@ -45,5 +65,283 @@ TEST_SUITE(Renderer_Kernel_Texturing_TextureStore_TileKey)
         EXPECT_EQ(12345, key.m_texture_uid);
         EXPECT_EQ(32323, key.get_tile_x());
         EXPECT_EQ(56565, key.get_tile_y());
+        EXPECT_EQ(0, key.get_level());
+    }
+
+    TEST_CASE(TilesOfDifferentLevelsHaveDifferentKeys)
+    {
+        const TextureStore::TileKey key0(123, 12345, 3, 4);
+        const TextureStore::TileKey key1(123, 12345, 3, 4, 1);
+
+        EXPECT_EQ(1, key1.get_level());
+        EXPECT_TRUE(key0 != key1);
+        EXPECT_TRUE(key0 < key1);
+    }
+}
+
+TEST_SUITE(Renderer_Kernel_Texturing_TextureStore)
+{
+    struct Fixture
+    {
+        auto_release_ptr<Scene>     m_scene;
+        UniqueID                    m_texture_uid;
+        const Tile*                 m_tile;
+
+        Fixture()
+          : m_scene(SceneFactory::create())
+        {
+            auto_release_ptr<Image> image(new Image(32, 32, 16, 16, 4, PixelFormatFloat));
+            m_tile = &image->tile(1, 0);
+
+            auto_release_ptr<Texture> texture(
+                MemoryTexture2dFactory().create(
+                    "texture",
+                    ParamArray().insert("color_space", "linear_rgb"),
+                    image));
+            m_texture_uid = texture->get_uid();
+
+            m_scene->textures().insert(texture);
+        }
+    };
+
+    TEST_CASE_F(Prefetch_ThenAcquire_ReturnsPrefetchedTile, Fixture)
+    {
+        TextureStore texture_store(m_scene.ref());
+        const TextureStore::TileKey key(~UniqueID(0), m_texture_uid, 1, 0);
+
+        const bool prefetched = texture_store.prefetch(key);
+        TextureStore::TileRecord& record = texture_store.acquire(key);
+        texture_store.release(record);
+
+        EXPECT_TRUE(prefetched);
+        EXPECT_EQ(m_tile, record.m_tile);
+    }
+
+    class TileLoadCountingTexture
+      : public Texture
+    {
+      public:
+        size_t m_load_count;
+
+        TileLoadCountingTexture()
+          : Texture("texture", ParamArray())
+          , m_load_count(0)
+          , m_props(32, 16, 16, 16, 3, PixelFormatFloat)
+          , m_tile(16, 16, 3, PixelFormatFloat)
+        {
+            m_tile.clear(Color3f(0.5f));
+        }
+
+        void release() override
+        {
+            delete this;
+        }
+
+        const char* get_model() const override
+        {
+            return "tile_load_counting_texture";
+        }
+
+        ColorSpace get_color_space() const override
+        {
+            return ColorSpaceLinearRGB;
+        }
+
+        const CanvasProperties& properties() override
+        {
+            return m_props;
+        }
+
+        Source* create_source(
+            const UniqueID          assembly_uid,
+            const TextureInstance&  texture_instance) override
+        {
+            return nullptr;
+        }
+
+        Tile* load_tile(
+            const size_t            tile_x,
+            const size_t            tile_y) override
+        {
+            ++m_load_count;
+            return &m_tile;
+        }
+
+        void unload_tile(
+            const size_t            tile_x,
+            const size_t            tile_y,
+            const Tile*             tile) override
+        {
+        }
+
+      private:
+        const CanvasProperties  m_props;
+        Tile                    m_tile;
+    };
+
+    TEST_CASE(Prefetch_GivenTileAlreadyInStore_DoesNotLoadTileAgain)
+    {
+        auto_release_ptr<Scene> scene(SceneFactory::create());
+
+        TileLoadCountingTexture* texture = new TileLoadCountingTexture();
+        scene->textures().insert(auto_release_ptr<Texture>(texture));
+
+        TextureStore texture_store(scene.ref());
+        const TextureStore::TileKey key(~UniqueID(0), texture->get_uid(), 1, 0);
+
+        TextureStore::TileRecord& record = texture_store.acquire(key);
+        texture_store.release(record);
+
+        const bool prefetched = texture_store.prefetch(key);
+
+        EXPECT_TRUE(prefetched);
+        EXPECT_EQ(1, texture->m_load_count);
+    }
+
+    TEST_CASE_F(Prefetch_GivenFullStore_ReturnsFalse, Fixture)
+    {
+        TextureStore texture_store(m_scene.ref(), ParamArray().insert("max_size", 1));
+
+        const bool first_prefetched = texture_store.prefetch(TextureStore::TileKey(~UniqueID(0), m_texture_uid, 0, 0));
+        const bool second_prefetched = texture_store.prefetch(TextureStore::TileKey(~UniqueID(0), m_texture_uid, 1, 0));
+
+        EXPECT_TRUE(first_prefetched);
+        EXPECT_FALSE(second_prefetched);
+    }
+
+    struct SingleChannelFixture
+    {
+        auto_release_ptr<Scene>     m_scene;
+        UniqueID                    m_texture_uid;
+
+        SingleChannelFixture()
+          : m_scene(SceneFactory::create())
+        {
+            // 5x3 single-channel texture made of 2x2 tiles, texel (x, y) holds x + 10 * y.
+            auto_release_ptr<Image> image(new Image(5, 3, 2, 2, 1, PixelFormatFloat));
+
+            for (size_t y = 0; y < 3; ++y)
+            {
+                for (size_t x = 0; x < 5; ++x)
+                {
+                    const float value = static_cast<float>(x + 10 * y);
+                    image->set_pixel(x, y, &value);
+                }
+            }
+
+            auto_release_ptr<Texture> texture(
+                MemoryTexture2dFactory().create(
+                    "texture",
+                    ParamArray().insert("color_space", "linear_rgb"),
+                    image));
+            m_texture_uid = texture->get_uid();
+
+            m_scene->textures().insert(texture);
+        }
+
+        float get_texel(
+            TextureStore&   texture_store,
+            const size_t    level,
+            const size_t    x,
+            const size_t    y) const
+        {
+            TextureStore::TileRecord& record =
+                texture_store.acquire(
+                    TextureStore::TileKey(~UniqueID(0), m_texture_uid, x / 2, y / 2, level));
+
+            const float value = record.m_tile->get_component<float>(x % 2, y % 2, 0);
+
+            texture_store.release(record);
+
+            return value;
+        }
+    };
+
+    TEST_CASE_F(AcquireLevelTile_SingleChannelTexture_AveragesTexelsOfPreviousLevel, SingleChannelFixture)
+    {
+        TextureStore texture_store(m_scene.ref());
+
+        // Level 1 is 3x2. Texels on the right and bottom edges cover fewer texels of level 0.
+        EXPECT_FEQ(5.5f, get_texel(texture_store, 1, 0, 0));
+        EXPECT_FEQ(7.5f, get_texel(texture_store, 1, 1, 0));
+        EXPECT_FEQ(9.0f, get_texel(texture_store, 1, 2, 0));
+        EXPECT_FEQ(20.5f, get_texel(texture_store, 1, 0, 1));
+        EXPECT_FEQ(22.5f, get_texel(texture_store, 1, 1, 1));
+        EXPECT_FEQ(24.0f, get_texel(texture_store, 1, 2, 1));
+
+        // Level 2 is 2x1.
+        EXPECT_FEQ(14.0f, get_texel(texture_store, 2, 0, 0));
+        EXPECT_FEQ(16.5f, get_texel(texture_store, 2, 1, 0));
+
+        // Level 3 is 1x1.
+        EXPECT_FEQ(15.25f, get_texel(texture_store, 3, 0, 0));
+    }
+
+    TEST_CASE_F(AcquireLevelTile_NonPowerOfTwoTexture_ReturnsPartialEdgeTileWithTextureChannelCount, SingleChannelFixture)
+    {
+        TextureStore texture_store(m_scene.ref());
+
+        TextureStore::TileRecord& record =
+            texture_store.acquire(TextureStore::TileKey(~UniqueID(0), m_texture_uid, 1, 0, 1));
+        const Tile* tile = record.m_tile;
+        texture_store.release(record);
+
+        EXPECT_EQ(1, tile->get_width());
+        EXPECT_EQ(2, tile->get_height());
+        EXPECT_EQ(1, tile->get_channel_count());
+        EXPECT_EQ(PixelFormatFloat, tile->get_pixel_format());
+    }
+
+    TEST_CASE_F(AcquireLevelTile_Twice_ReturnsCachedTile, SingleChannelFixture)
+    {
+        TextureStore texture_store(m_scene.ref());
+        const TextureStore::TileKey key(~UniqueID(0), m_texture_uid, 0, 0, 2);
+
+        TextureStore::TileRecord& first_record = texture_store.acquire(key);
+        texture_store.release(first_record);
+
+        TextureStore::TileRecord& second_record = texture_store.acquire(key);
+        texture_store.release(second_record);
+
+        EXPECT_EQ(first_record.m_tile, second_record.m_tile);
+    }
+}
+
+TEST_SUITE(Renderer_Kernel_Texturing_MipmapLevels)
+{
+    TEST_CASE(ComputeMipmapLevels_NonPowerOfTwoTexture_HalvesResolutionDownTo1x1)
+    {
+        const CanvasProperties base_props(13, 5, 8, 8, 3, PixelFormatUInt8);
+
+        vector<CanvasProperties> levels;
+        compute_mipmap_levels(base_props, levels);
+
+        ASSERT_EQ(5, levels.size());
+        EXPECT_EQ(13, levels[0].m_canvas_width);
+        EXPECT_EQ(5, levels[0].m_canvas_height);
+        EXPECT_EQ(7, levels[1].m_canvas_width);
+        EXPECT_EQ(3, levels[1].m_canvas_height);
+        EXPECT_EQ(4, levels[2].m_canvas_width);
+        EXPECT_EQ(2, levels[2].m_canvas_height);
+        EXPECT_EQ(2, levels[3].m_canvas_width);
+        EXPECT_EQ(1, levels[3].m_canvas_height);
+        EXPECT_EQ(1, levels[4].m_canvas_width);
+        EXPECT_EQ(1, levels[4].m_canvas_height);
+    }
+
+    TEST_CASE(ComputeMipmapLevels_KeepsTilingAndUsesFloatPixelsForUpperLevels)
+    {
+        const CanvasProperties base_props(64, 64, 16, 16, 4, PixelFormatUInt8);
+
+        vector<CanvasProperties> levels;
+        compute_mipmap_levels(base_props, levels);
+
+        ASSERT_EQ(7, levels.size());
+        EXPECT_EQ(PixelFormatUInt8, levels[0].m_pixel_format);
+        EXPECT_EQ(PixelFormatFloat, levels[1].m_pixel_format);
+        EXPECT_EQ(16, levels[1].m_tile_width);
+        EXPECT_EQ(2, levels[1].m_tile_count_x);
+        EXPECT_EQ(1, levels[2].m_tile_count_x);
+        EXPECT_EQ(4, levels[1].m_channel_count);
     }
 }
@@ -405,6 +405,79 @@ TEST_SUITE(Renderer_Utility_TransformSequence)
         EXPECT_FEQ(expected, sequence.evaluate(2.0));
     }
 
+    struct SmallRotationFixture
+    {
+        TransformSequence   m_sequence;
+        TransformSequence   m_unsampled_sequence;
+
+        SmallRotationFixture()
+        {
+            const Vector3d axis = normalize(Vector3d(0.1, 0.2, 1.0));
+            m_sequence.set_transform(
+                0.0f,
+                Transformd::from_local_to_parent(
+                    Matrix4d::make_translation(Vector3d(1.0, 2.0, 3.0)) *
+                    Matrix4d::make_rotation(axis, 0.3)));
+            m_sequence.set_transform(
+                1.0f,
+                Transformd::from_local_to_parent(
+                    Matrix4d::make_translation(Vector3d(1.1, 2.0, 3.0)) *
+                    Matrix4d::make_rotation(axis, 0.3 + Pi<double>() / 360.0)));
+
+            m_unsampled_sequence = m_sequence;
+            m_unsampled_sequence.set_max_samples_per_segment(0);
+
+            // This motion needs more samples than the default maximum.
+            m_sequence.set_max_samples_per_segment(32);
+
+            m_sequence.prepare();
+            m_unsampled_sequence.prepare();
+        }
+    };
+
+    TEST_CASE_F(Evaluate_GivenSmallRotation_MatchesExactInterpolation, SmallRotationFixture)
+    {
+        for (size_t i = 0; i <= 100; ++i)
+        {
+            const float time = i / 100.0f;
+            const Transformd expected = m_unsampled_sequence.evaluate(time);
+            const Transformd result = m_sequence.evaluate(time);
+
+            EXPECT_FEQ_EPS(expected.get_local_to_parent(), result.get_local_to_parent(), 1.0e-6);
+            EXPECT_FEQ_EPS(expected.get_parent_to_local(), result.get_parent_to_local(), 1.0e-6);
+        }
+    }
+
+    TEST_CASE_F(CopyConstructor_CopiesTimeSamples, SmallRotationFixture)
+    {
+        const TransformSequence copy(m_sequence);
+
+        EXPECT_EQ(m_sequence.evaluate(0.3f), copy.evaluate(0.3f));
+    }
+
+    TEST_CASE_F(GetSampleMemorySize_GivenSampledSequence_AccountsForAllSamples, SmallRotationFixture)
+    {
+        const TransformSequence copy(m_sequence);
+
+        EXPECT_LT(0, m_sequence.get_sample_memory_size());
+        EXPECT_EQ(m_sequence.get_sample_memory_size(), copy.get_sample_memory_size());
+        EXPECT_EQ(0, m_unsampled_sequence.get_sample_memory_size());
+    }
+
+    TEST_CASE(GetSampleMemorySize_GivenMotionExceedingDefaultMaximum_ReturnsNoSamples)
+    {
+        TransformSequence sequence;
+        sequence.set_transform(
+            0.0f,
+            Transformd::from_local_to_parent(Matrix4d::make_rotation_z(0.0)));
+        sequence.set_transform(
+            1.0f,
+            Transformd::from_local_to_parent(Matrix4d::make_rotation_z(Pi<double>() / 2.0)));
+        sequence.prepare();
+
+        EXPECT_GT(sizeof(Transformd), sequence.get_sample_memory_size());
+    }
+
     TEST_CASE(CompositionOperator_GivenTwoEmptyTransformSequences_ReturnsEmptyTransformSequence)
     {
         TransformSequence seq1, seq2;
@@ -31,11 +31,7 @@
 
 // appleseed.renderer headers.
 #include "renderer/kernel/aov/aovaccumulator.h"
-#include "renderer/kernel/aov/aovcomponents.h"
-#include "renderer/kernel/shading/shadingcomponents.h"
-#include "renderer/kernel/shading/shadingresult.h"
 #include "renderer/modeling/aov/aov.h"
-#include "renderer/modeling/color/colorspace.h"
 
 // appleseed.foundation headers.
 #include "foundation/image/color.h"
@@ -54,37 +50,6 @@ namespace renderer
 
 namespace
 {
-    //
-    // Albedo AOV accumulator.
-    //
-
-    class AlbedoAOVAccumulator
-      : public AOVAccumulator
-    {
-      public:
-        explicit AlbedoAOVAccumulator(const size_t index)
-          : m_index(index)
-        {
-        }
-
-        void write(
-            const PixelContext&         pixel_context,
-            const ShadingPoint&         shading_point,
-            const ShadingComponents&    shading_components,
-            const AOVComponents&        aov_components,
-            ShadingResult&              shading_result) override
-        {
-            shading_result.m_aovs[m_index].rgb() =
-                aov_components.m_albedo.to_rgb(g_std_lighting_conditions);
-
-            shading_result.m_aovs[m_index].a = shading_result.m_main.a;
-        }
-
-      private:
-        const size_t m_index;
-    };
-
-
     //
     // Albedo AOV.
     //
@@ -113,7 +78,9 @@ namespace
         auto_release_ptr<AOVAccumulator> create_accumulator() const override
         {
             return auto_release_ptr<AOVAccumulator>(
-                new AlbedoAOVAccumulator(m_image_index));
+                new ComponentAOVAccumulator(
+                    m_image_index,
+                    ComponentAOVAccumulator::Albedo));
         }
     };
 }
@@ -39,6 +39,7 @@
 #include "renderer/modeling/aov/glossyaov.h"
 #include "renderer/modeling/aov/normalaov.h"
 #include "renderer/modeling/aov/npraovs.h"
+#include "renderer/modeling/aov/pixelcostaov.h"
 #include "renderer/modeling/aov/pixeltimeaov.h"
 #include "renderer/modeling/aov/positionaov.h"
 #include "renderer/modeling/aov/uvaov.h"
@@ -96,6 +97,7 @@ void AOVFactoryRegistrar::reinitialize(const SearchPaths& search_paths)
     register_factory(auto_release_ptr<FactoryType>(new NormalAOVFactory()));
     register_factory(auto_release_ptr<FactoryType>(new NPRContourAOVFactory()));
     register_factory(auto_release_ptr<FactoryType>(new NPRShadingAOVFactory()));
+    register_factory(auto_release_ptr<FactoryType>(new PixelCostAOVFactory()));
     register_factory(auto_release_ptr<FactoryType>(new PixelSampleCountAOVFactory()));
     register_factory(auto_release_ptr<FactoryType>(new PixelTimeAOVFactory()));
     register_factory(auto_release_ptr<FactoryType>(new PixelVariationAOVFactory()));
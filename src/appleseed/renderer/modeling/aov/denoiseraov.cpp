@@ -409,54 +409,103 @@ void DenoiserAOV::compute_covariances_image(Deepimf& covariances) const
     covariances.resize(w, h, 6);
     covariances.fill(0.0f);
 
-    const int samples_channel_index = static_cast<int>(impl->m_num_bins * 3);
+    for (int j = 0; j < h; ++j)
+    {
+        for (int i = 0; i < w; ++i)
+            compute_pixel_covariances(j, i, covariances, j, i);
+    }
+}
 
-    const size_t c_xx = static_cast<size_t>(ESymmetricMatrix3x3Data::e_xx);
-    const size_t c_yy = static_cast<size_t>(ESymmetricMatrix3x3Data::e_yy);
-    const size_t c_zz = static_cast<size_t>(ESymmetricMatrix3x3Data::e_zz);
-    const size_t c_yz = static_cast<size_t>(ESymmetricMatrix3x3Data::e_yz);
-    const size_t c_xz = static_cast<size_t>(ESymmetricMatrix3x3Data::e_xz);
-    const size_t c_xy = static_cast<size_t>(ESymmetricMatrix3x3Data::e_xy);
+void DenoiserAOV::extract_region(
+    const AABB2u&           region,
+    Deepimf&                num_samples,
+    Deepimf&                histograms,
+    Deepimf&                covariances) const
+{
+    const int x0 = static_cast<int>(region.min.x);
+    const int y0 = static_cast<int>(region.min.y);
+    const int w = static_cast<int>(region.extent(0) + 1);
+    const int h = static_cast<int>(region.extent(1) + 1);
+
+    const int num_bins = static_cast<int>(impl->m_num_bins);
+    const int samples_channel_index = num_bins * 3;
+    const int channel_count = impl->m_histograms.getDepth();
+
+    num_samples.resize(w, h, 1);
+    histograms.resize(w, h, channel_count);
+    covariances.resize(w, h, 6);
+    covariances.fill(0.0f);
 
     for (int j = 0; j < h; ++j)
     {
         for (int i = 0; i < w; ++i)
         {
-            const float sample_count = impl->m_histograms.get(j, i, samples_channel_index);
+            for (int c = 0; c < channel_count; ++c)
+                histograms.get(j, i, c) = impl->m_histograms.get(y0 + j, x0 + i, c);
 
-            if (sample_count != 0.0f)
+            if (histograms.get(j, i, samples_channel_index) == 0.0f)
             {
-                const float rcp_sample_count = 1.0f / sample_count;
-
-                const float bias_correction_factor =
-                    sample_count == 1.0f
-                        ? 1.0f
-                        : 1.0f / (1.0f - rcp_sample_count);
-
-                // Compute the mean.
-                float mean[3];
-                for (int k = 0; k < 3; ++k)
-                    mean[k] = impl->m_sum_accum.get(j, i, k) * rcp_sample_count;
-
-                // Compute the covariances.
-                const float xx = impl->m_covariance_accum.get(j, i, c_xx);
-                const float yy = impl->m_covariance_accum.get(j, i, c_yy);
-                const float zz = impl->m_covariance_accum.get(j, i, c_zz);
-                const float yz = impl->m_covariance_accum.get(j, i, c_yz);
-                const float xz = impl->m_covariance_accum.get(j, i, c_xz);
-                const float xy = impl->m_covariance_accum.get(j, i, c_xy);
-
-                covariances.get(j, i, c_xx) = (xx * rcp_sample_count - mean[0] * mean[0]) * bias_correction_factor;
-                covariances.get(j, i, c_yy) = (yy * rcp_sample_count - mean[1] * mean[1]) * bias_correction_factor;
-                covariances.get(j, i, c_zz) = (zz * rcp_sample_count - mean[2] * mean[2]) * bias_correction_factor;
-                covariances.get(j, i, c_yz) = (yz * rcp_sample_count - mean[1] * mean[2]) * bias_correction_factor;
-                covariances.get(j, i, c_xz) = (xz * rcp_sample_count - mean[0] * mean[2]) * bias_correction_factor;
-                covariances.get(j, i, c_xy) = (xy * rcp_sample_count - mean[0] * mean[1]) * bias_correction_factor;
+                histograms.get(j, i, 0) = 1.0f;
+                histograms.get(j, i, num_bins) = 1.0f;
+                histograms.get(j, i, num_bins * 2) = 1.0f;
+                histograms.get(j, i, samples_channel_index) = 1.0f;
             }
+
+            num_samples.get(j, i, 0) = histograms.get(j, i, samples_channel_index);
+
+            compute_pixel_covariances(y0 + j, x0 + i, covariances, j, i);
         }
     }
 }
 
+void DenoiserAOV::compute_pixel_covariances(
+    const int               src_line,
+    const int               src_column,
+    Deepimf&                covariances,
+    const int               dst_line,
+    const int               dst_column) const
+{
+    const int samples_channel_index = static_cast<int>(impl->m_num_bins * 3);
+    const float sample_count = impl->m_histograms.get(src_line, src_column, samples_channel_index);
+
+    if (sample_count == 0.0f)
+        return;
+
+    const size_t c_xx = static_cast<size_t>(ESymmetricMatrix3x3Data::e_xx);
+    const size_t c_yy = static_cast<size_t>(ESymmetricMatrix3x3Data::e_yy);
+    const size_t c_zz = static_cast<size_t>(ESymmetricMatrix3x3Data::e_zz);
+    const size_t c_yz = static_cast<size_t>(ESymmetricMatrix3x3Data::e_yz);
+    const size_t c_xz = static_cast<size_t>(ESymmetricMatrix3x3Data::e_xz);
+    const size_t c_xy = static_cast<size_t>(ESymmetricMatrix3x3Data::e_xy);
+
+    const float rcp_sample_count = 1.0f / sample_count;
+
+    const float bias_correction_factor =
+        sample_count == 1.0f
+            ? 1.0f
+            : 1.0f / (1.0f - rcp_sample_count);
+
+    // Compute the mean.
+    float mean[3];
+    for (int k = 0; k < 3; ++k)
+        mean[k] = impl->m_sum_accum.get(src_line, src_column, k) * rcp_sample_count;
+
+    // Compute the covariances.
+    const float xx = impl->m_covariance_accum.get(src_line, src_column, c_xx);
+    const float yy = impl->m_covariance_accum.get(src_line, src_column, c_yy);
+    const float zz = impl->m_covariance_accum.get(src_line, src_column, c_zz);
+    const float yz = impl->m_covariance_accum.get(src_line, src_column, c_yz);
+    const float xz = impl->m_covariance_accum.get(src_line, src_column, c_xz);
+    const float xy = impl->m_covariance_accum.get(src_line, src_column, c_xy);
+
+    covariances.get(dst_line, dst_column, c_xx) = (xx * rcp_sample_count - mean[0] * mean[0]) * bias_correction_factor;
+    covariances.get(dst_line, dst_column, c_yy) = (yy * rcp_sample_count - mean[1] * mean[1]) * bias_correction_factor;
+    covariances.get(dst_line, dst_column, c_zz) = (zz * rcp_sample_count - mean[2] * mean[2]) * bias_correction_factor;
+    covariances.get(dst_line, dst_column, c_yz) = (yz * rcp_sample_count - mean[1] * mean[2]) * bias_correction_factor;
+    covariances.get(dst_line, dst_column, c_xz) = (xz * rcp_sample_count - mean[0] * mean[2]) * bias_correction_factor;
+    covariances.get(dst_line, dst_column, c_xy) = (xy * rcp_sample_count - mean[0] * mean[1]) * bias_correction_factor;
+}
+
 bool DenoiserAOV::write_images(const char* file_path) const
 {
     fill_empty_samples();
@@ -33,6 +33,7 @@
 #include "renderer/modeling/aov/aov.h"
 
 // appleseed.foundation headers.
+#include "foundation/math/aabb.h"
 #include "foundation/utility/autoreleaseptr.h"
 
 // BCD headers.
@@ -85,6 +86,14 @@ class DenoiserAOV
     void extract_num_samples_image(bcd::Deepimf& num_samples) const;
     void compute_covariances_image(bcd::Deepimf& covariances) const;
 
+    // Extract the denoiser inputs for a rectangular region of the frame (inclusive pixel bounds).
+    // Unlike fill_empty_samples(), pixels without samples are only filled in the extracted copies.
+    void extract_region(
+        const foundation::AABB2u&   region,
+        bcd::Deepimf&               num_samples,
+        bcd::Deepimf&               histograms,
+        bcd::Deepimf&               covariances) const;
+
     bool write_images(const char* file_path) const;
 
   private:
@@ -96,6 +105,13 @@ class DenoiserAOV
     DenoiserAOV(
         const float  max_hist_value,
         const size_t num_bins);
+
+    void compute_pixel_covariances(
+        const int       src_line,
+        const int       src_column,
+        bcd::Deepimf&   covariances,
+        const int       dst_line,
+        const int       dst_column) const;
 };
 
 
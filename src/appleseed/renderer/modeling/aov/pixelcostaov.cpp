@@ -0,0 +1,435 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2018 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// Interface header.
+#include "pixelcostaov.h"
+
+// appleseed.renderer headers.
+#include "renderer/global/globallogger.h"
+#include "renderer/kernel/aov/aovaccumulator.h"
+#include "renderer/kernel/rendering/costtracker.h"
+#include "renderer/kernel/rendering/pixelcontext.h"
+#include "renderer/modeling/aov/aov.h"
+#include "renderer/modeling/frame/frame.h"
+#include "renderer/modeling/shadergroup/shadergroup.h"
+
+// appleseed.foundation headers.
+#include "foundation/image/canvasproperties.h"
+#include "foundation/image/image.h"
+#include "foundation/image/tile.h"
+#include "foundation/utility/api/apistring.h"
+#include "foundation/utility/api/specializedapiarrays.h"
+#include "foundation/utility/containers/dictionary.h"
+#include "foundation/utility/string.h"
+
+// Boost headers.
+#include "boost/thread/locks.hpp"
+#include "boost/thread/mutex.hpp"
+
+// Standard headers.
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace foundation;
+using namespace std;
+
+namespace renderer
+{
+
+namespace
+{
+    const size_t CategoryCount = CostTracker::CategoryCount;
+
+    // Number of shader groups listed in the frame summary.
+    const size_t MaxReportedShaderGroupCount = 10;
+
+    string format_cost_breakdown(
+        const uint64                cycles[CategoryCount],
+        const double                rcp_frequency)
+    {
+        uint64 total = 0;
+        for (size_t i = 0; i < CategoryCount; ++i)
+            total += cycles[i];
+
+        string result = pretty_time(total * rcp_frequency, 3);
+
+        for (size_t i = 0; i < CategoryCount; ++i)
+        {
+            result += ", ";
+            result += CostTracker::get_category_name(i);
+            result += " ";
+            result += pretty_percent(cycles[i], total);
+        }
+
+        return result;
+    }
+
+
+    //
+    // Frame-wide cost statistics, shared by all accumulators of a pixel cost AOV.
+    //
+
+    class CostStatistics
+    {
+      public:
+        explicit CostStatistics(const double rcp_frequency)
+          : m_rcp_frequency(rcp_frequency)
+        {
+            clear();
+        }
+
+        double get_rcp_frequency() const
+        {
+            return m_rcp_frequency;
+        }
+
+        void clear()
+        {
+            boost::mutex::scoped_lock lock(m_mutex);
+
+            fill(m_cycles, m_cycles + CategoryCount, uint64(0));
+            m_shader_group_cycles.clear();
+        }
+
+        void merge(
+            const uint64            cycles[CategoryCount],
+            const ShaderGroup*      shader_groups[],
+            const uint64            shader_group_cycles[],
+            const size_t            shader_group_count)
+        {
+            boost::mutex::scoped_lock lock(m_mutex);
+
+            for (size_t i = 0; i < CategoryCount; ++i)
+                m_cycles[i] += cycles[i];
+
+            for (size_t i = 0; i < shader_group_count; ++i)
+                m_shader_group_cycles[shader_groups[i]] += shader_group_cycles[i];
+        }
+
+        void print() const
+        {
+            boost::mutex::scoped_lock lock(m_mutex);
+
+            RENDERER_LOG_INFO(
+                "pixel cost: %s.",
+                format_cost_breakdown(m_cycles, m_rcp_frequency).c_str());
+
+            // Sort shader groups by decreasing cost.
+            vector<pair<uint64, const ShaderGroup*>> shader_groups;
+            shader_groups.reserve(m_shader_group_cycles.size());
+            for (const auto& entry : m_shader_group_cycles)
+                shader_groups.emplace_back(entry.second, entry.first);
+            sort(shader_groups.rbegin(), shader_groups.rend());
+
+            const size_t count = min(shader_groups.size(), MaxReportedShaderGroupCount);
+            for (size_t i = 0; i < count; ++i)
+            {
+                const ShaderGroup* shader_group = shader_groups[i].second;
+                RENDERER_LOG_INFO(
+                    "  shader group %s: %s",
+                    shader_group ? shader_group->get_path().c_str() : "(others)",
+                    pretty_time(shader_groups[i].first * m_rcp_frequency, 3).c_str());
+            }
+        }
+
+      private:
+        const double                            m_rcp_frequency;
+        mutable boost::mutex                    m_mutex;
+        uint64                                  m_cycles[CategoryCount];
+        map<const ShaderGroup*, uint64>         m_shader_group_cycles;
+    };
+
+
+    //
+    // Pixel cost AOV accumulator.
+    //
+
+    class PixelCostAOVAccumulator
+      : public AOVAccumulator
+    {
+      public:
+        PixelCostAOVAccumulator(
+            Image&                  image,
+            CostStatistics&         statistics)
+          : m_image(image)
+          , m_statistics(statistics)
+          , m_scale(static_cast<float>(statistics.get_rcp_frequency() * 1.0e6))
+        {
+        }
+
+        void on_tile_begin(
+            const Frame&                frame,
+            const size_t                tile_x,
+            const size_t                tile_y,
+            const size_t                max_spp) override
+        {
+            // Fetch the destination tile.
+            const CanvasProperties& props = frame.image().properties();
+            m_tile = &m_image.tile(tile_x, tile_y);
+
+            // Fetch the tile bounds (inclusive).
+            m_tile_origin_x = static_cast<int>(tile_x * props.m_tile_width);
+            m_tile_origin_y = static_cast<int>(tile_y * props.m_tile_height);
+            m_tile_end_x = static_cast<int>(m_tile_origin_x + m_tile->get_width());
+            m_tile_end_y = static_cast<int>(m_tile_origin_y + m_tile->get_height());
+
+            fill(m_tile_cycles, m_tile_cycles + CategoryCount, uint64(0));
+
+            CostTracker::start_tracking();
+        }
+
+        void on_tile_end(
+            const Frame&                frame,
+            const size_t                tile_x,
+            const size_t                tile_y) override
+        {
+            uint64 cycles[CategoryCount];
+            CostTracker::fetch_cycles(cycles);
+
+            for (size_t i = 0; i < CategoryCount; ++i)
+                m_tile_cycles[i] += cycles[i];
+
+            const ShaderGroup* shader_groups[CostTracker::MaxShaderGroupCount];
+            uint64 shader_group_cycles[CostTracker::MaxShaderGroupCount];
+            const size_t shader_group_count =
+                CostTracker::fetch_shader_group_cycles(shader_groups, shader_group_cycles);
+
+            CostTracker::stop_tracking();
+
+            m_statistics.merge(
+                m_tile_cycles,
+                shader_groups,
+                shader_group_cycles,
+                shader_group_count);
+
+            RENDERER_LOG_DEBUG(
+                "tile (" FMT_SIZE_T ", " FMT_SIZE_T ") cost: %s.",
+                tile_x,
+                tile_y,
+                format_cost_breakdown(m_tile_cycles, m_statistics.get_rcp_frequency()).c_str());
+        }
+
+        void on_pixel_begin(const Vector2i& pi) override
+        {
+            fill(m_pixel_cycles, m_pixel_cycles + CategoryCount, uint64(0));
+        }
+
+        void on_pixel_end(const Vector2i& pi) override
+        {
+            if (outside_tile(pi))
+                return;
+
+            float* p = reinterpret_cast<float*>(
+                m_tile->pixel(pi.x - m_tile_origin_x, pi.y - m_tile_origin_y));
+
+            for (size_t i = 0; i < CategoryCount; ++i)
+                p[i] += static_cast<float>(m_pixel_cycles[i]) * m_scale;
+        }
+
+        void on_sample_begin(const PixelContext& pixel_context) override
+        {
+            // Charge the work done between samples to the tile only.
+            uint64 cycles[CategoryCount];
+            CostTracker::fetch_cycles(cycles);
+
+            for (size_t i = 0; i < CategoryCount; ++i)
+                m_tile_cycles[i] += cycles[i];
+        }
+
+        void on_sample_end(const PixelContext& pixel_context) override
+        {
+            uint64 cycles[CategoryCount];
+            CostTracker::fetch_cycles(cycles);
+
+            for (size_t i = 0; i < CategoryCount; ++i)
+                m_tile_cycles[i] += cycles[i];
+
+            // Only collect samples inside the tile.
+            if (!outside_tile(pixel_context.get_pixel_coords()))
+            {
+                for (size_t i = 0; i < CategoryCount; ++i)
+                    m_pixel_cycles[i] += cycles[i];
+            }
+        }
+
+      private:
+        Image&                              m_image;
+        CostStatistics&                     m_statistics;
+        const float                         m_scale;
+        foundation::Tile*                   m_tile;
+
+        int                                 m_tile_origin_x;
+        int                                 m_tile_origin_y;
+        int                                 m_tile_end_x;
+        int                                 m_tile_end_y;
+
+        uint64                              m_tile_cycles[CategoryCount];
+        uint64                              m_pixel_cycles[CategoryCount];
+
+        bool outside_tile(const Vector2i& pi) const
+        {
+            return
+                pi.x < m_tile_origin_x ||
+                pi.y < m_tile_origin_y ||
+                pi.x >= m_tile_end_x ||
+                pi.y >= m_tile_end_y;
+        }
+    };
+
+
+    //
+    // Pixel cost AOV.
+    //
+
+    const char* PixelCostAOVModel = "pixel_cost_aov";
+
+    class PixelCostAOV
+      : public AOV
+    {
+      public:
+        explicit PixelCostAOV(const ParamArray& params)
+          : AOV("pixel_cost", params)
+          , m_statistics(new CostStatistics(1.0 / CostTracker::measure_frequency()))
+        {
+        }
+
+        void release() override
+        {
+            delete this;
+        }
+
+        const char* get_model() const override
+        {
+            return PixelCostAOVModel;
+        }
+
+        size_t get_channel_count() const override
+        {
+            return CategoryCount;
+        }
+
+        const char** get_channel_names() const override
+        {
+            static const char* ChannelNames[] =
+            {
+                "Traversal",
+                "Shading",
+                "TextureFetch",
+                "LightSampling",
+                "Volume",
+                "Other"
+            };
+            return ChannelNames;
+        }
+
+        bool has_color_data() const override
+        {
+            return false;
+        }
+
+        void create_image(
+            const size_t canvas_width,
+            const size_t canvas_height,
+            const size_t tile_width,
+            const size_t tile_height,
+            ImageStack&  aov_images) override
+        {
+            m_image =
+                new Image(
+                    canvas_width,
+                    canvas_height,
+                    tile_width,
+                    tile_height,
+                    get_channel_count(),
+                    PixelFormatFloat);
+        }
+
+        void clear_image() override
+        {
+            m_image->clear(Color<float, CategoryCount>(0.0f));
+            m_statistics->clear();
+        }
+
+        void post_process_image(const AABB2u& crop_window) override
+        {
+            m_statistics->print();
+        }
+
+        auto_release_ptr<AOVAccumulator> create_accumulator() const override
+        {
+            return
+                auto_release_ptr<AOVAccumulator>(
+                    new PixelCostAOVAccumulator(get_image(), *m_statistics));
+        }
+
+      private:
+        unique_ptr<CostStatistics> m_statistics;
+    };
+}
+
+
+//
+// PixelCostAOVFactory class implementation.
+//
+
+void PixelCostAOVFactory::release()
+{
+    delete this;
+}
+
+const char* PixelCostAOVFactory::get_model() const
+{
+    return PixelCostAOVModel;
+}
+
+Dictionary PixelCostAOVFactory::get_model_metadata() const
+{
+    return
+        Dictionary()
+            .insert("name", PixelCostAOVModel)
+            .insert("label", "Pixel Cost");
+}
+
+DictionaryArray PixelCostAOVFactory::get_input_metadata() const
+{
+    DictionaryArray metadata;
+    return metadata;
+}
+
+auto_release_ptr<AOV> PixelCostAOVFactory::create(
+    const ParamArray&   params) const
+{
+    return auto_release_ptr<AOV>(new PixelCostAOV(params));
+}
+
+}   // namespace renderer
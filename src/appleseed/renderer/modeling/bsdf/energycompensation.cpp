@@ -37,6 +37,9 @@
 #include "foundation/image/tile.h"
 #include "foundation/math/scalar.h"
 #include "foundation/math/vector.h"
+#ifdef APPLESEED_USE_SSE
+#include "foundation/platform/sse.h"
+#endif
 
 // Boost headers.
 #include "boost/filesystem/fstream.hpp"
@@ -176,6 +179,60 @@ float AlbedoTable2D::get_directional_albedo(const float cos_theta, const float r
     return lerp(lerp(a, b, s), lerp(c, d, s), t);
 }
 
+void AlbedoTable2D::get_directional_albedos(
+    const float     cos_theta0,
+    const float     cos_theta1,
+    const float     roughness,
+    float&          albedo0,
+    float&          albedo1) const
+{
+    assert(cos_theta0 >= 0.0f);
+    assert(cos_theta0 <= 1.0f);
+    assert(cos_theta1 >= 0.0f);
+    assert(cos_theta1 <= 1.0f);
+    assert(roughness >= 0.0f);
+    assert(roughness <= 1.0f);
+
+    // Compute the bilinear weights. Both lookups share the same rows.
+    const float x0 = cos_theta0 * (TableSize - 1);
+    const float x1 = cos_theta1 * (TableSize - 1);
+    const float y = roughness * (TableSize - 1);
+
+    size_t i0, i1, j;
+    const float s0 = floor_frac(x0, i0);
+    const float s1 = floor_frac(x1, i1);
+    const float t = floor_frac(y, j);
+
+    const size_t i01 = min(i0 + 1, TableSize - 1);
+    const size_t i11 = min(i1 + 1, TableSize - 1);
+    const size_t j1 = min(j + 1, TableSize - 1);
+
+    const float* row0 = m_albedo_table + j * TableSize;
+    const float* row1 = m_albedo_table + j1 * TableSize;
+
+#ifdef APPLESEED_USE_SSE
+
+    // Interpolate along cos(theta) for both lookups and both rows at once.
+    // Lanes hold (lookup 0, row 0), (lookup 1, row 0), (lookup 0, row 1), (lookup 1, row 1).
+    const __m128 lo = _mm_set_ps(row1[i1], row1[i0], row0[i1], row0[i0]);
+    const __m128 hi = _mm_set_ps(row1[i11], row1[i01], row0[i11], row0[i01]);
+    const __m128 ms = _mm_set_ps(s1, s0, s1, s0);
+    const __m128 u = _mm_add_ps(lo, _mm_mul_ps(ms, _mm_sub_ps(hi, lo)));
+
+    // Interpolate along roughness.
+    const __m128 v = _mm_add_ps(u, _mm_mul_ps(_mm_set1_ps(t), _mm_sub_ps(_mm_movehl_ps(u, u), u)));
+
+    albedo0 = _mm_cvtss_f32(v);
+    albedo1 = _mm_cvtss_f32(_mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)));
+
+#else
+
+    albedo0 = lerp(lerp(row0[i0], row0[i01], s0), lerp(row1[i0], row1[i01], s0), t);
+    albedo1 = lerp(lerp(row0[i1], row0[i11], s1), lerp(row1[i1], row1[i11], s1), t);
+
+#endif
+}
+
 float AlbedoTable2D::get_average_albedo(const float roughness) const
 {
     assert(roughness >= 0.0f);
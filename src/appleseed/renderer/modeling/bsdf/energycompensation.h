@@ -50,6 +50,14 @@ class AlbedoTable2D
     // Return the directional albedo.
     float get_directional_albedo(const float cos_theta, const float roughness) const;
 
+    // Return the directional albedo for two directions and the same roughness.
+    void get_directional_albedos(
+        const float     cos_theta0,
+        const float     cos_theta1,
+        const float     roughness,
+        float&          albedo0,
+        float&          albedo1) const;
+
     // Return the average albedo.
     float get_average_albedo(const float roughness) const;
 
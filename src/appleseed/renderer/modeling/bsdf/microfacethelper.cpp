@@ -201,8 +201,8 @@ namespace
             return;
         }
 
-        const float eo = table.get_directional_albedo(abs(cos_on), roughness);
-        const float ei = table.get_directional_albedo(abs(cos_in), roughness);
+        float eo, ei;
+        table.get_directional_albedos(abs(cos_on), abs(cos_in), roughness, eo, ei);
         fms = ((1.0f - eo) * (1.0f - ei)) / (Pi<float>() * (1.0f - eavg));
     }
 }
@@ -47,6 +47,10 @@
 
 // Forward declarations.
 namespace foundation    { class Arena; }
+namespace foundation    { class IAbortSwitch; }
+namespace renderer      { class BaseGroup; }
+namespace renderer      { class OnFrameBeginRecorder; }
+namespace renderer      { class Project; }
 
 using namespace foundation;
 using namespace std;
@@ -88,6 +92,20 @@ namespace
             return Model;
         }
 
+        bool on_frame_begin(
+            const Project&          project,
+            const BaseGroup*        parent,
+            OnFrameBeginRecorder&   recorder,
+            IAbortSwitch*           abort_switch) override
+        {
+            if (!DipoleBSSRDF::on_frame_begin(project, parent, recorder, abort_switch))
+                return false;
+
+            prepare_alpha_prime_table<ComputeRdBetterDipole>();
+
+            return true;
+        }
+
         void prepare_inputs(
             Arena&                  arena,
             const ShadingPoint&     shading_point,
@@ -34,6 +34,7 @@
 #include "renderer/modeling/bssrdf/separablebssrdf.h"
 #include "renderer/modeling/bssrdf/sss.h"
 #include "renderer/modeling/input/inputarray.h"
+#include "renderer/modeling/input/source.h"
 
 // appleseed.foundation headers.
 #include "foundation/math/vector.h"
@@ -134,13 +135,19 @@ class DipoleBSSRDF
         Spectrum&                   value) const override;
 
   protected:
+    // Tabulate the inverse of Rd(alpha') if the index of refraction is uniform.
+    // Must be called from on_frame_begin() by models relying on Rd(alpha').
+    template <typename ComputeRdFun>
+    void prepare_alpha_prime_table();
+
     template <typename ComputeRdFun>
     void do_prepare_inputs(
         const ShadingPoint&         shading_point,
         DipoleBSSRDFInputValues*    values) const;
 
   protected:
-    bool m_has_sigma_sources;
+    bool            m_has_sigma_sources;
+    AlphaPrimeTable m_alpha_prime_table;
 };
 
 
@@ -161,6 +168,26 @@ inline bool DipoleBSSRDF::on_frame_begin(
     return true;
 }
 
+template <typename ComputeRdFun>
+void DipoleBSSRDF::prepare_alpha_prime_table()
+{
+    if (m_has_sigma_sources)
+        return;
+
+    const Source* ior_source = m_inputs.source("ior");
+    if (ior_source == nullptr || !ior_source->is_uniform())
+        return;
+
+    float ior;
+    ior_source->evaluate_uniform(ior);
+
+    // The table is built for a medium surrounded by air, by far the most common case.
+    // It is kept across frames and only rebuilt when the index of refraction changes.
+    const float eta = 1.0f / ior;
+    if (m_alpha_prime_table.get_eta() != eta)
+        m_alpha_prime_table.initialize<ComputeRdFun>(eta);
+}
+
 template <typename ComputeRdFun>
 void DipoleBSSRDF::do_prepare_inputs(
     const ShadingPoint&             shading_point,
@@ -190,14 +217,26 @@ void DipoleBSSRDF::do_prepare_inputs(
         foundation::clamp_in_place(values->m_reflectance, 0.001f, 0.999f);
         foundation::clamp_low_in_place(values->m_mfp, 1.0e-6f);
 
-        // Compute sigma_a and sigma_s.
-        const ComputeRdFun rd_fun(values->m_base_values.m_eta);
-        compute_absorption_and_scattering_mfp(
-            rd_fun,
-            values->m_reflectance,
-            values->m_mfp,
-            values->m_sigma_a,
-            values->m_sigma_s);
+        // Compute sigma_a and sigma_s, using the tabulated inverse of Rd(alpha') when possible.
+        if (m_alpha_prime_table.get_eta() == values->m_base_values.m_eta)
+        {
+            compute_absorption_and_scattering_mfp(
+                m_alpha_prime_table,
+                values->m_reflectance,
+                values->m_mfp,
+                values->m_sigma_a,
+                values->m_sigma_s);
+        }
+        else
+        {
+            const ComputeRdFun rd_fun(values->m_base_values.m_eta);
+            compute_absorption_and_scattering_mfp(
+                rd_fun,
+                values->m_reflectance,
+                values->m_mfp,
+                values->m_sigma_a,
+                values->m_sigma_s);
+        }
     }
 
     //
@@ -36,6 +36,7 @@
 #include "foundation/math/scalar.h"
 
 // Standard headers.
+#include <algorithm>
 #include <cmath>
 
 using namespace foundation;
@@ -185,32 +186,6 @@ float normalized_diffusion_profile(
 
 namespace
 {
-    const size_t NDCDFTableSize = 32;
-    const float NDCDFTableRmax = 35.0f;
-
-    float g_nd_cdf_table[NDCDFTableSize];
-    float g_nd_cdf_rmax;
-
-    struct InitializeNDCDFTable
-    {
-        InitializeNDCDFTable()
-        {
-            for (size_t i = 0; i < NDCDFTableSize; ++i)
-            {
-                const float r = fit<size_t, float>(i, 0, NDCDFTableSize - 1, 0.0f, NDCDFTableRmax);
-                g_nd_cdf_table[i] = normalized_diffusion_cdf(r, 1.0f);
-            }
-
-            // Save the real value of cdf(Rmax, 1).
-            g_nd_cdf_rmax = g_nd_cdf_table[NDCDFTableSize - 1];
-
-            // Make sure the last value is exactly 1.
-            g_nd_cdf_table[NDCDFTableSize - 1] = 1.0f;
-        }
-    };
-
-    InitializeNDCDFTable initialize_nd_cdf_table;
-
     struct NDCDFFun
     {
         const float m_d;
@@ -226,6 +201,7 @@ namespace
         }
     };
 
+    // Derivative of cdf(r, d) with respect to r, i.e. the radial density 2 * Pi * r * R(r).
     struct NDPDFFun
     {
         const float m_d;
@@ -237,9 +213,55 @@ namespace
 
         float operator()(const float r) const
         {
-            return normalized_diffusion_pdf(r, m_d);
+            const float exp_r3 = exp(-r / (3.0f * m_d));
+            return (cube(exp_r3) + exp_r3) / (4.0f * m_d);
+        }
+    };
+
+    //
+    // Tabulated inverse of cdf(r, 1), the CDF of r * R(r) for d = 1.
+    //
+    // Entry i holds the radius r such that cdf(r, 1) = i / (size - 1) * cdf(Rmax, 1).
+    // Since cdf(r, d) == cdf(r/d, 1), the table provides a tight interval and a good
+    // initial guess for the root of cdf(r, d) - u = 0 for any d, such that sampling
+    // only needs one or two refinement steps instead of a full root search.
+    //
+
+    const size_t NDInvCDFTableSize = 256;
+    const float NDCDFTableRmax = 35.0f;
+
+    float g_nd_inv_cdf_table[NDInvCDFTableSize];
+    float g_nd_cdf_rmax;
+
+    struct InitializeNDInvCDFTable
+    {
+        InitializeNDInvCDFTable()
+        {
+            // Save the real value of cdf(Rmax, 1).
+            g_nd_cdf_rmax = normalized_diffusion_cdf(NDCDFTableRmax, 1.0f);
+
+            g_nd_inv_cdf_table[0] = 0.0f;
+
+            for (size_t i = 1; i < NDInvCDFTableSize - 1; ++i)
+            {
+                const float u = fit<size_t, float>(i, 0, NDInvCDFTableSize - 1, 0.0f, g_nd_cdf_rmax);
+                g_nd_inv_cdf_table[i] =
+                    invert_cdf_function(
+                        NDCDFFun(1.0f),
+                        NDPDFFun(1.0f),
+                        u,
+                        g_nd_inv_cdf_table[i - 1],
+                        NDCDFTableRmax,
+                        g_nd_inv_cdf_table[i - 1],
+                        1.0e-6f,
+                        100);
+            }
+
+            g_nd_inv_cdf_table[NDInvCDFTableSize - 1] = NDCDFTableRmax;
         }
     };
+
+    InitializeNDInvCDFTable initialize_nd_inv_cdf_table;
 }
 
 float normalized_diffusion_sample(
@@ -258,15 +280,13 @@ float normalized_diffusion_sample(
     if (u >= g_nd_cdf_rmax)
         return NDCDFTableRmax * d;
 
-    // Use the CDF to find an initial interval for the root of cdf(r, 1) - u = 0.
-    const size_t i = sample_cdf(g_nd_cdf_table, g_nd_cdf_table + NDCDFTableSize, u);
-    assert(i > 0);
-    assert(g_nd_cdf_table[i - 1] <= u);
-    assert(g_nd_cdf_table[i] > u);
+    // Use the inverse CDF table to find an initial interval and guess for the root of cdf(r, 1) - u = 0.
+    const float x = u * ((NDInvCDFTableSize - 1) / g_nd_cdf_rmax);
+    const size_t i = min(truncate<size_t>(x), NDInvCDFTableSize - 2);
 
     // Transform the cdf(r, 1) interval to cdf(r, d) using the fact that cdf(r, d) == cdf(r/d, 1).
-    const float rmin = fit<size_t, float>(i - 1, 0, NDCDFTableSize - 1, 0.0f, NDCDFTableRmax) * d;
-    const float rmax = fit<size_t, float>(i,     0, NDCDFTableSize - 1, 0.0f, NDCDFTableRmax) * d;
+    const float rmin = g_nd_inv_cdf_table[i] * d;
+    const float rmax = g_nd_inv_cdf_table[i + 1] * d;
 
     return invert_cdf_function(
         NDCDFFun(d),
@@ -274,7 +294,7 @@ float normalized_diffusion_sample(
         u,
         rmin,
         rmax,
-        (rmin + rmax) * 0.5f,
+        lerp(rmin, rmax, x - i),
         eps,
         max_iterations);
 }
@@ -37,6 +37,7 @@
 #include "foundation/math/scalar.h"
 
 // Standard headers.
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
 
@@ -87,9 +88,38 @@ class ComputeRdBetterDipole
 // Numerically solve for the reduced albedo alpha' given Rd.
 template <typename ComputeRdFun>
 float compute_alpha_prime(
-    const ComputeRdFun  rd_fun,
+    const ComputeRdFun& rd_fun,
     const float         rd);
 
+// Tabulated inverse of Rd(alpha') for a given relative index of refraction.
+class AlphaPrimeTable
+{
+  public:
+    // Constructor. The table is initially empty.
+    AlphaPrimeTable();
+
+    // Tabulate alpha' for the given relative index of refraction.
+    template <typename ComputeRdFun>
+    void initialize(const float eta);
+
+    // Return the relative index of refraction of the table, or 0 if the table is empty.
+    float get_eta() const;
+
+    // Return alpha' given Rd, interpolating linearly between table entries.
+    float lookup(const float rd) const;
+
+  private:
+    enum { Size = 1024 };
+
+    float   m_eta;
+    float   m_values[Size];
+};
+
+// Look up the reduced albedo alpha' given Rd in a precomputed table.
+float compute_alpha_prime(
+    const AlphaPrimeTable&  table,
+    const float             rd);
+
 float diffusion_coefficient(
     const float         sigma_a,
     const float         sigma_t);
@@ -116,7 +146,7 @@ void effective_extinction_coefficient(
 // rd and dmfp must have the same size (both RGB or both spectral).
 template <typename ComputeRdFun>
 void compute_absorption_and_scattering_dmfp(
-    const ComputeRdFun  rd_fun,
+    const ComputeRdFun& rd_fun,                 // Rd(alpha') function or AlphaPrimeTable
     const Spectrum&     rd,                     // diffuse surface reflectance
     const Spectrum&     dmfp,                   // diffuse mean free path
     const float         g,                      // anisotropy
@@ -126,7 +156,7 @@ void compute_absorption_and_scattering_dmfp(
 // rd and mfp must have the same size (both RGB or both spectral).
 template <typename ComputeRdFun>
 void compute_absorption_and_scattering_mfp(
-    const ComputeRdFun  rd_fun,
+    const ComputeRdFun& rd_fun,                 // Rd(alpha') function or AlphaPrimeTable
     const Spectrum&     rd,                     // diffuse surface reflectance
     const Spectrum&     mfp,                    // mean free path
     Spectrum&           sigma_a,                // absorption coefficient
@@ -238,7 +268,7 @@ inline float evaluate_cosine_dwivedi(const float mu, const float cosine);
 
 template <typename ComputeRdFun>
 inline float compute_alpha_prime(
-    const ComputeRdFun  rd_fun,
+    const ComputeRdFun& rd_fun,
     const float         rd)
 {
     float x0 = 0.0f, x1 = 1.0f;
@@ -254,9 +284,52 @@ inline float compute_alpha_prime(
     return 0.5f * (x0 + x1);
 }
 
+inline AlphaPrimeTable::AlphaPrimeTable()
+  : m_eta(0.0f)
+{
+}
+
+template <typename ComputeRdFun>
+void AlphaPrimeTable::initialize(const float eta)
+{
+    const ComputeRdFun rd_fun(eta);
+
+    for (size_t i = 0; i < Size; ++i)
+    {
+        const float rd = static_cast<float>(i) / (Size - 1);
+        m_values[i] = compute_alpha_prime(rd_fun, rd);
+    }
+
+    m_eta = eta;
+}
+
+inline float AlphaPrimeTable::get_eta() const
+{
+    return m_eta;
+}
+
+inline float AlphaPrimeTable::lookup(const float rd) const
+{
+    assert(m_eta > 0.0f);
+    assert(rd >= 0.0f);
+    assert(rd <= 1.0f);
+
+    const float x = rd * (Size - 1);
+    const size_t i = std::min(foundation::truncate<size_t>(x), static_cast<size_t>(Size - 2));
+
+    return foundation::lerp(m_values[i], m_values[i + 1], x - i);
+}
+
+inline float compute_alpha_prime(
+    const AlphaPrimeTable&  table,
+    const float             rd)
+{
+    return table.lookup(rd);
+}
+
 template <typename ComputeRdFun>
 void compute_absorption_and_scattering_dmfp(
-    const ComputeRdFun  rd_fun,
+    const ComputeRdFun& rd_fun,
     const Spectrum&     rd,
     const Spectrum&     dmfp,
     const float         g,
@@ -293,7 +366,7 @@ void compute_absorption_and_scattering_dmfp(
 
 template <typename ComputeRdFun>
 void compute_absorption_and_scattering_mfp(
-    const ComputeRdFun  rd_fun,
+    const ComputeRdFun& rd_fun,
     const Spectrum&     rd,
     const Spectrum&     mfp,
     Spectrum&           sigma_a,
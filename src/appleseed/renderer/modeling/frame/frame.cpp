@@ -56,6 +56,7 @@
 #include "foundation/utility/api/specializedapiarrays.h"
 #include "foundation/utility/iostreamop.h"
 #include "foundation/utility/job/iabortswitch.h"
+#include "foundation/utility/profiler.h"
 #include "foundation/utility/stopwatch.h"
 #include "foundation/utility/string.h"
 
@@ -375,9 +376,12 @@ Frame::DenoisingMode Frame::get_denoising_mode() const
     return impl->m_denoising_mode;
 }
 
-void Frame::denoise(
-    const size_t        thread_count,
-    IAbortSwitch*       abort_switch) const
+bool Frame::is_streaming_denoising_enabled() const
+{
+    return m_params.get_optional<bool>("streaming_denoiser", false);
+}
+
+DenoiserOptions Frame::get_denoiser_options(const size_t thread_count) const
 {
     DenoiserOptions options;
 
@@ -413,6 +417,22 @@ void Frame::denoise(
     options.m_mark_invalid_pixels =
         m_params.get_optional<bool>("mark_invalid_pixels", false);
 
+    return options;
+}
+
+const DenoiserAOV* Frame::get_denoiser_aov() const
+{
+    return impl->m_denoiser_aov;
+}
+
+void Frame::denoise(
+    const size_t        thread_count,
+    IAbortSwitch*       abort_switch) const
+{
+    ProfileZone profile_zone("denoise frame");
+
+    const DenoiserOptions options = get_denoiser_options(thread_count);
+
     assert(impl->m_denoiser_aov);
 
     impl->m_denoiser_aov->fill_empty_samples();
@@ -584,6 +604,8 @@ namespace
     {
         assert(file_path);
 
+        ProfileZone profile_zone("write image");
+
         Stopwatch<DefaultWallclockTimer> stopwatch;
         stopwatch.start();
 
@@ -1028,6 +1050,17 @@ DictionaryArray FrameFactory::get_input_metadata()
             .insert("default", "off")
             .insert("on_change", "rebuild_form"));
 
+    metadata.push_back(
+        Dictionary()
+            .insert("name", "streaming_denoiser")
+            .insert("label", "Denoise While Rendering")
+            .insert("type", "boolean")
+            .insert("use", "optional")
+            .insert("default", "false")
+            .insert("visible_if",
+                Dictionary()
+                    .insert("denoiser", "on")));
+
     metadata.push_back(
         Dictionary()
             .insert("name", "skip_denoised")
@@ -62,6 +62,7 @@ namespace foundation    { class StringDictionary; }
 namespace foundation    { class Tile; }
 namespace renderer      { class BaseGroup; }
 namespace renderer      { class DenoiserAOV; }
+namespace renderer      { class DenoiserOptions; }
 namespace renderer      { class ImageStack; }
 namespace renderer      { class OnFrameBeginRecorder; }
 namespace renderer      { class ParamArray; }
@@ -163,6 +164,15 @@ class APPLESEED_DLLSYMBOL Frame
     // Retrieve the selected denoising mode.
     DenoisingMode get_denoising_mode() const;
 
+    // Return true if the frame should be denoised while the last rendering pass is in progress.
+    bool is_streaming_denoising_enabled() const;
+
+    // Retrieve the denoiser settings.
+    DenoiserOptions get_denoiser_options(const size_t thread_count) const;
+
+    // Access the AOV collecting the denoiser inputs. Return nullptr if denoising is off.
+    const DenoiserAOV* get_denoiser_aov() const;
+
     // Run the denoiser on the frame.
     void denoise(
         const size_t                thread_count,
@@ -29,16 +29,73 @@
 // Interface header.
 #include "sourceinputs.h"
 
+// appleseed.renderer headers.
+#include "renderer/kernel/shading/shadingpoint.h"
+
 namespace renderer
 {
 
 SourceInputs::SourceInputs(const foundation::Vector2f& uv)
     : m_uv_x(uv.x)
     , m_uv_y(uv.y)
+    , m_dudx(0.0f)
+    , m_dvdx(0.0f)
+    , m_dudy(0.0f)
+    , m_dvdy(0.0f)
+    , m_point_x(0)
+    , m_point_y(0)
+    , m_point_z(0)
+    , m_shading_point(nullptr)
+{
+}
+
+SourceInputs::SourceInputs(
+    const foundation::Vector2f& uv,
+    const foundation::Vector2f& duvdx,
+    const foundation::Vector2f& duvdy)
+    : m_uv_x(uv.x)
+    , m_uv_y(uv.y)
+    , m_dudx(duvdx.x)
+    , m_dvdx(duvdx.y)
+    , m_dudy(duvdy.x)
+    , m_dvdy(duvdy.y)
+    , m_point_x(0)
+    , m_point_y(0)
+    , m_point_z(0)
+    , m_shading_point(nullptr)
+{
+}
+
+SourceInputs::SourceInputs(
+    const foundation::Vector2f& uv,
+    const ShadingPoint&         shading_point)
+    : m_uv_x(uv.x)
+    , m_uv_y(uv.y)
+    , m_dudx(0.0f)
+    , m_dvdx(0.0f)
+    , m_dudy(0.0f)
+    , m_dvdy(0.0f)
     , m_point_x(0)
     , m_point_y(0)
     , m_point_z(0)
+    , m_shading_point(&shading_point)
+{
+}
+
+void SourceInputs::get_uv_derivatives(
+    foundation::Vector2f&       duvdx,
+    foundation::Vector2f&       duvdy) const
 {
+    if (m_shading_point != nullptr)
+    {
+        duvdx = m_shading_point->get_duvdx(0);
+        duvdy = m_shading_point->get_duvdy(0);
+    }
+    else
+    {
+        duvdx = foundation::Vector2f(m_dudx, m_dvdx);
+        duvdy = foundation::Vector2f(m_dudy, m_dvdy);
+    }
 }
 
 }
@@ -35,6 +35,9 @@
 // appleseed.main headers.
 #include "main/dllsymbol.h"
 
+// Forward declarations.
+namespace renderer  { class ShadingPoint; }
+
 namespace renderer
 {
 
@@ -43,11 +46,32 @@ class APPLESEED_DLLSYMBOL SourceInputs
   public:
     explicit SourceInputs(const foundation::Vector2f& uv);
 
-    float       m_uv_x;           // texture coordinates from UV set #0
-    float       m_uv_y;
-    double      m_point_x;        // world space intersection point
-    double      m_point_y;
-    double      m_point_z;
+    SourceInputs(
+        const foundation::Vector2f& uv,
+        const foundation::Vector2f& duvdx,
+        const foundation::Vector2f& duvdy);
+
+    // The screen space partial derivatives of the texture coordinates will be
+    // retrieved from the shading point, only if a source requests them.
+    SourceInputs(
+        const foundation::Vector2f& uv,
+        const ShadingPoint&         shading_point);
+
+    // Retrieve the screen space partial derivatives of the texture coordinates; they are zero if unknown.
+    void get_uv_derivatives(
+        foundation::Vector2f&       duvdx,
+        foundation::Vector2f&       duvdy) const;
+
+    float               m_uv_x;             // texture coordinates from UV set #0
+    float               m_uv_y;
+    float               m_dudx;             // screen space partial derivatives of the texture coordinates, zero if unknown
+    float               m_dvdx;
+    float               m_dudy;
+    float               m_dvdy;
+    double              m_point_x;          // world space intersection point
+    double              m_point_y;
+    double              m_point_z;
+    const ShadingPoint* m_shading_point;    // if set, provides the derivatives instead of m_dudx to m_dvdy
 };
 
 }
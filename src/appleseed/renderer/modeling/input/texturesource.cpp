@@ -31,6 +31,8 @@
 #include "texturesource.h"
 
 // appleseed.renderer headers.
+#include "renderer/kernel/rendering/costtracker.h"
+#include "renderer/kernel/texturing/mipmaplevels.h"
 #include "renderer/kernel/texturing/texturecache.h"
 #include "renderer/modeling/entity/entity.h"
 #include "renderer/modeling/texture/texture.h"
@@ -43,7 +45,10 @@
 #include "foundation/platform/types.h"
 
 // Standard headers.
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <utility>
 
 using namespace foundation;
 using namespace std;
@@ -103,10 +108,8 @@ namespace
             break;
 
           case TextureAddressingWrap:
-            if (ix < 0) ix = max_x;
-            if (iy < 0) iy = max_y;
-            if (ix > max_x) ix = 0;
-            if (iy > max_y) iy = 0;
+            ix = mod(ix, max_x + 1);
+            iy = mod(iy, max_y + 1);
             break;
 
           default:
@@ -119,11 +122,15 @@ namespace
                 static_cast<size_t>(iy));
     }
 
+    // Maximum ratio between the major and minor axes of the EWA filter footprint.
+    const float EWAMaxAnisotropy = 8.0f;
+
     // Utility function to sample a tile.
     inline void sample_tile(
         TextureCache&               texture_cache,
         const UniqueID              assembly_uid,
         const UniqueID              texture_uid,
+        const size_t                level,
         const size_t                tile_x,
         const size_t                tile_y,
         const size_t                pixel_x,
@@ -136,7 +143,8 @@ namespace
                 assembly_uid,
                 texture_uid,
                 tile_x,
-                tile_y);
+                tile_y,
+                level);
 
         // Sample the tile.
         if (tile.get_channel_count() == 3)
@@ -166,6 +174,7 @@ TextureSource::TextureSource(
   , m_max_x(static_cast<float>(m_texture_props.m_canvas_width - 1))
   , m_max_y(static_cast<float>(m_texture_props.m_canvas_height - 1))
 {
+    compute_mipmap_levels(m_texture_props, m_levels);
 }
 
 uint64 TextureSource::compute_signature() const
@@ -193,19 +202,39 @@ Vector2f TextureSource::apply_transform(const Vector2f& uv) const
     return Vector2f(p.x, p.y);
 }
 
+void TextureSource::compute_texel_derivatives(
+    const SourceInputs&         source_inputs,
+    Vector2f&                   dstdx,
+    Vector2f&                   dstdy) const
+{
+    Vector2f duvdx, duvdy;
+    source_inputs.get_uv_derivatives(duvdx, duvdy);
+
+    // Apply the texture instance transform to the derivatives.
+    const Vector3f dx = m_texture_transform.vector_to_local(Vector3f(duvdx.x, duvdx.y, 0.0f));
+    const Vector3f dy = m_texture_transform.vector_to_local(Vector3f(duvdy.x, duvdy.y, 0.0f));
+
+    // Express them in texels of level 0, flipping the Y axis like the texture coordinates.
+    dstdx = Vector2f(dx.x * m_scalar_canvas_width, -dx.y * m_scalar_canvas_height);
+    dstdy = Vector2f(dy.x * m_scalar_canvas_width, -dy.y * m_scalar_canvas_height);
+}
+
 Color4f TextureSource::get_texel(
     TextureCache&               texture_cache,
+    const size_t                level,
     const size_t                ix,
     const size_t                iy) const
 {
-    assert(ix < m_texture_props.m_canvas_width);
-    assert(iy < m_texture_props.m_canvas_height);
+    const CanvasProperties& props = m_levels[level];
+
+    assert(ix < props.m_canvas_width);
+    assert(iy < props.m_canvas_height);
 
     // Compute the coordinates of the tile containing the texel (x, y).
-    const size_t tile_x = truncate<size_t>(ix * m_texture_props.m_rcp_tile_width);
-    const size_t tile_y = truncate<size_t>(iy * m_texture_props.m_rcp_tile_height);
-    assert(tile_x < m_texture_props.m_tile_count_x);
-    assert(tile_y < m_texture_props.m_tile_count_y);
+    const size_t tile_x = truncate<size_t>(ix * props.m_rcp_tile_width);
+    const size_t tile_y = truncate<size_t>(iy * props.m_rcp_tile_height);
+    assert(tile_x < props.m_tile_count_x);
+    assert(tile_y < props.m_tile_count_y);
 
 #ifdef DEBUG_DISPLAY_TEXTURE_TILES
 
@@ -222,10 +251,10 @@ Color4f TextureSource::get_texel(
 #endif
 
     // Compute the tile space coordinates of the texel (x, y).
-    const size_t pixel_x = ix - tile_x * m_texture_props.m_tile_width;
-    const size_t pixel_y = iy - tile_y * m_texture_props.m_tile_height;
-    assert(pixel_x < m_texture_props.m_tile_width);
-    assert(pixel_y < m_texture_props.m_tile_height);
+    const size_t pixel_x = ix - tile_x * props.m_tile_width;
+    const size_t pixel_y = iy - tile_y * props.m_tile_height;
+    assert(pixel_x < props.m_tile_width);
+    assert(pixel_y < props.m_tile_height);
 
     // Sample the tile.
     Color4f sample;
@@ -233,6 +262,7 @@ Color4f TextureSource::get_texel(
         texture_cache,
         m_assembly_uid,
         m_texture_uid,
+        level,
         tile_x,
         tile_y,
         pixel_x,
@@ -244,6 +274,7 @@ Color4f TextureSource::get_texel(
 
 void TextureSource::get_texels_2x2(
     TextureCache&               texture_cache,
+    const size_t                level,
     const int                   ix,
     const int                   iy,
     Color4f&                    t00,
@@ -251,19 +282,21 @@ void TextureSource::get_texels_2x2(
     Color4f&                    t01,
     Color4f&                    t11) const
 {
+    const CanvasProperties& props = m_levels[level];
+
     const Vector<size_t, 2> p00 =
         constrain_to_canvas(
             m_texture_instance.get_addressing_mode(),
-            m_texture_props.m_canvas_width,
-            m_texture_props.m_canvas_height,
+            props.m_canvas_width,
+            props.m_canvas_height,
             ix + 0,
             iy + 0);
 
     const Vector<size_t, 2> p11 =
         constrain_to_canvas(
             m_texture_instance.get_addressing_mode(),
-            m_texture_props.m_canvas_width,
-            m_texture_props.m_canvas_height,
+            props.m_canvas_width,
+            props.m_canvas_height,
             ix + 1,
             iy + 1);
 
@@ -271,10 +304,10 @@ void TextureSource::get_texels_2x2(
     const Vector<size_t, 2> p01(p00.x, p11.y);
 
     // Compute the coordinates of the tile containing each texel.
-    const size_t tile_x_00 = truncate<size_t>(p00.x * m_texture_props.m_rcp_tile_width);
-    const size_t tile_y_00 = truncate<size_t>(p00.y * m_texture_props.m_rcp_tile_height);
-    const size_t tile_x_11 = truncate<size_t>(p11.x * m_texture_props.m_rcp_tile_width);
-    const size_t tile_y_11 = truncate<size_t>(p11.y * m_texture_props.m_rcp_tile_height);
+    const size_t tile_x_00 = truncate<size_t>(p00.x * props.m_rcp_tile_width);
+    const size_t tile_y_00 = truncate<size_t>(p00.y * props.m_rcp_tile_height);
+    const size_t tile_x_11 = truncate<size_t>(p11.x * props.m_rcp_tile_width);
+    const size_t tile_y_11 = truncate<size_t>(p11.y * props.m_rcp_tile_height);
 
     // Check whether all four texels are part of the same tile.
     const size_t tile_x_mask = tile_x_00 ^ tile_x_11;
@@ -285,24 +318,24 @@ void TextureSource::get_texels_2x2(
         // Not all four texels are part of the same tile.
 
         // Compute the tile space coordinates of each texel.
-        const size_t pixel_x_00 = p00.x - tile_x_00 * m_texture_props.m_tile_width;
-        const size_t pixel_y_00 = p00.y - tile_y_00 * m_texture_props.m_tile_height;
-        const size_t pixel_x_11 = p11.x - tile_x_11 * m_texture_props.m_tile_width;
-        const size_t pixel_y_11 = p11.y - tile_y_11 * m_texture_props.m_tile_height;
+        const size_t pixel_x_00 = p00.x - tile_x_00 * props.m_tile_width;
+        const size_t pixel_y_00 = p00.y - tile_y_00 * props.m_tile_height;
+        const size_t pixel_x_11 = p11.x - tile_x_11 * props.m_tile_width;
+        const size_t pixel_y_11 = p11.y - tile_y_11 * props.m_tile_height;
 
         // Sample the tile.
-        sample_tile(texture_cache, m_assembly_uid, m_texture_uid, tile_x_00, tile_y_00, pixel_x_00, pixel_y_00, t00);
-        sample_tile(texture_cache, m_assembly_uid, m_texture_uid, tile_x_11, tile_y_00, pixel_x_11, pixel_y_00, t10);
-        sample_tile(texture_cache, m_assembly_uid, m_texture_uid, tile_x_00, tile_y_11, pixel_x_00, pixel_y_11, t01);
-        sample_tile(texture_cache, m_assembly_uid, m_texture_uid, tile_x_11, tile_y_11, pixel_x_11, pixel_y_11, t11);
+        sample_tile(texture_cache, m_assembly_uid, m_texture_uid, level, tile_x_00, tile_y_00, pixel_x_00, pixel_y_00, t00);
+        sample_tile(texture_cache, m_assembly_uid, m_texture_uid, level, tile_x_11, tile_y_00, pixel_x_11, pixel_y_00, t10);
+        sample_tile(texture_cache, m_assembly_uid, m_texture_uid, level, tile_x_00, tile_y_11, pixel_x_00, pixel_y_11, t01);
+        sample_tile(texture_cache, m_assembly_uid, m_texture_uid, level, tile_x_11, tile_y_11, pixel_x_11, pixel_y_11, t11);
     }
     else
     {
         // All four texels are part of the same tile.
 
         // Compute the tile space coordinates of each texel.
-        const size_t org_x = tile_x_00 * m_texture_props.m_tile_width;
-        const size_t org_y = tile_y_00 * m_texture_props.m_tile_height;
+        const size_t org_x = tile_x_00 * props.m_tile_width;
+        const size_t org_y = tile_y_00 * props.m_tile_height;
         const size_t pixel_x_00 = p00.x - org_x;
         const size_t pixel_y_00 = p00.y - org_y;
         const size_t pixel_x_11 = p11.x - org_x;
@@ -314,7 +347,8 @@ void TextureSource::get_texels_2x2(
                 m_assembly_uid,
                 m_texture_uid,
                 tile_x_00,
-                tile_y_00);
+                tile_y_00,
+                level);
 
         // Sample the tile.
         if (tile.get_channel_count() == 3)
@@ -355,12 +389,215 @@ void TextureSource::get_texels_2x2(
     }
 }
 
+Color4f TextureSource::filter_bilinear(
+    TextureCache&               texture_cache,
+    const size_t                level,
+    const float                 x,
+    const float                 y) const
+{
+    const int ix = static_cast<int>(floor(x));
+    const int iy = static_cast<int>(floor(y));
+
+    // Retrieve the four surrounding texels.
+    Color4f t00, t10, t01, t11;
+    get_texels_2x2(
+        texture_cache,
+        level,
+        ix, iy,
+        t00, t10, t01, t11);
+
+    // Compute weights.
+    const float wx1 = x - ix;
+    const float wy1 = y - iy;
+    const float wx0 = 1.0f - wx1;
+    const float wy0 = 1.0f - wy1;
+
+    // Apply weights.
+    t00 *= wx0 * wy0;
+    t10 *= wx1 * wy0;
+    t01 *= wx0 * wy1;
+    t11 *= wx1 * wy1;
+
+    // Accumulate.
+    t00 += t10;
+    t00 += t01;
+    t00 += t11;
+
+    return t00;
+}
+
+Color4f TextureSource::sample_bilinear(
+    TextureCache&               texture_cache,
+    const size_t                level,
+    const Vector2f&             p) const
+{
+    const CanvasProperties& props = m_levels[level];
+
+    // Texel centers lie at half-integer coordinates on every level, so that levels
+    // of different resolutions stay registered with each other and with sample_ewa().
+    return
+        filter_bilinear(
+            texture_cache,
+            level,
+            p.x * static_cast<float>(props.m_canvas_width) - 0.5f,
+            p.y * static_cast<float>(props.m_canvas_height) - 0.5f);
+}
+
+Color4f TextureSource::sample_trilinear(
+    TextureCache&               texture_cache,
+    const Vector2f&             p,
+    const float                 lod) const
+{
+    const size_t max_level = m_levels.size() - 1;
+
+    if (!(lod > 0.0f))
+        return sample_bilinear(texture_cache, 0, p);
+
+    if (lod >= static_cast<float>(max_level))
+        return sample_bilinear(texture_cache, max_level, p);
+
+    const size_t level = truncate<size_t>(lod);
+    const float t = lod - static_cast<float>(level);
+
+    const Color4f c0 = sample_bilinear(texture_cache, level, p);
+    const Color4f c1 = sample_bilinear(texture_cache, level + 1, p);
+
+    return lerp(c0, c1, t);
+}
+
+Color4f TextureSource::sample_ewa(
+    TextureCache&               texture_cache,
+    const Vector2f&             p,
+    Vector2f                    dst0,
+    Vector2f                    dst1) const
+{
+    //
+    // Reference:
+    //
+    //   Physically Based Rendering, third edition, pp. 623-628
+    //
+
+    // Make sure dst0 is the major axis of the footprint.
+    if (square_norm(dst0) < square_norm(dst1))
+        std::swap(dst0, dst1);
+
+    const float major_length = norm(dst0);
+    float minor_length = norm(dst1);
+
+    // Clamp the eccentricity of the footprint to bound the number of texels to filter.
+    if (minor_length * EWAMaxAnisotropy < major_length && minor_length > 0.0f)
+    {
+        const float scale = major_length / (minor_length * EWAMaxAnisotropy);
+        dst1 *= scale;
+        minor_length *= scale;
+    }
+
+    // Degenerate footprint: fall back to bilinear filtering.
+    if (minor_length == 0.0f)
+        return sample_bilinear(texture_cache, 0, p);
+
+    // Choose the levels such that the minor axis spans a couple of texels.
+    const size_t max_level = m_levels.size() - 1;
+    const float lod = log2(minor_length);
+
+    if (!(lod > 0.0f))
+        return sample_ewa(texture_cache, 0, p, dst0, dst1);
+
+    if (lod >= static_cast<float>(max_level))
+        return sample_bilinear(texture_cache, max_level, p);
+
+    const size_t level = truncate<size_t>(lod);
+    const float t = lod - static_cast<float>(level);
+
+    const Color4f c0 = sample_ewa(texture_cache, level, p, dst0, dst1);
+    const Color4f c1 = sample_ewa(texture_cache, level + 1, p, dst0, dst1);
+
+    return lerp(c0, c1, t);
+}
+
+Color4f TextureSource::sample_ewa(
+    TextureCache&               texture_cache,
+    const size_t                level,
+    const Vector2f&             p,
+    const Vector2f&             dst0,
+    const Vector2f&             dst1) const
+{
+    const CanvasProperties& props = m_levels[level];
+
+    // Express the footprint in texels of this level.
+    const float level_scale = 1.0f / static_cast<float>(size_t(1) << level);
+    const Vector2f d0 = dst0 * level_scale;
+    const Vector2f d1 = dst1 * level_scale;
+
+    // Center of the footprint in texel space.
+    const float s = p.x * static_cast<float>(props.m_canvas_width) - 0.5f;
+    const float t = p.y * static_cast<float>(props.m_canvas_height) - 0.5f;
+
+    // Compute the coefficients of the implicit equation of the ellipse.
+    float a = d0.y * d0.y + d1.y * d1.y + 1.0f;
+    float b = -2.0f * (d0.x * d0.y + d1.x * d1.y);
+    float c = d0.x * d0.x + d1.x * d1.x + 1.0f;
+    const float rcp_f = 1.0f / (a * c - b * b * 0.25f);
+    a *= rcp_f;
+    b *= rcp_f;
+    c *= rcp_f;
+
+    // Compute the bounding box of the ellipse in texel space.
+    const float d = 4.0f * a * c - b * b;
+    const float rcp_d = 1.0f / d;
+    const float half_width = 2.0f * sqrt(d * c) * rcp_d;
+    const float half_height = 2.0f * sqrt(d * a) * rcp_d;
+    const int s0 = static_cast<int>(ceil(s - half_width));
+    const int s1 = static_cast<int>(floor(s + half_width));
+    const int t0 = static_cast<int>(ceil(t - half_height));
+    const int t1 = static_cast<int>(floor(t + half_height));
+
+    // Filter the texels inside the ellipse with a Gaussian.
+    const TextureAddressingMode addressing_mode = m_texture_instance.get_addressing_mode();
+    const float min_weight = exp(-2.0f);
+    Color4f sum(0.0f);
+    float weight_sum = 0.0f;
+
+    for (int it = t0; it <= t1; ++it)
+    {
+        const float tt = static_cast<float>(it) - t;
+
+        for (int is = s0; is <= s1; ++is)
+        {
+            const float ss = static_cast<float>(is) - s;
+
+            const float r2 = a * ss * ss + b * ss * tt + c * tt * tt;
+            if (r2 >= 1.0f)
+                continue;
+
+            const Vector<size_t, 2> texel =
+                constrain_to_canvas(
+                    addressing_mode,
+                    props.m_canvas_width,
+                    props.m_canvas_height,
+                    is,
+                    it);
+
+            const float weight = exp(-2.0f * r2) - min_weight;
+            sum += weight * get_texel(texture_cache, level, texel.x, texel.y);
+            weight_sum += weight;
+        }
+    }
+
+    return
+        weight_sum > 0.0f
+            ? sum / weight_sum
+            : sample_bilinear(texture_cache, level, p);
+}
+
 Color4f TextureSource::sample_texture(
     TextureCache&               texture_cache,
-    const Vector2f&             uv) const
+    const SourceInputs&         source_inputs) const
 {
+    CostScope cost_scope(CostTracker::TextureFetch);
+
     // Start with the transformed input texture coordinates.
-    Vector2f p = apply_transform(uv);
+    Vector2f p = apply_transform(Vector2f(source_inputs.m_uv_x, source_inputs.m_uv_y));
     p.y = 1.0f - p.y;
 
     // Apply the texture addressing mode.
@@ -376,42 +613,33 @@ Color4f TextureSource::sample_texture(
             const size_t ix = truncate<size_t>(p.x);
             const size_t iy = truncate<size_t>(p.y);
 
-            return get_texel(texture_cache, ix, iy);
+            return get_texel(texture_cache, 0, ix, iy);
         }
 
       case TextureFilteringBilinear:
+        // Plain bilinear filtering keeps its historical mapping, where the corners of
+        // the texture coincide with the centers of the corner texels, so that existing
+        // scenes render unchanged.
+        return filter_bilinear(texture_cache, 0, p.x * m_max_x, p.y * m_max_y);
+
+      case TextureFilteringTrilinear:
+        {
+            Vector2f dstdx, dstdy;
+            compute_texel_derivatives(source_inputs, dstdx, dstdy);
+
+            // Select the levels from the largest extent of the footprint.
+            const float width = max(square_norm(dstdx), square_norm(dstdy));
+            const float lod = width > 1.0f ? 0.5f * log2(width) : 0.0f;
+
+            return sample_trilinear(texture_cache, p, lod);
+        }
+
+      case TextureFilteringEWA:
         {
-            p.x *= m_max_x;
-            p.y *= m_max_y;
-
-            const int ix = truncate<int>(p.x);
-            const int iy = truncate<int>(p.y);
-
-            // Retrieve the four surrounding texels.
-            Color4f t00, t10, t01, t11;
-            get_texels_2x2(
-                texture_cache,
-                ix, iy,
-                t00, t10, t01, t11);
-
-            // Compute weights.
-            const float wx1 = p.x - ix;
-            const float wy1 = p.y - iy;
-            const float wx0 = 1.0f - wx1;
-            const float wy0 = 1.0f - wy1;
-
-            // Apply weights.
-            t00 *= wx0 * wy0;
-            t10 *= wx1 * wy0;
-            t01 *= wx0 * wy1;
-            t11 *= wx1 * wy1;
-
-            // Accumulate.
-            t00 += t10;
-            t00 += t01;
-            t00 += t11;
-
-            return t00;
+            Vector2f dstdx, dstdy;
+            compute_texel_derivatives(source_inputs, dstdx, dstdy);
+
+            return sample_ewa(texture_cache, p, dstdx, dstdy);
         }
 
       default:
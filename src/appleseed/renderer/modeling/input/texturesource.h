@@ -48,6 +48,7 @@
 
 // Standard headers.
 #include <cstddef>
+#include <vector>
 
 // Forward declarations.
 namespace renderer      { class TextureCache; }
@@ -115,20 +116,29 @@ class TextureSource
     const float                             m_scalar_canvas_height;
     const float                             m_max_x;
     const float                             m_max_y;
+    std::vector<foundation::CanvasProperties> m_levels;     // MIP levels, level 0 is the texture itself
 
     // Apply the texture instance transform to UV coordinates.
     foundation::Vector2f apply_transform(
         const foundation::Vector2f&         uv) const;
 
-    // Retrieve a given texel. Return a color in the linear RGB color space.
+    // Compute the screen space partial derivatives of the transformed texture coordinates, in texels.
+    void compute_texel_derivatives(
+        const SourceInputs&                 source_inputs,
+        foundation::Vector2f&               dstdx,
+        foundation::Vector2f&               dstdy) const;
+
+    // Retrieve a given texel of a given MIP level. Return a color in the linear RGB color space.
     foundation::Color4f get_texel(
         TextureCache&                       texture_cache,
+        const size_t                        level,
         const size_t                        ix,
         const size_t                        iy) const;
 
-    // Retrieve a 2x2 block of texels. Texels are expressed in the linear RGB color space.
+    // Retrieve a 2x2 block of texels of a given MIP level. Texels are expressed in the linear RGB color space.
     void get_texels_2x2(
         TextureCache&                       texture_cache,
+        const size_t                        level,
         const int                           ix,
         const int                           iy,
         foundation::Color4f&                t00,
@@ -136,10 +146,42 @@ class TextureSource
         foundation::Color4f&                t01,
         foundation::Color4f&                t11) const;
 
+    // Bilinearly interpolate the texels of a given MIP level at given continuous texel coordinates.
+    foundation::Color4f filter_bilinear(
+        TextureCache&                       texture_cache,
+        const size_t                        level,
+        const float                         x,
+        const float                         y) const;
+
+    // Sample a given MIP level with bilinear filtering, texel centers being at half-integer coordinates.
+    foundation::Color4f sample_bilinear(
+        TextureCache&                       texture_cache,
+        const size_t                        level,
+        const foundation::Vector2f&         p) const;
+
+    // Sample the MIP pyramid with trilinear filtering, given a fractional level of detail.
+    foundation::Color4f sample_trilinear(
+        TextureCache&                       texture_cache,
+        const foundation::Vector2f&         p,
+        const float                         lod) const;
+
+    // Sample the MIP pyramid with an elliptical weighted average filter, given the texel space footprint axes.
+    foundation::Color4f sample_ewa(
+        TextureCache&                       texture_cache,
+        const foundation::Vector2f&         p,
+        foundation::Vector2f                dst0,
+        foundation::Vector2f                dst1) const;
+    foundation::Color4f sample_ewa(
+        TextureCache&                       texture_cache,
+        const size_t                        level,
+        const foundation::Vector2f&         p,
+        const foundation::Vector2f&         dst0,
+        const foundation::Vector2f&         dst1) const;
+
     // Sample the texture. Return a color in the linear RGB color space.
     foundation::Color4f sample_texture(
         TextureCache&                       texture_cache,
-        const foundation::Vector2f&         uv) const;
+        const SourceInputs&                 source_inputs) const;
 
     // Compute an alpha value given a linear RGBA color and the alpha mode of the texture instance.
     void evaluate_alpha(
@@ -162,7 +204,7 @@ inline void TextureSource::evaluate(
     const SourceInputs&                     source_inputs,
     float&                                  scalar) const
 {
-    const foundation::Color4f color = sample_texture(texture_cache, foundation::Vector2f(source_inputs.m_uv_x, source_inputs.m_uv_y));
+    const foundation::Color4f color = sample_texture(texture_cache, source_inputs);
     scalar = color[0];
 }
 
@@ -171,7 +213,7 @@ inline void TextureSource::evaluate(
     const SourceInputs&                     source_inputs,
     foundation::Color3f&                    linear_rgb) const
 {
-    const foundation::Color4f color = sample_texture(texture_cache, foundation::Vector2f(source_inputs.m_uv_x, source_inputs.m_uv_y));
+    const foundation::Color4f color = sample_texture(texture_cache, source_inputs);
     linear_rgb = color.rgb();
 }
 
@@ -180,7 +222,7 @@ inline void TextureSource::evaluate(
     const SourceInputs&                     source_inputs,
     Spectrum&                               spectrum) const
 {
-    const foundation::Color4f color = sample_texture(texture_cache, foundation::Vector2f(source_inputs.m_uv_x, source_inputs.m_uv_y));
+    const foundation::Color4f color = sample_texture(texture_cache, source_inputs);
     spectrum.set(color.rgb(), g_std_lighting_conditions, Spectrum::Reflectance);
 }
 
@@ -189,7 +231,7 @@ inline void TextureSource::evaluate(
     const SourceInputs&                     source_inputs,
     Alpha&                                  alpha) const
 {
-    const foundation::Color4f color = sample_texture(texture_cache, foundation::Vector2f(source_inputs.m_uv_x, source_inputs.m_uv_y));
+    const foundation::Color4f color = sample_texture(texture_cache, source_inputs);
     evaluate_alpha(color, alpha);
 }
 
@@ -199,7 +241,7 @@ inline void TextureSource::evaluate(
     foundation::Color3f&                    linear_rgb,
     Alpha&                                  alpha) const
 {
-    const foundation::Color4f color = sample_texture(texture_cache, foundation::Vector2f(source_inputs.m_uv_x, source_inputs.m_uv_y));
+    const foundation::Color4f color = sample_texture(texture_cache, source_inputs);
     linear_rgb = color.rgb();
     evaluate_alpha(color, alpha);
 }
@@ -210,7 +252,7 @@ inline void TextureSource::evaluate(
     Spectrum&                               spectrum,
     Alpha&                                  alpha) const
 {
-    const foundation::Color4f color = sample_texture(texture_cache, foundation::Vector2f(source_inputs.m_uv_x, source_inputs.m_uv_y));
+    const foundation::Color4f color = sample_texture(texture_cache, source_inputs);
     spectrum.set(color.rgb(), g_std_lighting_conditions, Spectrum::Reflectance);
     evaluate_alpha(color, alpha);
 }
@@ -32,7 +32,11 @@
 
 // appleseed.renderer headers.
 #include "renderer/kernel/rasterization/objectrasterizer.h"
+#include "renderer/kernel/tessellation/geometrypager.h"
+#include "renderer/kernel/tessellation/loopsubdivision.h"
 #include "renderer/kernel/tessellation/statictessellation.h"
+#include "renderer/modeling/input/source.h"
+#include "renderer/modeling/input/sourceinputs.h"
 #include "renderer/modeling/object/iregion.h"
 #include "renderer/modeling/object/meshobjectprimitives.h"
 #include "renderer/modeling/object/meshobjectreader.h"
@@ -41,12 +45,18 @@
 // appleseed.foundation headers.
 #include "foundation/utility/api/apiarray.h"
 #include "foundation/utility/api/specializedapiarrays.h"
+#include "foundation/utility/casts.h"
 #include "foundation/utility/containers/dictionary.h"
 #include "foundation/utility/foreach.h"
+#include "foundation/utility/siphash.h"
+#include "foundation/utility/uid.h"
+#include "foundation/utility/version.h"
 
 // Standard headers.
 #include <cassert>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 using namespace foundation;
@@ -63,47 +73,154 @@ namespace
 {
     const char* Model = "mesh_object";
 
-    // A region that simply wraps a static tessellation.
+    // A region that wraps a static tessellation, either resident or paged out.
     class MeshRegion
       : public IRegion
     {
       public:
         explicit MeshRegion(StaticTriangleTess* tess)
-          : m_tess(tess)
-          , m_lazy_tess(tess)
+          : m_paged_tess(nullptr)
         {
+            set_tess(tess);
         }
 
         GAABB3 compute_local_bbox() const override
         {
-            return m_tess->compute_local_bbox();
+            return m_paged_tess ? m_paged_bbox : m_tess->compute_local_bbox();
         }
 
         Lazy<StaticTriangleTess>& get_static_triangle_tess() const override
         {
-            return m_lazy_tess;
+            return m_paged_tess ? *m_paged_tess : *m_lazy_tess;
+        }
+
+        StaticTriangleTess& get_tess() const
+        {
+            return *m_tess;
+        }
+
+        void set_tess(StaticTriangleTess* tess)
+        {
+            m_tess = tess;
+            m_lazy_tess.reset(new Lazy<StaticTriangleTess>(tess));
+        }
+
+        Lazy<StaticTriangleTess>* get_paged_tess() const
+        {
+            return m_paged_tess;
+        }
+
+        void set_paged_tess(Lazy<StaticTriangleTess>* paged_tess, const GAABB3& bbox)
+        {
+            m_paged_tess = paged_tess;
+            m_paged_bbox = bbox;
         }
 
       private:
-        StaticTriangleTess*                 m_tess;
-        mutable Lazy<StaticTriangleTess>    m_lazy_tess;
+        StaticTriangleTess*                         m_tess;
+        unique_ptr<Lazy<StaticTriangleTess>>        m_lazy_tess;
+        Lazy<StaticTriangleTess>*                   m_paged_tess;
+        GAABB3                                      m_paged_bbox;
     };
+
+    // Copy the features of a tessellation that are preserved by dicing.
+    void copy_diceable_features(
+        const StaticTriangleTess&   input,
+        StaticTriangleTess&         output)
+    {
+        output.m_vertices = input.m_vertices;
+        output.m_vertex_normals = input.m_vertex_normals;
+        output.m_primitives = input.m_primitives;
+
+        const size_t tex_coords_count = input.get_tex_coords_count();
+        output.reserve_tex_coords(tex_coords_count);
+        for (size_t i = 0; i < tex_coords_count; ++i)
+            output.push_tex_coords(input.get_tex_coords(i));
+    }
+
+    // Move each vertex along its normal by the value of a displacement map at that vertex.
+    // The tessellation must have smooth vertex normals.
+    void displace(
+        StaticTriangleTess&         tess,
+        const Source&               displacement_map,
+        const float                 scale,
+        TextureCache&               texture_cache)
+    {
+        // Find texture coordinates for each vertex.
+        vector<uint32> vertex_tex_coords(tess.m_vertices.size(), Triangle::None);
+        if (tess.get_tex_coords_count() > 0)
+        {
+            for (const Triangle& triangle : tess.m_primitives)
+            {
+                if (triangle.has_vertex_attributes())
+                {
+                    vertex_tex_coords[triangle.m_v0] = triangle.m_a0;
+                    vertex_tex_coords[triangle.m_v1] = triangle.m_a1;
+                    vertex_tex_coords[triangle.m_v2] = triangle.m_a2;
+                }
+            }
+        }
+
+        for (size_t i = 0, e = tess.m_vertices.size(); i < e; ++i)
+        {
+            const GVector2 uv =
+                vertex_tex_coords[i] != Triangle::None
+                    ? tess.get_tex_coords(vertex_tex_coords[i])
+                    : GVector2(0.0f);
+
+            float height;
+            displacement_map.evaluate(texture_cache, SourceInputs(Vector2f(uv)), height);
+
+            tess.m_vertices[i] += (scale * height) * tess.m_vertex_normals[i];
+        }
+    }
 }
 
 struct MeshObject::Impl
 {
-    StaticTriangleTess          m_tess;
-    MeshRegion                  m_region;
-    RegionKit                   m_region_kit;
-    mutable Lazy<RegionKit>     m_lazy_region_kit;
-    vector<string>              m_material_slots;
+    shared_ptr<StaticTriangleTess>      m_tess;                 // may be shared by identical mesh objects
+    UniqueID                            m_shared_geometry_uid;  // ~0 if the tessellation is not shared
+    unique_ptr<StaticTriangleTess>      m_diced_tess;
+    size_t                              m_dicing_level;
+    uint64                              m_dicing_signature;
+    VersionID                           m_cage_version_id;      // incremented whenever the base cage is modified
+    MeshRegion                          m_region;
+    RegionKit                           m_region_kit;
+    mutable Lazy<RegionKit>             m_lazy_region_kit;
+    vector<string>                      m_material_slots;
+    GeometryPager*                      m_pager;
 
     Impl()
-      : m_region(&m_tess)
+      : m_tess(new StaticTriangleTess())
+      , m_shared_geometry_uid(~UniqueID(0))
+      , m_dicing_level(~size_t(0))
+      , m_dicing_signature(0)
+      , m_cage_version_id(0)
+      , m_region(m_tess.get())
       , m_lazy_region_kit(&m_region_kit)
+      , m_pager(nullptr)
     {
         m_region_kit.push_back(&m_region);
     }
+
+    // Make a private copy of the tessellation if it is shared, in preparation for modifying it.
+    // Since the base cage is about to change, any diced geometry becomes stale.
+    void unshare()
+    {
+        ++m_cage_version_id;
+
+        if (m_tess.use_count() > 1)
+        {
+            shared_ptr<StaticTriangleTess> tess(new StaticTriangleTess());
+            tess->copy_from(*m_tess);
+            m_tess = tess;
+
+            if (m_diced_tess.get() == nullptr)
+                m_region.set_tess(m_tess.get());
+        }
+
+        m_shared_geometry_uid = ~UniqueID(0);
+    }
 };
 
 MeshObject::MeshObject(
@@ -113,6 +230,7 @@ MeshObject::MeshObject(
   , impl(new Impl())
 {
     m_inputs.declare("alpha_map", InputFormatFloat, "");
+    m_inputs.declare("displacement_map", InputFormatFloat, "");
 }
 
 MeshObject::~MeshObject()
@@ -137,7 +255,7 @@ const Source* MeshObject::get_uncached_alpha_map() const
 
 GAABB3 MeshObject::compute_local_bbox() const
 {
-    return impl->m_tess.compute_local_bbox();
+    return impl->m_region.compute_local_bbox();
 }
 
 Lazy<RegionKit>& MeshObject::get_region_kit()
@@ -147,18 +265,24 @@ Lazy<RegionKit>& MeshObject::get_region_kit()
 
 void MeshObject::rasterize(ObjectRasterizer& rasterizer) const
 {
+    const Access<StaticTriangleTess> tess(&impl->m_region.get_static_triangle_tess());
+
+    // Paged out geometry may fail to load.
+    if (tess.get() == nullptr)
+        return;
+
     rasterizer.begin_object();
 
-    for (const auto& prim : impl->m_tess.m_primitives)
+    for (const auto& prim : tess->m_primitives)
     {
-        const auto& v0 = impl->m_tess.m_vertices[prim.m_v0];
-        const auto& v1 = impl->m_tess.m_vertices[prim.m_v1];
-        const auto& v2 = impl->m_tess.m_vertices[prim.m_v2];
+        const auto& v0 = tess->m_vertices[prim.m_v0];
+        const auto& v1 = tess->m_vertices[prim.m_v1];
+        const auto& v2 = tess->m_vertices[prim.m_v2];
 
         // todo: check that vertex normals are available.
-        const auto& n0 = impl->m_tess.m_vertex_normals[prim.m_n0];
-        const auto& n1 = impl->m_tess.m_vertex_normals[prim.m_n1];
-        const auto& n2 = impl->m_tess.m_vertex_normals[prim.m_n2];
+        const auto& n0 = tess->m_vertex_normals[prim.m_n0];
+        const auto& n1 = tess->m_vertex_normals[prim.m_n1];
+        const auto& n2 = tess->m_vertex_normals[prim.m_n2];
 
         ObjectRasterizer::Triangle triangle;
 
@@ -192,137 +316,341 @@ void MeshObject::rasterize(ObjectRasterizer& rasterizer) const
     rasterizer.end_object();
 }
 
+void MeshObject::share_geometry(MeshObject& source)
+{
+    assert(!is_paged_out());
+    assert(!source.is_paged_out());
+
+    if (impl->m_tess == source.impl->m_tess)
+        return;
+
+    if (source.impl->m_shared_geometry_uid == ~UniqueID(0))
+        source.impl->m_shared_geometry_uid = new_guid();
+
+    impl->m_tess = source.impl->m_tess;
+    impl->m_shared_geometry_uid = source.impl->m_shared_geometry_uid;
+
+    if (!is_diced())
+        impl->m_region.set_tess(impl->m_tess.get());
+}
+
+bool MeshObject::is_sharing_geometry() const
+{
+    return impl->m_tess.use_count() > 1;
+}
+
+UniqueID MeshObject::get_geometry_uid() const
+{
+    return
+        is_diced() || impl->m_shared_geometry_uid == ~UniqueID(0)
+            ? get_uid()
+            : impl->m_shared_geometry_uid;
+}
+
+size_t MeshObject::get_geometry_memory_size() const
+{
+    size_t size = impl->m_tess->get_memory_size();
+
+    if (impl->m_diced_tess.get() != nullptr)
+        size += impl->m_diced_tess->get_memory_size();
+
+    return size;
+}
+
+bool MeshObject::needs_dicing() const
+{
+    return
+        m_params.get_optional<string>("subdivision_scheme", "none") != "none" ||
+        m_inputs.source("displacement_map") != nullptr;
+}
+
+size_t MeshObject::get_max_subdivision_level() const
+{
+    if (m_params.get_optional<string>("subdivision_scheme", "none") == "none")
+        return 0;
+
+    return m_params.get_optional<size_t>("max_subdivision_level", 4);
+}
+
+void MeshObject::dice(
+    const size_t            subdivision_level,
+    TextureCache&           texture_cache)
+{
+    assert(!is_paged_out());
+    assert(subdivision_level <= get_max_subdivision_level());
+
+    unique_ptr<StaticTriangleTess> diced(new StaticTriangleTess());
+
+    if (subdivision_level > 0)
+    {
+        unique_ptr<StaticTriangleTess> temp(new StaticTriangleTess());
+
+        loop_subdivide(*impl->m_tess, *diced);
+
+        for (size_t i = 1; i < subdivision_level; ++i)
+        {
+            loop_subdivide(*diced, *temp);
+            swap(diced, temp);
+        }
+
+        compute_smooth_vertex_normals(*diced);
+    }
+    else copy_diceable_features(*impl->m_tess, *diced);
+
+    const Source* displacement_map = m_inputs.source("displacement_map");
+    if (displacement_map != nullptr)
+    {
+        if (subdivision_level == 0)
+            compute_smooth_vertex_normals(*diced);
+
+        displace(
+            *diced,
+            *displacement_map,
+            m_params.get_optional<float>("displacement_scale", 1.0f),
+            texture_cache);
+
+        compute_smooth_vertex_normals(*diced);
+    }
+
+    impl->m_region.set_tess(diced.get());
+    impl->m_diced_tess = move(diced);
+    impl->m_dicing_level = subdivision_level;
+    impl->m_dicing_signature = compute_dicing_signature();
+}
+
+void MeshObject::clear_dicing()
+{
+    assert(!is_paged_out());
+
+    impl->m_region.set_tess(impl->m_tess.get());
+    impl->m_diced_tess.reset();
+    impl->m_dicing_level = ~size_t(0);
+    impl->m_dicing_signature = 0;
+}
+
+bool MeshObject::is_diced() const
+{
+    return impl->m_diced_tess.get() != nullptr;
+}
+
+size_t MeshObject::get_dicing_level() const
+{
+    return impl->m_dicing_level;
+}
+
+uint64 MeshObject::compute_dicing_signature() const
+{
+    uint64 signature = siphash24(get_version_id(), impl->m_cage_version_id);
+
+    const Source* displacement_map = m_inputs.source("displacement_map");
+    if (displacement_map != nullptr)
+    {
+        const float displacement_scale = m_params.get_optional<float>("displacement_scale", 1.0f);
+        signature = combine_signatures(signature, displacement_map->compute_signature());
+        signature = combine_signatures(signature, binary_cast<uint32>(displacement_scale));
+    }
+
+    return signature;
+}
+
+uint64 MeshObject::get_dicing_signature() const
+{
+    return impl->m_dicing_signature;
+}
+
+bool MeshObject::page_out(GeometryPager& pager)
+{
+    if (is_paged_out())
+        return true;
+
+    // Tessellations shared with other mesh objects stay in memory.
+    if (!is_diced() && is_sharing_geometry())
+        return false;
+
+    StaticTriangleTess& tess = impl->m_region.get_tess();
+    const GAABB3 bbox = tess.compute_local_bbox();
+
+    Lazy<StaticTriangleTess>* paged_tess = pager.page_out(tess);
+    if (paged_tess == nullptr)
+        return false;
+
+    tess.clear();
+    impl->m_region.set_paged_tess(paged_tess, bbox);
+    impl->m_pager = &pager;
+
+    return true;
+}
+
+bool MeshObject::page_in()
+{
+    if (!is_paged_out())
+        return true;
+
+    if (!impl->m_pager->page_in(impl->m_region.get_paged_tess(), impl->m_region.get_tess()))
+        return false;
+
+    impl->m_region.set_paged_tess(nullptr, GAABB3());
+    impl->m_pager = nullptr;
+
+    return true;
+}
+
+void MeshObject::discard_paged_geometry()
+{
+    impl->m_region.set_paged_tess(nullptr, GAABB3());
+    impl->m_pager = nullptr;
+}
+
+bool MeshObject::is_paged_out() const
+{
+    return impl->m_pager != nullptr;
+}
+
 void MeshObject::reserve_vertices(const size_t count)
 {
-    impl->m_tess.m_vertices.reserve(count);
+    impl->unshare();
+    impl->m_tess->m_vertices.reserve(count);
 }
 
 size_t MeshObject::push_vertex(const GVector3& vertex)
 {
-    const size_t index = impl->m_tess.m_vertices.size();
-    impl->m_tess.m_vertices.push_back(vertex);
+    impl->unshare();
+    const size_t index = impl->m_tess->m_vertices.size();
+    impl->m_tess->m_vertices.push_back(vertex);
     return index;
 }
 
 size_t MeshObject::get_vertex_count() const
 {
-    return impl->m_tess.m_vertices.size();
+    return impl->m_tess->m_vertices.size();
 }
 
 const GVector3& MeshObject::get_vertex(const size_t index) const
 {
-    return impl->m_tess.m_vertices[index];
+    return impl->m_tess->m_vertices[index];
 }
 
 void MeshObject::reserve_vertex_normals(const size_t count)
 {
-    impl->m_tess.m_vertex_normals.reserve(count);
+    impl->unshare();
+    impl->m_tess->m_vertex_normals.reserve(count);
 }
 
 size_t MeshObject::push_vertex_normal(const GVector3& normal)
 {
+    impl->unshare();
     assert(is_normalized(normal));
 
-    const size_t index = impl->m_tess.m_vertex_normals.size();
-    impl->m_tess.m_vertex_normals.push_back(normal);
+    const size_t index = impl->m_tess->m_vertex_normals.size();
+    impl->m_tess->m_vertex_normals.push_back(normal);
     return index;
 }
 
 size_t MeshObject::get_vertex_normal_count() const
 {
-    return impl->m_tess.m_vertex_normals.size();
+    return impl->m_tess->m_vertex_normals.size();
 }
 
 const GVector3& MeshObject::get_vertex_normal(const size_t index) const
 {
-    return impl->m_tess.m_vertex_normals[index];
+    return impl->m_tess->m_vertex_normals[index];
 }
 
 void MeshObject::clear_vertex_normals()
 {
-    impl->m_tess.m_vertex_normals.clear();
+    impl->unshare();
+    impl->m_tess->m_vertex_normals.clear();
 }
 
 void MeshObject::reserve_vertex_tangents(const size_t count)
 {
-    impl->m_tess.reserve_vertex_tangents(count);
+    impl->unshare();
+    impl->m_tess->reserve_vertex_tangents(count);
 }
 
 size_t MeshObject::push_vertex_tangent(const GVector3& tangent)
 {
-    return impl->m_tess.push_vertex_tangent(tangent);
+    impl->unshare();
+    return impl->m_tess->push_vertex_tangent(tangent);
 }
 
 size_t MeshObject::get_vertex_tangent_count() const
 {
-    return impl->m_tess.get_vertex_tangent_count();
+    return impl->m_tess->get_vertex_tangent_count();
 }
 
 GVector3 MeshObject::get_vertex_tangent(const size_t index) const
 {
-    return impl->m_tess.get_vertex_tangent(index);
+    return impl->m_tess->get_vertex_tangent(index);
 }
 
 void MeshObject::reserve_tex_coords(const size_t count)
 {
-    impl->m_tess.reserve_tex_coords(count);
+    impl->unshare();
+    impl->m_tess->reserve_tex_coords(count);
 }
 
 size_t MeshObject::push_tex_coords(const GVector2& tex_coords)
 {
-    return impl->m_tess.push_tex_coords(tex_coords);
+    impl->unshare();
+    return impl->m_tess->push_tex_coords(tex_coords);
 }
 
 size_t MeshObject::get_tex_coords_count() const
 {
-    return impl->m_tess.get_tex_coords_count();
+    return impl->m_tess->get_tex_coords_count();
 }
 
 GVector2 MeshObject::get_tex_coords(const size_t index) const
 {
-    return impl->m_tess.get_tex_coords(index);
+    return impl->m_tess->get_tex_coords(index);
 }
 
 void MeshObject::reserve_triangles(const size_t count)
 {
-    impl->m_tess.m_primitives.reserve(count);
+    impl->unshare();
+    impl->m_tess->m_primitives.reserve(count);
 }
 
 size_t MeshObject::push_triangle(const Triangle& triangle)
 {
-    const size_t index = impl->m_tess.m_primitives.size();
-    impl->m_tess.m_primitives.push_back(triangle);
+    impl->unshare();
+    const size_t index = impl->m_tess->m_primitives.size();
+    impl->m_tess->m_primitives.push_back(triangle);
     return index;
 }
 
 size_t MeshObject::get_triangle_count() const
 {
-    return impl->m_tess.m_primitives.size();
+    return impl->m_tess->m_primitives.size();
 }
 
 const Triangle& MeshObject::get_triangle(const size_t index) const
 {
-    return impl->m_tess.m_primitives[index];
+    return impl->m_tess->m_primitives[index];
 }
 
 Triangle& MeshObject::get_triangle(const size_t index)
 {
-    return impl->m_tess.m_primitives[index];
+    impl->unshare();
+    return impl->m_tess->m_primitives[index];
 }
 
 void MeshObject::clear_triangles()
 {
-    impl->m_tess.m_primitives.clear();
+    impl->unshare();
+    impl->m_tess->m_primitives.clear();
 }
 
 void MeshObject::set_motion_segment_count(const size_t count)
 {
-    impl->m_tess.set_motion_segment_count(count);
+    impl->unshare();
+    impl->m_tess->set_motion_segment_count(count);
 }
 
 size_t MeshObject::get_motion_segment_count() const
 {
-    return impl->m_tess.get_motion_segment_count();
+    return impl->m_tess->get_motion_segment_count();
 }
 
 void MeshObject::set_vertex_pose(
@@ -330,19 +658,21 @@ void MeshObject::set_vertex_pose(
     const size_t            motion_segment_index,
     const GVector3&         vertex)
 {
-    impl->m_tess.set_vertex_pose(vertex_index, motion_segment_index, vertex);
+    impl->unshare();
+    impl->m_tess->set_vertex_pose(vertex_index, motion_segment_index, vertex);
 }
 
 GVector3 MeshObject::get_vertex_pose(
     const size_t            vertex_index,
     const size_t            motion_segment_index) const
 {
-    return impl->m_tess.get_vertex_pose(vertex_index, motion_segment_index);
+    return impl->m_tess->get_vertex_pose(vertex_index, motion_segment_index);
 }
 
 void MeshObject::clear_vertex_poses()
 {
-    impl->m_tess.clear_vertex_poses();
+    impl->unshare();
+    impl->m_tess->clear_vertex_poses();
 }
 
 void MeshObject::set_vertex_normal_pose(
@@ -350,19 +680,21 @@ void MeshObject::set_vertex_normal_pose(
     const size_t            motion_segment_index,
     const GVector3&         normal)
 {
-    impl->m_tess.set_vertex_normal_pose(normal_index, motion_segment_index, normal);
+    impl->unshare();
+    impl->m_tess->set_vertex_normal_pose(normal_index, motion_segment_index, normal);
 }
 
 GVector3 MeshObject::get_vertex_normal_pose(
     const size_t            normal_index,
     const size_t            motion_segment_index) const
 {
-    return impl->m_tess.get_vertex_normal_pose(normal_index, motion_segment_index);
+    return impl->m_tess->get_vertex_normal_pose(normal_index, motion_segment_index);
 }
 
 void MeshObject::clear_vertex_normal_poses()
 {
-    impl->m_tess.clear_vertex_normal_poses();
+    impl->unshare();
+    impl->m_tess->clear_vertex_normal_poses();
 }
 
 void MeshObject::set_vertex_tangent_pose(
@@ -370,19 +702,21 @@ void MeshObject::set_vertex_tangent_pose(
     const size_t            motion_segment_index,
     const GVector3&         tangent)
 {
-    impl->m_tess.set_vertex_tangent_pose(tangent_index, motion_segment_index, tangent);
+    impl->unshare();
+    impl->m_tess->set_vertex_tangent_pose(tangent_index, motion_segment_index, tangent);
 }
 
 GVector3 MeshObject::get_vertex_tangent_pose(
     const size_t            tangent_index,
     const size_t            motion_segment_index) const
 {
-    return impl->m_tess.get_vertex_tangent_pose(tangent_index, motion_segment_index);
+    return impl->m_tess->get_vertex_tangent_pose(tangent_index, motion_segment_index);
 }
 
 void MeshObject::clear_vertex_tangent_poses()
 {
-    impl->m_tess.clear_vertex_tangent_poses();
+    impl->unshare();
+    impl->m_tess->clear_vertex_tangent_poses();
 }
 
 void MeshObject::reserve_material_slots(const size_t count)
@@ -477,6 +811,61 @@ DictionaryArray MeshObjectFactory::get_input_metadata() const
                     .insert("type", "hard"))
             .insert("use", "optional"));
 
+    metadata.push_back(
+        Dictionary()
+            .insert("name", "subdivision_scheme")
+            .insert("label", "Subdivision Scheme")
+            .insert("type", "enumeration")
+            .insert("items",
+                Dictionary()
+                    .insert("None", "none")
+                    .insert("Loop", "loop"))
+            .insert("use", "optional")
+            .insert("default", "none"));
+
+    metadata.push_back(
+        Dictionary()
+            .insert("name", "max_subdivision_level")
+            .insert("label", "Max Subdivision Level")
+            .insert("type", "integer")
+            .insert("min",
+                Dictionary()
+                    .insert("value", "0")
+                    .insert("type", "hard"))
+            .insert("max",
+                Dictionary()
+                    .insert("value", "8")
+                    .insert("type", "soft"))
+            .insert("use", "optional")
+            .insert("default", "4"));
+
+    metadata.push_back(
+        Dictionary()
+            .insert("name", "displacement_map")
+            .insert("label", "Displacement Map")
+            .insert("type", "colormap")
+            .insert("entity_types",
+                Dictionary()
+                    .insert("color", "Colors")
+                    .insert("texture_instance", "Texture Instances"))
+            .insert("use", "optional"));
+
+    metadata.push_back(
+        Dictionary()
+            .insert("name", "displacement_scale")
+            .insert("label", "Displacement Scale")
+            .insert("type", "numeric")
+            .insert("min",
+                Dictionary()
+                    .insert("value", "-1.0")
+                    .insert("type", "soft"))
+            .insert("max",
+                Dictionary()
+                    .insert("value", "1.0")
+                    .insert("type", "soft"))
+            .insert("use", "optional")
+            .insert("default", "1.0"));
+
     return metadata;
 }
 
@@ -53,9 +53,11 @@ namespace foundation    { class DictionaryArray; }
 namespace foundation    { class SearchPaths; }
 namespace foundation    { class StringArray; }
 namespace foundation    { class StringDictionary; }
+namespace renderer      { class GeometryPager; }
 namespace renderer      { class ObjectRasterizer; }
 namespace renderer      { class ParamArray; }
 namespace renderer      { class Source; }
+namespace renderer      { class TextureCache; }
 namespace renderer      { class Triangle; }
 
 namespace renderer
@@ -89,6 +91,65 @@ class APPLESEED_DLLSYMBOL MeshObject
     // Send this object to an object rasterizer.
     void rasterize(ObjectRasterizer& drawer) const override;
 
+    // Make this mesh object share the geometry of another mesh object, which must be
+    // identical, releasing its own copy. The geometry is copied again, on a per-object
+    // basis, as soon as it is modified through one of the methods below.
+    void share_geometry(MeshObject& source);
+
+    // Return true if the geometry of this mesh object is shared with other mesh objects.
+    bool is_sharing_geometry() const;
+
+    // Return an identifier that is the same for all mesh objects sharing the same
+    // rendering geometry. Diced mesh objects never share their rendering geometry.
+    foundation::UniqueID get_geometry_uid() const;
+
+    // Return the amount of memory used by the geometry of this mesh object (including
+    // diced geometry), in bytes. Shared geometry is accounted for by each object.
+    size_t get_geometry_memory_size() const;
+
+    // Return true if this mesh must be diced (subdivided and/or displaced) before rendering.
+    bool needs_dicing() const;
+
+    // Return the maximum subdivision level allowed for this mesh, 0 if it is not a subdivision surface.
+    size_t get_max_subdivision_level() const;
+
+    // Subdivide the mesh a given number of times, then displace it using its displacement
+    // map, if any. The diced geometry replaces the original geometry (the base cage) for
+    // rendering; the accessors below keep referring to the base cage.
+    void dice(
+        const size_t        subdivision_level,
+        TextureCache&       texture_cache);
+
+    // Discard the diced geometry and render the base cage again.
+    void clear_dicing();
+
+    // Return true if the mesh is diced, and the subdivision level of the diced geometry.
+    bool is_diced() const;
+    size_t get_dicing_level() const;
+
+    // Compute a signature of everything the diced geometry depends on besides the subdivision
+    // level: the version of the object, the version of its base cage and the displacement map
+    // and scale. get_dicing_signature() returns the signature at the time the mesh was diced.
+    foundation::uint64 compute_dicing_signature() const;
+    foundation::uint64 get_dicing_signature() const;
+
+    // Move the geometry of this mesh to a geometry pager, which will load it on demand.
+    // While the mesh is paged out, its geometry is only available through its region
+    // kit: the accessors below must not be used until page_in() is called.
+    // Return true if the geometry was successfully paged out.
+    bool page_out(GeometryPager& pager);
+
+    // Move the geometry of this mesh back into memory. Return false if the geometry
+    // could not be read back, in which case the mesh remains paged out.
+    bool page_in();
+
+    // Forget the paged out geometry of this mesh, which becomes empty. Used when the
+    // geometry cannot be paged back in and its geometry pager is about to be destroyed.
+    void discard_paged_geometry();
+
+    // Return true if the geometry of this mesh is paged out.
+    bool is_paged_out() const;
+
     // Insert and access vertices.
     void reserve_vertices(const size_t count);
     size_t push_vertex(const GVector3& vertex);
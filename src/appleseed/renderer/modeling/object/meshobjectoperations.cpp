@@ -32,16 +32,33 @@
 // appleseed.renderer headers.
 #include "renderer/global/globaltypes.h"
 #include "renderer/modeling/object/meshobject.h"
+#include "renderer/modeling/object/object.h"
 #include "renderer/modeling/object/triangle.h"
+#include "renderer/modeling/scene/assembly.h"
+#include "renderer/modeling/scene/assemblyinstance.h"
+#include "renderer/modeling/scene/basegroup.h"
+#include "renderer/modeling/scene/containers.h"
+#include "renderer/modeling/scene/objectinstance.h"
+#include "renderer/modeling/scene/scene.h"
 #include "renderer/utility/triangle.h"
 
 // appleseed.foundation headers.
 #include "foundation/math/vector.h"
+#include "foundation/platform/types.h"
+#include "foundation/utility/foreach.h"
 #include "foundation/utility/murmurhash.h"
+#include "foundation/utility/string.h"
+#include "foundation/utility/uid.h"
 
 // Standard headers.
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <cstring>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
 #include <vector>
 
 using namespace foundation;
@@ -268,4 +285,169 @@ void compute_signature(MurmurHash& hash, const MeshObject& object)
     }
 }
 
+namespace
+{
+    void collect_mesh_objects(
+        AssemblyContainer&          assemblies,
+        vector<MeshObject*>&        mesh_objects)
+    {
+        for (each<AssemblyContainer> i = assemblies; i; ++i)
+        {
+            for (each<ObjectContainer> j = i->objects(); j; ++j)
+            {
+                if (strcmp(j->get_model(), MeshObjectFactory().get_model()) == 0)
+                    mesh_objects.push_back(static_cast<MeshObject*>(&*j));
+            }
+
+            collect_mesh_objects(i->assemblies(), mesh_objects);
+        }
+    }
+
+    void count_assembly_instances(
+        const BaseGroup&            group,
+        const size_t                multiplicity,
+        map<const Assembly*, size_t>& counts)
+    {
+        for (const_each<AssemblyInstanceContainer> i = group.assembly_instances(); i; ++i)
+        {
+            const Assembly* assembly = i->find_assembly();
+
+            if (assembly != nullptr)
+            {
+                counts[assembly] += multiplicity;
+                count_assembly_instances(*assembly, multiplicity, counts);
+            }
+        }
+    }
+
+    struct MeshObjectInfo
+    {
+        const MeshObject*   m_object;
+        size_t              m_memory_size;
+        size_t              m_instance_count;
+
+        bool operator<(const MeshObjectInfo& rhs) const
+        {
+            return m_memory_size > rhs.m_memory_size;
+        }
+    };
+}
+
+size_t deduplicate_mesh_objects(Scene& scene)
+{
+    vector<MeshObject*> mesh_objects;
+    collect_mesh_objects(scene.assemblies(), mesh_objects);
+
+    // Mesh objects are considered identical if their signatures and sizes match.
+    typedef pair<MurmurHash, pair<size_t, size_t>> MeshKey;
+    map<MeshKey, MeshObject*> unique_meshes;
+
+    size_t deduplicated_count = 0;
+
+    for (MeshObject* mesh_object : mesh_objects)
+    {
+        if (mesh_object->is_paged_out() || mesh_object->is_diced())
+            continue;
+
+        MurmurHash hash;
+        compute_signature(hash, *mesh_object);
+
+        const MeshKey key(
+            hash,
+            make_pair(mesh_object->get_vertex_count(), mesh_object->get_triangle_count()));
+
+        const auto it = unique_meshes.find(key);
+
+        if (it == unique_meshes.end())
+            unique_meshes[key] = mesh_object;
+        else
+        {
+            mesh_object->share_geometry(*it->second);
+            ++deduplicated_count;
+        }
+    }
+
+    return deduplicated_count;
+}
+
+StatisticsVector compute_mesh_memory_statistics(const Scene& scene)
+{
+    const size_t MaxLargestMeshCount = 10;
+
+    vector<MeshObject*> mesh_objects;
+    collect_mesh_objects(scene.assemblies(), mesh_objects);
+
+    // Count how many times each assembly is instantiated, directly or not.
+    map<const Assembly*, size_t> assembly_instance_counts;
+    count_assembly_instances(scene, 1, assembly_instance_counts);
+
+    // Count how many times each mesh object is instantiated.
+    map<const Object*, size_t> object_instance_counts;
+    for (const auto& assembly_entry : assembly_instance_counts)
+    {
+        for (const_each<ObjectInstanceContainer> i = assembly_entry.first->object_instances(); i; ++i)
+        {
+            const Object* object = i->find_object();
+            if (object != nullptr)
+                object_instance_counts[object] += assembly_entry.second;
+        }
+    }
+
+    vector<MeshObjectInfo> infos;
+    infos.reserve(mesh_objects.size());
+
+    set<UniqueID> geometry_uids;
+    uint64 unique_memory_size = 0;
+    uint64 unshared_memory_size = 0;
+    uint64 uninstanced_memory_size = 0;
+    uint64 instance_count = 0;
+
+    for (const MeshObject* mesh_object : mesh_objects)
+    {
+        MeshObjectInfo info;
+        info.m_object = mesh_object;
+        info.m_memory_size = mesh_object->get_geometry_memory_size();
+
+        const auto it = object_instance_counts.find(mesh_object);
+        info.m_instance_count = it != object_instance_counts.end() ? it->second : 0;
+
+        if (geometry_uids.insert(mesh_object->get_geometry_uid()).second)
+            unique_memory_size += info.m_memory_size;
+
+        unshared_memory_size += info.m_memory_size;
+        uninstanced_memory_size += info.m_memory_size * info.m_instance_count;
+        instance_count += info.m_instance_count;
+
+        infos.push_back(info);
+    }
+
+    Statistics stats;
+    stats.insert<uint64>("mesh objects", mesh_objects.size());
+    stats.insert<uint64>("mesh instances", instance_count);
+    stats.insert<uint64>("unique geometries", geometry_uids.size());
+    stats.insert_size("memory", unique_memory_size);
+    stats.insert_size("memory w/o sharing", unshared_memory_size);
+    stats.insert_size("memory w/o instancing", uninstanced_memory_size);
+
+    const size_t largest_count = min(infos.size(), MaxLargestMeshCount);
+    partial_sort(infos.begin(), infos.begin() + largest_count, infos.end());
+
+    Statistics largest_stats;
+    for (size_t i = 0; i < largest_count; ++i)
+    {
+        const MeshObjectInfo& info = infos[i];
+        largest_stats.insert<string>(
+            "#" + foundation::to_string(i + 1) + " " + info.m_object->get_name(),
+            pretty_size(info.m_memory_size) + ", " +
+            pretty_uint(info.m_instance_count) +
+            (info.m_instance_count == 1 ? " instance" : " instances"));
+    }
+
+    StatisticsVector stats_vector;
+    stats_vector.insert("mesh memory statistics", stats);
+    stats_vector.insert("largest mesh objects", largest_stats);
+
+    return stats_vector;
+}
+
 }   // namespace renderer
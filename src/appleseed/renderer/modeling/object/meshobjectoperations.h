@@ -29,12 +29,19 @@
 #ifndef APPLESEED_RENDERER_MODELING_OBJECT_MESHOBJECTOPERATIONS_H
 #define APPLESEED_RENDERER_MODELING_OBJECT_MESHOBJECTOPERATIONS_H
 
+// appleseed.foundation headers.
+#include "foundation/utility/statistics.h"
+
 // appleseed.main headers.
 #include "main/dllsymbol.h"
 
+// Standard headers.
+#include <cstddef>
+
 // Forward declarations.
 namespace foundation { class MurmurHash; }
 namespace renderer   { class MeshObject; }
+namespace renderer   { class Scene; }
 
 namespace renderer
 {
@@ -51,6 +58,14 @@ APPLESEED_DLLSYMBOL void compute_smooth_vertex_tangents(MeshObject& object);
 // Compute a hash for a mesh object.
 APPLESEED_DLLSYMBOL void compute_signature(foundation::MurmurHash& hash, const MeshObject& object);
 
+// Make all mesh objects of a scene that have identical geometry share a single copy of it.
+// Returns the number of mesh objects whose geometry was released.
+APPLESEED_DLLSYMBOL size_t deduplicate_mesh_objects(Scene& scene);
+
+// Compute memory usage statistics for the mesh objects of a scene, taking instancing
+// and geometry sharing into account.
+APPLESEED_DLLSYMBOL foundation::StatisticsVector compute_mesh_memory_statistics(const Scene& scene);
+
 }       // namespace renderer
 
 #endif  // !APPLESEED_RENDERER_MODELING_OBJECT_MESHOBJECTOPERATIONS_H
@@ -39,6 +39,8 @@
 #include "renderer/kernel/rendering/final/uniformpixelrenderer.h"
 #include "renderer/kernel/rendering/generic/genericframerenderer.h"
 #include "renderer/kernel/rendering/progressive/progressiveframerenderer.h"
+#include "renderer/kernel/tessellation/geometrypager.h"
+#include "renderer/kernel/tessellation/meshtessellator.h"
 #include "renderer/kernel/texturing/texturestore.h"
 #include "renderer/utility/paramarray.h"
 
@@ -209,6 +211,14 @@ Dictionary Configuration::get_metadata()
         "texture_store",
         TextureStore::get_params_metadata());
 
+    metadata.dictionaries().insert(
+        "geometry_pager",
+        GeometryPager::get_params_metadata());
+
+    metadata.dictionaries().insert(
+        "tessellation",
+        MeshTessellator::get_params_metadata());
+
     metadata.dictionaries().insert(
         "uniform_pixel_renderer",
         UniformPixelRendererFactory::get_params_metadata());
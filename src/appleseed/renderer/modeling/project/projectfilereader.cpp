@@ -65,6 +65,7 @@
 #include "renderer/modeling/material/material.h"
 #include "renderer/modeling/material/materialfactoryregistrar.h"
 #include "renderer/modeling/object/iobjectfactory.h"
+#include "renderer/modeling/object/meshobjectoperations.h"
 #include "renderer/modeling/object/object.h"
 #include "renderer/modeling/object/objectfactoryregistrar.h"
 #include "renderer/modeling/postprocessingstage/ipostprocessingstagefactory.h"
@@ -100,6 +101,7 @@
 #include "renderer/utility/transformsequence.h"
 
 // appleseed.foundation headers.
+#include "foundation/core/exceptions/exceptionioerror.h"
 #include "foundation/core/exceptions/exceptionunsupportedfileformat.h"
 #include "foundation/math/aabb.h"
 #include "foundation/math/matrix.h"
@@ -111,6 +113,7 @@
 #include "foundation/platform/types.h"
 #include "foundation/utility/api/apiarray.h"
 #include "foundation/utility/api/apistring.h"
+#include "foundation/utility/binaryxml.h"
 #include "foundation/utility/containers/dictionary.h"
 #include "foundation/utility/foreach.h"
 #include "foundation/utility/iterators.h"
@@ -672,6 +675,13 @@ namespace
             get_vector(transcode(chars), m_values, m_context);
         }
 
+        void numeric_characters(
+            const double*       values,
+            const size_t        count) override
+        {
+            m_values.insert(m_values.end(), values, values + count);
+        }
+
         const Matrix4d& get_matrix() const
         {
             return m_matrix;
@@ -998,6 +1008,14 @@ namespace
             get_vector(transcode(chars), m_values, m_context);
         }
 
+        void numeric_characters(
+            const double*       values,
+            const size_t        count) override
+        {
+            for (size_t i = 0; i < count; ++i)
+                m_values.push_back(static_cast<float>(values[i]));
+        }
+
         const ColorValueArray& get_values() const
         {
             return m_values;
@@ -3437,12 +3455,6 @@ auto_release_ptr<Project> ProjectFileReader::load_project_file(
         project->search_paths() = *search_paths;
     }
 
-    // Create the error handler.
-    unique_ptr<ErrorLogger> error_handler(
-        new ErrorLoggerAndCounter(
-            project_filepath,
-            event_counters));
-
     // Create the content handler.
     ParseContext context(project.ref(), options, event_counters);
     unique_ptr<ContentHandler> content_handler(
@@ -3450,6 +3462,32 @@ auto_release_ptr<Project> ProjectFileReader::load_project_file(
             project.get(),
             context));
 
+    // Binary project files are replayed directly into the content handler.
+    if (BinaryXMLReader::is_binary_xml_file(project_filepath))
+    {
+        RENDERER_LOG_INFO("loading binary project file %s...", project_filepath);
+
+        try
+        {
+            BinaryXMLReader reader;
+            reader.read(project_filepath, *content_handler);
+        }
+        catch (const ExceptionIOError& e)
+        {
+            RENDERER_LOG_ERROR("failed to load binary project file %s: %s.", project_filepath, e.what());
+            event_counters.signal_error();
+            return auto_release_ptr<Project>(nullptr);
+        }
+
+        return project;
+    }
+
+    // Create the error handler.
+    unique_ptr<ErrorLogger> error_handler(
+        new ErrorLoggerAndCounter(
+            project_filepath,
+            event_counters));
+
     // Create the parser.
     unique_ptr<SAX2XMLReader> parser(XMLReaderFactory::createXMLReader());
     parser->setFeature(XMLUni::fgSAX2CoreNameSpaces, true);         // perform namespace processing
@@ -3586,6 +3624,16 @@ void ProjectFileReader::complete_project(
             EnvironmentFactory::create("environment", ParamArray()));
         project.get_scene()->set_environment(environment);
     }
+
+    // Let identical mesh objects share a single copy of their geometry.
+    const size_t deduplicated_count = deduplicate_mesh_objects(*project.get_scene());
+    if (deduplicated_count > 0)
+    {
+        RENDERER_LOG_INFO(
+            "found %s duplicate mesh object%s, geometry will be shared.",
+            pretty_uint(deduplicated_count).c_str(),
+            deduplicated_count > 1 ? "s" : "");
+    }
 }
 
 void ProjectFileReader::upgrade_project(
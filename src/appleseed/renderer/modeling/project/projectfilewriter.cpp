@@ -72,7 +72,10 @@
 
 // appleseed.foundation headers.
 #include "foundation/core/appleseed.h"
+#include "foundation/core/exceptions/exceptionioerror.h"
 #include "foundation/math/transform.h"
+#include "foundation/platform/snprintf.h"
+#include "foundation/utility/binaryxml.h"
 #include "foundation/utility/containers/dictionary.h"
 #include "foundation/utility/foreach.h"
 #include "foundation/utility/indenter.h"
@@ -113,26 +116,39 @@ namespace
     const char* MatrixFormat     = "%.15f";
     const char* ColorValueFormat = "%.6f";
 
+    // Floating-point formatting settings that allow values to be read back exactly.
+    const char* LosslessMatrixFormat     = "%.17g";
+    const char* LosslessColorValueFormat = "%.9g";
+
     class Writer
     {
       public:
-        // Constructor.
+        // Constructor. Binary project files store floating-point values
+        // without loss of precision, plain project files keep them readable.
         Writer(
             const Project&      project,
             const char*         filepath,
-            FILE*               file,
-            const int           options)
+            const XMLOutput&    output,
+            const int           options,
+            const bool          lossless_floating_point_values)
           : m_project_new_root_dir(filesystem::path(filepath).parent_path())
-          , m_file(file)
+          , m_output(output)
           , m_options(options)
-          , m_indenter(4)
+          , m_matrix_format(
+                lossless_floating_point_values
+                    ? LosslessMatrixFormat
+                    : MatrixFormat)
+          , m_color_value_format(
+                lossless_floating_point_values
+                    ? LosslessColorValueFormat
+                    : ColorValueFormat)
         {
         }
 
         // Write the <project> element.
         void write_project(const Project& project)
         {
-            XMLElement element("project", m_file, m_indenter);
+            XMLElement element("project", m_output);
             element.add_attribute("format_revision", project.get_format_revision());
             element.write(XMLElement::HasChildElements);
 
@@ -150,9 +166,10 @@ namespace
 
       private:
         const filesystem::path  m_project_new_root_dir;
-        FILE*                   m_file;
+        const XMLOutput         m_output;
         const int               m_options;
-        Indenter                m_indenter;
+        const char*             m_matrix_format;
+        const char*             m_color_value_format;
 
         // Write a vector of scalars.
         template <typename Vec>
@@ -164,25 +181,32 @@ namespace
         {
             assert(columns > 0);
 
+            string text;
+
             for (size_t i = 0; i < size; ++i)
             {
                 const size_t col = i % columns;
 
                 if (col == 0)
-                    fputs(m_indenter.c_str(), m_file);
-                else fputc(' ', m_file);
+                    text += m_output.get_indentation();
+                else text += ' ';
 
-                fprintf(m_file, fmt, v[i]);
+                // Large enough for any double printed with a fixed-point format.
+                char buffer[512];
+                portable_snprintf(buffer, sizeof(buffer), fmt, v[i]);
+                text += buffer;
 
                 if (col == columns - 1 || i == size - 1)
-                    fputc('\n', m_file);
+                    text += '\n';
             }
+
+            m_output.characters(text);
         }
 
         // Write a (possibly hierarchical) set of parameters.
         void write_params(const Dictionary& params)
         {
-            write_dictionary(params, m_file, m_indenter);
+            write_dictionary(params, m_output);
         }
 
         // Write a <transform> element.
@@ -192,18 +216,18 @@ namespace
             if (transform.get_local_to_parent() == Matrix<T, 4, 4>::identity())
                 return;
 
-            XMLElement element("transform", m_file, m_indenter);
+            XMLElement element("transform", m_output);
             element.write(XMLElement::HasChildElements);
 
             {
-                XMLElement child_element("matrix", m_file, m_indenter);
+                XMLElement child_element("matrix", m_output);
                 child_element.write(XMLElement::HasChildElements);
 
                 write_vector(
                     transform.get_local_to_parent(),
                     16,
                     4,
-                    MatrixFormat);
+                    m_matrix_format);
             }
         }
 
@@ -225,19 +249,19 @@ namespace
                 Transformd transform;
                 transform_sequence.get_transform(i, time, transform);
 
-                XMLElement element("transform", m_file, m_indenter);
+                XMLElement element("transform", m_output);
                 element.add_attribute("time", time);
                 element.write(XMLElement::HasChildElements);
 
                 {
-                    XMLElement child_element("matrix", m_file, m_indenter);
+                    XMLElement child_element("matrix", m_output);
                     child_element.write(XMLElement::HasChildElements);
 
                     write_vector(
                         transform.get_local_to_parent(),
                         16,
                         4,
-                        MatrixFormat);
+                        m_matrix_format);
                 }
             }
         }
@@ -245,13 +269,13 @@ namespace
         // Write an array of color values.
         void write_value_array(const char* element_name, const ColorValueArray& values)
         {
-            XMLElement element(element_name, m_file, m_indenter);
+            XMLElement element(element_name, m_output);
             element.write(XMLElement::HasChildElements);
             write_vector(
                 values,
                 values.size(),
                 8,
-                ColorValueFormat);
+                m_color_value_format);
         }
 
         template <typename Entity>
@@ -263,7 +287,7 @@ namespace
         template <typename Entity>
         void write_entity(const char* element_name, const Entity& entity, const char* entity_name)
         {
-            XMLElement element(element_name, m_file, m_indenter);
+            XMLElement element(element_name, m_output);
             element.add_attribute("name", entity_name);
             element.add_attribute("model", entity.get_model());
             element.write(
@@ -314,7 +338,7 @@ namespace
         // Write an <aov> element.
         void write(const AOV& aov)
         {
-            XMLElement element("aov", m_file, m_indenter);
+            XMLElement element("aov", m_output);
             element.add_attribute("model", aov.get_model());
             element.write(
                 !aov.get_parameters().empty()
@@ -330,7 +354,7 @@ namespace
             AOVContainer& aovs = frame.aovs();
             if (!aovs.empty())
             {
-                XMLElement element("aovs", m_file, m_indenter);
+                XMLElement element("aovs", m_output);
                 element.write(XMLElement::HasChildElements);
                 write_collection(aovs);
             }
@@ -339,7 +363,7 @@ namespace
         // Write an <assembly> element.
         void write(const Assembly& assembly)
         {
-            XMLElement element("assembly", m_file, m_indenter);
+            XMLElement element("assembly", m_output);
             element.add_attribute("name", assembly.get_name());
 
             // Don't write the assembly model for normal assemblies
@@ -402,7 +426,7 @@ namespace
         // Write an <assembly_instance> element.
         void write(const AssemblyInstance& assembly_instance)
         {
-            XMLElement element("assembly_instance", m_file, m_indenter);
+            XMLElement element("assembly_instance", m_output);
             element.add_attribute("name", assembly_instance.get_name());
             element.add_attribute("assembly", assembly_instance.get_assembly_name());
             element.write(XMLElement::HasChildElements);
@@ -417,7 +441,7 @@ namespace
             const string&               side,
             const string&               name)
         {
-            XMLElement element("assign_material", m_file, m_indenter);
+            XMLElement element("assign_material", m_output);
             element.add_attribute("slot", slot);
             element.add_attribute("side", side);
             element.add_attribute("material", name);
@@ -450,7 +474,7 @@ namespace
         // Write a <camera> element.
         void write(const Camera& camera)
         {
-            XMLElement element("camera", m_file, m_indenter);
+            XMLElement element("camera", m_output);
             element.add_attribute("name", camera.get_name());
             element.add_attribute("model", camera.get_model());
             element.write(XMLElement::HasChildElements);
@@ -462,7 +486,7 @@ namespace
         // Write a <color> element.
         void write(const ColorEntity& color_entity)
         {
-            XMLElement element("color", m_file, m_indenter);
+            XMLElement element("color", m_output);
             element.add_attribute("name", color_entity.get_name());
             element.write(XMLElement::HasChildElements);
 
@@ -475,7 +499,7 @@ namespace
         // Write a <configuration> element.
         void write_configuration(const Configuration& configuration)
         {
-            XMLElement element("configuration", m_file, m_indenter);
+            XMLElement element("configuration", m_output);
             element.add_attribute("name", configuration.get_name());
             if (configuration.get_base())
                 element.add_attribute("base", configuration.get_base()->get_name());
@@ -502,7 +526,7 @@ namespace
         // Write a <configurations> element.
         void write_configurations(const Project& project)
         {
-            XMLElement element("configurations", m_file, m_indenter);
+            XMLElement element("configurations", m_output);
             element.write(
                 count_non_base_configurations(project.configurations()) > 0
                     ? XMLElement::HasChildElements
@@ -520,7 +544,7 @@ namespace
         // Write a <display> element.
         void write(const Display& display)
         {
-            XMLElement element("display", m_file, m_indenter);
+            XMLElement element("display", m_output);
             element.add_attribute("name", display.get_name());
             element.write(
                 !display.get_parameters().empty()
@@ -545,7 +569,7 @@ namespace
         // Write an <environment_edf> element.
         void write(const EnvironmentEDF& env_edf)
         {
-            XMLElement element("environment_edf", m_file, m_indenter);
+            XMLElement element("environment_edf", m_output);
             element.add_attribute("name", env_edf.get_name());
             element.add_attribute("model", env_edf.get_model());
             element.write(XMLElement::HasChildElements);
@@ -563,7 +587,7 @@ namespace
         // Write a <frame> element.
         void write_frame(const Frame& frame)
         {
-            XMLElement element("frame", m_file, m_indenter);
+            XMLElement element("frame", m_output);
             element.add_attribute("name", frame.get_name());
             element.write(
                 !frame.get_parameters().empty() ||
@@ -579,7 +603,7 @@ namespace
         // Write a <light> element.
         void write(const Light& light)
         {
-            XMLElement element("light", m_file, m_indenter);
+            XMLElement element("light", m_output);
             element.add_attribute("name", light.get_name());
             element.add_attribute("model", light.get_model());
             element.write(XMLElement::HasChildElements);
@@ -626,7 +650,7 @@ namespace
             // If the object is a mesh primitive, do not write geometry to disk.
             if (params.strings().exist("primitive"))
             {
-                XMLElement element("object", m_file, m_indenter);
+                XMLElement element("object", m_output);
                 element.add_attribute("name", object.get_name());
                 element.add_attribute("model", MeshObjectFactory().get_model());
                 element.write(XMLElement::HasChildElements);
@@ -687,7 +711,7 @@ namespace
             }
 
             // Write the <object> element.
-            XMLElement element("object", m_file, m_indenter);
+            XMLElement element("object", m_output);
             element.add_attribute("name", object_name);
             element.add_attribute("model", MeshObjectFactory().get_model());
             element.write(XMLElement::HasChildElements);
@@ -735,7 +759,7 @@ namespace
         // Write an <object_instance> element.
         void write(const ObjectInstance& object_instance)
         {
-            XMLElement element("object_instance", m_file, m_indenter);
+            XMLElement element("object_instance", m_output);
             element.add_attribute("name", object_instance.get_name());
             element.add_attribute("object", translate_object_name(object_instance.get_object_name()));
             element.write(XMLElement::HasChildElements);
@@ -750,7 +774,7 @@ namespace
         // Write an <output> element.
         void write_output(const Project& project)
         {
-            XMLElement element("output", m_file, m_indenter);
+            XMLElement element("output", m_output);
             element.write(
                 project.get_frame() != nullptr
                     ? XMLElement::HasChildElements
@@ -772,7 +796,7 @@ namespace
             PostProcessingStageContainer& stages = frame.post_processing_stages();
             if (!stages.empty())
             {
-                XMLElement element("post_processing_stages", m_file, m_indenter);
+                XMLElement element("post_processing_stages", m_output);
                 element.write(XMLElement::HasChildElements);
                 write_collection(stages);
             }
@@ -781,7 +805,7 @@ namespace
         // Write a <scene> element.
         void write_scene(const Scene& scene)
         {
-            XMLElement element("scene", m_file, m_indenter);
+            XMLElement element("scene", m_output);
             element.write(
                 !scene.cameras().empty() ||
                 !scene.colors().empty() ||
@@ -816,10 +840,11 @@ namespace
         // Write a <search_path> element.
         void write_search_path(const char* search_path)
         {
-            XMLElement element("search_path", m_file, m_indenter);
+            XMLElement element("search_path", m_output);
             element.write(XMLElement::HasChildElements);
 
-            fprintf(m_file, "%s%s\n", m_indenter.c_str(), search_path);
+            m_output.characters(
+                string(m_output.get_indentation()) + search_path + "\n");
         }
 
         // Write a <search_paths> element.
@@ -829,7 +854,7 @@ namespace
 
             if (search_paths.get_explicit_path_count() > 0)
             {
-                XMLElement element("search_paths", m_file, m_indenter);
+                XMLElement element("search_paths", m_output);
                 element.write(XMLElement::HasChildElements);
 
                 for (size_t i = 0; i < search_paths.get_explicit_path_count(); ++i)
@@ -840,7 +865,7 @@ namespace
         // Write a shader's <parameter> element.
         void write(const ShaderParam& param)
         {
-            XMLElement element("parameter", m_file, m_indenter);
+            XMLElement element("parameter", m_output);
             element.add_attribute("name", param.get_name());
             element.add_attribute("value", param.get_value_as_string());
             element.write(XMLElement::HasNoContent);
@@ -849,7 +874,7 @@ namespace
         // Write a <shader> element.
         void write(const Shader& shader)
         {
-            XMLElement element("shader", m_file, m_indenter);
+            XMLElement element("shader", m_output);
             element.add_attribute("type", shader.get_type());
             element.add_attribute("name", shader.get_shader());
             element.add_attribute("layer", shader.get_layer());
@@ -862,7 +887,7 @@ namespace
         // Write a <connect_shaders> element.
         void write(const ShaderConnection& connection)
         {
-            XMLElement element("connect_shaders", m_file, m_indenter);
+            XMLElement element("connect_shaders", m_output);
             element.add_attribute("src_layer", connection.get_src_layer());
             element.add_attribute("src_param", connection.get_src_param());
             element.add_attribute("dst_layer", connection.get_dst_layer());
@@ -873,7 +898,7 @@ namespace
         // Write a <shader_group> element.
         void write(const ShaderGroup& shader_group)
         {
-            XMLElement element("shader_group", m_file, m_indenter);
+            XMLElement element("shader_group", m_output);
             element.add_attribute("name", shader_group.get_name());
             element.write(XMLElement::HasChildElements);
 
@@ -899,7 +924,7 @@ namespace
         // Write a <texture_instance> element.
         void write(const TextureInstance& texture_instance)
         {
-            XMLElement element("texture_instance", m_file, m_indenter);
+            XMLElement element("texture_instance", m_output);
             element.add_attribute("name", texture_instance.get_name());
             element.add_attribute("texture", texture_instance.get_texture_name());
             element.write(XMLElement::HasChildElements);
@@ -908,6 +933,25 @@ namespace
             write_transform(texture_instance.get_transform());
         }
     };
+
+    // Manage references to external asset files, relative to the project file being written.
+    bool handle_asset_files(
+        Project&        project,
+        const char*     filepath,
+        const int       options)
+    {
+        if (options & ProjectFileWriter::OmitHandlingAssetFiles)
+            return true;
+
+        const AssetHandler asset_handler(
+            project,
+            filepath,
+            (options & ProjectFileWriter::CopyAllAssets) != 0
+                ? AssetHandler::CopyAllAssets
+                : AssetHandler::CopyRelativeAssetsOnly);
+
+        return asset_handler.handle_assets();
+    }
 }
 
 bool ProjectFileWriter::write(
@@ -916,10 +960,13 @@ bool ProjectFileWriter::write(
     const int       options,
     const char*     extra_comments)
 {
-    return
-        bf::path(filepath).extension() == ".appleseedz"
-            ? write_packed_project_file(project, filepath, options, extra_comments)
-            : write_plain_project_file(project, filepath, options, extra_comments);
+    const bf::path extension = bf::path(filepath).extension();
+
+    if (extension == ".appleseedz")
+        return write_packed_project_file(project, filepath, options, extra_comments);
+    else if (extension == ".appleseedb")
+        return write_binary_project_file(project, filepath, options, extra_comments);
+    else return write_plain_project_file(project, filepath, options, extra_comments);
 }
 
 bool ProjectFileWriter::write_plain_project_file(
@@ -930,20 +977,10 @@ bool ProjectFileWriter::write_plain_project_file(
 {
     RENDERER_LOG_INFO("writing project file %s...", filepath);
 
-    if (!(options & OmitHandlingAssetFiles))
+    if (!handle_asset_files(project, filepath, options))
     {
-        // Manage references to external asset files.
-        const AssetHandler asset_handler(
-            project,
-            filepath,
-            (options & CopyAllAssets) != 0
-                ? AssetHandler::CopyAllAssets
-                : AssetHandler::CopyRelativeAssetsOnly);
-        if (!asset_handler.handle_assets())
-        {
-            RENDERER_LOG_ERROR("failed to write project file %s.", filepath);
-            return false;
-        }
+        RENDERER_LOG_ERROR("failed to write project file %s.", filepath);
+        return false;
     }
 
     // Open the file for writing.
@@ -980,7 +1017,8 @@ bool ProjectFileWriter::write_plain_project_file(
     }
 
     // Write the project.
-    Writer writer(project, filepath, file, options);
+    Indenter indenter(4);
+    Writer writer(project, filepath, XMLOutput(file, indenter), options, false);
     writer.write_project(project);
 
     // Close the file.
@@ -990,6 +1028,45 @@ bool ProjectFileWriter::write_plain_project_file(
     return true;
 }
 
+bool ProjectFileWriter::write_binary_project_file(
+    Project&        project,
+    const char*     filepath,
+    const int       options,
+    const char*     extra_comments)
+{
+    RENDERER_LOG_INFO("writing binary project file %s...", filepath);
+
+    if (!handle_asset_files(project, filepath, options))
+    {
+        RENDERER_LOG_ERROR("failed to write binary project file %s.", filepath);
+        return false;
+    }
+
+    // Character data of these elements is stored as raw numbers.
+    set<string> numeric_elements;
+    numeric_elements.insert("alpha");
+    numeric_elements.insert("matrix");
+    numeric_elements.insert("values");
+
+    // Record the project directly, without going through a plain project file.
+    BinaryXMLWriter binary_writer(numeric_elements);
+    Writer writer(project, filepath, XMLOutput(binary_writer), options, true);
+    writer.write_project(project);
+
+    try
+    {
+        binary_writer.write(filepath);
+    }
+    catch (const ExceptionIOError&)
+    {
+        RENDERER_LOG_ERROR("failed to write binary project file %s: i/o error.", filepath);
+        return false;
+    }
+
+    RENDERER_LOG_INFO("wrote binary project file %s.", filepath);
+    return true;
+}
+
 bool ProjectFileWriter::write_packed_project_file(
     Project&        project,
     const char*     filepath,
@@ -55,7 +55,8 @@ class APPLESEED_DLLSYMBOL ProjectFileWriter
         CopyAllAssets               = 1 << 3    // copy all asset files (by default copy asset files with relative paths only)
     };
 
-    // Write a project to disk.
+    // Write a project to disk. Projects written to files with the .appleseedb
+    // extension are stored in a compact binary form that is much faster to read.
     // Returns true on success, false otherwise.
     static bool write(
         Project&        project,
@@ -72,6 +73,14 @@ class APPLESEED_DLLSYMBOL ProjectFileWriter
         const int       options,
         const char*     comments);
 
+    // Write a project to disk as a binary project file.
+    // Returns true on success, false otherwise.
+    static bool write_binary_project_file(
+        Project&        project,
+        const char*     filepath,
+        const int       options,
+        const char*     extra_comments);
+
     // Write a project file to disk as a packed project file.
     // Returns true on success, false otherwise.
     static bool write_packed_project_file(
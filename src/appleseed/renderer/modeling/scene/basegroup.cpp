@@ -31,6 +31,7 @@
 #include "basegroup.h"
 
 // appleseed.renderer headers.
+#include "renderer/global/globallogger.h"
 #include "renderer/kernel/shading/oslshadingsystem.h"
 #include "renderer/modeling/color/colorentity.h"
 #include "renderer/modeling/scene/assembly.h"
@@ -41,9 +42,18 @@
 
 // appleseed.foundation headers.
 #include "foundation/utility/foreach.h"
+#include "foundation/utility/job.h"
 #include "foundation/utility/job/abortswitch.h"
 
+// Boost headers.
+#include "boost/atomic/atomic.hpp"
+
+// Standard headers.
+#include <algorithm>
+#include <vector>
+
 using namespace foundation;
+using namespace std;
 
 namespace renderer
 {
@@ -108,29 +118,103 @@ void BaseGroup::clear()
     impl->m_assembly_instances.clear();
 }
 
+namespace
+{
+    void collect_invalid_shader_groups(
+        const BaseGroup&                    group,
+        vector<ShaderGroup*>&               shader_groups)
+    {
+        for (each<AssemblyContainer> i = group.assemblies(); i; ++i)
+            collect_invalid_shader_groups(*i, shader_groups);
+
+        for (each<ShaderGroupContainer> i = group.shader_groups(); i; ++i)
+        {
+            if (!i->is_valid())
+                shader_groups.push_back(&*i);
+        }
+    }
+
+    class ShaderGroupOptimizationJob
+      : public IJob
+    {
+      public:
+        ShaderGroupOptimizationJob(
+            ShaderGroup&                    shader_group,
+            OSLShadingSystem&               shading_system,
+            IAbortSwitch*                   abort_switch,
+            boost::atomic<bool>&            success)
+          : m_shader_group(shader_group)
+          , m_shading_system(shading_system)
+          , m_abort_switch(abort_switch)
+          , m_success(success)
+        {
+        }
+
+        void execute(const size_t thread_index) override
+        {
+            if (is_aborted(m_abort_switch))
+                return;
+
+            if (!m_shader_group.create_optimized_osl_shader_group(m_shading_system, m_abort_switch))
+                m_success = false;
+        }
+
+      private:
+        ShaderGroup&                        m_shader_group;
+        OSLShadingSystem&                   m_shading_system;
+        IAbortSwitch*                       m_abort_switch;
+        boost::atomic<bool>&                m_success;
+    };
+}
+
 bool BaseGroup::create_optimized_osl_shader_groups(
     OSLShadingSystem&           shading_system,
-    IAbortSwitch*               abort_switch)
+    IAbortSwitch*               abort_switch,
+    const size_t                thread_count)
 {
-    bool success = true;
+    vector<ShaderGroup*> shader_groups;
+    collect_invalid_shader_groups(*this, shader_groups);
 
-    for (each<AssemblyContainer> i = assemblies(); i; ++i)
+    if (shader_groups.empty())
+        return true;
+
+    // Shader groups are independent from one another: optimizing (JITing) them in parallel
+    // significantly reduces the time it takes for the first pixels to appear.
+    const size_t job_thread_count = min(thread_count, shader_groups.size());
+
+    if (job_thread_count <= 1)
     {
-        if (is_aborted(abort_switch))
-            return true;
+        bool success = true;
+
+        for (ShaderGroup* shader_group : shader_groups)
+        {
+            if (is_aborted(abort_switch))
+                return true;
 
-        success = success && i->create_optimized_osl_shader_groups(shading_system, abort_switch);
+            success = success && shader_group->create_optimized_osl_shader_group(shading_system, abort_switch);
+        }
+
+        return success;
     }
 
-    for (each<ShaderGroupContainer> i = shader_groups(); i; ++i)
-    {
-        if (is_aborted(abort_switch))
-            return true;
+    boost::atomic<bool> success(true);
+    JobQueue job_queue;
 
-        success = success && i->create_optimized_osl_shader_group(shading_system, abort_switch);
+    for (ShaderGroup* shader_group : shader_groups)
+    {
+        job_queue.schedule(
+            new ShaderGroupOptimizationJob(
+                *shader_group,
+                shading_system,
+                abort_switch,
+                success));
     }
 
-    return success;
+    JobManager job_manager(global_logger(), job_queue, job_thread_count);
+    job_manager.start();
+    job_queue.wait_until_completion();
+
+    return is_aborted(abort_switch) || success;
 }
 
 void BaseGroup::release_optimized_osl_shader_groups()
@@ -36,6 +36,9 @@
 // appleseed.main headers.
 #include "main/dllsymbol.h"
 
+// Standard headers.
+#include <cstddef>
+
 // Forward declarations.
 namespace foundation    { class IAbortSwitch; }
 namespace foundation    { class StringArray; }
@@ -77,10 +80,11 @@ class APPLESEED_DLLSYMBOL BaseGroup
     // Clear the base group contents.
     void clear();
 
-    // Create OSL shader groups and optimize them.
+    // Create OSL shader groups and optimize them, using up to `thread_count` threads.
     bool create_optimized_osl_shader_groups(
         OSLShadingSystem&           shading_system,
-        foundation::IAbortSwitch*   abort_switch = nullptr);
+        foundation::IAbortSwitch*   abort_switch = nullptr,
+        const size_t                thread_count = 1);
 
     // Release internal OSL shader groups.
     void release_optimized_osl_shader_groups();
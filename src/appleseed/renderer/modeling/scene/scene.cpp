@@ -58,6 +58,7 @@
 #include "foundation/utility/api/specializedapiarrays.h"
 #include "foundation/utility/foreach.h"
 #include "foundation/utility/job/abortswitch.h"
+#include "foundation/utility/profiler.h"
 
 // Standard headers.
 #include <set>
@@ -335,6 +336,8 @@ bool Scene::expand_procedural_assemblies(
     const Project&          project,
     IAbortSwitch*           abort_switch)
 {
+    ProfileZone profile_zone("expand procedural assemblies");
+
     for (each<AssemblyContainer> i = assemblies(); i; ++i)
     {
         if (!invoke_procedural_expand(*i, project, nullptr, abort_switch))
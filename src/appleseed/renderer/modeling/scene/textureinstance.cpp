@@ -103,9 +103,13 @@ TextureInstance::TextureInstance(
 
     // Retrieve the texture filtering mode.
     const string filtering_mode =
-        m_params.get_optional<string>("filtering_mode", "bilinear", make_vector("nearest", "bilinear"), context);
+        m_params.get_optional<string>("filtering_mode", "bilinear", make_vector("nearest", "bilinear", "trilinear", "ewa"), context);
     if (filtering_mode == "nearest")
         m_filtering_mode = TextureFilteringNearest;
+    else if (filtering_mode == "trilinear")
+        m_filtering_mode = TextureFilteringTrilinear;
+    else if (filtering_mode == "ewa")
+        m_filtering_mode = TextureFilteringEWA;
     else m_filtering_mode = TextureFilteringBilinear;
 
     // Retrieve the texture alpha mode.
@@ -269,7 +273,9 @@ DictionaryArray TextureInstanceFactory::get_input_metadata()
             .insert("items",
                 Dictionary()
                     .insert("Nearest", "nearest")
-                    .insert("Bilinear", "bilinear"))
+                    .insert("Bilinear", "bilinear")
+                    .insert("Trilinear (MIP-Mapped)", "trilinear")
+                    .insert("EWA (MIP-Mapped)", "ewa"))
             .insert("use", "optional")
             .insert("default", "bilinear"));
 
@@ -45,6 +45,7 @@
 #include "foundation/utility/uid.h"
 
 // Boost headers.
+#include "boost/thread/mutex.hpp"
 #include "boost/unordered/unordered_map.hpp"
 
 // Standard headers.
@@ -77,6 +78,11 @@ namespace
 
     const OIIO::ustring g_dPdtime_str("dPdtime");
 
+    // OSL keeps track of the shader group being built as part of the shading system's state,
+    // so ShaderGroupBegin()...ShaderGroupEnd() sequences must not overlap. Optimizing (JITing)
+    // shader groups, on the other hand, can safely be done concurrently.
+    boost::mutex g_shader_group_setup_mutex;
+
     bool is_subsurface_closure(const OIIO::ustring& closure_name)
     {
         return
@@ -179,45 +185,11 @@ bool ShaderGroup::create_optimized_osl_shader_group(
 
     try
     {
-        OSL::ShaderGroupRef shader_group_ref = shading_system.ShaderGroupBegin(get_name());
-
-        if (shader_group_ref.get() == nullptr)
-        {
-            RENDERER_LOG_ERROR("failed to setup shader group \"%s\": ShaderGroupBegin() call failed.", get_path().c_str());
-            return false;
-        }
-
-        for (each<ShaderContainer> i = impl->m_shaders; i; ++i)
-        {
-            if (is_aborted(abort_switch))
-            {
-                shading_system.ShaderGroupEnd();
-                return true;
-            }
-
-            if (!i->add(shading_system))
-                return false;
-        }
-
-        for (each<ShaderConnectionContainer> i = impl->m_connections; i; ++i)
-        {
-            if (is_aborted(abort_switch))
-            {
-                shading_system.ShaderGroupEnd();
-                return true;
-            }
-
-            if (!i->add(shading_system))
-                return false;
-        }
-
-        if (!shading_system.ShaderGroupEnd())
-        {
-            RENDERER_LOG_ERROR("failed to setup shader group \"%s\": ShaderGroupEnd() call failed.", get_path().c_str());
+        if (!create_osl_shader_group(shading_system, abort_switch))
             return false;
-        }
 
-        impl->m_shader_group_ref = shader_group_ref;
+        if (!is_valid())
+            return true;
 
         get_shadergroup_closures_info(shading_system);
         report_has_closure("bsdf", HasBSDFs);
@@ -238,6 +210,55 @@ bool ShaderGroup::create_optimized_osl_shader_group(
     }
 }
 
+bool ShaderGroup::create_osl_shader_group(
+    OSLShadingSystem&   shading_system,
+    IAbortSwitch*       abort_switch)
+{
+    boost::mutex::scoped_lock lock(g_shader_group_setup_mutex);
+
+    OSL::ShaderGroupRef shader_group_ref = shading_system.ShaderGroupBegin(get_name());
+
+    if (shader_group_ref.get() == nullptr)
+    {
+        RENDERER_LOG_ERROR("failed to setup shader group \"%s\": ShaderGroupBegin() call failed.", get_path().c_str());
+        return false;
+    }
+
+    for (each<ShaderContainer> i = impl->m_shaders; i; ++i)
+    {
+        if (is_aborted(abort_switch))
+        {
+            shading_system.ShaderGroupEnd();
+            return true;
+        }
+
+        if (!i->add(shading_system))
+            return false;
+    }
+
+    for (each<ShaderConnectionContainer> i = impl->m_connections; i; ++i)
+    {
+        if (is_aborted(abort_switch))
+        {
+            shading_system.ShaderGroupEnd();
+            return true;
+        }
+
+        if (!i->add(shading_system))
+            return false;
+    }
+
+    if (!shading_system.ShaderGroupEnd())
+    {
+        RENDERER_LOG_ERROR("failed to setup shader group \"%s\": ShaderGroupEnd() call failed.", get_path().c_str());
+        return false;
+    }
+
+    impl->m_shader_group_ref = shader_group_ref;
+
+    return true;
+}
+
 void ShaderGroup::release_optimized_osl_shader_group()
 {
     impl->m_shader_group_ref.reset();
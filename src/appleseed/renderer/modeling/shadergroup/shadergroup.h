@@ -84,7 +84,7 @@ class APPLESEED_DLLSYMBOL ShaderGroup
         const char*                 dst_layer,
         const char*                 dst_param);
 
-    // Create internal OSL shader group.
+    // Create internal OSL shader group. Distinct shader groups can be created concurrently.
     bool create_optimized_osl_shader_group(
         OSLShadingSystem&           shading_system,
         foundation::IAbortSwitch*   abort_switch = nullptr);
@@ -172,6 +172,10 @@ class APPLESEED_DLLSYMBOL ShaderGroup
     // Destructor.
     ~ShaderGroup() override;
 
+    bool create_osl_shader_group(
+        OSLShadingSystem&           shading_system,
+        foundation::IAbortSwitch*   abort_switch);
+
     void get_shadergroup_closures_info(OSLShadingSystem& shading_system);
     void report_has_closure(const char* closure_name, const Flags flag) const;
 
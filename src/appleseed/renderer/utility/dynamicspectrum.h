@@ -54,6 +54,10 @@ namespace renderer
 //
 // Internal working spectrum type, either RGB or spectral depending on the thread-local spectrum mode.
 //
+// When APPLESEED_RGB_ONLY_SPECTRUM is defined, spectral rendering is compiled out: the spectrum
+// mode is always RGB, only four samples are stored and mode tests are resolved at compile time.
+// Note that this changes the size of the type and therefore the binary interface of the library.
+//
 
 template <typename T, size_t N>
 class DynamicSpectrum
@@ -64,7 +68,11 @@ class DynamicSpectrum
     static const size_t Samples = N;
 
     // Number of stored samples such that the size of the sample array is a multiple of 16 bytes.
+#ifdef APPLESEED_RGB_ONLY_SPECTRUM
+    static const size_t StoredSamples = (((3 * sizeof(T)) + 15) & ~15) / sizeof(T);
+#else
     static const size_t StoredSamples = (((N * sizeof(T)) + 15) & ~15) / sizeof(T);
+#endif
 
     enum Mode
     {
@@ -79,8 +87,12 @@ class DynamicSpectrum
     };
 
     // Change the current thread-local spectrum mode. Return the previous mode.
+    // In RGB-only builds, the mode cannot be changed and always remains RGB.
     static Mode set_mode(const Mode mode);
 
+    // Return true if spectral rendering is supported by this build.
+    static bool is_spectral_mode_supported();
+
     // Return the current thread-local spectrum mode.
     static Mode get_mode();
 
@@ -142,8 +154,13 @@ class DynamicSpectrum
         const foundation::LightingConditions&   lighting_conditions) const;
 
   private:
+#ifdef APPLESEED_RGB_ONLY_SPECTRUM
+    static const Mode               s_mode = RGB;
+    static const size_t             s_size = 3;
+#else
     static APPLESEED_TLS Mode       s_mode;
     static APPLESEED_TLS size_t     s_size;
+#endif
 
     APPLESEED_SIMD4_ALIGN ValueType m_samples[StoredSamples];
 };
@@ -275,6 +292,28 @@ template <typename T, size_t N> renderer::DynamicSpectrum<T, N> exp(const render
 namespace renderer
 {
 
+#ifdef APPLESEED_RGB_ONLY_SPECTRUM
+
+template <typename T, size_t N>
+const typename DynamicSpectrum<T, N>::Mode DynamicSpectrum<T, N>::s_mode;
+
+template <typename T, size_t N>
+const size_t DynamicSpectrum<T, N>::s_size;
+
+template <typename T, size_t N>
+inline typename DynamicSpectrum<T, N>::Mode DynamicSpectrum<T, N>::set_mode(const Mode)
+{
+    return RGB;
+}
+
+template <typename T, size_t N>
+inline bool DynamicSpectrum<T, N>::is_spectral_mode_supported()
+{
+    return false;
+}
+
+#else
+
 // Full specialization is required in the value for Apple LLVM version 7.0.0 (clang-700.1.76).
 template <typename T, size_t N>
 APPLESEED_TLS typename DynamicSpectrum<T, N>::Mode DynamicSpectrum<T, N>::s_mode = DynamicSpectrum<float, 31>::RGB;
@@ -293,6 +332,14 @@ typename DynamicSpectrum<T, N>::Mode DynamicSpectrum<T, N>::set_mode(const Mode
     return old_mode;
 }
 
+template <typename T, size_t N>
+inline bool DynamicSpectrum<T, N>::is_spectral_mode_supported()
+{
+    return true;
+}
+
+#endif
+
 template <typename T, size_t N>
 inline typename DynamicSpectrum<T, N>::Mode DynamicSpectrum<T, N>::get_mode()
 {
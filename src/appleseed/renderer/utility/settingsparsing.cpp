@@ -56,6 +56,13 @@ Spectrum::Mode get_spectrum_mode(const ParamArray& params)
             "rgb",
             make_vector("rgb", "spectral"));
 
+    if (spectrum_mode == "spectral" && !Spectrum::is_spectral_mode_supported())
+    {
+        RENDERER_LOG_WARNING(
+            "spectral rendering is not supported by this build of appleseed, using rgb spectrum mode.");
+        return Spectrum::RGB;
+    }
+
     return
         spectrum_mode == "rgb"
             ? Spectrum::RGB
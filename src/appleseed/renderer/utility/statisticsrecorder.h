@@ -0,0 +1,67 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2018 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef APPLESEED_RENDERER_UTILITY_STATISTICSRECORDER_H
+#define APPLESEED_RENDERER_UTILITY_STATISTICSRECORDER_H
+
+// appleseed.foundation headers.
+#include "foundation/core/concepts/noncopyable.h"
+#include "foundation/utility/statistics.h"
+
+// Boost headers.
+#include "boost/thread/mutex.hpp"
+
+namespace renderer
+{
+
+//
+// A record of the statistics reported by renderer components, used to export
+// them in a machine-readable form. This class is thread-safe.
+//
+
+class StatisticsRecorder
+  : public foundation::NonCopyable
+{
+  public:
+    // Record a set of statistics.
+    void record(const foundation::StatisticsVector& stats);
+
+    // Return all statistics recorded since the last call to clear().
+    foundation::StatisticsVector get_statistics() const;
+
+    // Forget all recorded statistics.
+    void clear();
+
+  private:
+    mutable boost::mutex            m_mutex;
+    foundation::StatisticsVector    m_stats;
+};
+
+}       // namespace renderer
+
+#endif  // !APPLESEED_RENDERER_UTILITY_STATISTICSRECORDER_H
@@ -41,6 +41,7 @@
 #include <algorithm>
 #include <cmath>
 #include <cstring>
+#include <limits>
 
 using namespace foundation;
 using namespace std;
@@ -48,11 +49,33 @@ using namespace std;
 namespace renderer
 {
 
+namespace
+{
+    // Default maximum number of time samples precomputed for each motion segment.
+    const size_t DefaultMaxSamplesPerSegment = 8;
+
+    // Maximum relative error tolerated when interpolating matrices directly.
+    const double MaxMatrixInterpolationError = 1.0e-7;
+
+    void lerp_matrices(
+        const Matrix4d&     a,
+        const Matrix4d&     b,
+        const double        t,
+        Matrix4d&           result)
+    {
+        for (size_t i = 0; i < 16; ++i)
+            result[i] = a[i] + (b[i] - a[i]) * t;
+    }
+}
+
 TransformSequence::TransformSequence()
   : m_capacity(0)
   , m_size(0)
   , m_keys(nullptr)
   , m_interpolators(nullptr)
+  , m_max_samples_per_segment(DefaultMaxSamplesPerSegment)
+  , m_segments(nullptr)
+  , m_samples(nullptr)
   , m_can_swap_handedness(false)
   , m_all_swap_handedness(false)
 {
@@ -85,6 +108,12 @@ void TransformSequence::clear()
     delete[] m_interpolators;
     m_interpolators = nullptr;
 
+    delete[] m_segments;
+    m_segments = nullptr;
+
+    delete[] m_samples;
+    m_samples = nullptr;
+
     m_can_swap_handedness = false;
     m_all_swap_handedness = false;
 }
@@ -156,6 +185,18 @@ const Transformd& TransformSequence::get_earliest_transform() const
     return m_keys[earliest_index].m_transform;
 }
 
+void TransformSequence::set_max_samples_per_segment(const size_t count)
+{
+    m_max_samples_per_segment = count;
+}
+
+size_t TransformSequence::get_sample_memory_size() const
+{
+    return
+          (m_segments != nullptr ? (m_size - 1) * sizeof(MotionSegment) : 0)
+        + get_sample_count() * sizeof(Transformd);
+}
+
 void TransformSequence::optimize()
 {
     if (m_size > 1)
@@ -184,6 +225,12 @@ bool TransformSequence::prepare()
     delete[] m_interpolators;
     m_interpolators = nullptr;
 
+    delete[] m_segments;
+    m_segments = nullptr;
+
+    delete[] m_samples;
+    m_samples = nullptr;
+
     bool success = true;
 
     if (m_size > 1)
@@ -199,6 +246,9 @@ bool TransformSequence::prepare()
                     m_keys[i].m_transform,
                     m_keys[i + 1].m_transform);
         }
+
+        if (success)
+            prepare_samples();
     }
 
     m_can_swap_handedness = false;
@@ -301,10 +351,47 @@ void TransformSequence::copy_from(const TransformSequence& rhs)
     }
     else m_interpolators = nullptr;
 
+    m_max_samples_per_segment = rhs.m_max_samples_per_segment;
+
+    if (rhs.m_segments)
+    {
+        m_segments = new MotionSegment[m_size - 1];
+
+        for (size_t i = 0; i < m_size - 1; ++i)
+            m_segments[i] = rhs.m_segments[i];
+    }
+    else m_segments = nullptr;
+
+    if (rhs.m_samples)
+    {
+        const size_t sample_count = rhs.get_sample_count();
+        m_samples = new Transformd[sample_count];
+
+        for (size_t i = 0; i < sample_count; ++i)
+            m_samples[i] = rhs.m_samples[i];
+    }
+    else m_samples = nullptr;
+
     m_can_swap_handedness = rhs.m_can_swap_handedness;
     m_all_swap_handedness = rhs.m_all_swap_handedness;
 }
 
+size_t TransformSequence::get_sample_count() const
+{
+    size_t sample_count = 0;
+
+    if (m_segments)
+    {
+        for (size_t i = 0; i < m_size - 1; ++i)
+        {
+            if (m_segments[i].m_sample_count > 0)
+                sample_count = m_segments[i].m_first_sample + m_segments[i].m_sample_count + 1;
+        }
+    }
+
+    return sample_count;
+}
+
 void TransformSequence::interpolate(
     const float         time,
     Transformd&         result) const
@@ -329,7 +416,87 @@ void TransformSequence::interpolate(
 
     const float t = (time - begin_time) / (end_time - begin_time);
 
-    m_interpolators[begin].evaluate(static_cast<double>(t), result);
+    const size_t sample_count = m_segments != nullptr ? m_segments[begin].m_sample_count : 0;
+
+    if (sample_count > 0)
+    {
+        // Interpolate the matrices of the two surrounding time samples.
+        const double x = static_cast<double>(t) * sample_count;
+        const size_t i = min(truncate<size_t>(x), sample_count - 1);
+        const Transformd* samples = m_samples + m_segments[begin].m_first_sample + i;
+
+        Matrix4d m;
+        lerp_matrices(samples[0].get_local_to_parent(), samples[1].get_local_to_parent(), x - i, m);
+        result.set_local_to_parent(m);
+        lerp_matrices(samples[0].get_parent_to_local(), samples[1].get_parent_to_local(), x - i, m);
+        result.set_parent_to_local(m);
+    }
+    else m_interpolators[begin].evaluate(static_cast<double>(t), result);
+}
+
+void TransformSequence::prepare_samples()
+{
+    assert(m_size > 1);
+    assert(m_interpolators != nullptr);
+
+    if (m_max_samples_per_segment == 0)
+        return;
+
+    m_segments = new MotionSegment[m_size - 1];
+
+    size_t total_sample_count = 0;
+
+    for (size_t i = 0; i < m_size - 1; ++i)
+    {
+        const TransformInterpolatord& interpolator = m_interpolators[i];
+
+        // Rotation angle, relative scaling change and relative translation change over the segment.
+        const double theta = 2.0 * acos(min(abs(dot(interpolator.get_q0(), interpolator.get_q1())), 1.0));
+        const Vector3d& s0 = interpolator.get_s0();
+        const Vector3d& s1 = interpolator.get_s1();
+        double min_scale = numeric_limits<double>::max(), max_scale_change = 0.0;
+        for (size_t j = 0; j < 3; ++j)
+        {
+            min_scale = min(min_scale, min(abs(s0[j]), abs(s1[j])));
+            max_scale_change = max(max_scale_change, abs(s1[j] - s0[j]));
+        }
+        const double r = min_scale > 0.0 ? max_scale_change / min_scale : numeric_limits<double>::max();
+        const double max_translation = max(norm(interpolator.get_t0()), norm(interpolator.get_t1()));
+        const double d = max_translation > 0.0 ? norm(interpolator.get_t1() - interpolator.get_t0()) / max_translation : 0.0;
+
+        // Bound on the second derivative of the matrices with respect to the interpolation parameter
+        // (relative to their magnitude), which drives the error of linear interpolation between samples.
+        // Translations alone are exactly linear in time.
+        const double k = square(theta) + 4.0 * square(r) + 2.0 * theta * r + 2.0 * theta * d + 2.0 * r * d;
+        const double n = ceil(sqrt(k / (8.0 * MaxMatrixInterpolationError)));
+
+        MotionSegment& segment = m_segments[i];
+        segment.m_first_sample = total_sample_count;
+        segment.m_sample_count =
+            n <= static_cast<double>(m_max_samples_per_segment)
+                ? max<size_t>(static_cast<size_t>(n), 1)
+                : 0;
+
+        if (segment.m_sample_count > 0)
+            total_sample_count += segment.m_sample_count + 1;
+    }
+
+    if (total_sample_count == 0)
+        return;
+
+    m_samples = new Transformd[total_sample_count];
+
+    for (size_t i = 0; i < m_size - 1; ++i)
+    {
+        const MotionSegment& segment = m_segments[i];
+
+        for (size_t j = 0; segment.m_sample_count > 0 && j <= segment.m_sample_count; ++j)
+        {
+            m_interpolators[i].evaluate(
+                static_cast<double>(j) / segment.m_sample_count,
+                m_samples[segment.m_first_sample + j]);
+        }
+    }
 }
 
 namespace
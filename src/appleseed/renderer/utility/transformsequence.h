@@ -87,6 +87,16 @@ class APPLESEED_DLLSYMBOL TransformSequence
     // Return the identity transform if the sequence is empty.
     const foundation::Transformd& get_earliest_transform() const;
 
+    // Set the maximum number of time samples precomputed by prepare() for each motion segment.
+    // Between two samples, evaluate() interpolates the matrices directly, which is only done
+    // when the motion is small enough for this to be accurate. Zero disables the sampling.
+    // Each sample takes sizeof(foundation::Transformd) bytes. The default maximum is 8.
+    void set_max_samples_per_segment(const size_t count);
+    size_t get_max_samples_per_segment() const;
+
+    // Return the size in bytes of the time samples precomputed by prepare().
+    size_t get_sample_memory_size() const;
+
     // Optimize the sequence by removing redundant transforms.
     // If called, this method must be called after new transforms
     // have been set and before the call to prepare().
@@ -136,15 +146,28 @@ class APPLESEED_DLLSYMBOL TransformSequence
         }
     };
 
+    struct MotionSegment
+    {
+        size_t                          m_first_sample;
+        size_t                          m_sample_count;     // number of sampling intervals, 0 if the segment isn't sampled
+    };
+
     size_t                              m_capacity;
     size_t                              m_size;
     TransformKey*                       m_keys;
     foundation::TransformInterpolatord* m_interpolators;
+    size_t                              m_max_samples_per_segment;
+    MotionSegment*                      m_segments;
+    foundation::Transformd*             m_samples;
     bool                                m_can_swap_handedness;
     bool                                m_all_swap_handedness;
 
     void copy_from(const TransformSequence& rhs);
 
+    void prepare_samples();
+
+    size_t get_sample_count() const;
+
     void interpolate(
         const float                     time,
         foundation::Transformd&         result) const;
@@ -170,6 +193,11 @@ inline size_t TransformSequence::size() const
     return m_size;
 }
 
+inline size_t TransformSequence::get_max_samples_per_segment() const
+{
+    return m_max_samples_per_segment;
+}
+
 inline bool TransformSequence::can_swap_handedness() const
 {
     return m_can_swap_handedness;